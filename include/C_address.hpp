@@ -1,62 +1,86 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#ifndef C_ADDRESS_H_INCLUDED
-#define C_ADDRESS_H_INCLUDED
-
-#include <string>
-#include <list>
-
-#define CODEG_NULL_UINDEX 0
-
-namespace codeg
-{
-
-struct CompilerData;
-
-typedef uint32_t Address;
-
-struct Label
-{
-    std::string _name;
-    uint16_t _uniqueIndex;
-    codeg::Address _addressStatic;
-
-    static uint16_t s_indexCount;
-};
-
-struct JumpPoint
-{
-    std::string _labelName;
-    codeg::Address _addressStatic;
-};
-
-struct JumpList
-{
-    void resolve(codeg::CompilerData& data);
-
-    bool addLabel(const codeg::Label& d);
-    bool addJumpPoint(const codeg::JumpPoint& d);
-
-    std::list<codeg::Label>::iterator getLabel(const std::string& name);
-
-    std::list<codeg::Label> _labels;
-    std::list<codeg::JumpPoint> _jumpPoints;
-};
-
-}//end codeg
-
-#endif // C_ADDRESS_H_INCLUDED
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_ADDRESS_H_INCLUDED
+#define C_ADDRESS_H_INCLUDED
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+#define CODEG_NULL_UINDEX 0
+
+namespace codeg
+{
+
+struct CompilerData;
+
+typedef uint32_t Address;
+
+struct Label
+{
+    std::string _name;
+    uint16_t _uniqueIndex;
+    codeg::Address _addressStatic;
+
+    static uint16_t s_indexCount;
+};
+
+enum JumpPointTypes : uint8_t
+{
+    JUMP_POINT_JUMP_SOURCE = 0, //BJMPSRC3/2/1 sequence, the address is written in the 3 arguments
+
+    JUMP_POINT_BYTE_MSB, //1 instruction, only 1 byte of the address is written in the argument
+    JUMP_POINT_BYTE_MID,
+    JUMP_POINT_BYTE_LSB
+};
+
+struct JumpPoint
+{
+    std::string _labelName;
+    codeg::Address _addressStatic;
+    codeg::JumpPointTypes _type = codeg::JumpPointTypes::JUMP_POINT_JUMP_SOURCE;
+};
+
+struct JumpTable
+{
+    std::string _labelName; //Start of the table, aligned to a 256 bytes page
+    codeg::Address _paddingStatic; //Start of the padding placed before the table
+    uint32_t _entryCount; //Every entry is a jump followed by a padding byte (8 bytes)
+};
+
+struct JumpList
+{
+    void resolve(codeg::CompilerData& data);
+
+    bool addLabel(const codeg::Label& d);
+    bool addJumpPoint(const codeg::JumpPoint& d);
+
+    std::list<codeg::Label>::iterator getLabel(const std::string& name);
+    std::list<codeg::Label>::iterator removeLabel(std::list<codeg::Label>::iterator it);
+
+    std::list<codeg::Label> _labels; //Must be modified with addLabel/removeLabel to keep the lookups in sync
+    std::unordered_map<std::string, std::list<codeg::Label>::iterator> _labelNames;
+    std::unordered_set<uint16_t> _labelIndexes; //Used unique index (CODEG_NULL_UINDEX excluded)
+    std::list<codeg::Label> _mergedLabels; //Removed by the optimizer, they share the address of another label
+    std::list<codeg::JumpPoint> _jumpPoints;
+    std::list<codeg::JumpTable> _jumpTables;
+};
+
+}//end codeg
+
+#endif // C_ADDRESS_H_INCLUDED
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_ALU_H_INCLUDED
+#define C_ALU_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace codeg
+{
+
+class CodeData;
+
+enum AluRevisions : uint8_t
+{
+    ALU_REVISION_NULL = 0,
+
+    ALU_REVISION_GP8B_V1,
+    ALU_REVISION_GP8B_V4
+};
+
+using AluFunction = uint8_t (*)(uint8_t left, uint8_t right);
+
+struct AluOperation
+{
+    std::string _name;
+    codeg::AluFunction _function;
+};
+
+class Alu
+{
+    /**
+    Describe the semantics of every operation code of the target ALU for 8-bit operands.
+    An unknown operation code (or an operation without a declared semantic) can't be computed.
+    **/
+public:
+    Alu() = default;
+    ~Alu() = default;
+
+    void clear();
+
+    bool setRevision(const std::string& name);
+    codeg::AluRevisions getRevision() const;
+    const std::string& getRevisionName() const;
+
+    const codeg::AluOperation* getOperation(uint8_t opcode) const;
+    bool compute(uint8_t left, uint8_t opcode, uint8_t right, uint8_t& result) const;
+
+private:
+    codeg::AluRevisions g_revision = codeg::AluRevisions::ALU_REVISION_NULL;
+    std::string g_revisionName;
+    std::vector<codeg::AluOperation> g_operations;
+};
+
+struct AluLatch
+{
+    bool _known = false;
+    uint8_t _value = 0;
+};
+
+class AluState
+{
+    /**
+    Track the content of the ALU latches (OPLEFT, OPCHOOSE, OPRIGHT) while compiling.
+
+    When the 3 latches are known, the result is known and can be used as an immediate value.
+    A "do" with only constant operands is not emitted immediately (pending), it is only
+    emitted (flushed) when the hardware latches could be observed by something else than
+    a "_result" read (a jump, a label, a call, a "choose OP", a "brut", ...).
+    **/
+public:
+    AluState() = default;
+    ~AluState() = default;
+
+    void clear();
+
+    void setLeft(bool known, uint8_t value=0);
+    void setOperation(bool known, uint8_t value=0);
+    void setRight(bool known, uint8_t value=0);
+
+    const codeg::AluLatch& getLeft() const;
+    const codeg::AluLatch& getOperation() const;
+    const codeg::AluLatch& getRight() const;
+
+    bool getResult(const codeg::Alu& alu, uint8_t& result) const;
+
+    void setPending(bool pending);
+    bool isPending() const;
+
+    void flush(codeg::CodeData& code);
+    void discard();
+
+    uint32_t getRemovedCount() const;
+
+private:
+    codeg::AluLatch g_left;
+    codeg::AluLatch g_operation;
+    codeg::AluLatch g_right;
+
+    bool g_pending = false;
+    uint32_t g_removedCount = 0;
+};
+
+}//end codeg
+
+#endif // C_ALU_H_INCLUDED
@@ -1,142 +1,302 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#ifndef C_COMPILERDATA_H_INCLUDED
-#define C_COMPILERDATA_H_INCLUDED
-
-#include "C_reserved.hpp"
-#include "C_function.hpp"
-#include "C_fileReader.hpp"
-#include "C_stringDecomposer.hpp"
-#include "C_macro.hpp"
-#include "C_variable.hpp"
-#include "C_address.hpp"
-#include "C_instruction.hpp"
-#include <memory>
-#include <stack>
-
-namespace codeg
-{
-
-enum ScopeStats
-{
-    SCOPE_FUNCTION,
-    SCOPE_DEFINITION,
-
-    SCOPE_CONDITIONAL_TRUE,
-    SCOPE_CONDITIONAL_FALSE
-};
-
-struct Scope
-{
-    uint32_t _id;
-    codeg::ScopeStats _stat;
-
-    unsigned int _startLine;
-    std::string _startFile;
-};
-
-class ScopeList
-{
-public:
-    using ScopeListType = std::stack<codeg::Scope>;
-
-    ScopeList() = default;
-    ~ScopeList() = default;
-
-    void clear();
-
-    void newScope(codeg::ScopeStats stat, unsigned int startLine, const std::string& startFile);
-
-    const codeg::Scope& top() const;
-    codeg::Scope& top();
-
-    void pop();
-
-    bool empty() const;
-    size_t size() const;
-    uint32_t getScopeCount() const;
-
-private:
-    codeg::ScopeList::ScopeListType g_data;
-    uint32_t g_scopeCount = 0;
-};
-
-class CodeData
-{
-public:
-    CodeData() = default;
-    ~CodeData() = default;
-
-    void clear();
-
-    void push(uint8_t d);
-    void pushDummy();
-    void resize(uint32_t n);
-
-    uint32_t getCapacity() const;
-    uint32_t getCursor() const;
-
-    void set(uint32_t index, uint32_t value);
-    uint8_t get(uint32_t index) const;
-
-    uint8_t& operator[](uint32_t index);
-    const uint8_t& operator[](uint32_t index) const;
-
-    uint8_t* getData();
-    std::shared_ptr<uint8_t[]>& getSharedData();
-
-    void setWriteDummy(bool value);
-    bool getWriteDummy() const;
-
-private:
-    uint32_t g_cursor = 0;
-    uint32_t g_capacity = 0;
-
-    bool g_writeDummy = false;
-
-    std::shared_ptr<uint8_t[]> g_data;
-};
-
-struct CompilerData
-{
-    codeg::StringDecomposer _decomposer;
-
-    codeg::InstructionList _instructions;
-    codeg::ReservedList _reservedKeywords;
-
-    codeg::PoolList _pools;
-    std::string _defaultPool;
-
-    codeg::MacroList _macros;
-
-    codeg::JumpList _jumps;
-
-    bool _writeLinesIntoDefinition=false;
-    std::string _actualFunctionName;
-    codeg::FunctionList _functions;
-
-    codeg::ScopeList _scopes;
-
-    codeg::FileReader _reader;
-    std::string _relativePath;
-
-    codeg::CodeData _code;
-};
-
-}//end codeg
-
-#endif // C_COMPILERDATA_H_INCLUDED
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_COMPILERDATA_H_INCLUDED
+#define C_COMPILERDATA_H_INCLUDED
+
+#include "C_reserved.hpp"
+#include "C_function.hpp"
+#include "C_fileReader.hpp"
+#include "C_stringDecomposer.hpp"
+#include "C_macro.hpp"
+#include "C_variable.hpp"
+#include "C_address.hpp"
+#include "C_instruction.hpp"
+#include "C_alu.hpp"
+#include "C_dataflow.hpp"
+#include <memory>
+#include <stack>
+#include <list>
+#include <vector>
+
+namespace codeg
+{
+
+enum OptimizationLevels : uint8_t
+{
+    OPTIMIZATION_LEVEL_0 = 0,
+    OPTIMIZATION_LEVEL_1,
+    OPTIMIZATION_LEVEL_2
+};
+enum OptimizationPolicies : uint8_t
+{
+    OPTIMIZATION_POLICY_SPEED = 0,
+    OPTIMIZATION_POLICY_SIZE
+};
+
+enum ScopeStats
+{
+    SCOPE_FUNCTION,
+    SCOPE_DEFINITION,
+
+    SCOPE_CONDITIONAL_TRUE,
+    SCOPE_CONDITIONAL_FALSE,
+
+    SCOPE_REPEAT,
+    SCOPE_SWITCH
+};
+
+struct Scope
+{
+    uint32_t _id;
+    codeg::ScopeStats _stat;
+
+    unsigned int _startLine;
+    std::string _startFile;
+
+    codeg::DataflowState _dataflow; //State of the other path (false condition, before a function)
+};
+
+enum RepeatCosts : uint32_t
+{
+    REPEAT_COST_LOOP_SIZE = 22, //Bytes of the counter decrement and the conditional jump
+    REPEAT_COST_LOOP_CYCLES = 13, //Instructions executed by the counter decrement and the conditional jump
+    REPEAT_COST_MAX_SIZE = 256, //Max bytes of the repeated code when the code is duplicated (speed policy)
+    REPEAT_COST_BYTES_PER_CYCLE = 2 //Bytes that can be added for every saved instruction (speed policy)
+};
+
+struct Repeat
+{
+    /**
+    The first copy of the repeated code is compiled as a loop body, its lines are kept and
+    the "end" choose how the code is repeated :
+        - fully unrolled, the code is duplicated [value] times (the counter is not used)
+        - partially unrolled, the loop body contain _loopCopies copies and the remaining copies are placed after the loop
+        - a loop that decrement the counter (always used with a dynamic [value])
+    **/
+    uint32_t _scopeId;
+
+    codeg::Variable* _counter;
+    std::string _counterKeyword;
+
+    bool _constant; //The count is known
+    uint8_t _count;
+    uint32_t _countIndex; //Index of the count in the code, changed when the loop body is unrolled
+
+    uint32_t _bodyStart;
+    unsigned int _readerLevel; //Reader level of the kept lines
+    codeg::Function::FunctionLinesType _lines;
+
+    uint8_t _loopCopies = 1;
+    uint8_t _remainderCopies = 0;
+    bool _unrolled = false; //No loop
+    bool _duplicated = false; //The copies are compiled
+};
+
+enum DelayCosts : uint32_t
+{
+    DELAY_MIN_COUNT = 32, //Less ticks (or pulses) are always unrolled
+    DELAY_MAX_ITERATIONS = 255, //The countdown use an 8-bit ALU
+    DELAY_BODY_SEARCH = 8 //Loop body sizes tried to find the smallest code
+};
+
+struct Delay
+{
+    std::string _description;
+    std::string _file;
+    unsigned int _line;
+
+    uint32_t _count; //Requested ticks (or pulses)
+    uint32_t _cycles; //Cycles of the compiled loop
+    bool _exact; //The cycles are the requested ticks
+};
+
+struct LoopBound
+{
+    std::string _label; //Start of the loop (the target of the jump back)
+    uint32_t _min; //Executions of the start every time the loop is entered
+    uint32_t _max;
+};
+
+struct CycleBudget
+{
+    std::string _name; //Function or label
+    uint64_t _cycles; //Max worst case cycles
+    std::string _file;
+    unsigned int _line;
+};
+
+struct CodeOrigin
+{
+    std::string _function; //Function or definition, empty for the main code
+    bool _definition;
+    std::string _file;
+    unsigned int _line;
+    std::string _keyword; //Instruction
+};
+
+enum SwitchCosts : uint32_t
+{
+    SWITCH_TABLE_MAX_ENTRIES = 32, //An entry index is multiplied by 8 with an 8-bit ALU
+    SWITCH_TABLE_MIN_CASES = 4, //Less cases are faster with a compare tree
+    SWITCH_TREE_LEAF_SIZE = 3 //Max cases tested one after the other at the end of the compare tree
+};
+
+struct Switch
+{
+    /**
+    The cases are compiled in the order of the code, every case jump to the end of the switch.
+    The dispatch is placed after the last case (the switch start with a jump to it) :
+        - a dense set of cases use a jump table aligned to a 256 bytes page (with the speed policy)
+        - else a balanced compare tree
+    **/
+    uint32_t _scopeId;
+
+    codeg::Variable* _variable; //nullptr if the value is read from a bus
+    codeg::ReadableBusses _valueBus;
+    uint8_t _value;
+
+    std::vector<uint8_t> _cases;
+    bool _default = false;
+};
+
+class ScopeList
+{
+public:
+    using ScopeListType = std::stack<codeg::Scope>;
+
+    ScopeList() = default;
+    ~ScopeList() = default;
+
+    void clear();
+
+    void newScope(codeg::ScopeStats stat, unsigned int startLine, const std::string& startFile);
+
+    const codeg::Scope& top() const;
+    codeg::Scope& top();
+
+    void pop();
+
+    bool empty() const;
+    size_t size() const;
+    uint32_t getScopeCount() const;
+
+private:
+    codeg::ScopeList::ScopeListType g_data;
+    uint32_t g_scopeCount = 0;
+};
+
+class CodeData
+{
+public:
+    CodeData() = default;
+    ~CodeData() = default;
+
+    void clear();
+
+    void push(uint8_t d);
+    void pushDummy();
+    void resize(uint32_t n);
+
+    uint32_t getCapacity() const;
+    uint32_t getCursor() const;
+
+    void set(uint32_t index, uint32_t value);
+    uint8_t get(uint32_t index) const;
+
+    uint8_t& operator[](uint32_t index);
+    const uint8_t& operator[](uint32_t index) const;
+
+    uint8_t* getData();
+    std::shared_ptr<uint8_t[]>& getSharedData();
+
+    void setWriteDummy(bool value);
+    bool getWriteDummy() const;
+
+    uint32_t getInstructionCount(uint32_t begin, uint32_t end) const;
+
+    void setOriginTracking(bool value);
+    bool getOriginTracking() const;
+    void setOrigin(uint32_t origin);
+    uint32_t getOrigin() const;
+    uint32_t getOrigin(uint32_t index) const;
+
+private:
+    uint32_t g_cursor = 0;
+    uint32_t g_capacity = 0;
+
+    bool g_writeDummy = false;
+
+    uint32_t g_origin = 0; //Origin of the next pushed bytes
+    bool g_originTracking = false;
+    std::vector<uint32_t> g_origins; //Origin of every byte
+
+    std::shared_ptr<uint8_t[]> g_data;
+};
+
+struct CompilerData
+{
+    codeg::StringDecomposer _decomposer;
+
+    codeg::InstructionList _instructions;
+    codeg::ReservedList _reservedKeywords;
+
+    codeg::PoolList _pools;
+    std::string _defaultPool;
+
+    codeg::MacroList _macros;
+
+    codeg::JumpList _jumps;
+
+    bool _writeLinesIntoDefinition=false;
+    std::string _actualFunctionName;
+    codeg::FunctionList _functions;
+    codeg::Function* _recordedFunction = nullptr; //Function that keep its lines for inlining
+    unsigned int _recordedFunctionLevel = 0; //Reader level of the recorded lines
+    uint32_t _inlinedCalls = 0;
+
+    codeg::ScopeList _scopes;
+    std::list<codeg::Repeat> _repeats;
+    std::list<codeg::Switch> _switches;
+    std::list<codeg::Delay> _delays; //Ticks and pulses compiled as a countdown loop
+    std::list<codeg::LoopBound> _loopBounds; //Iterations of the loops (repeat, delays and "wcet bound")
+    std::list<codeg::CycleBudget> _cycleBudgets;
+    std::vector<codeg::CodeOrigin> _codeOrigins; //Source of the emitted bytes (index 0 is the compiler itself)
+
+    codeg::FileReader _reader;
+    std::string _relativePath;
+
+    codeg::CodeData _code;
+    bool _relocatableCode = true; //False when the code use absolute code addresses or unknown instructions ("brut")
+
+    codeg::OptimizationLevels _optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_0;
+    codeg::OptimizationPolicies _policy = codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SPEED;
+    bool _ramOverlay = false; //Variables can share the same address
+    bool _outlining = false; //Repeated sequences are moved in subroutines (-Oz)
+    codeg::Alu _alu;
+    codeg::AluState _aluState;
+
+    codeg::DataflowState _dataflow;
+    uint32_t _forwardedReads = 0;
+    uint32_t _foldedConditions = 0;
+
+    uint64_t _keywordClassifications = 0; //Calls of Keyword::process
+    uint64_t _macroReplacements = 0;
+};
+
+}//end codeg
+
+#endif // C_COMPILERDATA_H_INCLUDED
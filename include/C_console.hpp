@@ -1,37 +1,37 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#ifndef C_CONSOLE_H_INCLUDED
-#define C_CONSOLE_H_INCLUDED
-
-#include <string>
-
-namespace codeg
-{
-
-int ConsoleInit();
-
-void ConsoleWrite(const std::string& str);
-
-void ConsoleFatalWrite(const std::string& str);
-void ConsoleErrorWrite(const std::string& str);
-void ConsoleWarningWrite(const std::string& str);
-void ConsoleInfoWrite(const std::string& str);
-void ConsoleSyntaxWrite(const std::string& str);
-
-}//end codeg
-
-#endif // C_CONSOLE_H_INCLUDED
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_CONSOLE_H_INCLUDED
+#define C_CONSOLE_H_INCLUDED
+
+#include <string>
+
+namespace codeg
+{
+
+int ConsoleInit();
+
+void ConsoleWrite(const std::string& str);
+
+void ConsoleFatalWrite(const std::string& str);
+void ConsoleErrorWrite(const std::string& str);
+void ConsoleWarningWrite(const std::string& str);
+void ConsoleInfoWrite(const std::string& str);
+void ConsoleSyntaxWrite(const std::string& str);
+
+}//end codeg
+
+#endif // C_CONSOLE_H_INCLUDED
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef C_DATAFLOW_H_INCLUDED
+#define C_DATAFLOW_H_INCLUDED
+
+#include <map>
+#include <cstdint>
+#include "C_readableBus.hpp"
+
+namespace codeg
+{
+
+struct Variable;
+
+struct KnownValue
+{
+    codeg::ReadableBusses _bus;
+    uint8_t _value;
+};
+
+class DataflowState
+{
+    /**
+    Forward dataflow state of the RAM variables at the actual compiling point.
+
+    A variable can hold a known constant (READABLE_SOURCE) or the same value as a
+    readable bus (READABLE_RESULT), in that case the variable don't have to be read
+    from the RAM.
+    An unreachable state (after an unconditional jump) is ignored when merging 2 paths.
+    **/
+public:
+    using DataflowStateType = std::map<const codeg::Variable*, codeg::KnownValue>;
+
+    DataflowState() = default;
+    ~DataflowState() = default;
+
+    void clear();
+
+    void setUnreachable();
+    bool isReachable() const;
+
+    void set(const codeg::Variable* var, codeg::ReadableBusses bus, uint8_t value=0);
+    void remove(const codeg::Variable* var);
+    void removeBus(codeg::ReadableBusses bus);
+    const codeg::KnownValue* get(const codeg::Variable* var) const;
+
+    void merge(const codeg::DataflowState& state);
+
+private:
+    codeg::DataflowState::DataflowStateType g_values;
+    bool g_reachable = true;
+};
+
+}//end codeg
+
+#endif // C_DATAFLOW_H_INCLUDED
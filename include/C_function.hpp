@@ -1,79 +1,123 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#ifndef C_FUNCTION_H_INCLUDED
-#define C_FUNCTION_H_INCLUDED
-
-#include <string>
-#include <list>
-#include <forward_list>
-
-namespace codeg
-{
-
-class Function
-{
-public:
-    using FunctionLinesType = std::list<std::string>;
-
-    Function() = default;
-    Function(const std::string& name, bool definition=false);
-    ~Function() = default;
-
-    void setName(const std::string& name);
-    const std::string& getName() const;
-
-    void setDefinitionType(bool definition);
-    bool isDefinition() const;
-
-    void clearLines();
-    void addLine(const std::string& str);
-
-    bool operator== (const std::string& l) const;
-
-    codeg::Function::FunctionLinesType::const_iterator getIteratorBegin() const;
-    codeg::Function::FunctionLinesType::const_iterator getIteratorEnd() const;
-
-private:
-    std::string g_name;
-
-    bool g_isDefinition=false;
-    codeg::Function::FunctionLinesType g_definitionLines;
-};
-
-class FunctionList
-{
-public:
-    using FunctionListType = std::forward_list<codeg::Function>;
-
-    FunctionList() = default;
-    ~FunctionList() = default;
-
-    void clear();
-
-    codeg::Function* push(const codeg::Function& newFunction);
-    codeg::Function* push(const std::string& name, bool definition=false);
-
-    codeg::Function* getLast();
-    codeg::Function* get(const std::string& name);
-
-private:
-    codeg::FunctionList::FunctionListType g_data;
-};
-
-}//end codeg
-
-#endif // C_FUNCTION_H_INCLUDED
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_FUNCTION_H_INCLUDED
+#define C_FUNCTION_H_INCLUDED
+
+#include <string>
+#include <list>
+#include <forward_list>
+#include <cstdint>
+
+namespace codeg
+{
+
+enum InlineHints : uint8_t
+{
+    INLINE_HINT_NONE = 0,
+
+    INLINE_HINT_ALWAYS,
+    INLINE_HINT_NEVER
+};
+
+enum InlineCosts : uint32_t
+{
+    INLINE_COST_CALL_SIZE = 25, //Bytes of a "call" with a return address
+    INLINE_COST_RETURN_SIZE = 16, //Bytes of the return "jump" with 3 variables
+    INLINE_COST_CALL_CYCLES = 23, //Instructions executed by the call and the return
+    INLINE_COST_BYTES_PER_CYCLE = 2 //Bytes that can be added for every saved instruction (speed policy)
+};
+
+class Function
+{
+    /**
+    A function is compiled once, a definition is compiled every time it is called.
+
+    The lines of a function are also kept to be inlined, the last line of the function
+    must be the return "jump" with the 3 variables given to the "call".
+    **/
+public:
+    using FunctionLinesType = std::list<std::string>;
+
+    Function() = default;
+    Function(const std::string& name, bool definition=false);
+    ~Function() = default;
+
+    void setName(const std::string& name);
+    const std::string& getName() const;
+
+    void setDefinitionType(bool definition);
+    bool isDefinition() const;
+
+    void clearLines();
+    void addLine(const std::string& str);
+
+    void setInlineHint(codeg::InlineHints hint);
+    codeg::InlineHints getInlineHint() const;
+
+    void setCodeSize(uint32_t size);
+    uint32_t getCodeSize() const;
+
+    void setComplete(bool complete);
+    bool isComplete() const;
+
+    void setInlining(bool inlining);
+    bool isInlining() const;
+
+    bool getInlineLines(const std::string returnVariables[3], const std::string& labelSuffix,
+                        codeg::Function::FunctionLinesType& lines) const;
+
+    bool operator== (const std::string& l) const;
+
+    codeg::Function::FunctionLinesType::const_iterator getIteratorBegin() const;
+    codeg::Function::FunctionLinesType::const_iterator getIteratorEnd() const;
+
+private:
+    std::string g_name;
+
+    bool g_isDefinition=false;
+    codeg::Function::FunctionLinesType g_definitionLines;
+
+    codeg::InlineHints g_inlineHint = codeg::InlineHints::INLINE_HINT_NONE;
+    uint32_t g_codeSize = 0;
+    bool g_isComplete = false;
+    bool g_isInlining = false;
+};
+
+class FunctionList
+{
+public:
+    using FunctionListType = std::forward_list<codeg::Function>;
+
+    FunctionList() = default;
+    ~FunctionList() = default;
+
+    void clear();
+
+    codeg::Function* push(const codeg::Function& newFunction);
+    codeg::Function* push(const std::string& name, bool definition=false);
+
+    codeg::Function* getLast();
+    codeg::Function* get(const std::string& name);
+    codeg::FunctionList::FunctionListType& getFunctions();
+
+private:
+    codeg::FunctionList::FunctionListType g_data;
+};
+
+}//end codeg
+
+#endif // C_FUNCTION_H_INCLUDED
@@ -0,0 +1,123 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_INSTRUMENT_H_INCLUDED
+#define C_INSTRUMENT_H_INCLUDED
+
+#include "C_variable.hpp"
+#include "C_compilerData.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+#define CODEG_INSTRUMENT_POOL "%%instrument"
+
+namespace codeg
+{
+
+enum InstrumentModes : uint8_t
+{
+    INSTRUMENT_MODE_NONE = 0,
+
+    INSTRUMENT_MODE_FUNCTIONS, //Function entries (also the inlined functions and the expanded definitions)
+    INSTRUMENT_MODE_BLOCKS //Function entries, user labels and the heads of the conditional/switch blocks
+};
+
+enum InstrumentKinds : uint8_t
+{
+    INSTRUMENT_KIND_FUNCTION = 0,
+    INSTRUMENT_KIND_LABEL,
+    INSTRUMENT_KIND_BLOCK,
+
+    INSTRUMENT_KIND_COUNT
+};
+
+extern const char* ReadableStringInstrumentKinds[];
+
+struct InstrumentCounter
+{
+    codeg::InstrumentKinds _kind;
+    std::string _name; //Function, label or keyword that start the block
+    std::string _function; //Function or definition that contain the counter (empty for the main code)
+    std::string _file;
+    unsigned int _line;
+};
+
+class Instrumentation
+{
+    /**
+    Profiling instrumentation : a counter increment is compiled at the function entries (and, with the
+    blocks mode, at the user labels and the heads of the conditional and switch blocks).
+
+    The counters are 8 or 16 bits (little endian), wrapping or saturating, they are placed in the dynamic
+    pool "%%instrument" that is observable (the optimizer never remove an increment). The increment
+    only use the ALU and the RAM, the value of "_result" is preserved but not always the ALU latches :
+    the latches known by the compiler are restored, else they hold "_result | 0" after the increment.
+
+    The side table (JSON) give the RAM address of every counter and its source, so a RAM dump of the
+    target can be turned into a hot spot report.
+    **/
+public:
+    Instrumentation() = default;
+    ~Instrumentation() = default;
+
+    void clear();
+
+    bool setMode(const std::string& mode);
+    codeg::InstrumentModes getMode() const;
+    bool isEnabled() const;
+
+    bool setCounterBits(unsigned int bits);
+    unsigned int getCounterSize() const;
+    void setSaturating(bool saturating);
+    bool isSaturating() const;
+
+    ///Create the pool of the counters (need the ALU revision to find the operations)
+    void setup(codeg::CompilerData& data);
+
+    ///Called before and after the compilation of an instruction line
+    void prepare(const codeg::StringDecomposer& input, const codeg::CompilerData& data);
+    void instrument(const codeg::StringDecomposer& input, codeg::CompilerData& data);
+
+    ///Write the side table (need the resolved pools)
+    void writeJson(codeg::CompilerData& data, std::ostream& stream) const;
+
+    const std::vector<codeg::InstrumentCounter>& getCounters() const;
+
+private:
+    void addCounter(codeg::CompilerData& data, codeg::InstrumentKinds kind, const std::string& name, const std::string& function);
+    void pushIncrement(codeg::CompilerData& data, codeg::Variable* low, codeg::Variable* high) const;
+
+    codeg::InstrumentModes g_mode = codeg::InstrumentModes::INSTRUMENT_MODE_NONE;
+    unsigned int g_counterSize = 1;
+    bool g_saturating = false;
+
+    uint8_t g_operationAdd = 0;
+    uint8_t g_operationLess = 0;
+    uint8_t g_operationAnd = 0;
+    uint8_t g_operationOr = 0;
+
+    unsigned int g_readerLevel = 0; //Reader level before the instruction, a "call" that open a reader is inlined
+    std::size_t g_scopeCount = 0;
+    codeg::ScopeStats g_scopeStat = codeg::ScopeStats::SCOPE_FUNCTION; //Scope that can be closed by the instruction
+
+    std::vector<codeg::InstrumentCounter> g_counters;
+};
+
+}//end codeg
+
+#endif // C_INSTRUMENT_H_INCLUDED
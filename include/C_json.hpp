@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_JSON_H_INCLUDED
+#define C_JSON_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+namespace codeg
+{
+
+std::string JsonEscape(const std::string& str);
+
+class JsonValue
+{
+    /**
+    Small JSON reader for the files written by the compiler and its tools (reports, baselines).
+
+    parse() throw a codeg::SyntaxError on a bad document, the accessors never throw : a missing
+    member or a bad index return a null value.
+    **/
+public:
+    enum Types : uint8_t
+    {
+        TYPE_NULL = 0,
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT
+    };
+
+    JsonValue() = default;
+    ~JsonValue() = default;
+
+    static codeg::JsonValue parse(const std::string& str);
+    static bool parseFile(const std::string& path, codeg::JsonValue& value);
+
+    codeg::JsonValue::Types getType() const;
+    bool isNull() const;
+
+    bool getBool() const;
+    double getNumber() const;
+    const std::string& getString() const;
+
+    std::size_t size() const;
+    const codeg::JsonValue& operator[](std::size_t index) const;
+    const codeg::JsonValue& operator[](const std::string& key) const;
+    bool has(const std::string& key) const;
+    const std::map<std::string, codeg::JsonValue>& getMembers() const;
+
+private:
+    codeg::JsonValue::Types g_type = codeg::JsonValue::Types::TYPE_NULL;
+    bool g_bool = false;
+    double g_number = 0.0;
+    std::string g_string;
+    std::vector<codeg::JsonValue> g_array;
+    std::map<std::string, codeg::JsonValue> g_object;
+
+    friend class JsonParser;
+};
+
+}//end codeg
+
+#endif // C_JSON_H_INCLUDED
@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_MEMORYMAP_H_INCLUDED
+#define C_MEMORYMAP_H_INCLUDED
+
+#include "C_variable.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+
+#define CODEG_RAM_SIZE 65536
+
+namespace codeg
+{
+
+struct MemoryMapVariable
+{
+    std::string _name;
+    codeg::MemoryAddress _address;
+    uint32_t _accesses; //Instructions that set the RAM address of the variable
+};
+
+struct MemoryMapPool
+{
+    std::string _name;
+    bool _static;
+    bool _placed; //A pool without variable and with a dynamic size is ignored
+    codeg::MemoryAddress _start;
+    codeg::MemoryBigSize _reserved; //Size of the pool in the RAM
+    codeg::MemoryBigSize _used; //Size used by the variables
+    uint32_t _poolAccesses; //Accesses with an offset (not linked to a variable)
+    std::vector<codeg::MemoryMapVariable> _variables;
+};
+
+struct MemoryMapGap
+{
+    codeg::MemoryBigSize _start;
+    codeg::MemoryBigSize _size;
+};
+
+class MemoryMap
+{
+    /**
+    Placement of the pools in the RAM after PoolList::resolve : the pools with their variables, the
+    free gaps between the pools and how fragmented the free RAM is.
+
+    The fragmentation index is 1 - (largest free block / free bytes), 0 when all the free RAM is in
+    one block.
+    **/
+public:
+    MemoryMap() = default;
+    ~MemoryMap() = default;
+
+    void clear();
+
+    void build(codeg::PoolList& pools);
+
+    void writeJson(std::ostream& stream) const;
+    void writeText(std::ostream& stream) const;
+
+    const std::vector<codeg::MemoryMapPool>& getPools() const;
+    const std::vector<codeg::MemoryMapGap>& getGaps() const;
+
+    codeg::MemoryBigSize getReservedSize() const;
+    codeg::MemoryBigSize getUsedSize() const;
+    codeg::MemoryBigSize getFreeSize() const;
+    codeg::MemoryBigSize getLargestFreeBlock() const;
+    double getFragmentation() const;
+
+private:
+    std::vector<codeg::MemoryMapPool> g_pools;
+    std::vector<codeg::MemoryMapGap> g_gaps;
+
+    codeg::MemoryBigSize g_reservedSize = 0;
+    codeg::MemoryBigSize g_usedSize = 0;
+    codeg::MemoryBigSize g_freeSize = CODEG_RAM_SIZE;
+    codeg::MemoryBigSize g_largestFreeBlock = CODEG_RAM_SIZE;
+};
+
+}//end codeg
+
+#endif // C_MEMORYMAP_H_INCLUDED
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef C_OPTIMIZER_H_INCLUDED
+#define C_OPTIMIZER_H_INCLUDED
+
+#include "C_address.hpp"
+#include "C_variable.hpp"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+namespace codeg
+{
+
+struct CompilerData;
+class Peephole;
+
+struct MicroOp
+{
+    uint8_t getOpcode() const;
+    uint8_t getBus() const;
+    bool hasArgument() const;
+
+    uint8_t _code; //Opcode and readable bus
+    uint8_t _argument;
+    uint8_t _size; //Size in bytes, with the dummy byte
+
+    codeg::Address _address; //Address before the optimization
+    bool _removed;
+    bool _moved; //Encoded before another instruction (hoisted)
+};
+
+enum LatchTypes : uint8_t
+{
+    LATCH_UNKNOWN = 0,
+    LATCH_LABEL,
+    LATCH_CONSTANT,
+    LATCH_COMPUTED
+};
+
+struct JumpLatch
+{
+    codeg::LatchTypes _type;
+    std::string _label;
+    uint8_t _value;
+};
+
+struct RamTarget
+{
+    bool _known; //False if any address can be accessed
+    std::size_t _location;
+    std::size_t _pool;
+    bool _poolLink; //Address set with a pool and an offset (a "get" on a pool can be used to read the whole pool)
+};
+
+class Optimizer
+{
+    /**
+    Work on the compiled code before the jumps and the pools are resolved.
+
+    The code is decoded into instructions (MicroOp) with the relocations (labels, jump points,
+    variables and pools links), the passes can remove instructions and the code is encoded back
+    with updated relocations.
+    The jump tables are kept as they are, only the padding that align them is computed again.
+    Repeated sequences can be outlined in subroutines that are placed after an unconditional jump,
+    the return address is written in a hidden pool ("%%outline"). A call modify the jump source and
+    the RAM address, the next passes don't keep them across a call.
+    The functions can be moved after the main code, the instructions are then encoded in another order
+    but the fall through between them is kept.
+    A jump source setup is only partially written when the register already have the MSB or the MID
+    of the address (same 256 bytes page).
+    The code can't be decoded if it use absolute code addresses or unknown instructions ("brut").
+    **/
+public:
+    using LocationSet = std::vector<bool>;
+
+    struct Loop
+    {
+        std::size_t _header;
+        codeg::Optimizer::LocationSet _blocks;
+        std::vector<std::size_t> _backEdges; //Blocks that jump back to the header
+    };
+    struct JumpTable
+    {
+        std::string _label;
+        std::size_t _begin;
+        std::size_t _entryCount;
+    };
+    struct FunctionRange
+    {
+        std::string _name;
+        std::size_t _begin; //Function label
+        std::size_t _end; //End label (target of the jump over the function)
+    };
+    struct Outline
+    {
+        std::string _label;
+        std::vector<std::size_t> _body; //Instructions of the first sequence, copied in the subroutine
+        std::vector<std::size_t> _sites; //First instruction of every sequence, replaced by a call
+    };
+    struct PoolInfo
+    {
+        bool _static;
+        codeg::MemoryAddress _startAddress;
+        codeg::MemorySize _maxSize;
+    };
+
+    struct Block
+    {
+        std::size_t _begin;
+        std::size_t _end;
+
+        std::vector<std::size_t> _successors;
+        bool _exit; //The block can leave the known code (unknown jump, end of the code)
+        bool _unknownJump; //The block can jump to any label
+    };
+
+    Optimizer() = default;
+    ~Optimizer() = default;
+
+    bool decode(codeg::CompilerData& data);
+    void encode(codeg::CompilerData& data);
+
+    void setProfile(const std::map<std::string, uint64_t>& profile);
+
+    void buildControlFlow();
+    void computeLoops();
+
+    uint32_t threadJumps();
+    uint32_t removeUselessJumps();
+    uint32_t removeUnreachableCode();
+    uint32_t removeDeadStores();
+    uint32_t applyPeephole(codeg::Peephole& peephole);
+    uint32_t computeOverlays();
+    uint32_t placeVariables();
+    uint32_t placeFunctions();
+    uint32_t removeAddressReloads();
+    uint32_t hoistLoopInvariants();
+    uint32_t outlineSequences();
+    uint32_t removeJumpReloads();
+
+    uint32_t getSize() const;
+
+    const std::vector<codeg::MicroOp>& getOps() const;
+    const std::vector<codeg::Optimizer::Block>& getBlocks() const;
+
+private:
+    std::size_t getOpIndex(codeg::Address address) const;
+    std::size_t getNextOp(std::size_t index) const;
+    std::size_t getPreviousOp(std::size_t index) const;
+
+    bool isLabelJump(std::size_t index, std::string& label) const;
+    std::string getFinalLabel(const std::string& label) const;
+    void updateReturnPoints();
+
+    void getOrder(std::vector<std::size_t>& order) const;
+    void computeLayout(std::vector<codeg::Address>& newAddress, std::map<std::size_t, codeg::Address>& bodyAddress) const;
+
+    bool isTableStart(std::size_t index) const;
+    bool isAddressPair(std::size_t index) const;
+    bool isRemovable(std::size_t index) const;
+    bool isRelocated(std::size_t index) const;
+
+    void computeRamTargets();
+    void applyLiveness(std::size_t index, codeg::Optimizer::LocationSet& live) const;
+    void computeLiveness(std::vector<codeg::Optimizer::LocationSet>& liveOut) const;
+    void computeBlockWeights(std::vector<uint64_t>& weights) const;
+    uint8_t applyRegisterLiveness(std::size_t index, uint8_t live) const;
+    void computeRegisterLiveness(std::vector<uint8_t>& liveIn) const;
+
+    std::vector<codeg::MicroOp> g_ops;
+    std::vector<uint32_t> g_opOrigins; //Source of the instructions (--size-report)
+    std::vector<codeg::Optimizer::Block> g_blocks;
+    std::vector<std::size_t> g_opBlock;
+    std::vector<bool> g_labelOps;
+
+    std::map<std::string, std::size_t> g_labels;
+    std::map<std::size_t, std::string> g_jumpSources;
+    std::map<std::size_t, std::string> g_returnSources; //Return address written by a call
+    std::vector<std::size_t> g_returnPoints;
+    std::map<std::size_t, std::string> g_tableSources; //Address of a jump table written by a computed jump
+    std::vector<codeg::Optimizer::JumpTable> g_tables;
+    std::vector<bool> g_tableOps; //Instructions of a jump table, they can't be removed or moved
+    std::vector<bool> g_jumpReloads; //Removed jump source setups, the register already have the same value
+
+    std::map<codeg::Address, codeg::RamTarget> g_ramLinks;
+    std::vector<std::vector<std::size_t> > g_poolLocations;
+    std::vector<std::size_t> g_poolVariableCount;
+    std::vector<bool> g_poolLinked;
+    std::vector<std::vector<codeg::MemoryAddress> > g_overlays; //Offset of every variable when the pool is overlaid or reordered
+    std::vector<codeg::Optimizer::PoolInfo> g_poolInfos;
+    std::vector<bool> g_pageLocks;
+    std::vector<std::size_t> g_observableLocations; //Variables of an observable pool, always live
+    std::map<std::size_t, std::size_t> g_lsbLinks; //Removed BRAMADD2 with the BRAMADD1 that keep the link
+    std::map<std::size_t, std::vector<std::size_t> > g_hoisted; //Instructions moved before a loop header
+    std::vector<codeg::Optimizer::FunctionRange> g_functions;
+    std::vector<std::size_t> g_order; //Order of the instructions in the encoded code, empty if unchanged
+    std::vector<codeg::Optimizer::Outline> g_outlines;
+    std::map<std::size_t, std::size_t> g_outlineSites; //First instruction of an outlined sequence with its subroutine
+    std::size_t g_outlineIndex = 0; //The subroutines are placed before this instruction
+
+    std::vector<codeg::Optimizer::Loop> g_loops;
+    std::vector<std::size_t> g_loopDepth;
+    std::vector<codeg::Optimizer::LocationSet> g_dominators;
+    std::map<std::string, uint64_t> g_profile; //Execution count of labels
+    std::size_t g_locationCount = 0;
+    std::vector<codeg::RamTarget> g_ramTargets;
+
+    codeg::Address g_endAddress = 0;
+    bool g_writeDummy = false;
+};
+
+}//end codeg
+
+#endif // C_OPTIMIZER_H_INCLUDED
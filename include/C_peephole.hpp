@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_PEEPHOLE_H_INCLUDED
+#define C_PEEPHOLE_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+namespace codeg
+{
+
+enum PeepholeOperandTypes : uint8_t
+{
+    PEEPHOLE_OPERAND_ANY = 0,
+
+    PEEPHOLE_OPERAND_BUS, //A readable bus (with any constant for the SOURCE bus)
+    PEEPHOLE_OPERAND_CONSTANT, //A constant read on the SOURCE bus
+    PEEPHOLE_OPERAND_NAMED //Same value everywhere in the rule
+};
+
+struct PeepholeOperand
+{
+    codeg::PeepholeOperandTypes _type;
+    uint8_t _value; //Bus or constant
+    std::string _name;
+};
+
+struct PeepholeInstruction
+{
+    bool _anyOpcode;
+    uint8_t _opcode;
+    codeg::PeepholeOperand _operand;
+};
+
+struct PeepholeGuard
+{
+    std::string _name;
+    bool _equal;
+    codeg::PeepholeOperand _operand;
+};
+
+struct PeepholeRule
+{
+    std::string _name;
+    std::vector<codeg::PeepholeInstruction> _pattern;
+    std::vector<codeg::PeepholeInstruction> _replacement;
+    std::vector<codeg::PeepholeGuard> _guards;
+
+    uint32_t _hits;
+};
+
+struct PeepholeValue
+{
+    uint8_t _bus;
+    uint8_t _argument; //Only used by the SOURCE bus
+};
+
+class Peephole
+{
+    /**
+    Rules that replace a short sequence of instructions by a shorter one.
+
+    A rule is written on one line :
+        name : pattern => replacement [if guard, guard ...]
+    The pattern and the replacement are instructions separated by ";" (the replacement "-" is empty),
+    an instruction is an opcode (as in the readable output, "*" is any instruction in the pattern) with
+    an operand : a readable bus, a constant (read on the SOURCE bus), any operand "*" or a named operand "$name".
+    A guard compare a named operand with another operand ("==" or "!=").
+    The replacement must have less instructions than the pattern.
+
+    The rules are compiled in a single automaton on the opcodes (Aho-Corasick), every instruction is
+    read once and the rules that end on it are checked in the order they were added.
+    **/
+public:
+    Peephole() = default;
+    ~Peephole() = default;
+
+    void clear();
+
+    void addDefaultRules();
+    void addRule(const std::string& line);
+    bool loadFromFile(const std::string& path);
+
+    void compile();
+
+    std::size_t getNextState(std::size_t state, uint8_t opcode) const;
+    const std::vector<std::size_t>& getMatches(std::size_t state) const;
+
+    bool match(std::size_t rule, const std::vector<codeg::PeepholeValue>& window, const std::vector<uint8_t>& opcodes,
+               std::map<std::string, codeg::PeepholeValue>& values) const;
+    void getReplacement(std::size_t rule, const std::map<std::string, codeg::PeepholeValue>& values,
+                        std::vector<codeg::PeepholeInstruction>& replacement) const;
+
+    void addHit(std::size_t rule);
+
+    const std::vector<codeg::PeepholeRule>& getRules() const;
+
+private:
+    struct Node
+    {
+        std::size_t _next[32];
+        std::size_t _fail;
+        std::vector<std::size_t> _matches; //Rules that end on this node
+    };
+
+    std::vector<codeg::PeepholeRule> g_rules;
+    std::vector<codeg::Peephole::Node> g_nodes;
+};
+
+}//end codeg
+
+#endif // C_PEEPHOLE_H_INCLUDED
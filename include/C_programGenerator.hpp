@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_PROGRAMGENERATOR_H_INCLUDED
+#define C_PROGRAMGENERATOR_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <random>
+#include <ostream>
+#include <cstdint>
+
+namespace codeg
+{
+
+struct ProgramGeneratorSettings
+{
+    uint32_t _seed = 1;
+    uint32_t _scale = 1; //Multiply every count except the if nesting and the variables by pool
+
+    uint32_t _statements = 6; //Statements of the main code (the nested ones included)
+    uint32_t _labels = 1;
+    uint32_t _ifDepth = 2; //Maximum nesting of the "if"
+    uint32_t _pools = 1;
+    uint32_t _variablesPerPool = 4;
+    uint32_t _imports = 1; //Imported files, they contain the definitions
+    uint32_t _definitions = 1;
+    uint32_t _calls = 1; //Calls of the definitions
+};
+
+class ProgramGenerator
+{
+    /**
+    Generate valid codeG programs of any size for the scaling benchmarks : pools and their
+    variables, labels, nested "if", backward jumps, definitions in imported files and their calls.
+
+    The same settings (and seed) always generate the same program, the random numbers are taken
+    directly from a std::mt19937 because the standard distributions are not the same everywhere.
+    **/
+public:
+    ProgramGenerator() = default;
+    ~ProgramGenerator() = default;
+
+    void setSettings(const codeg::ProgramGeneratorSettings& settings);
+    const codeg::ProgramGeneratorSettings& getSettings() const;
+
+    ///Write the main file and the imported files ("<main file name>.lib<index>" in the same directory)
+    bool generate(const std::string& mainPath);
+
+    uint32_t getLineCount() const; //Every generated files
+    const std::vector<std::string>& getFiles() const;
+
+private:
+    uint32_t random(uint32_t count); //In [0, count[
+    uint32_t scaled(uint32_t count) const;
+
+    std::string getVariable();
+    void writeLine(std::ostream& stream, unsigned int depth, const std::string& line);
+    void writeStatement(std::ostream& stream, unsigned int depth, uint32_t& remaining, uint32_t labelCount);
+
+    codeg::ProgramGeneratorSettings g_settings;
+    std::mt19937 g_random;
+
+    uint32_t g_pools = 0;
+    uint32_t g_variablesPerPool = 0;
+
+    uint32_t g_lineCount = 0;
+    std::vector<std::string> g_files;
+};
+
+}//end codeg
+
+#endif // C_PROGRAMGENERATOR_H_INCLUDED
@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_SIMULATOR_H_INCLUDED
+#define C_SIMULATOR_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "C_alu.hpp"
+#include "C_readableBus.hpp"
+
+namespace codeg
+{
+
+enum SimulatorStops : uint8_t
+{
+    SIMULATOR_STOP_END = 0, //The end of the code is reached
+    SIMULATOR_STOP_LIMIT, //The maximum number of instructions is reached
+    SIMULATOR_STOP_BAD_JUMP, //Jump outside of the code or in the middle of an instruction
+    SIMULATOR_STOP_UNKNOWN_OPCODE
+};
+
+extern const char* ReadableStringSimulatorStops[];
+
+struct SimulatorOp
+{
+    const void* _handler; //Label of the handler (threaded dispatch)
+    uint32_t _address; //Code address of the instruction
+    uint16_t _kind; //Handler index
+    uint8_t _value; //Argument of the SOURCE bus or index of the external bus
+    uint8_t _cycles;
+};
+
+struct SimulatorCounters
+{
+    uint64_t _instructions = 0; //Executed instructions
+    uint64_t _skipped = 0; //Instructions skipped by IF/IFNOT
+    uint64_t _cycles = 0;
+    uint64_t _jumps = 0;
+
+    uint64_t _writes1 = 0;
+    uint64_t _writes2 = 0;
+    uint64_t _ramWrites = 0;
+    uint64_t _peripheralClocks = 0;
+    uint64_t _spiClocks = 0;
+    uint64_t _ticks = 0;
+    uint64_t _longTicks = 0;
+};
+
+struct SimulatorRegisters
+{
+    uint8_t _left = 0;
+    uint8_t _operation = 0;
+    uint8_t _right = 0;
+
+    uint16_t _ramAddress = 0;
+    uint8_t _jump[3] = {0, 0, 0}; //LSB, MID, MSB
+
+    uint8_t _bus1 = 0; //Last value written on BWRITE1
+    uint8_t _bus2 = 0; //Last value written on BWRITE2
+    uint8_t _peripheral = 0; //Chip select
+    uint8_t _spi = 0; //Last value sent
+    uint8_t _spiConfig = 0;
+
+    uint32_t _address = 0; //Code address of the next instruction
+};
+
+class Simulator
+{
+    /**
+    Execute a codeG binary for the GP8B processor.
+
+    The binary is decoded once in an array of instructions, every instruction already know its
+    handler and where its operand come from (constant, external bus, RAM or ALU result) so the
+    execution don't have to decode anything. With GCC and Clang the handlers are chained with
+    computed gotos (direct threading), a switch is used otherwise.
+
+    IF/IFNOT skip the next instruction when the value is not 0 / is 0, a skipped instruction
+    take its cycles. The external buses (BREAD1, BREAD2, SPI, EXT1, EXT2) read constant inputs.
+    **/
+public:
+    Simulator();
+    ~Simulator() = default;
+
+    void clear();
+
+    bool load(const std::vector<uint8_t>& code, bool writeDummy=false);
+    bool loadFromFile(const std::string& path, bool writeDummy=false);
+    std::size_t getInstructionCount() const;
+
+    void setAlu(const codeg::Alu& alu);
+    void setInput(codeg::ReadableBusses bus, uint8_t value);
+
+    void reset();
+    codeg::SimulatorStops run(uint64_t maxInstructions);
+
+    const codeg::SimulatorCounters& getCounters() const;
+    const codeg::SimulatorRegisters& getRegisters() const;
+    uint8_t getRam(uint16_t address) const;
+
+private:
+    codeg::SimulatorStops execute(uint64_t maxInstructions);
+
+    std::vector<codeg::SimulatorOp> g_ops; //Ends with 2 stop instructions
+    std::vector<uint32_t> g_opIndex; //Instruction of every code address
+    bool g_threaded = false;
+
+    codeg::AluFunction g_alu[256];
+    uint8_t g_inputs[8];
+
+    codeg::SimulatorCounters g_counters;
+    codeg::SimulatorRegisters g_registers;
+    std::vector<uint8_t> g_ram;
+    std::size_t g_actualOp = 0;
+};
+
+}//end codeg
+
+#endif // C_SIMULATOR_H_INCLUDED
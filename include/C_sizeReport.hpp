@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_SIZEREPORT_H_INCLUDED
+#define C_SIZEREPORT_H_INCLUDED
+
+#include <string>
+#include <map>
+#include <ostream>
+#include <cstdint>
+
+namespace codeg
+{
+
+struct CompilerData;
+
+enum SizeClasses : uint8_t
+{
+    SIZE_CLASS_ADDRESS = 0, //BRAMADD1, BRAMADD2
+    SIZE_CLASS_JUMP, //BJMPSRC1/2/3, JMPSRC
+    SIZE_CLASS_ALU, //OPLEFT, OPRIGHT, OPCHOOSE, UOP
+    SIZE_CLASS_BUS, //BWRITE1/2, BPCS, PERIPHERAL, SPI, BCFG_SPI, RAMW
+    SIZE_CLASS_CONDITION, //IF, IFNOT
+    SIZE_CLASS_TICK, //STICK, LTICK
+    SIZE_CLASS_BRUT, //Bytes written by "brut"
+
+    SIZE_CLASS_COUNT
+};
+
+extern const char* ReadableStringSizeClasses[];
+
+codeg::SizeClasses GetSizeClass(uint8_t opcode);
+
+///Set the origin of the next emitted bytes (need the origin tracking of the code)
+void UpdateCodeOrigin(codeg::CompilerData& data, const std::string& keyword);
+
+struct SizeEntry
+{
+    uint32_t _bytes = 0;
+    uint32_t _classes[codeg::SizeClasses::SIZE_CLASS_COUNT] = {0};
+    bool _definition = false; //Only for the functions
+};
+
+class SizeReport
+{
+    /**
+    Attribute every byte of the final code to its source : the function or definition, the source
+    line (the line of the file, the expanded definitions and inlined functions are counted on the
+    line that use them) and the instruction keyword, with a break down by opcode class.
+
+    The source of the bytes is recorded by the CodeData while the code is emitted (and kept by the
+    optimizer), building the report is only a pass over the final code.
+    **/
+public:
+    SizeReport() = default;
+    ~SizeReport() = default;
+
+    void clear();
+
+    void build(codeg::CompilerData& data);
+
+    bool loadJson(const std::string& path);
+    void writeJson(std::ostream& stream) const;
+    void writeText(std::ostream& stream) const;
+
+    ///Print the entries that changed since a previous report and return the total size difference
+    int64_t writeDiff(const codeg::SizeReport& previous, std::ostream& stream) const;
+
+    uint32_t getTotal() const;
+    uint32_t getCapacity() const;
+    const codeg::SizeEntry& getClasses() const;
+    const std::map<std::string, codeg::SizeEntry>& getFunctions() const;
+    const std::map<std::string, codeg::SizeEntry>& getKeywords() const;
+    const std::map<std::pair<std::string, unsigned int>, codeg::SizeEntry>& getLines() const;
+
+private:
+    void getEntries(std::map<std::string, int64_t>& entries) const;
+
+    uint32_t g_total = 0;
+    uint32_t g_capacity = 0;
+
+    codeg::SizeEntry g_classes;
+    std::map<std::string, codeg::SizeEntry> g_functions; //Empty name for the main code
+    std::map<std::string, codeg::SizeEntry> g_keywords;
+    std::map<std::pair<std::string, unsigned int>, codeg::SizeEntry> g_lines; //File and line
+};
+
+}//end codeg
+
+#endif // C_SIZEREPORT_H_INCLUDED
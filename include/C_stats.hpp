@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_STATS_H_INCLUDED
+#define C_STATS_H_INCLUDED
+
+#include <string>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+namespace codeg
+{
+
+struct CompilerData;
+class Peephole;
+
+enum StatsPhases : uint8_t
+{
+    STATS_PHASE_READING = 0, //FileReader::getline
+    STATS_PHASE_DECOMPOSING, //StringDecomposer::decompose
+    STATS_PHASE_COMPILING, //Instruction::compile/compileDefinition
+    STATS_PHASE_OPTIMIZING,
+    STATS_PHASE_JUMPS, //JumpList::resolve
+    STATS_PHASE_POOLS, //PoolList::resolve
+    STATS_PHASE_REPORTS, //RAM map, WCET and size report
+    STATS_PHASE_WRITING, //Binary and readable files
+
+    STATS_PHASE_COUNT
+};
+
+extern const char* ReadableStringStatsPhases[];
+
+///Number of calls of the global operator new since the start of the program
+uint64_t GetAllocationCount();
+///Peak resident set size of the process in bytes (0 when unknown)
+uint64_t GetPeakMemoryUsage();
+
+struct StatsInstruction
+{
+    uint64_t _count = 0;
+    uint64_t _nanoseconds = 0;
+};
+
+class Statistics
+{
+    /**
+    Timings and counters of a compilation, for "--stats".
+
+    Nothing is measured until enable() is called : now() return an empty time point and the add
+    functions do nothing, so the timing calls can stay in the compile loop.
+    **/
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Statistics() = default;
+    ~Statistics() = default;
+
+    void enable();
+    bool isEnabled() const;
+
+    codeg::Statistics::Clock::time_point now() const;
+    void addTime(codeg::StatsPhases phase, const codeg::Statistics::Clock::time_point& since);
+    ///Also added to the compiling phase
+    void addInstructionTime(const std::string& keyword, const codeg::Statistics::Clock::time_point& since);
+    void addLine(std::size_t tokens);
+
+    ///Get the counters of the compiler data, the memory usage and the total time
+    void collect(codeg::CompilerData& data, const codeg::Peephole& peephole);
+
+    void writeJson(std::ostream& stream) const;
+    void writeText(std::ostream& stream) const;
+
+    uint64_t getPhaseTime(codeg::StatsPhases phase) const; //Nanoseconds
+    uint64_t getTotalTime() const;
+    const std::map<std::string, codeg::StatsInstruction>& getInstructions() const;
+
+private:
+    bool g_enabled = false;
+    codeg::Statistics::Clock::time_point g_startTime;
+
+    uint64_t g_phaseTimes[codeg::StatsPhases::STATS_PHASE_COUNT] = {0};
+    uint64_t g_totalTime = 0;
+    std::map<std::string, codeg::StatsInstruction> g_instructions;
+
+    uint64_t g_lines = 0;
+    uint64_t g_tokens = 0;
+    uint64_t g_macroReplacements = 0;
+    uint64_t g_keywordClassifications = 0;
+    uint64_t g_labels = 0;
+    uint64_t g_jumpPoints = 0;
+    uint64_t g_variableLinks = 0;
+    uint64_t g_codeSize = 0;
+
+    uint64_t g_peakMemory = 0;
+    uint64_t g_allocations = 0;
+
+    std::vector<std::pair<std::string, uint32_t>> g_peepholeHits;
+};
+
+}//end codeg
+
+#endif // C_STATS_H_INCLUDED
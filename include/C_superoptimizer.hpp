@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_SUPEROPTIMIZER_H_INCLUDED
+#define C_SUPEROPTIMIZER_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+namespace codeg
+{
+
+enum SuperoptimizerOperands : uint8_t
+{
+    SUPEROPTIMIZER_OPERAND_RESULT = 0,
+    SUPEROPTIMIZER_OPERAND_RAM,
+
+    SUPEROPTIMIZER_OPERAND_A, //Constant "$a"
+    SUPEROPTIMIZER_OPERAND_B, //Constant "$b"
+
+    SUPEROPTIMIZER_OPERAND_COUNT
+};
+
+using SuperoptimizerSequence = std::vector<uint8_t>; //Index of the instructions in the alphabet
+
+#define CODEG_SUPEROPTIMIZER_MAX_LENGTH 8
+
+struct SuperoptimizerRewrite
+{
+    codeg::SuperoptimizerSequence _pattern;
+    codeg::SuperoptimizerSequence _replacement;
+};
+
+class Superoptimizer
+{
+    /**
+    Exhaustive search of the shortest equivalent of every instruction sequence up to a length.
+
+    The alphabet is every chosen opcode with every operand (RESULT, RAM and 2 named constants),
+    a sequence is only built from shorter sequences that can't be reduced (prefix and suffix).
+    A sequence is compared with the shorter ones by its result on a few random machine states
+    (latches, RAM address, jump source, RAM content and bus writes), a match is then verified
+    on every value of the named constants before being kept as a rewrite.
+    The ALU is an unknown function, so the rewrites are valid for every ALU revision.
+
+    Every length is searched with multiple threads and is saved in a cache directory,
+    a longer search restart from the cached lengths.
+    **/
+public:
+    Superoptimizer() = default;
+    ~Superoptimizer() = default;
+
+    void clear();
+
+    static const std::vector<uint8_t>& getDefaultOpcodes();
+    static bool isSupportedOpcode(uint8_t opcode);
+
+    void setOpcodes(const std::vector<uint8_t>& opcodes);
+    const std::vector<uint8_t>& getOpcodes() const;
+
+    void setThreadCount(unsigned int count);
+    void setCachePath(const std::string& path);
+
+    void search(std::size_t length);
+
+    std::size_t getSequenceCount(std::size_t length) const;
+    bool isCached(std::size_t length) const;
+
+    const std::vector<codeg::SuperoptimizerRewrite>& getRewrites() const;
+    std::string getRule(std::size_t index) const;
+
+private:
+    void searchLength(std::size_t length);
+    void addFingerprints(std::size_t length);
+
+    bool loadCache(std::size_t length);
+    void saveCache(std::size_t length) const;
+    std::string getCacheFilePath(std::size_t length) const;
+
+    std::vector<uint8_t> g_opcodes;
+    unsigned int g_threadCount = 1;
+    std::string g_cachePath;
+
+    std::vector<std::vector<uint64_t> > g_sequences; //Sorted packed sequences that can't be reduced, by length
+    std::vector<bool> g_cached;
+    std::map<uint64_t, uint64_t> g_fingerprints; //Cheapest packed sequence for every fingerprint
+    std::vector<codeg::SuperoptimizerRewrite> g_rewrites;
+};
+
+}//end codeg
+
+#endif // C_SUPEROPTIMIZER_H_INCLUDED
@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_TRACE_H_INCLUDED
+#define C_TRACE_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+#define CODEG_TRACE_BUFFER_SIZE 65536
+
+namespace codeg
+{
+
+struct CompilerData;
+class ReaderData;
+
+enum TraceTracks : uint8_t
+{
+    TRACE_TRACK_COMPILER = 1, //Steps, files and expanded definitions
+    TRACE_TRACK_FUNCTIONS //Function and definition bodies
+};
+
+struct TraceEvent
+{
+    uint32_t _name; //Index in the name table
+    uint32_t _category;
+    bool _begin;
+    codeg::TraceTracks _track;
+    uint64_t _time; //Nanoseconds since the start of the trace
+    uint64_t _lines; //Lines read since the start of the trace
+    uint32_t _cursor; //Code cursor
+};
+
+class Tracer
+{
+    /**
+    Timeline of a compilation in the Chrome trace event format (chrome://tracing, Perfetto), for
+    "--trace".
+
+    The spans are recorded as begin/end events in a buffer allocated by enable(), the names are
+    stored once in a table. The events are matched and converted in complete events only by
+    writeJson(), with the number of lines read and the bytes emitted by every span.
+
+    syncReader() follow the FileReader stack (imported files, expanded definitions, inlined
+    functions and repeated code) and the body of the function that is compiled, it must be called
+    after every read line and every compiled instruction.
+    **/
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Tracer() = default;
+    ~Tracer() = default;
+
+    void enable();
+    bool isEnabled() const;
+
+    void begin(const std::string& category, const std::string& name, const codeg::CompilerData& data,
+               codeg::TraceTracks track=codeg::TraceTracks::TRACE_TRACK_COMPILER);
+    void end(const codeg::CompilerData& data, codeg::TraceTracks track=codeg::TraceTracks::TRACE_TRACK_COMPILER);
+
+    ///Count the read line (not the empty line returned when a reader is closed) and call syncReader()
+    void readLine(const codeg::CompilerData& data);
+    void syncReader(const codeg::CompilerData& data);
+    ///End every opened span
+    void finish(const codeg::CompilerData& data);
+
+    void writeJson(std::ostream& stream) const;
+
+    std::size_t getEventCount() const;
+
+private:
+    uint32_t getNameIndex(const std::string& name);
+    void pushEvent(uint32_t name, uint32_t category, bool begin, codeg::TraceTracks track, const codeg::CompilerData& data);
+
+    bool g_enabled = false;
+    codeg::Tracer::Clock::time_point g_startTime;
+    uint64_t g_lines = 0;
+
+    std::vector<codeg::TraceEvent> g_events;
+    std::vector<std::string> g_names;
+    std::unordered_map<std::string, uint32_t> g_nameIndexes;
+
+    std::vector<const codeg::ReaderData*> g_readers; //Readers with an opened span
+    std::size_t g_openedSpans[codeg::TraceTracks::TRACE_TRACK_FUNCTIONS+1] = {0};
+    std::string g_function; //Function with an opened span
+};
+
+}//end codeg
+
+#endif // C_TRACE_H_INCLUDED
@@ -0,0 +1,162 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef C_WCET_H_INCLUDED
+#define C_WCET_H_INCLUDED
+
+#include "C_address.hpp"
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstdint>
+#include <limits>
+
+#define CODEG_WCET_UNBOUNDED std::numeric_limits<uint64_t>::max()
+#define CODEG_WCET_OPCODE_COUNT 0x18
+
+namespace codeg
+{
+
+struct CompilerData;
+
+struct WcetResult
+{
+    std::string _name;
+    bool _function; //Else a user label
+    codeg::Address _address;
+
+    uint64_t _best; //Cycles
+    uint64_t _worst; //CODEG_WCET_UNBOUNDED when it can't be bounded
+    std::string _reason; //Why the worst case is unbounded
+};
+
+class WcetAnalyzer
+{
+    /**
+    Compute the best and the worst case cycles of the functions and the user labels on the final code
+    (after the jumps and the pools are resolved).
+
+    The code is decoded and the value of the jump source register is followed to find the target of
+    every jump :
+        - a jump to the start of a function (or an outlined sequence) is a call, its cost is the cost of
+          the function and the code continue after the jump
+        - a jump source read from the RAM is a return
+        - a jump source computed by the ALU in a known 256 bytes page can go to every entry of a jump table
+    (a jump to a function is a call only when the next instruction is a return address of a call).
+    A function is measured from its start to its returns, a user label from the label to the next user
+    label (itself included), a return or the end of the code.
+
+    The loops are found with the dominators. The number of times the start of a loop is executed every
+    time the loop is entered come from the "repeat" counts, the delay loops and the "wcet bound" annotations.
+    A loop without a bound, an unknown jump or a recursive call make the worst case unbounded.
+    **/
+public:
+    WcetAnalyzer();
+    ~WcetAnalyzer() = default;
+
+    void clear();
+
+    bool loadCosts(const std::string& path);
+    void setCost(uint8_t opcode, uint32_t cycles);
+    uint32_t getCost(uint8_t opcode) const;
+    void setSkippedCost(uint32_t cycles);
+    uint32_t getSkippedCost() const;
+
+    void analyze(codeg::CompilerData& data);
+
+    const std::vector<codeg::WcetResult>& getResults() const;
+    const codeg::WcetResult* getResult(const std::string& name) const;
+
+private:
+    enum JumpKinds : uint8_t
+    {
+        JUMP_NONE = 0,
+        JUMP_KNOWN,
+        JUMP_CALL,
+        JUMP_RETURN,
+        JUMP_TABLE,
+        JUMP_UNKNOWN
+    };
+
+    struct Op
+    {
+        codeg::Address _address;
+        uint8_t _code;
+        uint8_t _argument;
+    };
+    struct Edge
+    {
+        uint32_t _target; //Block, UINT32_MAX when the code is left
+        uint64_t _cycles; //Skipped instruction
+        uint32_t _callee; //Block of the called function, UINT32_MAX if not a call
+    };
+    struct Block
+    {
+        std::size_t _begin;
+        std::size_t _end;
+        uint64_t _cycles;
+        std::vector<codeg::WcetAnalyzer::Edge> _successors;
+        bool _unknownJump;
+        bool _boundary; //Start of a user label
+    };
+    struct Exit
+    {
+        uint32_t _target;
+        uint64_t _worst;
+        uint64_t _best;
+    };
+    struct Summary
+    {
+        uint64_t _best;
+        uint64_t _worst;
+        std::string _reason;
+    };
+
+    void decode(codeg::CompilerData& data);
+    void followJumps(codeg::CompilerData& data);
+    void buildBlocks();
+    codeg::WcetAnalyzer::Summary evaluate(uint32_t entry, bool function);
+    std::string getName(codeg::Address address) const;
+
+    uint32_t g_costs[CODEG_WCET_OPCODE_COUNT];
+    uint32_t g_skippedCost;
+
+    std::vector<codeg::WcetAnalyzer::Op> g_ops;
+    std::vector<uint32_t> g_opIndex; //Instruction of every code address
+    std::vector<bool> g_reached;
+    std::vector<codeg::WcetAnalyzer::JumpKinds> g_jumpKinds;
+    std::vector<std::vector<std::size_t> > g_jumpTargets;
+    std::vector<bool> g_leaders;
+
+    std::vector<codeg::WcetAnalyzer::Block> g_blocks;
+    std::vector<uint32_t> g_opBlock;
+
+    std::multimap<codeg::Address, std::string> g_labels;
+    std::set<codeg::Address> g_entries; //Start of the functions and the outlined sequences
+    std::set<codeg::Address> g_boundaries; //Start of the user labels
+    std::set<codeg::Address> g_returnPoints; //Return address of the calls
+    std::map<codeg::Address, std::pair<uint32_t, uint32_t> > g_bounds;
+
+    std::map<uint32_t, codeg::WcetAnalyzer::Summary> g_functions;
+    std::set<uint32_t> g_evaluating;
+
+    std::vector<codeg::WcetResult> g_results;
+};
+
+}//end codeg
+
+#endif // C_WCET_H_INCLUDED
@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_alu.hpp"
+#include "C_compilerData.hpp"
+#include "C_readableBus.hpp"
+
+namespace codeg
+{
+
+///Operations semantics
+
+static uint8_t AluAdd(uint8_t left, uint8_t right){ return left + right; }
+static uint8_t AluSub(uint8_t left, uint8_t right){ return left - right; }
+
+static uint8_t AluAnd(uint8_t left, uint8_t right){ return left & right; }
+static uint8_t AluOr(uint8_t left, uint8_t right){ return left | right; }
+static uint8_t AluXor(uint8_t left, uint8_t right){ return left ^ right; }
+
+static uint8_t AluLogicalAnd(uint8_t left, uint8_t right){ return (left && right) ? 1 : 0; }
+static uint8_t AluLogicalOr(uint8_t left, uint8_t right){ return (left || right) ? 1 : 0; }
+static uint8_t AluLogicalXor(uint8_t left, uint8_t right){ return ((left!=0) != (right!=0)) ? 1 : 0; }
+
+static uint8_t AluShiftRight(uint8_t left, uint8_t right){ return (right < 8) ? (left >> right) : 0; }
+static uint8_t AluShiftLeft(uint8_t left, uint8_t right){ return (right < 8) ? (left << right) : 0; }
+
+static uint8_t AluGreater(uint8_t left, uint8_t right){ return (left > right) ? 1 : 0; }
+static uint8_t AluLess(uint8_t left, uint8_t right){ return (left < right) ? 1 : 0; }
+static uint8_t AluGreaterEqual(uint8_t left, uint8_t right){ return (left >= right) ? 1 : 0; }
+static uint8_t AluLessEqual(uint8_t left, uint8_t right){ return (left <= right) ? 1 : 0; }
+static uint8_t AluEqual(uint8_t left, uint8_t right){ return (left == right) ? 1 : 0; }
+
+static uint8_t AluNot(uint8_t left, [[maybe_unused]] uint8_t right){ return ~left; }
+static uint8_t AluLogicalNot(uint8_t left, [[maybe_unused]] uint8_t right){ return (left == 0) ? 1 : 0; }
+
+static uint8_t AluMultiply(uint8_t left, uint8_t right){ return left * right; }
+
+///Alu
+
+void Alu::clear()
+{
+    this->g_revision = codeg::AluRevisions::ALU_REVISION_NULL;
+    this->g_revisionName.clear();
+    this->g_operations.clear();
+}
+
+bool Alu::setRevision(const std::string& name)
+{
+    if ( (name == "GP8B_V1") || (name == "GP8B_V4") )
+    {
+        /*
+        GP8B ALU - V1 (also used by the GP8B V4 board), unary operations use the left operand.
+        Operations 18 "~1" and 19 "@" don't have a declared semantic and are never computed.
+        */
+        this->g_revision = (name == "GP8B_V1") ? codeg::AluRevisions::ALU_REVISION_GP8B_V1 : codeg::AluRevisions::ALU_REVISION_GP8B_V4;
+        this->g_revisionName = name;
+        this->g_operations = {
+            {"+", codeg::AluAdd},
+            {"-", codeg::AluSub},
+
+            {"&", codeg::AluAnd},
+            {"|", codeg::AluOr},
+            {"^", codeg::AluXor},
+
+            {"&&", codeg::AluLogicalAnd},
+            {"||", codeg::AluLogicalOr},
+            {"^^", codeg::AluLogicalXor},
+
+            {">>", codeg::AluShiftRight},
+            {"<<", codeg::AluShiftLeft},
+
+            {">", codeg::AluGreater},
+            {"<", codeg::AluLess},
+            {">=", codeg::AluGreaterEqual},
+            {"<=", codeg::AluLessEqual},
+            {"==", codeg::AluEqual},
+
+            {"~", codeg::AluNot},
+            {"!", codeg::AluLogicalNot},
+
+            {"*", codeg::AluMultiply},
+
+            {"~1", nullptr},
+            {"@", nullptr}
+        };
+        return true;
+    }
+
+    return false;
+}
+codeg::AluRevisions Alu::getRevision() const
+{
+    return this->g_revision;
+}
+const std::string& Alu::getRevisionName() const
+{
+    return this->g_revisionName;
+}
+
+const codeg::AluOperation* Alu::getOperation(uint8_t opcode) const
+{
+    if (opcode < this->g_operations.size())
+    {
+        return &this->g_operations[opcode];
+    }
+    return nullptr;
+}
+bool Alu::compute(uint8_t left, uint8_t opcode, uint8_t right, uint8_t& result) const
+{
+    const codeg::AluOperation* operation = this->getOperation(opcode);
+    if (operation != nullptr)
+    {
+        if (operation->_function != nullptr)
+        {
+            result = operation->_function(left, right);
+            return true;
+        }
+    }
+    return false;
+}
+
+///AluState
+
+void AluState::clear()
+{
+    this->g_left._known = false;
+    this->g_operation._known = false;
+    this->g_right._known = false;
+
+    this->g_pending = false;
+}
+
+void AluState::setLeft(bool known, uint8_t value)
+{
+    this->g_left = {known, value};
+}
+void AluState::setOperation(bool known, uint8_t value)
+{
+    this->g_operation = {known, value};
+}
+void AluState::setRight(bool known, uint8_t value)
+{
+    this->g_right = {known, value};
+}
+
+const codeg::AluLatch& AluState::getLeft() const
+{
+    return this->g_left;
+}
+const codeg::AluLatch& AluState::getOperation() const
+{
+    return this->g_operation;
+}
+const codeg::AluLatch& AluState::getRight() const
+{
+    return this->g_right;
+}
+
+bool AluState::getResult(const codeg::Alu& alu, uint8_t& result) const
+{
+    if ( this->g_left._known && this->g_operation._known && this->g_right._known )
+    {
+        return alu.compute(this->g_left._value, this->g_operation._value, this->g_right._value, result);
+    }
+    return false;
+}
+
+void AluState::setPending(bool pending)
+{
+    this->g_pending = pending;
+}
+bool AluState::isPending() const
+{
+    return this->g_pending;
+}
+
+void AluState::flush(codeg::CodeData& code)
+{
+    if (!this->g_pending)
+    {
+        return;
+    }
+
+    code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_SOURCE);
+    code.push(this->g_left._value);
+    code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+    code.push(this->g_operation._value);
+    code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+    code.push(this->g_right._value);
+
+    this->g_pending = false;
+}
+void AluState::discard()
+{
+    if (this->g_pending)
+    {//The pending operation is overwritten before being observed
+        this->g_pending = false;
+        ++this->g_removedCount;
+    }
+}
+
+uint32_t AluState::getRemovedCount() const
+{
+    return this->g_removedCount;
+}
+
+}//end codeg
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_dataflow.hpp"
+
+namespace codeg
+{
+
+///DataflowState
+
+void DataflowState::clear()
+{
+    this->g_values.clear();
+    this->g_reachable = true;
+}
+
+void DataflowState::setUnreachable()
+{
+    this->g_values.clear();
+    this->g_reachable = false;
+}
+bool DataflowState::isReachable() const
+{
+    return this->g_reachable;
+}
+
+void DataflowState::set(const codeg::Variable* var, codeg::ReadableBusses bus, uint8_t value)
+{
+    this->g_values[var] = {bus, value};
+}
+void DataflowState::remove(const codeg::Variable* var)
+{
+    this->g_values.erase(var);
+}
+void DataflowState::removeBus(codeg::ReadableBusses bus)
+{
+    for (codeg::DataflowState::DataflowStateType::iterator it=this->g_values.begin(); it!=this->g_values.end();)
+    {
+        if (it->second._bus == bus)
+        {
+            it = this->g_values.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+const codeg::KnownValue* DataflowState::get(const codeg::Variable* var) const
+{
+    codeg::DataflowState::DataflowStateType::const_iterator it = this->g_values.find(var);
+    if (it != this->g_values.end())
+    {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+void DataflowState::merge(const codeg::DataflowState& state)
+{
+    if (!state.g_reachable)
+    {//Nothing come from the other path
+        return;
+    }
+    if (!this->g_reachable)
+    {//Nothing come from this path
+        *this = state;
+        return;
+    }
+
+    //Keeping only the values that are the same in the 2 paths
+    for (codeg::DataflowState::DataflowStateType::iterator it=this->g_values.begin(); it!=this->g_values.end();)
+    {
+        const codeg::KnownValue* value = state.get(it->first);
+        if ( (value != nullptr) && (value->_bus == it->second._bus) && (value->_value == it->second._value) )
+        {
+            ++it;
+        }
+        else
+        {
+            it = this->g_values.erase(it);
+        }
+    }
+}
+
+}//end codeg
@@ -1,109 +1,237 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "C_function.hpp"
-
-namespace codeg
-{
-
-///Function
-
-Function::Function(const std::string& name, bool definition)
-{
-    this->g_name = name;
-    this->g_isDefinition = definition;
-}
-
-void Function::setName(const std::string& name)
-{
-    this->g_name = name;
-}
-const std::string& Function::getName() const
-{
-    return this->g_name;
-}
-
-void Function::setDefinitionType(bool definition)
-{
-    this->g_isDefinition = definition;
-}
-bool Function::isDefinition() const
-{
-    return this->g_isDefinition;
-}
-
-void Function::clearLines()
-{
-    this->g_definitionLines.clear();
-}
-void Function::addLine(const std::string& str)
-{
-    this->g_definitionLines.push_back(str);
-}
-
-bool Function::operator== (const std::string& l) const
-{
-    return this->g_name == l;
-}
-
-codeg::Function::FunctionLinesType::const_iterator Function::getIteratorBegin() const
-{
-    return this->g_definitionLines.cbegin();
-}
-codeg::Function::FunctionLinesType::const_iterator Function::getIteratorEnd() const
-{
-    return this->g_definitionLines.cend();
-}
-
-///FunctionList
-
-void FunctionList::clear()
-{
-    this->g_data.clear();
-}
-
-codeg::Function* FunctionList::push(const codeg::Function& newFunction)
-{
-    this->g_data.push_front(newFunction);
-    return &this->g_data.front();
-}
-codeg::Function* FunctionList::push(const std::string& name, bool definition)
-{
-    this->g_data.emplace_front(name, definition);
-    return &this->g_data.front();
-}
-
-codeg::Function* FunctionList::getLast()
-{
-    if ( this->g_data.empty() )
-    {
-        return nullptr;
-    }
-    return &this->g_data.front();
-}
-codeg::Function* FunctionList::get(const std::string& name)
-{
-    for (auto& value : this->g_data)
-    {
-        if (value.getName() == name)
-        {
-            return &value;
-        }
-    }
-    return nullptr;
-}
-
-}//end codeg
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_function.hpp"
+#include "C_stringDecomposer.hpp"
+#include <set>
+
+namespace codeg
+{
+
+///Function
+
+Function::Function(const std::string& name, bool definition)
+{
+    this->g_name = name;
+    this->g_isDefinition = definition;
+}
+
+void Function::setName(const std::string& name)
+{
+    this->g_name = name;
+}
+const std::string& Function::getName() const
+{
+    return this->g_name;
+}
+
+void Function::setDefinitionType(bool definition)
+{
+    this->g_isDefinition = definition;
+}
+bool Function::isDefinition() const
+{
+    return this->g_isDefinition;
+}
+
+void Function::clearLines()
+{
+    this->g_definitionLines.clear();
+}
+void Function::addLine(const std::string& str)
+{
+    this->g_definitionLines.push_back(str);
+}
+
+void Function::setInlineHint(codeg::InlineHints hint)
+{
+    this->g_inlineHint = hint;
+}
+codeg::InlineHints Function::getInlineHint() const
+{
+    return this->g_inlineHint;
+}
+
+void Function::setCodeSize(uint32_t size)
+{
+    this->g_codeSize = size;
+}
+uint32_t Function::getCodeSize() const
+{
+    return this->g_codeSize;
+}
+
+void Function::setComplete(bool complete)
+{
+    this->g_isComplete = complete;
+}
+bool Function::isComplete() const
+{
+    return this->g_isComplete;
+}
+
+void Function::setInlining(bool inlining)
+{
+    this->g_isInlining = inlining;
+}
+bool Function::isInlining() const
+{
+    return this->g_isInlining;
+}
+
+bool Function::getInlineLines(const std::string returnVariables[3], const std::string& labelSuffix,
+                              codeg::Function::FunctionLinesType& lines) const
+{
+    lines.clear();
+
+    if ( this->g_isDefinition || !this->g_isComplete || this->g_definitionLines.empty() )
+    {
+        return false;
+    }
+
+    codeg::StringDecomposer decomposer;
+
+    ///Checking the lines
+    std::set<std::string> labels;
+    for (codeg::Function::FunctionLinesType::const_iterator it=this->g_definitionLines.cbegin(); it!=this->g_definitionLines.cend(); ++it)
+    {
+        decomposer.decompose(*it);
+        if ( decomposer._keywords.empty() )
+        {
+            continue;
+        }
+
+        const std::string& instruction = decomposer._keywords[0];
+        if ( std::next(it) == this->g_definitionLines.cend() )
+        {//The last line must be the return
+            if ( (instruction != "jump") || (decomposer._keywords.size() != 4) ||
+                 (decomposer._keywords[1] != returnVariables[0]) ||
+                 (decomposer._keywords[2] != returnVariables[1]) ||
+                 (decomposer._keywords[3] != returnVariables[2]) )
+            {
+                return false;
+            }
+            break;
+        }
+
+        if ( (instruction != "affect") && (instruction != "get") && (instruction != "write") &&
+             (instruction != "choose") && (instruction != "do") && (instruction != "tick") &&
+             (instruction != "clock") && (instruction != "if") && (instruction != "if_not") &&
+             (instruction != "else") && (instruction != "end") && (instruction != "jump") &&
+             (instruction != "restart") && (instruction != "call") && (instruction != "label") &&
+             (instruction != "repeat") && (instruction != "switch") && (instruction != "case") &&
+             (instruction != "default") )
+        {//Declarations and unknown instructions are not duplicated
+            return false;
+        }
+
+        if (instruction == "label")
+        {
+            if (decomposer._keywords.size() != 2)
+            {//Fixed address
+                return false;
+            }
+            labels.insert(decomposer._keywords[1]);
+        }
+
+        for (std::size_t i=1; i<decomposer._keywords.size(); ++i)
+        {
+            if ( (decomposer._keywords[i] == returnVariables[0]) ||
+                 (decomposer._keywords[i] == returnVariables[1]) ||
+                 (decomposer._keywords[i] == returnVariables[2]) )
+            {//The return address is used by something else than the return
+                return false;
+            }
+        }
+    }
+
+    ///Renaming the labels
+    for (codeg::Function::FunctionLinesType::const_iterator it=this->g_definitionLines.cbegin(); std::next(it)!=this->g_definitionLines.cend(); ++it)
+    {
+        decomposer.decompose(*it);
+
+        if ( (decomposer._keywords.size() == 2) &&
+             ((decomposer._keywords[0] == "label") || (decomposer._keywords[0] == "jump")) &&
+             (labels.find(decomposer._keywords[1]) != labels.end()) )
+        {
+            lines.push_back(decomposer._keywords[0]+" "+decomposer._keywords[1]+labelSuffix);
+        }
+        else
+        {
+            lines.push_back(*it);
+        }
+    }
+
+    return true;
+}
+
+bool Function::operator== (const std::string& l) const
+{
+    return this->g_name == l;
+}
+
+codeg::Function::FunctionLinesType::const_iterator Function::getIteratorBegin() const
+{
+    return this->g_definitionLines.cbegin();
+}
+codeg::Function::FunctionLinesType::const_iterator Function::getIteratorEnd() const
+{
+    return this->g_definitionLines.cend();
+}
+
+///FunctionList
+
+void FunctionList::clear()
+{
+    this->g_data.clear();
+}
+
+codeg::Function* FunctionList::push(const codeg::Function& newFunction)
+{
+    this->g_data.push_front(newFunction);
+    return &this->g_data.front();
+}
+codeg::Function* FunctionList::push(const std::string& name, bool definition)
+{
+    this->g_data.emplace_front(name, definition);
+    return &this->g_data.front();
+}
+
+codeg::Function* FunctionList::getLast()
+{
+    if ( this->g_data.empty() )
+    {
+        return nullptr;
+    }
+    return &this->g_data.front();
+}
+codeg::Function* FunctionList::get(const std::string& name)
+{
+    for (auto& value : this->g_data)
+    {
+        if (value.getName() == name)
+        {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+codeg::FunctionList::FunctionListType& FunctionList::getFunctions()
+{
+    return this->g_data;
+}
+
+}//end codeg
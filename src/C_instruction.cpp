@@ -1,1785 +1,2889 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "C_instruction.hpp"
-#include "C_readableBus.hpp"
-#include "C_compilerData.hpp"
-#include "C_console.hpp"
-#include "C_keyword.hpp"
-#include "C_bus.hpp"
-#include "C_error.hpp"
-
-namespace codeg
-{
-
-const char* ReadableStringBinaryOpcodes[]=
-{
-    "BWRITE1_CLK",
-    "BWRITE2_CLK",
-
-    "BPCS_CLK",
-
-    "OPLEFT_CLK",
-    "OPRIGHT_CLK",
-    "OPCHOOSE_CLK",
-
-    "PERIPHERAL_CLK",
-
-    "BJMPSRC1_CLK",
-    "BJMPSRC2_CLK",
-    "BJMPSRC3_CLK",
-    "JMPSRC_CLK",
-
-    "BRAMADD1_CLK",
-    "BRAMADD2_CLK",
-
-    "SPI_CLK",
-    "BCFG_SPI_CLK",
-
-    "STICK",
-
-    "IF",
-    "IFNOT",
-
-    "RAMW",
-
-    "UOP",
-    "UOP",
-    "UOP",
-    "UOP",
-
-    "LTICK"
-};
-
-///Instruction
-
-void Instruction::compileDefinition(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    data._functions.getLast()->addLine(input._cleaned);
-}
-
-///InstructionList
-
-void InstructionList::clear()
-{
-    this->g_data.clear();
-}
-
-void InstructionList::push(codeg::Instruction* newInstruction)
-{
-    this->g_data.push_front( std::unique_ptr<codeg::Instruction>(newInstruction) );
-}
-codeg::Instruction* InstructionList::get(const std::string& name) const
-{
-    for (auto& valPtr : this->g_data)
-    {
-        if (valPtr.get()->getName() == name)
-        {
-            return valPtr.get();
-        }
-    }
-    return nullptr;
-}
-
-///Instruction_set
-Instruction_set::Instruction_set(){}
-Instruction_set::~Instruction_set(){}
-
-std::string Instruction_set::getName() const
-{
-    return "set";
-}
-
-void Instruction_set::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 3 )
-    {//Check size
-        throw codeg::CompileError("set : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argName;
-    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
-    {//Check name
-        throw codeg::CompileError("set : bad argument (argument 1 [string] must be a valid string)");
-    }
-
-    codeg::Keyword argString;
-    if ( !argString.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_STRING, data) )
-    {//Check string
-        throw codeg::CompileError("set : bad argument (argument 2 [string] must be a valid string)");
-    }
-
-    if ( data._macros.check(argName._str) )
-    {//Check if already set
-        data._macros.set(argName._str, argString._str);
-        codeg::ConsoleWarningWrite("[warning] set : macro \""+ argName._str +"\" already exist and will be replaced");
-    }
-    else
-    {
-        data._macros.set(argName._str, argString._str);
-    }
-}
-
-///Instruction_unset
-Instruction_unset::Instruction_unset(){}
-Instruction_unset::~Instruction_unset(){}
-
-std::string Instruction_unset::getName() const
-{
-    return "unset";
-}
-
-void Instruction_unset::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("unset : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argName;
-    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
-    {//Check name
-        throw codeg::CompileError("unset : bad argument (argument 1 [string] must be a valid string)");
-    }
-
-    data._macros.remove(argName._str);
-}
-
-///Instruction_var
-Instruction_var::Instruction_var(){}
-Instruction_var::~Instruction_var(){}
-
-std::string Instruction_var::getName() const
-{
-    return "var";
-}
-
-void Instruction_var::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 3 )
-    {//Check size
-        codeg::Keyword argVarName;
-        if ( !argVarName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check var name
-            throw codeg::CompileError("var : bad argument (argument 1 [name] must be a valid name)");
-        }
-
-        codeg::Keyword argPoolName;
-        if ( !argPoolName.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check pool name
-            throw codeg::CompileError("var : bad argument (argument 2 [name] must be a valid name)");
-        }
-
-        if ( codeg::Pool* tmpPool = data._pools.getPool(argPoolName._str) )
-        {//Check pool
-            if ( !tmpPool->addVariable( {argVarName._str, std::list<codeg::Address>()} ) )
-            {
-                codeg::ConsoleWrite("[warning] var : variable \""+argVarName._str+"\" already exist in pool \""+argPoolName._str+"\"");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("var : bad pool (argument 2 \""+argPoolName._str+"\" the pool does not exist)");
-        }
-
-        return;
-    }
-
-    if ( input._keywords.size() == 2 )
-    {//Check size
-        codeg::Keyword argVarName;
-        if ( !argVarName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check var name
-            throw codeg::CompileError("var : bad argument (argument 1 [name] must be a valid name)");
-        }
-
-        if ( codeg::Pool* tmpPool = data._pools.getPool(data._defaultPool) )
-        {//Check pool
-            if ( !tmpPool->addVariable( {argVarName._str, std::list<codeg::Address>()} ) )
-            {
-                codeg::ConsoleWrite("[warning] var : variable \""+argVarName._str+"\" already exist in pool \""+data._defaultPool+"\"");
-            }
-        }
-        else
-        {
-            throw codeg::FatalError("the default pool appear to not be created");
-        }
-
-        return;
-    }
-
-    throw codeg::CompileError("var : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
-}
-
-///Instruction_label
-Instruction_label::Instruction_label(){}
-Instruction_label::~Instruction_label(){}
-
-std::string Instruction_label::getName() const
-{
-    return "label";
-}
-
-void Instruction_label::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 2 )
-    {//Label name with determined cursor address
-        codeg::Keyword argName;
-        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check label name
-            throw codeg::CompileError("label : bad argument (argument 1 [name] must be a valid name)");
-        }
-
-        codeg::Label tmpLabel;
-        tmpLabel._addressStatic = data._code.getCursor();
-        tmpLabel._uniqueIndex = 0;
-        tmpLabel._name = argName._str;
-
-        if ( !data._jumps.addLabel(tmpLabel) )
-        {//Check name
-            throw codeg::CompileError("label : bad label (label "+argName._str+" already exist)");
-        }
-    }
-    else if ( input._keywords.size() == 3 )
-    {//Label name with fixed address
-        codeg::Keyword argName;
-        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check label name
-            throw codeg::CompileError("label : bad argument (argument 1 [name] must be a valid name)");
-        }
-        codeg::Keyword argValue;
-        if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//Check const value
-            throw codeg::CompileError("label : bad argument (argument 2 [value] must be a valid constant value)");
-        }
-        if ( !argValue._valueIsConst )
-        {
-            throw codeg::CompileError("label : bad argument (argument 2 [value] must be a valid constant value)");
-        }
-
-        codeg::Label tmpLabel;
-        tmpLabel._addressStatic = argValue._value;
-        tmpLabel._uniqueIndex = 0;
-        tmpLabel._name = argName._str;
-
-        if ( !data._jumps.addLabel(tmpLabel) )
-        {//Check name
-            throw codeg::CompileError("label : bad label (label "+argName._str+" already exist)");
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("label : bad arguments size (wanted 2 or 3 got "+std::to_string(input._keywords.size())+")");
-    }
-}
-
-///Instruction_jump
-Instruction_jump::Instruction_jump(){}
-Instruction_jump::~Instruction_jump(){}
-
-std::string Instruction_jump::getName() const
-{
-    return "jump";
-}
-
-void Instruction_jump::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 2 )
-    {//Label name or fixed address
-        codeg::Keyword arg1;
-        if ( arg1.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Check label name
-            codeg::JumpPoint tmpPoint;
-            tmpPoint._addressStatic = data._code.getCursor();
-            tmpPoint._labelName = arg1._str;
-
-            if ( !data._jumps.addJumpPoint(tmpPoint) )
-            {
-                throw codeg::CompileError("jump : bad label (unknown label \""+arg1._str+"\")");
-            }
-
-            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_JMPSRC_CLK);
-        }
-        else if ( arg1._type == codeg::KeywordTypes::KEYWORD_VALUE )
-        {//Check constant value
-            if ( arg1._valueSize <= 3 )
-            {
-                uint32_t address = arg1._value;
-
-                data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-                data._code.push( (address&0x00FF0000)>>16 );
-                data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-                data._code.push( (address&0x0000FF00)>>8 );
-                data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-                data._code.push( address&0x000000FF );
-                data._code.push(codeg::OPCODE_JMPSRC_CLK);
-            }
-            else
-            {
-                throw codeg::CompileError("jump : bad size (argument 1 [value] byte size must be <= 3)");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("jump : bad argument (argument 1 [name]/[value] must be a valid name or constant value)");
-        }
-    }
-    else if ( input._keywords.size() == 4 )
-    {//3 separate values or variables
-        codeg::Keyword arg1;
-        if ( arg1.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A constant value
-            if ( arg1._valueSize == 1 )
-            {
-                data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-                data._code.push( arg1._value );
-            }
-            else
-            {
-                throw codeg::CompileError("jump : bad size (argument 1 [value] byte size must be == 1)");
-            }
-        }
-        else if ( arg1._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {//A variable
-            arg1._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_RAM);
-            data._code.pushDummy();
-        }
-        else
-        {
-            throw codeg::CompileError("jump : bad argument (argument 1 [value] must be a valid value)");
-        }
-
-        codeg::Keyword arg2;
-        if ( arg2.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A constant value
-            if ( arg2._valueSize == 1 )
-            {
-                data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-                data._code.push( arg2._value );
-            }
-            else
-            {
-                throw codeg::CompileError("jump : bad size (argument 2 [value] byte size must be == 1)");
-            }
-        }
-        else if ( arg2._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {//A variable
-            arg2._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_RAM);
-            data._code.pushDummy();
-        }
-        else
-        {
-            throw codeg::CompileError("jump : bad argument (argument 2 [value] must be a valid value)");
-        }
-
-        codeg::Keyword arg3;
-        if ( arg3.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A constant value
-            if ( arg3._valueSize == 1 )
-            {
-                data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-                data._code.push( arg3._value );
-            }
-            else
-            {
-                throw codeg::CompileError("jump : bad size (argument 3 [value] byte size must be == 1)");
-            }
-        }
-        else if ( arg3._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {//A variable
-            arg3._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_RAM);
-            data._code.pushDummy();
-        }
-        else
-        {
-            throw codeg::CompileError("jump : bad argument (argument 3 [value] must be a valid value)");
-        }
-
-        data._code.push(codeg::OPCODE_JMPSRC_CLK);
-    }
-    else
-    {//Bad size
-        throw codeg::CompileError("jump : bad arguments size (wanted 2 or 4 got "+std::to_string(input._keywords.size())+")");
-    }
-}
-
-///Instruction_restart
-Instruction_restart::Instruction_restart(){}
-Instruction_restart::~Instruction_restart(){}
-
-std::string Instruction_restart::getName() const
-{
-    return "restart";
-}
-
-void Instruction_restart::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 1 )
-    {//Check size
-        throw codeg::CompileError("restart : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_JMPSRC_CLK);
-}
-
-///Instruction_affect
-Instruction_affect::Instruction_affect(){}
-Instruction_affect::~Instruction_affect(){}
-
-std::string Instruction_affect::getName() const
-{
-    return "affect";
-}
-
-void Instruction_affect::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 3 )
-    {//fixed specified address or variable
-        codeg::Keyword argVar;
-        if ( argVar.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
-        {//Variable
-            codeg::Keyword argValue;
-            if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-            {//A value
-                if ( !argValue._valueIsVariable )
-                {
-                    if (argValue._valueSize != 1)
-                    {
-                        throw codeg::CompileError("affect : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-                    }
-
-                    argVar._variable->_link.push_back(data._code.getCursor());
-
-                    data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                    data._code.push(0x00);
-                    data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                    data._code.push(0x00);
-
-                    data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
-                    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-                    {
-                        data._code.push(argValue._value);
-                    }
-                    else
-                    {
-                        data._code.pushDummy();
-                    }
-                }
-                else
-                {//A variable
-                    throw codeg::CompileError("affect : can't copy (for now) a variable in another variable");
-                }
-            }
-            else
-            {
-                throw codeg::CompileError("affect : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
-            }
-        }
-        else if ( argVar._type == codeg::KeywordTypes::KEYWORD_CONSTANT )
-        {//Constant
-            if ( argVar._valueSize > 2 )
-            {
-                throw codeg::CompileError("affect : bad constant (require size is <= 2 byte got \""+std::to_string(argVar._valueSize)+"\")");
-            }
-
-            codeg::Keyword argValue;
-            if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-            {//A value
-                if ( !argValue._valueIsVariable )
-                {
-                    if (argValue._valueSize != 1)
-                    {
-                        throw codeg::CompileError("affect : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-                    }
-
-                    data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                    data._code.push((argVar._value&0xFF00)>>8);
-                    data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                    data._code.push(argVar._value&0x00FF);
-
-                    data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
-                    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-                    {
-                        data._code.push(argValue._value);
-                    }
-                    else
-                    {
-                        data._code.pushDummy();
-                    }
-                }
-                else
-                {//A variable
-                    throw codeg::CompileError("affect : can't copy (for now) a variable in another variable");
-                }
-            }
-            else
-            {
-                throw codeg::CompileError("affect : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("affect : bad argument (argument 1 [variable]/[constant] must be valid)");
-        }
-    }
-    else if ( input._keywords.size() >= 4 )
-    {//fixed size pool
-        codeg::Keyword argPoolName;
-        if ( argPoolName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Pool name
-            codeg::Pool* pool = data._pools.getPool(argPoolName._str);
-            if (!pool)
-            {
-                throw codeg::CompileError("affect : bad argument (unknown pool : \""+argPoolName._str+"\")");
-            }
-            if ( pool->getMaxSize() == 0 )
-            {
-                throw codeg::CompileError("affect : bad argument (pool must have a fixed size)");
-            }
-
-            codeg::Keyword argOffset;
-            if ( argOffset.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_CONSTANT, data) )
-            {//Offset
-                if (argOffset._valueSize > 2)
-                {
-                    throw codeg::CompileError("affect : bad argument (argument 2 [constant] must have a byte size of <= 2)");
-                }
-
-                codeg::Address offset = argOffset._value;
-                unsigned int numOfValue = input._keywords.size() - 3;
-                if ( (numOfValue+offset) > pool->getMaxSize())
-                {
-                    throw codeg::CompileError("affect : pool overflow (try to affect "+std::to_string(numOfValue)+" values with offset "+std::to_string(offset)+" but the max size is "+std::to_string(pool->getMaxSize())+")");
-                }
-
-                for (unsigned int i=0; i<numOfValue; ++i)
-                {
-                    codeg::Keyword argValue;
-                    if ( argValue.process(input._keywords[i+3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-                    {//Value
-                        if (argValue._valueSize != 1)
-                        {
-                            throw codeg::CompileError("affect : bad argument (argument "+std::to_string(i+3)+" [value] must have a byte size of 1)");
-                        }
-
-                        pool->_link.push_back({data._code.getCursor(), i+offset});
-
-                        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                        data._code.push(0x00);
-                        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                        data._code.push(0x00);
-
-                        data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
-                        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-                        {
-                            data._code.push(argValue._value);
-                        }
-                        else
-                        {
-                            data._code.pushDummy();
-                        }
-                    }
-                    else if ( argValue._valueIsVariable )
-                    {
-                        throw codeg::CompileError("affect : can't copy a variable in another location in memory");
-                    }
-                    else
-                    {
-                        throw codeg::CompileError("affect : bad argument (argument "+std::to_string(i+3)+" [value] must be a valid value)");
-                    }
-                }
-            }
-            else
-            {
-                throw codeg::CompileError("affect : bad argument (argument 2 [constant] must be a valid constant)");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("affect : bad argument (argument 1 [name] must be a valid name)");
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("affect : bad arguments size (wanted 3 or 4 got "+std::to_string(input._keywords.size())+")");
-    }
-}
-
-///Instruction_get
-Instruction_get::Instruction_get(){}
-Instruction_get::~Instruction_get(){}
-
-std::string Instruction_get::getName() const
-{
-    return "get";
-}
-
-void Instruction_get::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 2 )
-    {//fixed specified address or variable
-        codeg::Keyword argVar;
-        if ( argVar.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
-        {//Variable
-            argVar._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else if ( argVar._type == codeg::KeywordTypes::KEYWORD_CONSTANT )
-        {//Constant
-            if ( argVar._valueSize > 2 )
-            {
-                throw codeg::CompileError("get : bad constant (require size is <= 2 byte got \""+std::to_string(argVar._valueSize)+"\")");
-            }
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push((argVar._value&0xFF00)>>8);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(argVar._value&0x00FF);
-        }
-        else
-        {
-            throw codeg::CompileError("get : bad argument (argument 1 [variable]/[constant] must be valid)");
-        }
-    }
-    else if ( input._keywords.size() == 3 )
-    {//fixed size pool
-        codeg::Keyword argPoolName;
-        if ( argPoolName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {//Pool name
-            codeg::Pool* pool = data._pools.getPool(argPoolName._str);
-            if (!pool)
-            {
-                throw codeg::CompileError("get : bad argument (unknown pool : \""+argPoolName._str+"\")");
-            }
-            if ( pool->getMaxSize() == 0 )
-            {
-                throw codeg::CompileError("get : bad argument (pool must have a fixed size)");
-            }
-
-            codeg::Keyword argOffset;
-            if ( argOffset.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_CONSTANT, data) )
-            {//Offset
-                if (argOffset._valueSize > 2)
-                {
-                    throw codeg::CompileError("get : bad argument (argument 2 [constant] must have a byte size of <= 2)");
-                }
-
-                codeg::Address offset = argOffset._value;
-                if (offset >= pool->getMaxSize())
-                {
-                    throw codeg::CompileError("get : pool overflow (try to get value at offset "+std::to_string(offset)+" but the max size is "+std::to_string(pool->getMaxSize())+")");
-                }
-
-                pool->_link.push_back({data._code.getCursor(), offset});
-
-                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-            }
-            else
-            {
-                throw codeg::CompileError("get : bad argument (argument 2 [constant] must be a valid constant)");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("get : bad argument (argument 1 [name] must be a valid name)");
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("get : bad arguments size (wanted 2 or 3 got "+std::to_string(input._keywords.size())+")");
-    }
-}
-
-///Instruction_write
-Instruction_write::Instruction_write(){}
-Instruction_write::~Instruction_write(){}
-
-std::string Instruction_write::getName() const
-{
-    return "write";
-}
-
-void Instruction_write::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 3 )
-    {//Check size
-        throw codeg::CompileError("write : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argBus;
-    if ( argBus.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_BUS, data) )
-    {//A bus
-        codeg::Keyword argValue;
-        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A value
-            if (argValue._valueSize != 1)
-            {
-                throw codeg::CompileError("write : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-            }
-        }
-        else
-        {//Possibly a variable
-            if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-            {
-                argValue._variable->_link.push_back(data._code.getCursor());
-
-                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-            }
-            else
-            {
-                throw codeg::CompileError("write : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
-            }
-        }
-
-        switch ( argBus._value )
-        {
-        case codeg::BUS_NULL:
-            throw codeg::CompileError("write : bad bus (bus can't be null)");
-            break;
-
-        case codeg::BUS_WRITEABLE_1:
-            data._code.push(codeg::OPCODE_BWRITE1_CLK | argValue._valueBus);
-            break;
-        case codeg::BUS_WRITEABLE_2:
-            data._code.push(codeg::OPCODE_BWRITE2_CLK | argValue._valueBus);
-            break;
-        case codeg::BUS_SPICFG:
-            data._code.push(codeg::OPCODE_BCFG_SPI_CLK | argValue._valueBus);
-            break;
-
-        default:
-            throw codeg::CompileError("write : bad bus (unknown bus)");
-            break;
-        }
-
-        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-        {
-            data._code.push(argValue._value);
-        }
-        else
-        {
-            data._code.pushDummy();
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("write : bad argument (argument 1 \""+argBus._str+"\" is not a bus");
-    }
-}
-
-///Instruction_choose
-Instruction_choose::Instruction_choose(){}
-Instruction_choose::~Instruction_choose(){}
-
-std::string Instruction_choose::getName() const
-{
-    return "choose";
-}
-
-void Instruction_choose::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 3 )
-    {//Check size
-        throw codeg::CompileError("choose : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argTarget;
-    if ( argTarget.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_TARGET, data) )
-    {//A target
-        codeg::Keyword argValue;
-        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A value
-            if (argValue._valueSize != 1)
-            {
-                throw codeg::CompileError("choose : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-            }
-        }
-        else
-        {//Possibly a variable
-            if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-            {
-                argValue._variable->_link.push_back(data._code.getCursor());
-
-                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-                data._code.push(0x00);
-            }
-            else
-            {
-                throw codeg::CompileError("choose : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
-            }
-        }
-
-        switch ( argTarget._target )
-        {
-        case codeg::TargetType::TARGET_OPERATION:
-            data._code.push(codeg::OPCODE_OPCHOOSE_CLK | argValue._valueBus);
-            break;
-        case codeg::TargetType::TARGET_PERIPHERAL:
-            data._code.push(codeg::OPCODE_BPCS_CLK | argValue._valueBus);
-            break;
-
-        default:
-            throw codeg::CompileError("choose : bad target (unknown target)");
-            break;
-        }
-
-        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-        {
-            data._code.push(argValue._value);
-        }
-        else
-        {
-            data._code.pushDummy();
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("choose : bad argument (argument 1 \""+argTarget._str+"\" is not a target)");
-    }
-}
-
-///Instruction_do
-Instruction_do::Instruction_do(){}
-Instruction_do::~Instruction_do(){}
-
-std::string Instruction_do::getName() const
-{
-    return "do";
-}
-
-void Instruction_do::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 4 )
-    {//Check size
-        throw codeg::CompileError("do : bad arguments size (wanted 4 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    ///LEFT
-    codeg::Keyword argValueLeft;
-    if ( argValueLeft.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        if (argValueLeft._valueSize != 1)
-        {
-            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueLeft._valueSize)+"\")");
-        }
-    }
-    else
-    {//Possibly a variable
-        if ( argValueLeft._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {
-            argValueLeft._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else
-        {
-            throw codeg::CompileError("do : bad argument (argument 1 \""+argValueLeft._str+"\" is not a value)");
-        }
-    }
-    data._code.push(codeg::OPCODE_OPLEFT_CLK | argValueLeft._valueBus);
-    if (argValueLeft._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-    {
-        data._code.push(argValueLeft._value);
-    }
-    else
-    {
-        data._code.pushDummy();
-    }
-
-    ///OPERATION
-    codeg::Keyword argValueOp;
-    if ( argValueOp.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        if (argValueOp._valueSize != 1)
-        {
-            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueOp._valueSize)+"\")");
-        }
-    }
-    else
-    {//Possibly a variable
-        if ( argValueOp._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {
-            argValueOp._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else
-        {
-            throw codeg::CompileError("do : bad argument (argument 2 \""+argValueOp._str+"\" is not a value)");
-        }
-    }
-    data._code.push(codeg::OPCODE_OPCHOOSE_CLK | argValueOp._valueBus);
-    if (argValueOp._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-    {
-        data._code.push(argValueOp._value);
-    }
-    else
-    {
-        data._code.pushDummy();
-    }
-
-    ///RIGHT
-    codeg::Keyword argValueRight;
-    if ( argValueRight.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        if (argValueRight._valueSize != 1)
-        {
-            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueRight._valueSize)+"\")");
-        }
-    }
-    else
-    {//Possibly a variable
-        if ( argValueRight._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {
-            argValueRight._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else
-        {
-            throw codeg::CompileError("do : bad argument (argument 3 \""+argValueRight._str+"\" is not a value)");
-        }
-    }
-    data._code.push(codeg::OPCODE_OPRIGHT_CLK | argValueRight._valueBus);
-    if (argValueRight._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-    {
-        data._code.push(argValueRight._value);
-    }
-    else
-    {
-        data._code.pushDummy();
-    }
-}
-
-///Instruction_tick
-Instruction_tick::Instruction_tick(){}
-Instruction_tick::~Instruction_tick(){}
-
-std::string Instruction_tick::getName() const
-{
-    return "tick";
-}
-
-void Instruction_tick::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( (input._keywords.size() != 2) && (input._keywords.size() != 3) )
-    {//Check size
-        throw codeg::CompileError("tick : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argStr;
-    if ( argStr.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
-    {//A string
-        if (argStr._str == "simple")
-        {
-            if ( input._keywords.size() == 3 )
-            {//Check size
-                codeg::Keyword argValue;
-                if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-                {
-                    if ( !argValue._valueIsConst )
-                    {
-                        throw codeg::CompileError("tick : bad argument (argument 2 [value] must be a valid constant value)");
-                    }
-                }
-                for (uint32_t i=0; i<argValue._value; ++i)
-                {
-                    data._code.push(codeg::OPCODE_STICK | codeg::READABLE_DEFAULT);
-                    data._code.pushDummy();
-                }
-            }
-            else
-            {
-                data._code.push(codeg::OPCODE_STICK | codeg::READABLE_DEFAULT);
-                data._code.pushDummy();
-            }
-        }
-        else if (argStr._str == "long")
-        {
-            if ( input._keywords.size() == 3 )
-            {//Check size
-                codeg::Keyword argValue;
-                if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-                {
-                    if ( !argValue._valueIsConst )
-                    {
-                        throw codeg::CompileError("tick : bad argument (argument 2 [value] must be a valid constant value)");
-                    }
-                }
-                for (uint32_t i=0; i<argValue._value; ++i)
-                {
-                    data._code.push(codeg::OPCODE_LTICK | codeg::READABLE_DEFAULT);
-                    data._code.pushDummy();
-                }
-            }
-            else
-            {
-                data._code.push(codeg::OPCODE_LTICK | codeg::READABLE_DEFAULT);
-                data._code.pushDummy();
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("tick : bad argument (argument 1 [string] must be \"long\" or \"simple\")");
-        }
-    }
-    else
-    {
-        throw codeg::CompileError("tick : bad string (argument 1 is not a string)");
-    }
-}
-
-///Instruction_brut
-Instruction_brut::Instruction_brut(){}
-Instruction_brut::~Instruction_brut(){}
-
-std::string Instruction_brut::getName() const
-{
-    return "brut";
-}
-
-void Instruction_brut::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() <= 1 )
-    {//Check size
-        throw codeg::CompileError("tick : bad arguments size (wanted >1 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argValue;
-
-    for (uint32_t i=1; i<input._keywords.size(); ++i)
-    {
-        if ( argValue.process(input._keywords[i], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A value
-            if ( argValue._valueIsConst )
-            {
-                if ( argValue._valueSize == 1 )
-                {
-                    data._code.push(argValue._value);
-                }
-                else
-                {
-                    throw codeg::CompileError("brut : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-                }
-            }
-            else
-            {
-                throw codeg::CompileError("brut : bad value (argument "+std::to_string(i)+" \""+argValue._str+"\" is not a valid constant value)");
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("brut : bad argument (argument "+std::to_string(i)+" [value] is not a value)");
-        }
-    }
-}
-
-///Instruction_function
-Instruction_function::Instruction_function(){}
-Instruction_function::~Instruction_function(){}
-
-std::string Instruction_function::getName() const
-{
-    return "function";
-}
-
-void Instruction_function::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("function : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argName;
-    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-    {
-        throw codeg::CompileError("function : bad argument (argument 1 [name] bad name)");
-    }
-
-    if ( data._functions.get(argName._str) != nullptr )
-    {
-        throw codeg::CompileError("function : bad function (function \""+argName._str+"\" already exist)");
-    }
-
-    if ( !data._actualFunctionName.empty() )
-    {
-        throw codeg::CompileError("function : function error (can't create a function in a function)");
-    }
-    if ( data._scopes.size() )
-    {
-        throw codeg::CompileError("function : function error (can't create a function in a scope)");
-    }
-
-    data._scopes.newScope(codeg::ScopeStats::SCOPE_FUNCTION, data._reader.getlineCount(), data._reader.getPath()); //New scope
-
-    data._actualFunctionName = argName._str;
-    data._functions.push(argName._str);
-
-    data._jumps._jumpPoints.push_back({"%%E"+argName._str, data._code.getCursor()}); //Jump to the end of the function
-    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_JMPSRC_CLK);
-
-    if ( !data._jumps.addLabel({"%%"+argName._str, 0, data._code.getCursor()}) )
-    {//Label to the start of the function
-        throw codeg::CompileError("function : label error (label \"%%"+argName._str+"\" already exist)");
-    }
-}
-
-///Instruction_if
-Instruction_if::Instruction_if(){}
-Instruction_if::~Instruction_if(){}
-
-std::string Instruction_if::getName() const
-{
-    return "if";
-}
-
-void Instruction_if::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("if : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argValue;
-    if ( argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        if (argValue._valueSize != 1)
-        {
-            throw codeg::CompileError("if : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-        }
-    }
-    else
-    {//Possibly a variable
-        if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {
-            argValue._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else
-        {
-            throw codeg::CompileError("if : bad argument (argument 1 \""+argValue._str+"\" is not a value)");
-        }
-    }
-    /*
-    2 jump points must be created in order to work properly :
-        - At the false condition, label named %%Fn where n is the scope
-        - At the end of the condition, label named %%En where n is the scope
-    if there is no "else" keyword, the label %%Fn will be the end of the condition
-    */
-
-    data._scopes.newScope(codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE, data._reader.getlineCount(), data._reader.getPath()); //New scope
-
-    data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
-    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-
-
-    data._code.push(codeg::OPCODE_IF | argValue._valueBus);
-    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-    {
-        data._code.push(argValue._value);
-    }
-    else
-    {
-        data._code.pushDummy();
-    }
-
-    data._code.push(codeg::OPCODE_JMPSRC_CLK);
-}
-
-///Instruction_else
-Instruction_else::Instruction_else(){}
-Instruction_else::~Instruction_else(){}
-
-std::string Instruction_else::getName() const
-{
-    return "else";
-}
-
-void Instruction_else::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 1 )
-    {//Check size
-        throw codeg::CompileError("else : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    if ( data._scopes.empty() )
-    {
-        throw codeg::CompileError("else : scope error (else must be placed in a valid conditional scope)");
-    }
-
-    if ( data._scopes.top()._stat != codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE )
-    {
-        throw codeg::CompileError("else : scope error (else must be placed after a conditional keyword)");
-    }
-
-    data._jumps._jumpPoints.push_back({"%%E"+std::to_string(data._scopes.top()._id), data._code.getCursor()});
-    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_JMPSRC_CLK);
-
-    if ( !data._jumps.addLabel({"%%F"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
-    {
-        throw codeg::CompileError("else : label error (label \"%%F"+std::to_string(data._scopes.top()._id)+"\" already exist)");
-    }
-
-    data._scopes.top()._stat = codeg::ScopeStats::SCOPE_CONDITIONAL_FALSE;
-}
-
-///Instruction_ifnot
-Instruction_ifnot::Instruction_ifnot(){}
-Instruction_ifnot::~Instruction_ifnot(){}
-
-std::string Instruction_ifnot::getName() const
-{
-    return "if_not";
-}
-
-void Instruction_ifnot::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("if_not : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argValue;
-    if ( argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        if (argValue._valueSize != 1)
-        {
-            throw codeg::CompileError("if_not : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
-        }
-    }
-    else
-    {//Possibly a variable
-        if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
-        {
-            argValue._variable->_link.push_back(data._code.getCursor());
-
-            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-            data._code.push(0x00);
-        }
-        else
-        {
-            throw codeg::CompileError("if_not : bad argument (argument 1 \""+argValue._str+"\" is not a value)");
-        }
-    }
-    /*
-    2 jump points must be created in order to work properly :
-        - At the false condition, label named %%Fn where n is the scope
-        - At the end of the condition, label named %%En where n is the scope
-    if there is no "else" keyword, the label %%Fn will be the end of the condition
-    */
-
-    data._scopes.newScope(codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE, data._reader.getlineCount(), data._reader.getPath()); //New scope
-
-    data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
-    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-    data._code.push(0x00);
-
-
-    data._code.push(codeg::OPCODE_IFNOT | argValue._valueBus);
-    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
-    {
-        data._code.push(argValue._value);
-    }
-    else
-    {
-        data._code.pushDummy();
-    }
-
-    data._code.push(codeg::OPCODE_JMPSRC_CLK);
-}
-
-///Instruction_end
-Instruction_end::Instruction_end(){}
-Instruction_end::~Instruction_end(){}
-
-std::string Instruction_end::getName() const
-{
-    return "end";
-}
-
-void Instruction_end::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 1 )
-    {//Check size
-        throw codeg::CompileError("end : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    if ( data._scopes.empty() )
-    {
-        throw codeg::CompileError("end : scope error ('end' must be placed to end a scope)");
-    }
-
-    //Ending a scope
-    switch ( data._scopes.top()._stat )
-    {
-    case codeg::ScopeStats::SCOPE_FUNCTION:
-        //Ending a function
-        if ( !data._jumps.addLabel({"%%E"+data._actualFunctionName, 0, data._code.getCursor()}) )
-        {
-            throw codeg::CompileError("end : label error (label \"%%E"+data._actualFunctionName+"\" already exist)");
-        }
-        data._actualFunctionName.clear();
-        break;
-    case codeg::ScopeStats::SCOPE_CONDITIONAL_FALSE:
-        //Ending a conditional scope with the "else" keyword
-        if ( !data._jumps.addLabel({"%%E"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
-        {
-            throw codeg::CompileError("end : label error (label \"%%E"+std::to_string(data._scopes.top()._id)+"\" already exist)");
-        }
-        break;
-    case codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE:
-        //Ending a conditional scope without the "else" keyword
-        if ( !data._jumps.addLabel({"%%F"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
-        {
-            throw codeg::CompileError("end : label error (label \"%%F"+std::to_string(data._scopes.top()._id)+"\" already exist)");
-        }
-        if ( !data._jumps.addLabel({"%%E"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
-        {
-            throw codeg::CompileError("end : label error (label \"%%E"+std::to_string(data._scopes.top()._id)+"\" already exist)");
-        }
-        break;
-    default:
-        throw codeg::FatalError("Bad scope stat !");
-        break;
-    }
-
-    data._scopes.pop();
-}
-
-///Instruction_call
-Instruction_call::Instruction_call(){}
-Instruction_call::~Instruction_call(){}
-
-std::string Instruction_call::getName() const
-{
-    return "call";
-}
-
-void Instruction_call::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() == 5 )
-    {//call a function
-        codeg::Keyword argName;
-        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {
-            throw codeg::CompileError("call : bad argument (argument 1 \""+argName._str+"\" is not a name)");
-        }
-        codeg::Function* func = data._functions.get(argName._str);
-        if ( func == nullptr )
-        {
-            throw codeg::CompileError("call : bad function (unknown function \""+argName._str+"\")");
-        }
-        if ( func->isDefinition() )
-        {
-            throw codeg::CompileError("call : bad function (can't call a definition with return address)");
-        }
-
-        codeg::Keyword argVar1;
-        if ( !argVar1.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
-        {
-            throw codeg::CompileError("call : bad argument (argument 2 \""+argVar1._str+"\" is not a valid variable)");
-        }
-        codeg::Keyword argVar2;
-        if ( !argVar2.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
-        {
-            throw codeg::CompileError("call : bad argument (argument 3 \""+argVar2._str+"\" is not a valid variable)");
-        }
-        codeg::Keyword argVar3;
-        if ( !argVar3.process(input._keywords[4], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
-        {
-            throw codeg::CompileError("call : bad argument (argument 4 \""+argVar3._str+"\" is not a valid variable)");
-        }
-
-        //Prepare return address
-        uint32_t returnAddress = data._code.getCursor() + 25;
-
-        argVar1._variable->_link.push_back(data._code.getCursor()); //MSB
-        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
-        data._code.push((returnAddress&0x00FF0000)>>16);
-
-        argVar2._variable->_link.push_back(data._code.getCursor()); //MSB
-        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
-        data._code.push((returnAddress&0x0000FF00)>>8);
-
-        argVar3._variable->_link.push_back(data._code.getCursor()); //MSB
-        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
-        data._code.push(returnAddress&0x000000FF);
-
-        codeg::JumpPoint tmpPoint;
-        tmpPoint._addressStatic = data._code.getCursor();
-        tmpPoint._labelName = "%%"+argName._str;
-
-        if ( !data._jumps.addJumpPoint(tmpPoint) )
-        {
-            throw codeg::CompileError("call : bad label (unknown label \"%%"+argName._str+"\")");
-        }
-        data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
-        data._code.push(0x00);
-        data._code.push(codeg::OPCODE_JMPSRC_CLK);
-    }
-    else if ( input._keywords.size() == 2 )
-    {//call a definition
-        codeg::Keyword argName;
-        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-        {
-            throw codeg::CompileError("call : bad argument (argument 1 \""+argName._str+"\" is not a name)");
-        }
-        codeg::Function* func = data._functions.get(argName._str);
-        if ( func == nullptr )
-        {
-            throw codeg::CompileError("call : bad definition (unknown definition \""+argName._str+"\")");
-        }
-        if ( !func->isDefinition() )
-        {
-            throw codeg::CompileError("call : bad definition (\""+argName._str+"\" is not a definition)");
-        }
-
-        data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_definition(func)) );
-    }
-    else
-    {
-        throw codeg::CompileError("call : bad arguments size (wanted 5 or 2 got "+std::to_string(input._keywords.size())+")");
-    }
-}
-
-///Instruction_clock
-Instruction_clock::Instruction_clock(){}
-Instruction_clock::~Instruction_clock(){}
-
-std::string Instruction_clock::getName() const
-{
-    return "clock";
-}
-
-void Instruction_clock::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( (input._keywords.size() != 2) && (input._keywords.size() != 3) )
-    {//Check size
-        throw codeg::CompileError("clock : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argTarget;
-    if ( !argTarget.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_TARGET, data) )
-    {
-        throw codeg::CompileError("clock : bad argument (argument 1 [target] is not a valid target)");
-    }
-
-    uint8_t targetOpcode;
-    switch (argTarget._target)
-    {
-    case codeg::TARGET_PERIPHERAL:
-        targetOpcode = codeg::OPCODE_PERIPHERAL_CLK;
-        break;
-    case codeg::TARGET_SPI:
-        targetOpcode = codeg::OPCODE_SPI_CLK;
-        break;
-    default:
-        throw codeg::CompileError("clock : bad argument (argument 1 [target] is not a valid target)");
-        break;
-    }
-
-    if (input._keywords.size() == 3)
-    {
-        codeg::Keyword argValue;
-        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A value
-            for (uint32_t i=0; i<argValue._value; ++i)
-            {
-                data._code.push(targetOpcode | codeg::READABLE_DEFAULT);
-                data._code.pushDummy();
-            }
-        }
-        else
-        {
-            throw codeg::CompileError("clock : bad argument (argument 2 [value] is not valid constant value)");
-        }
-    }
-    else
-    {
-        data._code.push(targetOpcode | codeg::READABLE_DEFAULT);
-        data._code.pushDummy();
-    }
-}
-
-///Instruction_pool
-Instruction_pool::Instruction_pool(){}
-Instruction_pool::~Instruction_pool(){}
-
-std::string Instruction_pool::getName() const
-{
-    return "pool";
-}
-
-void Instruction_pool::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( (input._keywords.size() != 3) && (input._keywords.size() != 4) )
-    {//Check size
-        throw codeg::CompileError("pool : bad arguments size (wanted 3-4 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argName;
-    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-    {//A name
-        throw codeg::CompileError("pool : bad argument (argument 1 [name] is not a name)");
-    }
-
-    codeg::Keyword argSize;
-    if ( !argSize.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-    {//A value
-        throw codeg::CompileError("pool : bad argument (argument 2 [value] is not a value)");
-    }
-    if ( !argSize._valueIsConst )
-    {
-        throw codeg::CompileError("pool : bad value (argument 2 [value] must be a valid constant value)");
-    }
-
-    codeg::Keyword argStart;
-    bool isDynamic = true;
-    if (input._keywords.size() == 4)
-    {
-        if ( !argStart.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
-        {//A value
-            throw codeg::CompileError("pool : bad argument (argument 3 [value] is not a value)");
-        }
-        if ( !argStart._valueIsConst )
-        {
-            throw codeg::CompileError("pool : bad value (argument 3 [value] must be a valid constant value)");
-        }
-        isDynamic = false;
-    }
-
-    if ( codeg::Pool* tmpPool = data._pools.getPool(argName._str) )
-    {//Pool already exist
-        codeg::ConsoleWarningWrite("Warning : pool \""+argName._str+"\" already exist and will be replaced !");
-
-        if (isDynamic)
-        {
-            tmpPool->setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
-            tmpPool->setAddress(argStart._value, argSize._value);
-        }
-        else
-        {
-            tmpPool->setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC);
-            tmpPool->setAddress(argStart._value, argSize._value);
-        }
-    }
-    else
-    {//Pool must be created
-        codeg::Pool tmpNewPool(argName._str);
-
-        if (isDynamic)
-        {
-            tmpNewPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
-            tmpNewPool.setAddress(argStart._value, argSize._value);
-        }
-        else
-        {
-            tmpNewPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC);
-            tmpNewPool.setAddress(argStart._value, argSize._value);
-        }
-
-        if ( !data._pools.addPool(tmpNewPool) )
-        {
-            throw codeg::CompileError("pool : bad pool (pool \""+argName._str+"\" already exist)");
-        }
-    }
-}
-
-///Instruction_import
-Instruction_import::Instruction_import(){}
-Instruction_import::~Instruction_import(){}
-
-std::string Instruction_import::getName() const
-{
-    return "import";
-}
-
-void Instruction_import::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("import : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    std::string path = data._relativePath + input._keywords[1];
-
-    if ( !data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_file(path)) ) )
-    {
-        throw codeg::CompileError("import : can't open the file : "+path+")");
-    }
-}
-
-///Instruction_definition
-Instruction_definition::Instruction_definition(){}
-Instruction_definition::~Instruction_definition(){}
-
-std::string Instruction_definition::getName() const
-{
-    return "definition";
-}
-
-void Instruction_definition::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 2 )
-    {//Check size
-        throw codeg::CompileError("definition : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    codeg::Keyword argName;
-    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
-    {
-        throw codeg::CompileError("definition : bad argument (argument 1 [name] bad name)");
-    }
-
-    if ( data._functions.get(argName._str) != nullptr )
-    {
-        throw codeg::CompileError("definition : bad definition (definition/function \""+argName._str+"\" already exist)");
-    }
-
-    if ( data._scopes.size() )
-    {
-        throw codeg::CompileError("definition : definition error (can't create a definition in a scope)");
-    }
-
-    data._scopes.newScope(codeg::ScopeStats::SCOPE_DEFINITION, data._reader.getlineCount(), data._reader.getPath()); //New scope
-
-    data._actualFunctionName = argName._str;
-    data._functions.push(argName._str, true);
-
-    data._writeLinesIntoDefinition = true;
-}
-///Instruction_enddef
-Instruction_enddef::Instruction_enddef(){}
-Instruction_enddef::~Instruction_enddef(){}
-
-std::string Instruction_enddef::getName() const
-{
-    return "end_def";
-}
-
-void Instruction_enddef::compile( [[maybe_unused]] const codeg::StringDecomposer& input, [[maybe_unused]] codeg::CompilerData& data)
-{
-    throw codeg::CompileError("end_def : 'end_def' can only be placed to end a definition scope");
-}
-void Instruction_enddef::compileDefinition(const codeg::StringDecomposer& input, codeg::CompilerData& data)
-{
-    if ( input._keywords.size() != 1 )
-    {//Check size
-        throw codeg::CompileError("end_def : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
-    }
-
-    //Ending the definition
-    data._writeLinesIntoDefinition = false;
-    data._actualFunctionName.clear();
-
-    data._scopes.pop();
-}
-
-}//end codeg
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_compilerData.hpp"
+#include "C_console.hpp"
+#include "C_keyword.hpp"
+#include "C_bus.hpp"
+#include "C_error.hpp"
+#include <set>
+#include <algorithm>
+
+namespace codeg
+{
+
+const char* ReadableStringBinaryOpcodes[]=
+{
+    "BWRITE1_CLK",
+    "BWRITE2_CLK",
+
+    "BPCS_CLK",
+
+    "OPLEFT_CLK",
+    "OPRIGHT_CLK",
+    "OPCHOOSE_CLK",
+
+    "PERIPHERAL_CLK",
+
+    "BJMPSRC1_CLK",
+    "BJMPSRC2_CLK",
+    "BJMPSRC3_CLK",
+    "JMPSRC_CLK",
+
+    "BRAMADD1_CLK",
+    "BRAMADD2_CLK",
+
+    "SPI_CLK",
+    "BCFG_SPI_CLK",
+
+    "STICK",
+
+    "IF",
+    "IFNOT",
+
+    "RAMW",
+
+    "UOP",
+    "UOP",
+    "UOP",
+    "UOP",
+
+    "LTICK"
+};
+
+const uint8_t OpcodeCycles[]=
+{//GP8B : every instruction take 1 cycle (a skipped instruction too), the long tick wait is not included
+    1, 1, //BWRITE1_CLK, BWRITE2_CLK
+    1, //BPCS_CLK
+    1, 1, 1, //OPLEFT_CLK, OPRIGHT_CLK, OPCHOOSE_CLK
+    1, //PERIPHERAL_CLK
+    1, 1, 1, 1, //BJMPSRC1_CLK, BJMPSRC2_CLK, BJMPSRC3_CLK, JMPSRC_CLK
+    1, 1, //BRAMADD1_CLK, BRAMADD2_CLK
+    1, 1, //SPI_CLK, BCFG_SPI_CLK
+    1, //STICK
+    1, 1, //IF, IFNOT
+    1, //RAMW
+    1, 1, 1, 1, //UOP
+    1 //LTICK
+};
+
+///Instruction
+
+void Instruction::compileDefinition(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    data._functions.getLast()->addLine(input._cleaned);
+}
+
+///InstructionList
+
+void InstructionList::clear()
+{
+    this->g_data.clear();
+}
+
+void InstructionList::push(codeg::Instruction* newInstruction)
+{
+    this->g_data.push_front( std::unique_ptr<codeg::Instruction>(newInstruction) );
+}
+codeg::Instruction* InstructionList::get(const std::string& name) const
+{
+    for (auto& valPtr : this->g_data)
+    {
+        if (valPtr.get()->getName() == name)
+        {
+            return valPtr.get();
+        }
+    }
+    return nullptr;
+}
+
+void InstructionList::pushDefaultInstructions()
+{
+    this->push(new codeg::Instruction_set());
+    this->push(new codeg::Instruction_unset());
+    this->push(new codeg::Instruction_var());
+    this->push(new codeg::Instruction_label());
+    this->push(new codeg::Instruction_jump());
+    this->push(new codeg::Instruction_restart());
+    this->push(new codeg::Instruction_affect());
+    this->push(new codeg::Instruction_get());
+    this->push(new codeg::Instruction_write());
+    this->push(new codeg::Instruction_choose());
+    this->push(new codeg::Instruction_do());
+    this->push(new codeg::Instruction_tick());
+    this->push(new codeg::Instruction_brut());
+    this->push(new codeg::Instruction_function());
+    this->push(new codeg::Instruction_if());
+    this->push(new codeg::Instruction_else());
+    this->push(new codeg::Instruction_ifnot());
+    this->push(new codeg::Instruction_end());
+    this->push(new codeg::Instruction_call());
+    this->push(new codeg::Instruction_clock());
+    this->push(new codeg::Instruction_pool());
+    this->push(new codeg::Instruction_import());
+    this->push(new codeg::Instruction_definition());
+    this->push(new codeg::Instruction_enddef());
+    this->push(new codeg::Instruction_repeat());
+    this->push(new codeg::Instruction_switch());
+    this->push(new codeg::Instruction_case());
+    this->push(new codeg::Instruction_default());
+    this->push(new codeg::Instruction_wcet());
+}
+
+///Instruction_set
+Instruction_set::Instruction_set(){}
+Instruction_set::~Instruction_set(){}
+
+std::string Instruction_set::getName() const
+{
+    return "set";
+}
+
+void Instruction_set::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 3 )
+    {//Check size
+        throw codeg::CompileError("set : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
+    {//Check name
+        throw codeg::CompileError("set : bad argument (argument 1 [string] must be a valid string)");
+    }
+
+    codeg::Keyword argString;
+    if ( !argString.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_STRING, data) )
+    {//Check string
+        throw codeg::CompileError("set : bad argument (argument 2 [string] must be a valid string)");
+    }
+
+    if ( data._macros.check(argName._str) )
+    {//Check if already set
+        data._macros.set(argName._str, argString._str);
+        codeg::ConsoleWarningWrite("[warning] set : macro \""+ argName._str +"\" already exist and will be replaced");
+    }
+    else
+    {
+        data._macros.set(argName._str, argString._str);
+    }
+}
+
+///Instruction_unset
+Instruction_unset::Instruction_unset(){}
+Instruction_unset::~Instruction_unset(){}
+
+std::string Instruction_unset::getName() const
+{
+    return "unset";
+}
+
+void Instruction_unset::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("unset : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
+    {//Check name
+        throw codeg::CompileError("unset : bad argument (argument 1 [string] must be a valid string)");
+    }
+
+    data._macros.remove(argName._str);
+}
+
+///Instruction_var
+Instruction_var::Instruction_var(){}
+Instruction_var::~Instruction_var(){}
+
+std::string Instruction_var::getName() const
+{
+    return "var";
+}
+
+void Instruction_var::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() == 3 )
+    {//Check size
+        codeg::Keyword argVarName;
+        if ( !argVarName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check var name
+            throw codeg::CompileError("var : bad argument (argument 1 [name] must be a valid name)");
+        }
+
+        codeg::Keyword argPoolName;
+        if ( !argPoolName.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check pool name
+            throw codeg::CompileError("var : bad argument (argument 2 [name] must be a valid name)");
+        }
+
+        if ( codeg::Pool* tmpPool = data._pools.getPool(argPoolName._str) )
+        {//Check pool
+            if ( !tmpPool->addVariable( {argVarName._str, std::list<codeg::Address>(), std::list<codeg::Address>()} ) )
+            {
+                codeg::ConsoleWrite("[warning] var : variable \""+argVarName._str+"\" already exist in pool \""+argPoolName._str+"\"");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("var : bad pool (argument 2 \""+argPoolName._str+"\" the pool does not exist)");
+        }
+
+        return;
+    }
+
+    if ( input._keywords.size() == 2 )
+    {//Check size
+        codeg::Keyword argVarName;
+        if ( !argVarName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check var name
+            throw codeg::CompileError("var : bad argument (argument 1 [name] must be a valid name)");
+        }
+
+        if ( codeg::Pool* tmpPool = data._pools.getPool(data._defaultPool) )
+        {//Check pool
+            if ( !tmpPool->addVariable( {argVarName._str, std::list<codeg::Address>(), std::list<codeg::Address>()} ) )
+            {
+                codeg::ConsoleWrite("[warning] var : variable \""+argVarName._str+"\" already exist in pool \""+data._defaultPool+"\"");
+            }
+        }
+        else
+        {
+            throw codeg::FatalError("the default pool appear to not be created");
+        }
+
+        return;
+    }
+
+    throw codeg::CompileError("var : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
+}
+
+///Instruction_label
+Instruction_label::Instruction_label(){}
+Instruction_label::~Instruction_label(){}
+
+std::string Instruction_label::getName() const
+{
+    return "label";
+}
+
+void Instruction_label::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    if ( input._keywords.size() == 2 )
+    {//Label name with determined cursor address
+        codeg::Keyword argName;
+        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check label name
+            throw codeg::CompileError("label : bad argument (argument 1 [name] must be a valid name)");
+        }
+
+        codeg::Label tmpLabel;
+        tmpLabel._addressStatic = data._code.getCursor();
+        tmpLabel._uniqueIndex = 0;
+        tmpLabel._name = argName._str;
+
+        if ( !data._jumps.addLabel(tmpLabel) )
+        {//Check name
+            throw codeg::CompileError("label : bad label (label "+argName._str+" already exist)");
+        }
+    }
+    else if ( input._keywords.size() == 3 )
+    {//Label name with fixed address
+        codeg::Keyword argName;
+        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check label name
+            throw codeg::CompileError("label : bad argument (argument 1 [name] must be a valid name)");
+        }
+        codeg::Keyword argValue;
+        if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//Check const value
+            throw codeg::CompileError("label : bad argument (argument 2 [value] must be a valid constant value)");
+        }
+        if ( !argValue._valueIsConst )
+        {
+            throw codeg::CompileError("label : bad argument (argument 2 [value] must be a valid constant value)");
+        }
+
+        codeg::Label tmpLabel;
+        tmpLabel._addressStatic = argValue._value;
+        tmpLabel._uniqueIndex = 0;
+        tmpLabel._name = argName._str;
+
+        if ( !data._jumps.addLabel(tmpLabel) )
+        {//Check name
+            throw codeg::CompileError("label : bad label (label "+argName._str+" already exist)");
+        }
+        data._relocatableCode = false; //A fixed address can't follow the code
+    }
+    else
+    {
+        throw codeg::CompileError("label : bad arguments size (wanted 2 or 3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._aluState.clear(); //A label can be reached from anywhere
+    data._dataflow.clear();
+}
+
+///Instruction_jump
+Instruction_jump::Instruction_jump(){}
+Instruction_jump::~Instruction_jump(){}
+
+std::string Instruction_jump::getName() const
+{
+    return "jump";
+}
+
+void Instruction_jump::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    if ( input._keywords.size() == 2 )
+    {//Label name or fixed address
+        codeg::Keyword arg1;
+        if ( arg1.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Check label name
+            codeg::JumpPoint tmpPoint;
+            tmpPoint._addressStatic = data._code.getCursor();
+            tmpPoint._labelName = arg1._str;
+
+            if ( !data._jumps.addJumpPoint(tmpPoint) )
+            {
+                throw codeg::CompileError("jump : bad label (unknown label \""+arg1._str+"\")");
+            }
+
+            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_JMPSRC_CLK);
+        }
+        else if ( arg1._type == codeg::KeywordTypes::KEYWORD_VALUE )
+        {//Check constant value
+            if ( arg1._valueSize <= 3 )
+            {
+                uint32_t address = arg1._value;
+                if (address != 0)
+                {//Only the start of the program can't be moved
+                    data._relocatableCode = false;
+                }
+
+                data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+                data._code.push( (address&0x00FF0000)>>16 );
+                data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+                data._code.push( (address&0x0000FF00)>>8 );
+                data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+                data._code.push( address&0x000000FF );
+                data._code.push(codeg::OPCODE_JMPSRC_CLK);
+            }
+            else
+            {
+                throw codeg::CompileError("jump : bad size (argument 1 [value] byte size must be <= 3)");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("jump : bad argument (argument 1 [name]/[value] must be a valid name or constant value)");
+        }
+    }
+    else if ( input._keywords.size() == 4 )
+    {//3 separate values or variables
+        codeg::Keyword arg1;
+        if ( arg1.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A constant value
+            if ( arg1._valueSize == 1 )
+            {
+                data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+                data._code.push( arg1._value );
+            }
+            else
+            {
+                throw codeg::CompileError("jump : bad size (argument 1 [value] byte size must be == 1)");
+            }
+        }
+        else if ( arg1._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+        {//A variable
+            arg1._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_RAM);
+            data._code.pushDummy();
+        }
+        else
+        {
+            throw codeg::CompileError("jump : bad argument (argument 1 [value] must be a valid value)");
+        }
+
+        codeg::Keyword arg2;
+        if ( arg2.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A constant value
+            if ( arg2._valueSize == 1 )
+            {
+                data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+                data._code.push( arg2._value );
+            }
+            else
+            {
+                throw codeg::CompileError("jump : bad size (argument 2 [value] byte size must be == 1)");
+            }
+        }
+        else if ( arg2._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+        {//A variable
+            arg2._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_RAM);
+            data._code.pushDummy();
+        }
+        else
+        {
+            throw codeg::CompileError("jump : bad argument (argument 2 [value] must be a valid value)");
+        }
+
+        codeg::Keyword arg3;
+        if ( arg3.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A constant value
+            if ( arg3._valueSize == 1 )
+            {
+                data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+                data._code.push( arg3._value );
+            }
+            else
+            {
+                throw codeg::CompileError("jump : bad size (argument 3 [value] byte size must be == 1)");
+            }
+        }
+        else if ( arg3._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+        {//A variable
+            arg3._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_RAM);
+            data._code.pushDummy();
+        }
+        else
+        {
+            throw codeg::CompileError("jump : bad argument (argument 3 [value] must be a valid value)");
+        }
+
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+    }
+    else
+    {//Bad size
+        throw codeg::CompileError("jump : bad arguments size (wanted 2 or 4 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._dataflow.setUnreachable(); //The next instruction can only be reached with a label
+}
+
+///Instruction_restart
+Instruction_restart::Instruction_restart(){}
+Instruction_restart::~Instruction_restart(){}
+
+std::string Instruction_restart::getName() const
+{
+    return "restart";
+}
+
+void Instruction_restart::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 1 )
+    {//Check size
+        throw codeg::CompileError("restart : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    data._dataflow.setUnreachable(); //The next instruction can only be reached with a label
+}
+
+///Instruction_affect
+Instruction_affect::Instruction_affect(){}
+Instruction_affect::~Instruction_affect(){}
+
+std::string Instruction_affect::getName() const
+{
+    return "affect";
+}
+
+void Instruction_affect::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() == 3 )
+    {//fixed specified address or variable
+        codeg::Keyword argVar;
+        if ( argVar.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+        {//Variable
+            codeg::Keyword argValue;
+            if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+            {//A value
+                if ( !argValue._valueIsVariable )
+                {
+                    if (argValue._valueSize != 1)
+                    {
+                        throw codeg::CompileError("affect : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+                    }
+
+                    argVar._variable->_link.push_back(data._code.getCursor());
+
+                    data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                    data._code.push(0x00);
+                    data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                    data._code.push(0x00);
+
+                    data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
+                    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+                    {
+                        data._code.push(argValue._value);
+                    }
+                    else
+                    {
+                        data._code.pushDummy();
+                    }
+
+                    if ( (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE) ||
+                         (argValue._valueBus == codeg::ReadableBusses::READABLE_RESULT) )
+                    {//The variable now hold a known value
+                        data._dataflow.set(argVar._variable, argValue._valueBus, argValue._value);
+                    }
+                    else
+                    {
+                        data._dataflow.remove(argVar._variable);
+                    }
+                }
+                else
+                {//A variable
+                    throw codeg::CompileError("affect : can't copy (for now) a variable in another variable");
+                }
+            }
+            else
+            {
+                throw codeg::CompileError("affect : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
+            }
+        }
+        else if ( argVar._type == codeg::KeywordTypes::KEYWORD_CONSTANT )
+        {//Constant
+            if ( argVar._valueSize > 2 )
+            {
+                throw codeg::CompileError("affect : bad constant (require size is <= 2 byte got \""+std::to_string(argVar._valueSize)+"\")");
+            }
+
+            codeg::Keyword argValue;
+            if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+            {//A value
+                if ( !argValue._valueIsVariable )
+                {
+                    if (argValue._valueSize != 1)
+                    {
+                        throw codeg::CompileError("affect : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+                    }
+
+                    data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                    data._code.push((argVar._value&0xFF00)>>8);
+                    data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                    data._code.push(argVar._value&0x00FF);
+
+                    data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
+                    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+                    {
+                        data._code.push(argValue._value);
+                    }
+                    else
+                    {
+                        data._code.pushDummy();
+                    }
+
+                    data._dataflow.clear(); //The address can be the one of any variable
+                }
+                else
+                {//A variable
+                    throw codeg::CompileError("affect : can't copy (for now) a variable in another variable");
+                }
+            }
+            else
+            {
+                throw codeg::CompileError("affect : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("affect : bad argument (argument 1 [variable]/[constant] must be valid)");
+        }
+    }
+    else if ( input._keywords.size() >= 4 )
+    {//fixed size pool
+        codeg::Keyword argPoolName;
+        if ( argPoolName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Pool name
+            codeg::Pool* pool = data._pools.getPool(argPoolName._str);
+            if (!pool)
+            {
+                throw codeg::CompileError("affect : bad argument (unknown pool : \""+argPoolName._str+"\")");
+            }
+            if ( pool->getMaxSize() == 0 )
+            {
+                throw codeg::CompileError("affect : bad argument (pool must have a fixed size)");
+            }
+
+            codeg::Keyword argOffset;
+            if ( argOffset.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_CONSTANT, data) )
+            {//Offset
+                if (argOffset._valueSize > 2)
+                {
+                    throw codeg::CompileError("affect : bad argument (argument 2 [constant] must have a byte size of <= 2)");
+                }
+
+                codeg::Address offset = argOffset._value;
+                unsigned int numOfValue = input._keywords.size() - 3;
+                if ( (numOfValue+offset) > pool->getMaxSize())
+                {
+                    throw codeg::CompileError("affect : pool overflow (try to affect "+std::to_string(numOfValue)+" values with offset "+std::to_string(offset)+" but the max size is "+std::to_string(pool->getMaxSize())+")");
+                }
+
+                for (unsigned int i=0; i<numOfValue; ++i)
+                {
+                    codeg::Keyword argValue;
+                    if ( argValue.process(input._keywords[i+3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+                    {//Value
+                        if (argValue._valueSize != 1)
+                        {
+                            throw codeg::CompileError("affect : bad argument (argument "+std::to_string(i+3)+" [value] must have a byte size of 1)");
+                        }
+
+                        pool->_link.push_back({data._code.getCursor(), i+offset});
+
+                        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                        data._code.push(0x00);
+                        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                        data._code.push(0x00);
+
+                        data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
+                        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+                        {
+                            data._code.push(argValue._value);
+                        }
+                        else
+                        {
+                            data._code.pushDummy();
+                        }
+                    }
+                    else if ( argValue._valueIsVariable )
+                    {
+                        throw codeg::CompileError("affect : can't copy a variable in another location in memory");
+                    }
+                    else
+                    {
+                        throw codeg::CompileError("affect : bad argument (argument "+std::to_string(i+3)+" [value] must be a valid value)");
+                    }
+                }
+
+                data._dataflow.clear(); //The pool can share addresses with variables
+            }
+            else
+            {
+                throw codeg::CompileError("affect : bad argument (argument 2 [constant] must be a valid constant)");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("affect : bad argument (argument 1 [name] must be a valid name)");
+        }
+    }
+    else
+    {
+        throw codeg::CompileError("affect : bad arguments size (wanted 3 or 4 got "+std::to_string(input._keywords.size())+")");
+    }
+}
+
+///Instruction_get
+Instruction_get::Instruction_get(){}
+Instruction_get::~Instruction_get(){}
+
+std::string Instruction_get::getName() const
+{
+    return "get";
+}
+
+void Instruction_get::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() == 2 )
+    {//fixed specified address or variable
+        codeg::Keyword argVar;
+        if ( argVar.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+        {//Variable
+            argVar._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+        }
+        else if ( argVar._type == codeg::KeywordTypes::KEYWORD_CONSTANT )
+        {//Constant
+            if ( argVar._valueSize > 2 )
+            {
+                throw codeg::CompileError("get : bad constant (require size is <= 2 byte got \""+std::to_string(argVar._valueSize)+"\")");
+            }
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push((argVar._value&0xFF00)>>8);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(argVar._value&0x00FF);
+        }
+        else
+        {
+            throw codeg::CompileError("get : bad argument (argument 1 [variable]/[constant] must be valid)");
+        }
+    }
+    else if ( input._keywords.size() == 3 )
+    {//fixed size pool
+        codeg::Keyword argPoolName;
+        if ( argPoolName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {//Pool name
+            codeg::Pool* pool = data._pools.getPool(argPoolName._str);
+            if (!pool)
+            {
+                throw codeg::CompileError("get : bad argument (unknown pool : \""+argPoolName._str+"\")");
+            }
+            if ( pool->getMaxSize() == 0 )
+            {
+                throw codeg::CompileError("get : bad argument (pool must have a fixed size)");
+            }
+
+            codeg::Keyword argOffset;
+            if ( argOffset.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_CONSTANT, data) )
+            {//Offset
+                if (argOffset._valueSize > 2)
+                {
+                    throw codeg::CompileError("get : bad argument (argument 2 [constant] must have a byte size of <= 2)");
+                }
+
+                codeg::Address offset = argOffset._value;
+                if (offset >= pool->getMaxSize())
+                {
+                    throw codeg::CompileError("get : pool overflow (try to get value at offset "+std::to_string(offset)+" but the max size is "+std::to_string(pool->getMaxSize())+")");
+                }
+
+                pool->_link.push_back({data._code.getCursor(), offset});
+
+                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+            }
+            else
+            {
+                throw codeg::CompileError("get : bad argument (argument 2 [constant] must be a valid constant)");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("get : bad argument (argument 1 [name] must be a valid name)");
+        }
+    }
+    else
+    {
+        throw codeg::CompileError("get : bad arguments size (wanted 2 or 3 got "+std::to_string(input._keywords.size())+")");
+    }
+}
+
+///Instruction_write
+Instruction_write::Instruction_write(){}
+Instruction_write::~Instruction_write(){}
+
+std::string Instruction_write::getName() const
+{
+    return "write";
+}
+
+void Instruction_write::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 3 )
+    {//Check size
+        throw codeg::CompileError("write : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argBus;
+    if ( argBus.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_BUS, data) )
+    {//A bus
+        codeg::Keyword argValue;
+        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+        {//A value
+            if (argValue._valueSize != 1)
+            {
+                throw codeg::CompileError("write : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+            }
+        }
+        else
+        {//Possibly a variable
+            if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+            {
+                argValue._variable->_link.push_back(data._code.getCursor());
+
+                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+            }
+            else
+            {
+                throw codeg::CompileError("write : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
+            }
+        }
+
+        switch ( argBus._value )
+        {
+        case codeg::BUS_NULL:
+            throw codeg::CompileError("write : bad bus (bus can't be null)");
+            break;
+
+        case codeg::BUS_WRITEABLE_1:
+            data._code.push(codeg::OPCODE_BWRITE1_CLK | argValue._valueBus);
+            break;
+        case codeg::BUS_WRITEABLE_2:
+            data._code.push(codeg::OPCODE_BWRITE2_CLK | argValue._valueBus);
+            break;
+        case codeg::BUS_SPICFG:
+            data._code.push(codeg::OPCODE_BCFG_SPI_CLK | argValue._valueBus);
+            break;
+
+        default:
+            throw codeg::CompileError("write : bad bus (unknown bus)");
+            break;
+        }
+
+        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+        {
+            data._code.push(argValue._value);
+        }
+        else
+        {
+            data._code.pushDummy();
+        }
+    }
+    else
+    {
+        throw codeg::CompileError("write : bad argument (argument 1 \""+argBus._str+"\" is not a bus");
+    }
+}
+
+///Instruction_choose
+Instruction_choose::Instruction_choose(){}
+Instruction_choose::~Instruction_choose(){}
+
+std::string Instruction_choose::getName() const
+{
+    return "choose";
+}
+
+void Instruction_choose::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 3 )
+    {//Check size
+        throw codeg::CompileError("choose : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argTarget;
+    if ( argTarget.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_TARGET, data) )
+    {//A target
+        codeg::Keyword argValue;
+        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+        {//A value
+            if (argValue._valueSize != 1)
+            {
+                throw codeg::CompileError("choose : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+            }
+        }
+        else
+        {//Possibly a variable
+            if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+            {
+                argValue._variable->_link.push_back(data._code.getCursor());
+
+                data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+                data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+                data._code.push(0x00);
+            }
+            else
+            {
+                throw codeg::CompileError("choose : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
+            }
+        }
+
+        switch ( argTarget._target )
+        {
+        case codeg::TargetType::TARGET_OPERATION:
+            data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+            data._aluState.setOperation(data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1 &&
+                                        argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE, argValue._value);
+            data._code.push(codeg::OPCODE_OPCHOOSE_CLK | argValue._valueBus);
+            data._dataflow.removeBus(codeg::ReadableBusses::READABLE_RESULT);
+            break;
+        case codeg::TargetType::TARGET_PERIPHERAL:
+            data._code.push(codeg::OPCODE_BPCS_CLK | argValue._valueBus);
+            break;
+
+        default:
+            throw codeg::CompileError("choose : bad target (unknown target)");
+            break;
+        }
+
+        if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+        {
+            data._code.push(argValue._value);
+        }
+        else
+        {
+            data._code.pushDummy();
+        }
+    }
+    else
+    {
+        throw codeg::CompileError("choose : bad argument (argument 1 \""+argTarget._str+"\" is not a target)");
+    }
+}
+
+///Instruction_do
+Instruction_do::Instruction_do(){}
+Instruction_do::~Instruction_do(){}
+
+std::string Instruction_do::getName() const
+{
+    return "do";
+}
+
+void Instruction_do::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 4 )
+    {//Check size
+        throw codeg::CompileError("do : bad arguments size (wanted 4 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    /*
+    The 3 ALU latches are always written, so a pending operation is overwritten here.
+    The latches are updated one by one, a "_result" argument sees the latches written before it.
+    */
+    bool fold = data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1;
+    data._aluState.discard();
+
+    ///LEFT
+    codeg::Keyword argValueLeft;
+    if ( argValueLeft.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValueLeft.forwardVariable(data) )
+    {//A value
+        if (argValueLeft._valueSize != 1)
+        {
+            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueLeft._valueSize)+"\")");
+        }
+    }
+    else if ( argValueLeft._type != codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {//Not a variable
+        throw codeg::CompileError("do : bad argument (argument 1 \""+argValueLeft._str+"\" is not a value)");
+    }
+    fold = fold && (argValueLeft._valueBus == codeg::ReadableBusses::READABLE_SOURCE);
+    data._aluState.setLeft(fold, argValueLeft._value);
+
+    data._dataflow.removeBus(codeg::ReadableBusses::READABLE_RESULT); //The result change with the next latches
+
+    ///OPERATION
+    codeg::Keyword argValueOp;
+    if ( argValueOp.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValueOp.forwardVariable(data) )
+    {//A value
+        if (argValueOp._valueSize != 1)
+        {
+            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueOp._valueSize)+"\")");
+        }
+    }
+    else if ( argValueOp._type != codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {//Not a variable
+        throw codeg::CompileError("do : bad argument (argument 2 \""+argValueOp._str+"\" is not a value)");
+    }
+    fold = fold && (argValueOp._valueBus == codeg::ReadableBusses::READABLE_SOURCE);
+    data._aluState.setOperation(fold, argValueOp._value);
+
+    ///RIGHT
+    codeg::Keyword argValueRight;
+    if ( argValueRight.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValueRight.forwardVariable(data) )
+    {//A value
+        if (argValueRight._valueSize != 1)
+        {
+            throw codeg::CompileError("do : bad value (require size is 1 byte got \""+std::to_string(argValueRight._valueSize)+"\")");
+        }
+    }
+    else if ( argValueRight._type != codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {//Not a variable
+        throw codeg::CompileError("do : bad argument (argument 3 \""+argValueRight._str+"\" is not a value)");
+    }
+    fold = fold && (argValueRight._valueBus == codeg::ReadableBusses::READABLE_SOURCE);
+    data._aluState.setRight(fold, argValueRight._value);
+
+    uint8_t result;
+    if ( fold && data._aluState.getResult(data._alu, result) )
+    {//Constant folding, the operation is emitted only if the latches are observed
+        data._aluState.setPending(true);
+        return;
+    }
+
+    ///LEFT
+    if ( argValueLeft._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {
+        argValueLeft._variable->_link.push_back(data._code.getCursor());
+
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+    }
+    data._code.push(codeg::OPCODE_OPLEFT_CLK | argValueLeft._valueBus);
+    if (argValueLeft._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValueLeft._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+
+    ///OPERATION
+    if ( argValueOp._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {
+        argValueOp._variable->_link.push_back(data._code.getCursor());
+
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+    }
+    data._code.push(codeg::OPCODE_OPCHOOSE_CLK | argValueOp._valueBus);
+    if (argValueOp._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValueOp._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+
+    ///RIGHT
+    if ( argValueRight._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {
+        argValueRight._variable->_link.push_back(data._code.getCursor());
+
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+    }
+    data._code.push(codeg::OPCODE_OPRIGHT_CLK | argValueRight._valueBus);
+    if (argValueRight._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValueRight._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+}
+
+///Instruction_tick
+static void PushDelay(codeg::CompilerData& data, uint8_t opcode, uint32_t count, bool exact, const std::string& description)
+{
+    /*
+    Push "count" times the opcode, as a countdown loop when it is smaller :
+        OPCHOOSE -, OPRIGHT 1, OPLEFT K+1, BJMPSRC3/2/1 (setup)
+        label : "body" times the opcode, OPLEFT _result, IFNOT _result, JMPSRC (K times)
+        "remainder" times the opcode
+    When exact, the instructions of the loop are part of the delay (the opcode must take 1 cycle).
+    */
+    uint32_t opSize = data._code.getWriteDummy() ? 2 : 1;
+    uint32_t setupCycles = 3*ToOpcodeCycles(codeg::OPCODE_OPLEFT_CLK) + 3*ToOpcodeCycles(codeg::OPCODE_BJMPSRC1_CLK);
+    uint32_t loopCycles = ToOpcodeCycles(codeg::OPCODE_OPLEFT_CLK) + ToOpcodeCycles(codeg::OPCODE_IFNOT) + ToOpcodeCycles(codeg::OPCODE_JMPSRC_CLK);
+
+    uint32_t bestBody = 0;
+    uint32_t bestIterations = 0;
+    uint32_t bestRemainder = count;
+
+    if ( (count >= codeg::DelayCosts::DELAY_MIN_COUNT) && (!exact || (count >= setupCycles+loopCycles)) )
+    {
+        uint32_t delay = exact ? (count - setupCycles) : count; //Delay of the loop and the remainder
+        uint32_t overhead = exact ? loopCycles : 0; //Delay of the loop instructions
+        uint32_t minBody = (delay/(codeg::DelayCosts::DELAY_MAX_ITERATIONS+1) + 1 > overhead) ? (delay/(codeg::DelayCosts::DELAY_MAX_ITERATIONS+1) + 1 - overhead) : 0;
+        minBody = std::max<uint32_t>(minBody, exact ? 0 : 1);
+
+        for (uint32_t body=minBody; body<minBody+codeg::DelayCosts::DELAY_BODY_SEARCH; ++body)
+        {
+            uint32_t iterations = delay/(body+overhead);
+            uint32_t remainder = delay - iterations*(body+overhead);
+            if ( (iterations > 0) && (body+remainder < bestBody+bestRemainder) )
+            {
+                bestBody = body;
+                bestIterations = iterations;
+                bestRemainder = remainder;
+            }
+        }
+    }
+
+    uint32_t loopSize = 6*2 + (bestBody+bestRemainder+2)*opSize + 1;
+    if ( (bestIterations == 0) || (loopSize >= count*opSize) )
+    {//Unrolled
+        for (uint32_t i=0; i<count; ++i)
+        {
+            data._code.push(opcode | codeg::READABLE_DEFAULT);
+            data._code.pushDummy();
+        }
+        return;
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches are modified
+
+    std::string label = "%%K"+std::to_string(data._code.getCursor());
+    data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x01); //-
+    data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x01);
+    data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_SOURCE);
+    data._code.push((bestIterations+1) & 0xFF);
+
+    data._jumps._jumpPoints.push_back({label, data._code.getCursor()});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+
+    if ( !data._jumps.addLabel({label, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("delay : label error (label \""+label+"\" already exist)");
+    }
+    for (uint32_t i=0; i<bestBody; ++i)
+    {
+        data._code.push(opcode | codeg::READABLE_DEFAULT);
+        data._code.pushDummy();
+    }
+    data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_RESULT);
+    data._code.pushDummy();
+    data._code.push(codeg::OPCODE_IFNOT | codeg::READABLE_RESULT);
+    data._code.pushDummy();
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    for (uint32_t i=0; i<bestRemainder; ++i)
+    {
+        data._code.push(opcode | codeg::READABLE_DEFAULT);
+        data._code.pushDummy();
+    }
+
+    //The loop is left with the counter at 0 (1 - 1)
+    data._aluState.setLeft(true, 0x01);
+    data._aluState.setOperation(true, 0x01);
+    data._aluState.setRight(true, 0x01);
+    data._dataflow.removeBus(codeg::ReadableBusses::READABLE_RESULT);
+
+    uint32_t cycles = setupCycles + bestIterations*(bestBody*ToOpcodeCycles(opcode) + loopCycles) + bestRemainder*ToOpcodeCycles(opcode);
+    data._delays.push_back({description, data._reader.getPath(), data._reader.getlineCount(), count, cycles, exact});
+    data._loopBounds.push_back({label, bestIterations, bestIterations});
+}
+
+Instruction_tick::Instruction_tick(){}
+Instruction_tick::~Instruction_tick(){}
+
+std::string Instruction_tick::getName() const
+{
+    return "tick";
+}
+
+void Instruction_tick::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( (input._keywords.size() != 2) && (input._keywords.size() != 3) )
+    {//Check size
+        throw codeg::CompileError("tick : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argStr;
+    if ( argStr.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
+    {//A string
+        if (argStr._str == "simple")
+        {
+            if ( input._keywords.size() == 3 )
+            {//Check size
+                codeg::Keyword argValue;
+                if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+                {
+                    if ( !argValue._valueIsConst )
+                    {
+                        throw codeg::CompileError("tick : bad argument (argument 2 [value] must be a valid constant value)");
+                    }
+                }
+                codeg::PushDelay(data, codeg::OPCODE_STICK, argValue._value, true, "tick simple "+std::to_string(argValue._value));
+            }
+            else
+            {
+                data._code.push(codeg::OPCODE_STICK | codeg::READABLE_DEFAULT);
+                data._code.pushDummy();
+            }
+        }
+        else if (argStr._str == "long")
+        {
+            if ( input._keywords.size() == 3 )
+            {//Check size
+                codeg::Keyword argValue;
+                if ( !argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+                {
+                    if ( !argValue._valueIsConst )
+                    {
+                        throw codeg::CompileError("tick : bad argument (argument 2 [value] must be a valid constant value)");
+                    }
+                }
+                codeg::PushDelay(data, codeg::OPCODE_LTICK, argValue._value, false, "tick long "+std::to_string(argValue._value));
+            }
+            else
+            {
+                data._code.push(codeg::OPCODE_LTICK | codeg::READABLE_DEFAULT);
+                data._code.pushDummy();
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("tick : bad argument (argument 1 [string] must be \"long\" or \"simple\")");
+        }
+    }
+    else
+    {
+        throw codeg::CompileError("tick : bad string (argument 1 is not a string)");
+    }
+}
+
+///Instruction_brut
+Instruction_brut::Instruction_brut(){}
+Instruction_brut::~Instruction_brut(){}
+
+std::string Instruction_brut::getName() const
+{
+    return "brut";
+}
+
+void Instruction_brut::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() <= 1 )
+    {//Check size
+        throw codeg::CompileError("tick : bad arguments size (wanted >1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    codeg::Keyword argValue;
+
+    for (uint32_t i=1; i<input._keywords.size(); ++i)
+    {
+        if ( argValue.process(input._keywords[i], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A value
+            if ( argValue._valueIsConst )
+            {
+                if ( argValue._valueSize == 1 )
+                {
+                    data._code.push(argValue._value);
+                }
+                else
+                {
+                    throw codeg::CompileError("brut : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+                }
+            }
+            else
+            {
+                throw codeg::CompileError("brut : bad value (argument "+std::to_string(i)+" \""+argValue._str+"\" is not a valid constant value)");
+            }
+        }
+        else
+        {
+            throw codeg::CompileError("brut : bad argument (argument "+std::to_string(i)+" [value] is not a value)");
+        }
+    }
+
+    data._aluState.clear(); //Unknown instructions
+    data._dataflow.clear();
+    data._relocatableCode = false;
+}
+
+///Instruction_function
+Instruction_function::Instruction_function(){}
+Instruction_function::~Instruction_function(){}
+
+std::string Instruction_function::getName() const
+{
+    return "function";
+}
+
+void Instruction_function::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( (input._keywords.size() != 2) && (input._keywords.size() != 3) )
+    {//Check size
+        throw codeg::CompileError("function : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+    {
+        throw codeg::CompileError("function : bad argument (argument 1 [name] bad name)");
+    }
+
+    codeg::InlineHints hint = codeg::InlineHints::INLINE_HINT_NONE;
+    if ( input._keywords.size() == 3 )
+    {
+        if ( input._keywords[2] == "inline" )
+        {
+            hint = codeg::InlineHints::INLINE_HINT_ALWAYS;
+        }
+        else if ( input._keywords[2] == "noinline" )
+        {
+            hint = codeg::InlineHints::INLINE_HINT_NEVER;
+        }
+        else
+        {
+            throw codeg::CompileError("function : bad argument (argument 2 [hint] must be \"inline\" or \"noinline\")");
+        }
+    }
+
+    if ( data._functions.get(argName._str) != nullptr )
+    {
+        throw codeg::CompileError("function : bad function (function \""+argName._str+"\" already exist)");
+    }
+
+    if ( !data._actualFunctionName.empty() )
+    {
+        throw codeg::CompileError("function : function error (can't create a function in a function)");
+    }
+    if ( data._scopes.size() )
+    {
+        throw codeg::CompileError("function : function error (can't create a function in a scope)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_FUNCTION, data._reader.getlineCount(), data._reader.getPath()); //New scope
+    data._scopes.top()._dataflow = data._dataflow; //The end of the function is reached by jumping over it
+
+    data._actualFunctionName = argName._str;
+    data._functions.push(argName._str);
+    data._functions.getLast()->setInlineHint(hint);
+
+    data._recordedFunction = data._functions.getLast(); //Keep the lines for inlining
+    data._recordedFunctionLevel = data._reader.getSize();
+
+    data._jumps._jumpPoints.push_back({"%%E"+argName._str, data._code.getCursor()}); //Jump to the end of the function
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    if ( !data._jumps.addLabel({"%%"+argName._str, 0, data._code.getCursor()}) )
+    {//Label to the start of the function
+        throw codeg::CompileError("function : label error (label \"%%"+argName._str+"\" already exist)");
+    }
+    data._aluState.clear(); //A label can be reached from anywhere
+    data._dataflow.clear();
+}
+
+///Instruction_if
+Instruction_if::Instruction_if(){}
+Instruction_if::~Instruction_if(){}
+
+std::string Instruction_if::getName() const
+{
+    return "if";
+}
+
+void Instruction_if::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("if : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    codeg::Keyword argValue;
+    if ( argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+    {//A value
+        if (argValue._valueSize != 1)
+        {
+            throw codeg::CompileError("if : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+        }
+    }
+    else
+    {//Possibly a variable
+        if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+        {
+            argValue._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+        }
+        else
+        {
+            throw codeg::CompileError("if : bad argument (argument 1 \""+argValue._str+"\" is not a value)");
+        }
+    }
+    /*
+    2 jump points must be created in order to work properly :
+        - At the false condition, label named %%Fn where n is the scope
+        - At the end of the condition, label named %%En where n is the scope
+    if there is no "else" keyword, the label %%Fn will be the end of the condition
+    */
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE, data._reader.getlineCount(), data._reader.getPath()); //New scope
+    data._scopes.top()._dataflow = data._dataflow; //State of the false path
+
+    if ( (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1) &&
+         (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE) )
+    {//The condition is known, the flow is unconditional
+        ++data._foldedConditions;
+
+        if (argValue._value != 0)
+        {//Always true, the false path is never taken
+            data._scopes.top()._dataflow.setUnreachable();
+        }
+        else
+        {//Always false, jumping directly to the false path
+            data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
+            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+            data._dataflow.setUnreachable();
+        }
+        return;
+    }
+
+    data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+
+
+    data._code.push(codeg::OPCODE_IF | argValue._valueBus);
+    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValue._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    if (argValue._variable != nullptr)
+    {//The variable is 0 in the false path
+        data._scopes.top()._dataflow.set(argValue._variable, codeg::ReadableBusses::READABLE_SOURCE, 0);
+    }
+}
+
+///Instruction_else
+Instruction_else::Instruction_else(){}
+Instruction_else::~Instruction_else(){}
+
+std::string Instruction_else::getName() const
+{
+    return "else";
+}
+
+void Instruction_else::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 1 )
+    {//Check size
+        throw codeg::CompileError("else : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    if ( data._scopes.empty() )
+    {
+        throw codeg::CompileError("else : scope error (else must be placed in a valid conditional scope)");
+    }
+
+    if ( data._scopes.top()._stat != codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE )
+    {
+        throw codeg::CompileError("else : scope error (else must be placed after a conditional keyword)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    data._jumps._jumpPoints.push_back({"%%E"+std::to_string(data._scopes.top()._id), data._code.getCursor()});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    if ( !data._jumps.addLabel({"%%F"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("else : label error (label \"%%F"+std::to_string(data._scopes.top()._id)+"\" already exist)");
+    }
+
+    data._scopes.top()._stat = codeg::ScopeStats::SCOPE_CONDITIONAL_FALSE;
+    data._aluState.clear(); //A label can be reached from anywhere
+    std::swap(data._dataflow, data._scopes.top()._dataflow); //Starting the false path, keeping the true path state
+}
+
+///Instruction_ifnot
+Instruction_ifnot::Instruction_ifnot(){}
+Instruction_ifnot::~Instruction_ifnot(){}
+
+std::string Instruction_ifnot::getName() const
+{
+    return "if_not";
+}
+
+void Instruction_ifnot::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("if_not : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    codeg::Keyword argValue;
+    if ( argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+    {//A value
+        if (argValue._valueSize != 1)
+        {
+            throw codeg::CompileError("if_not : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+        }
+    }
+    else
+    {//Possibly a variable
+        if ( argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE )
+        {
+            argValue._variable->_link.push_back(data._code.getCursor());
+
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+        }
+        else
+        {
+            throw codeg::CompileError("if_not : bad argument (argument 1 \""+argValue._str+"\" is not a value)");
+        }
+    }
+    /*
+    2 jump points must be created in order to work properly :
+        - At the false condition, label named %%Fn where n is the scope
+        - At the end of the condition, label named %%En where n is the scope
+    if there is no "else" keyword, the label %%Fn will be the end of the condition
+    */
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE, data._reader.getlineCount(), data._reader.getPath()); //New scope
+    data._scopes.top()._dataflow = data._dataflow; //State of the false path
+
+    if ( (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1) &&
+         (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE) )
+    {//The condition is known, the flow is unconditional
+        ++data._foldedConditions;
+
+        if (argValue._value == 0)
+        {//Always true, the false path is never taken
+            data._scopes.top()._dataflow.setUnreachable();
+        }
+        else
+        {//Always false, jumping directly to the false path
+            data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
+            data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+            data._dataflow.setUnreachable();
+        }
+        return;
+    }
+
+    data._jumps._jumpPoints.push_back({"%%F"+std::to_string(data._scopes.getScopeCount()), data._code.getCursor()});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+
+
+    data._code.push(codeg::OPCODE_IFNOT | argValue._valueBus);
+    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValue._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    if (argValue._variable != nullptr)
+    {//The variable is 0 in the true path
+        data._dataflow.set(argValue._variable, codeg::ReadableBusses::READABLE_SOURCE, 0);
+    }
+}
+
+///Instruction_end
+static bool GetRepeatLines(const codeg::Repeat& repeat, const std::string& labelSuffix, codeg::Function::FunctionLinesType& lines)
+{
+    codeg::StringDecomposer decomposer;
+
+    ///Checking the lines
+    std::set<std::string> labels;
+    for (auto&& vLine : repeat._lines)
+    {
+        decomposer.decompose(vLine);
+        if ( decomposer._keywords.empty() )
+        {
+            continue;
+        }
+
+        const std::string& instruction = decomposer._keywords[0];
+        if ( (instruction != "affect") && (instruction != "get") && (instruction != "write") &&
+             (instruction != "choose") && (instruction != "do") && (instruction != "tick") &&
+             (instruction != "clock") && (instruction != "if") && (instruction != "if_not") &&
+             (instruction != "else") && (instruction != "end") && (instruction != "jump") &&
+             (instruction != "restart") && (instruction != "call") && (instruction != "label") &&
+             (instruction != "repeat") && (instruction != "switch") && (instruction != "case") &&
+             (instruction != "default") )
+        {//Declarations and unknown instructions are not duplicated
+            return false;
+        }
+
+        if (instruction == "label")
+        {
+            if (decomposer._keywords.size() != 2)
+            {//Fixed address
+                return false;
+            }
+            labels.insert(decomposer._keywords[1]);
+        }
+
+        for (std::size_t i=1; i<decomposer._keywords.size(); ++i)
+        {
+            if (decomposer._keywords[i] == repeat._counterKeyword)
+            {//The counter is used, the loop is needed
+                return false;
+            }
+        }
+    }
+
+    ///Renaming the labels
+    for (auto&& vLine : repeat._lines)
+    {
+        decomposer.decompose(vLine);
+
+        if ( (decomposer._keywords.size() == 2) &&
+             ((decomposer._keywords[0] == "label") || (decomposer._keywords[0] == "jump")) &&
+             (labels.find(decomposer._keywords[1]) != labels.end()) )
+        {
+            lines.push_back(decomposer._keywords[0]+" "+decomposer._keywords[1]+labelSuffix);
+        }
+        else
+        {
+            lines.push_back(vLine);
+        }
+    }
+
+    return true;
+}
+static void ChooseRepeatStrategy(codeg::Repeat& repeat, uint32_t bodySize, uint32_t bodyCycles, const codeg::CompilerData& data)
+{
+    if ( !repeat._constant || (data._optimization < codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2) )
+    {
+        return;
+    }
+
+    uint32_t count = repeat._count;
+    const uint32_t loopSize = bodySize + codeg::RepeatCosts::REPEAT_COST_LOOP_SIZE;
+    const uint64_t loopCycles = static_cast<uint64_t>(count) * (bodyCycles + codeg::RepeatCosts::REPEAT_COST_LOOP_CYCLES);
+
+    uint32_t bestSize = loopSize;
+    uint64_t bestCycles = loopCycles;
+    for (uint32_t copies=2; copies<=count; ++copies)
+    {
+        bool unrolled = (copies == count);
+        uint32_t remainder = unrolled ? 0 : (count % copies);
+        uint32_t size = unrolled ? count*bodySize : (copies+remainder)*bodySize + codeg::RepeatCosts::REPEAT_COST_LOOP_SIZE;
+        uint64_t cycles = static_cast<uint64_t>(count)*bodyCycles + (unrolled ? 0 : (count/copies)*codeg::RepeatCosts::REPEAT_COST_LOOP_CYCLES);
+
+        bool better;
+        if ( data._policy == codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SIZE )
+        {
+            better = (size < bestSize) || ((size == bestSize) && (cycles < bestCycles));
+        }
+        else
+        {
+            int64_t addedBytes = static_cast<int64_t>(size) - static_cast<int64_t>(loopSize);
+            int64_t savedCycles = static_cast<int64_t>(loopCycles - cycles);
+            better = (size <= codeg::RepeatCosts::REPEAT_COST_MAX_SIZE) &&
+                     (addedBytes <= savedCycles*codeg::RepeatCosts::REPEAT_COST_BYTES_PER_CYCLE) &&
+                     ((cycles < bestCycles) || ((cycles == bestCycles) && (size < bestSize)));
+        }
+
+        if (better)
+        {
+            bestSize = size;
+            bestCycles = cycles;
+            repeat._loopCopies = copies;
+            repeat._remainderCopies = remainder;
+            repeat._unrolled = unrolled;
+        }
+    }
+}
+static bool EndRepeat(codeg::CompilerData& data)
+{
+    codeg::Repeat& repeat = data._repeats.back();
+    std::string scopeId = std::to_string(repeat._scopeId);
+
+    if ( !repeat._duplicated )
+    {//End of the first copy
+        codeg::Function::FunctionLinesType copy;
+        if ( GetRepeatLines(repeat, "", copy) )
+        {
+            uint32_t bodySize = data._code.getCursor() - repeat._bodyStart;
+            ChooseRepeatStrategy(repeat, bodySize, data._code.getInstructionCount(repeat._bodyStart, data._code.getCursor()), data);
+        }
+
+        if (repeat._loopCopies > 1)
+        {//The other copies of the body are compiled before the real end
+            codeg::Function::FunctionLinesType lines;
+            for (uint32_t i=1; i<repeat._loopCopies; ++i)
+            {
+                GetRepeatLines(repeat, "%%U"+scopeId+"_"+std::to_string(i), lines);
+            }
+            lines.push_back("end");
+
+            repeat._duplicated = true;
+            data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_repeat(lines, data._scopes.top()._startLine)) );
+            return false;
+        }
+    }
+
+    if ( !repeat._unrolled )
+    {//Decrementing the counter and jumping to the start of the body
+        repeat._counter->_link.push_back(data._code.getCursor());
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_RAM);
+        data._code.pushDummy();
+        data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x01);
+        data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x01);
+
+        repeat._counter->_link.push_back(data._code.getCursor());
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_RESULT);
+        data._code.pushDummy();
+
+        data._jumps._jumpPoints.push_back({"%%L"+scopeId, data._code.getCursor()});
+        data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_IFNOT | codeg::READABLE_RESULT);
+        data._code.pushDummy();
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+        data._aluState.setLeft(false);
+        data._aluState.setOperation(true, 0x01);
+        data._aluState.setRight(true, 0x01);
+
+        data._dataflow.removeBus(codeg::ReadableBusses::READABLE_RESULT);
+        data._dataflow.set(repeat._counter, codeg::ReadableBusses::READABLE_SOURCE, 0); //The loop is left when the counter is 0
+
+        if (repeat._loopCopies > 1)
+        {//The loop body is unrolled
+            data._code.set(repeat._countIndex, repeat._count/repeat._loopCopies);
+        }
+
+        if (repeat._constant)
+        {
+            uint32_t iterations = repeat._count/repeat._loopCopies;
+            data._loopBounds.push_back({"%%L"+scopeId, iterations, iterations});
+        }
+        else
+        {//The counter is a byte
+            data._loopBounds.push_back({"%%L"+scopeId, 1, 0xFF});
+        }
+    }
+
+    if ( !repeat._constant )
+    {//Skipped code when the count is 0
+        if ( !data._jumps.addLabel({"%%E"+scopeId, 0, data._code.getCursor()}) )
+        {
+            throw codeg::CompileError("end : label error (label \"%%E"+scopeId+"\" already exist)");
+        }
+    }
+
+    if (repeat._remainderCopies > 0)
+    {//The remaining copies are placed after the loop
+        codeg::Function::FunctionLinesType lines;
+        for (uint32_t i=repeat._loopCopies; i<static_cast<uint32_t>(repeat._loopCopies)+repeat._remainderCopies; ++i)
+        {
+            GetRepeatLines(repeat, "%%U"+scopeId+"_"+std::to_string(i), lines);
+        }
+        data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_repeat(lines, data._scopes.top()._startLine)) );
+    }
+
+    data._repeats.pop_back();
+    return true;
+}
+
+static void PushSwitchJump(codeg::CompilerData& data, const std::string& label, uint8_t condition=0)
+{//Jump to a label, with a condition (OPCODE_IF or OPCODE_IFNOT on the ALU result) if not 0
+    data._jumps._jumpPoints.push_back({label, data._code.getCursor()});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    if (condition != 0)
+    {
+        data._code.push(condition | codeg::READABLE_RESULT);
+        data._code.pushDummy();
+    }
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+}
+static void PushSwitchTable(codeg::CompilerData& data, const codeg::Switch& sw, const std::vector<uint8_t>& values, const std::string& defaultLabel)
+{
+    std::string scopeId = std::to_string(sw._scopeId);
+    uint32_t range = static_cast<uint32_t>(values.back()) - values.front() + 1;
+
+    if (values.front() != 0)
+    {//Index of the entry
+        data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x01); //-
+        data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+        data._code.push(values.front());
+        data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_RESULT);
+        data._code.pushDummy();
+    }
+
+    //Out of the table (a lower value give a big index)
+    data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x0B); //<
+    data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+    data._code.push(range);
+    codeg::PushSwitchJump(data, defaultLabel, codeg::OPCODE_IF);
+
+    //Address of the entry, the table start at the beginning of a page
+    data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x09); //<<
+    data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x03);
+
+    data._jumps._jumpPoints.push_back({"%%J"+scopeId, data._code.getCursor(), codeg::JumpPointTypes::JUMP_POINT_BYTE_MSB});
+    data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._jumps._jumpPoints.push_back({"%%J"+scopeId, data._code.getCursor(), codeg::JumpPointTypes::JUMP_POINT_BYTE_MID});
+    data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_RESULT);
+    data._code.pushDummy();
+    data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+    ///Jump table
+    codeg::Address paddingStart = data._code.getCursor();
+    while ( (data._code.getCursor() & 0xFF) != 0 )
+    {
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+    }
+    if ( !data._jumps.addLabel({"%%J"+scopeId, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("end : label error (label \"%%J"+scopeId+"\" already exist)");
+    }
+    for (uint32_t i=0; i<range; ++i)
+    {//8 bytes by entry
+        uint8_t value = static_cast<uint8_t>(values.front() + i);
+        bool found = std::find(values.begin(), values.end(), value) != values.end();
+        codeg::PushSwitchJump(data, found ? ("%%C"+scopeId+"_"+std::to_string(value)) : defaultLabel);
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+    }
+    data._jumps._jumpTables.push_back({"%%J"+scopeId, paddingStart, range});
+}
+static void PushSwitchTree(codeg::CompilerData& data, const codeg::Switch& sw, const std::vector<uint8_t>& values,
+                           std::size_t begin, std::size_t end, const std::string& defaultLabel, int& operation, uint32_t& nodeCount)
+{
+    std::string scopeId = std::to_string(sw._scopeId);
+    auto choose = [&](uint8_t value)
+    {//The operation is kept by the ALU
+        if (operation != value)
+        {
+            data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+            data._code.push(value);
+            operation = value;
+        }
+    };
+
+    if (end - begin <= codeg::SwitchCosts::SWITCH_TREE_LEAF_SIZE)
+    {//Testing every remaining case
+        for (std::size_t i=begin; i<end; ++i)
+        {
+            choose(0x0E); //==
+            data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+            data._code.push(values[i]);
+            codeg::PushSwitchJump(data, "%%C"+scopeId+"_"+std::to_string(values[i]), codeg::OPCODE_IFNOT);
+        }
+        codeg::PushSwitchJump(data, defaultLabel);
+        return;
+    }
+
+    std::size_t middle = (begin + end)/2;
+    std::string nodeLabel = "%%T"+scopeId+"_"+std::to_string(nodeCount++);
+
+    choose(0x0B); //<
+    data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+    data._code.push(values[middle]);
+    codeg::PushSwitchJump(data, nodeLabel, codeg::OPCODE_IFNOT);
+
+    codeg::PushSwitchTree(data, sw, values, middle, end, defaultLabel, operation, nodeCount);
+
+    if ( !data._jumps.addLabel({nodeLabel, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("end : label error (label \""+nodeLabel+"\" already exist)");
+    }
+    operation = 0x0B;
+    codeg::PushSwitchTree(data, sw, values, begin, middle, defaultLabel, operation, nodeCount);
+}
+static void EndSwitch(codeg::CompilerData& data)
+{
+    codeg::Switch& sw = data._switches.back();
+    std::string scopeId = std::to_string(sw._scopeId);
+    std::string defaultLabel = sw._default ? ("%%C"+scopeId+"_D") : ("%%E"+scopeId);
+
+    if ( data._dataflow.isReachable() )
+    {//End of the last case
+        codeg::PushSwitchJump(data, "%%E"+scopeId);
+    }
+
+    ///Dispatch
+    if ( !data._jumps.addLabel({"%%D"+scopeId, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("end : label error (label \"%%D"+scopeId+"\" already exist)");
+    }
+
+    std::vector<uint8_t> values = sw._cases;
+    std::sort(values.begin(), values.end());
+
+    if ( (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1) &&
+         (sw._variable == nullptr) && (sw._valueBus == codeg::ReadableBusses::READABLE_SOURCE) )
+    {//The value is known, the case is chosen now
+        ++data._foldedConditions;
+
+        bool found = std::find(values.begin(), values.end(), sw._value) != values.end();
+        codeg::PushSwitchJump(data, found ? ("%%C"+scopeId+"_"+std::to_string(sw._value)) : defaultLabel);
+    }
+    else if ( values.empty() )
+    {
+        codeg::PushSwitchJump(data, defaultLabel);
+    }
+    else
+    {
+        if (sw._variable != nullptr)
+        {
+            sw._variable->_link.push_back(data._code.getCursor());
+            data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+            data._code.push(0x00);
+            data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_RAM);
+            data._code.pushDummy();
+        }
+        else
+        {
+            data._code.push(codeg::OPCODE_OPLEFT_CLK | sw._valueBus);
+            if (sw._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+            {
+                data._code.push(sw._value);
+            }
+            else
+            {
+                data._code.pushDummy();
+            }
+        }
+
+        uint32_t range = static_cast<uint32_t>(values.back()) - values.front() + 1;
+        if ( (data._policy == codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SPEED) &&
+             (values.size() >= codeg::SwitchCosts::SWITCH_TABLE_MIN_CASES) &&
+             (range <= codeg::SwitchCosts::SWITCH_TABLE_MAX_ENTRIES) && (2*values.size() >= range) )
+        {//Dense cases, O(1) dispatch
+            codeg::PushSwitchTable(data, sw, values, defaultLabel);
+        }
+        else
+        {
+            int operation = -1;
+            uint32_t nodeCount = 0;
+            codeg::PushSwitchTree(data, sw, values, 0, values.size(), defaultLabel, operation, nodeCount);
+        }
+    }
+
+    if ( !data._jumps.addLabel({"%%E"+scopeId, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("end : label error (label \"%%E"+scopeId+"\" already exist)");
+    }
+
+    data._dataflow.clear(); //Every case can jump to the end
+    data._switches.pop_back();
+}
+
+Instruction_end::Instruction_end(){}
+Instruction_end::~Instruction_end(){}
+
+std::string Instruction_end::getName() const
+{
+    return "end";
+}
+
+void Instruction_end::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 1 )
+    {//Check size
+        throw codeg::CompileError("end : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    if ( data._scopes.empty() )
+    {
+        throw codeg::CompileError("end : scope error ('end' must be placed to end a scope)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    //Ending a scope
+    switch ( data._scopes.top()._stat )
+    {
+    case codeg::ScopeStats::SCOPE_FUNCTION:
+        //Ending a function
+        if ( !data._jumps.addLabel({"%%E"+data._actualFunctionName, 0, data._code.getCursor()}) )
+        {
+            throw codeg::CompileError("end : label error (label \"%%E"+data._actualFunctionName+"\" already exist)");
+        }
+        {
+            codeg::Function* func = data._functions.get(data._actualFunctionName);
+            std::list<codeg::Label>::iterator itStart = data._jumps.getLabel("%%"+data._actualFunctionName);
+            func->setCodeSize(data._code.getCursor() - itStart->_addressStatic);
+            func->setComplete(true);
+        }
+        data._recordedFunction = nullptr;
+        data._actualFunctionName.clear();
+        break;
+    case codeg::ScopeStats::SCOPE_CONDITIONAL_FALSE:
+        //Ending a conditional scope with the "else" keyword
+        if ( !data._jumps.addLabel({"%%E"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
+        {
+            throw codeg::CompileError("end : label error (label \"%%E"+std::to_string(data._scopes.top()._id)+"\" already exist)");
+        }
+        break;
+    case codeg::ScopeStats::SCOPE_REPEAT:
+        //Ending a repeat
+        if ( !codeg::EndRepeat(data) )
+        {//The copies of the code are compiled before the real end
+            return;
+        }
+        break;
+    case codeg::ScopeStats::SCOPE_SWITCH:
+        //Ending a switch, the dispatch is placed after the cases
+        codeg::EndSwitch(data);
+        break;
+    case codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE:
+        //Ending a conditional scope without the "else" keyword
+        if ( !data._jumps.addLabel({"%%F"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
+        {
+            throw codeg::CompileError("end : label error (label \"%%F"+std::to_string(data._scopes.top()._id)+"\" already exist)");
+        }
+        if ( !data._jumps.addLabel({"%%E"+std::to_string(data._scopes.top()._id), 0, data._code.getCursor()}) )
+        {
+            throw codeg::CompileError("end : label error (label \"%%E"+std::to_string(data._scopes.top()._id)+"\" already exist)");
+        }
+        break;
+    default:
+        throw codeg::FatalError("Bad scope stat !");
+        break;
+    }
+
+    data._dataflow.merge(data._scopes.top()._dataflow); //Joining the 2 paths
+    data._scopes.pop();
+    data._aluState.clear(); //A label can be reached from anywhere
+}
+
+///Instruction_call
+static bool IsWorthInlining(const codeg::Function& func, const codeg::CompilerData& data)
+{
+    if ( (data._optimization < codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1) || func.isInlining() ||
+         (func.getInlineHint() == codeg::InlineHints::INLINE_HINT_NEVER) )
+    {
+        return false;
+    }
+    if ( func.getInlineHint() == codeg::InlineHints::INLINE_HINT_ALWAYS )
+    {
+        return true;
+    }
+    if ( data._optimization < codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2 )
+    {
+        return false;
+    }
+
+    //The body replace the call and the return
+    int32_t addedBytes = static_cast<int32_t>(func.getCodeSize())
+                        - codeg::InlineCosts::INLINE_COST_RETURN_SIZE - codeg::InlineCosts::INLINE_COST_CALL_SIZE;
+
+    if ( data._policy == codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SIZE )
+    {
+        return addedBytes <= 0;
+    }
+    return addedBytes <= static_cast<int32_t>(codeg::InlineCosts::INLINE_COST_CALL_CYCLES*codeg::InlineCosts::INLINE_COST_BYTES_PER_CYCLE);
+}
+
+Instruction_call::Instruction_call(){}
+Instruction_call::~Instruction_call(){}
+
+std::string Instruction_call::getName() const
+{
+    return "call";
+}
+
+void Instruction_call::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() == 5 )
+    {//call a function
+        codeg::Keyword argName;
+        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {
+            throw codeg::CompileError("call : bad argument (argument 1 \""+argName._str+"\" is not a name)");
+        }
+        codeg::Function* func = data._functions.get(argName._str);
+        if ( func == nullptr )
+        {
+            throw codeg::CompileError("call : bad function (unknown function \""+argName._str+"\")");
+        }
+        if ( func->isDefinition() )
+        {
+            throw codeg::CompileError("call : bad function (can't call a definition with return address)");
+        }
+
+        codeg::Keyword argVar1;
+        if ( !argVar1.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+        {
+            throw codeg::CompileError("call : bad argument (argument 2 \""+argVar1._str+"\" is not a valid variable)");
+        }
+        codeg::Keyword argVar2;
+        if ( !argVar2.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+        {
+            throw codeg::CompileError("call : bad argument (argument 3 \""+argVar2._str+"\" is not a valid variable)");
+        }
+        codeg::Keyword argVar3;
+        if ( !argVar3.process(input._keywords[4], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+        {
+            throw codeg::CompileError("call : bad argument (argument 4 \""+argVar3._str+"\" is not a valid variable)");
+        }
+
+        if ( IsWorthInlining(*func, data) )
+        {//Compile the body of the function here
+            std::string returnVariables[3] = {input._keywords[2], input._keywords[3], input._keywords[4]};
+            codeg::Function::FunctionLinesType lines;
+
+            if ( func->getInlineLines(returnVariables, "%%I"+std::to_string(data._inlinedCalls+1), lines) )
+            {
+                ++data._inlinedCalls;
+                data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_inline(func, lines)) );
+                return;
+            }
+        }
+
+        data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+        //Prepare return address (resolved like a label, the code can be moved by the optimizer)
+        std::string returnLabel = "%%R"+std::to_string(data._code.getCursor() + 25);
+
+        argVar1._variable->_link.push_back(data._code.getCursor()); //MSB
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._jumps._jumpPoints.push_back({returnLabel, data._code.getCursor(), codeg::JumpPointTypes::JUMP_POINT_BYTE_MSB});
+        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+
+        argVar2._variable->_link.push_back(data._code.getCursor()); //MSB
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._jumps._jumpPoints.push_back({returnLabel, data._code.getCursor(), codeg::JumpPointTypes::JUMP_POINT_BYTE_MID});
+        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+
+        argVar3._variable->_link.push_back(data._code.getCursor()); //MSB
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._jumps._jumpPoints.push_back({returnLabel, data._code.getCursor(), codeg::JumpPointTypes::JUMP_POINT_BYTE_LSB});
+        data._code.push(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+
+        codeg::JumpPoint tmpPoint;
+        tmpPoint._addressStatic = data._code.getCursor();
+        tmpPoint._labelName = "%%"+argName._str;
+
+        if ( !data._jumps.addJumpPoint(tmpPoint) )
+        {
+            throw codeg::CompileError("call : bad label (unknown label \"%%"+argName._str+"\")");
+        }
+        data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+        if ( !data._jumps.addLabel({returnLabel, 0, data._code.getCursor()}) )
+        {//Return address label
+            throw codeg::CompileError("call : label error (label \""+returnLabel+"\" already exist)");
+        }
+
+        data._aluState.clear(); //The function can modify the latches
+        data._dataflow.clear(); //The function can modify any variable
+    }
+    else if ( input._keywords.size() == 2 )
+    {//call a definition
+        codeg::Keyword argName;
+        if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+        {
+            throw codeg::CompileError("call : bad argument (argument 1 \""+argName._str+"\" is not a name)");
+        }
+        codeg::Function* func = data._functions.get(argName._str);
+        if ( func == nullptr )
+        {
+            throw codeg::CompileError("call : bad definition (unknown definition \""+argName._str+"\")");
+        }
+        if ( !func->isDefinition() )
+        {
+            throw codeg::CompileError("call : bad definition (\""+argName._str+"\" is not a definition)");
+        }
+
+        data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_definition(func)) );
+    }
+    else
+    {
+        throw codeg::CompileError("call : bad arguments size (wanted 5 or 2 got "+std::to_string(input._keywords.size())+")");
+    }
+}
+
+///Instruction_clock
+Instruction_clock::Instruction_clock(){}
+Instruction_clock::~Instruction_clock(){}
+
+std::string Instruction_clock::getName() const
+{
+    return "clock";
+}
+
+void Instruction_clock::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( (input._keywords.size() != 2) && (input._keywords.size() != 3) )
+    {//Check size
+        throw codeg::CompileError("clock : bad arguments size (wanted 2-3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argTarget;
+    if ( !argTarget.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_TARGET, data) )
+    {
+        throw codeg::CompileError("clock : bad argument (argument 1 [target] is not a valid target)");
+    }
+
+    uint8_t targetOpcode;
+    switch (argTarget._target)
+    {
+    case codeg::TARGET_PERIPHERAL:
+        targetOpcode = codeg::OPCODE_PERIPHERAL_CLK;
+        break;
+    case codeg::TARGET_SPI:
+        targetOpcode = codeg::OPCODE_SPI_CLK;
+        break;
+    default:
+        throw codeg::CompileError("clock : bad argument (argument 1 [target] is not a valid target)");
+        break;
+    }
+
+    if (input._keywords.size() == 3)
+    {
+        codeg::Keyword argValue;
+        if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A value
+            codeg::PushDelay(data, targetOpcode, argValue._value, false, "clock "+input._keywords[1]+" "+std::to_string(argValue._value));
+        }
+        else
+        {
+            throw codeg::CompileError("clock : bad argument (argument 2 [value] is not valid constant value)");
+        }
+    }
+    else
+    {
+        data._code.push(targetOpcode | codeg::READABLE_DEFAULT);
+        data._code.pushDummy();
+    }
+}
+
+///Instruction_pool
+Instruction_pool::Instruction_pool(){}
+Instruction_pool::~Instruction_pool(){}
+
+std::string Instruction_pool::getName() const
+{
+    return "pool";
+}
+
+void Instruction_pool::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( (input._keywords.size() != 3) && (input._keywords.size() != 4) )
+    {//Check size
+        throw codeg::CompileError("pool : bad arguments size (wanted 3-4 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+    {//A name
+        throw codeg::CompileError("pool : bad argument (argument 1 [name] is not a name)");
+    }
+
+    codeg::Keyword argSize;
+    if ( !argSize.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+    {//A value
+        throw codeg::CompileError("pool : bad argument (argument 2 [value] is not a value)");
+    }
+    if ( !argSize._valueIsConst )
+    {
+        throw codeg::CompileError("pool : bad value (argument 2 [value] must be a valid constant value)");
+    }
+
+    codeg::Keyword argStart;
+    bool isDynamic = true;
+    if (input._keywords.size() == 4)
+    {
+        if ( !argStart.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) )
+        {//A value
+            throw codeg::CompileError("pool : bad argument (argument 3 [value] is not a value)");
+        }
+        if ( !argStart._valueIsConst )
+        {
+            throw codeg::CompileError("pool : bad value (argument 3 [value] must be a valid constant value)");
+        }
+        isDynamic = false;
+    }
+
+    if ( codeg::Pool* tmpPool = data._pools.getPool(argName._str) )
+    {//Pool already exist
+        codeg::ConsoleWarningWrite("Warning : pool \""+argName._str+"\" already exist and will be replaced !");
+
+        if (isDynamic)
+        {
+            tmpPool->setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+            tmpPool->setAddress(argStart._value, argSize._value);
+        }
+        else
+        {
+            tmpPool->setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC);
+            tmpPool->setAddress(argStart._value, argSize._value);
+        }
+    }
+    else
+    {//Pool must be created
+        codeg::Pool tmpNewPool(argName._str);
+
+        if (isDynamic)
+        {
+            tmpNewPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+            tmpNewPool.setAddress(argStart._value, argSize._value);
+        }
+        else
+        {
+            tmpNewPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC);
+            tmpNewPool.setAddress(argStart._value, argSize._value);
+        }
+
+        if ( !data._pools.addPool(tmpNewPool) )
+        {
+            throw codeg::CompileError("pool : bad pool (pool \""+argName._str+"\" already exist)");
+        }
+    }
+}
+
+///Instruction_import
+Instruction_import::Instruction_import(){}
+Instruction_import::~Instruction_import(){}
+
+std::string Instruction_import::getName() const
+{
+    return "import";
+}
+
+void Instruction_import::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("import : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    std::string path = data._relativePath + input._keywords[1];
+
+    if ( !data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_file(path)) ) )
+    {
+        throw codeg::CompileError("import : can't open the file : "+path+")");
+    }
+}
+
+///Instruction_definition
+Instruction_definition::Instruction_definition(){}
+Instruction_definition::~Instruction_definition(){}
+
+std::string Instruction_definition::getName() const
+{
+    return "definition";
+}
+
+void Instruction_definition::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("definition : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_NAME, data) )
+    {
+        throw codeg::CompileError("definition : bad argument (argument 1 [name] bad name)");
+    }
+
+    if ( data._functions.get(argName._str) != nullptr )
+    {
+        throw codeg::CompileError("definition : bad definition (definition/function \""+argName._str+"\" already exist)");
+    }
+
+    if ( data._scopes.size() )
+    {
+        throw codeg::CompileError("definition : definition error (can't create a definition in a scope)");
+    }
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_DEFINITION, data._reader.getlineCount(), data._reader.getPath()); //New scope
+
+    data._actualFunctionName = argName._str;
+    data._functions.push(argName._str, true);
+
+    data._writeLinesIntoDefinition = true;
+}
+///Instruction_enddef
+Instruction_enddef::Instruction_enddef(){}
+Instruction_enddef::~Instruction_enddef(){}
+
+std::string Instruction_enddef::getName() const
+{
+    return "end_def";
+}
+
+void Instruction_enddef::compile( [[maybe_unused]] const codeg::StringDecomposer& input, [[maybe_unused]] codeg::CompilerData& data)
+{
+    throw codeg::CompileError("end_def : 'end_def' can only be placed to end a definition scope");
+}
+void Instruction_enddef::compileDefinition(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 1 )
+    {//Check size
+        throw codeg::CompileError("end_def : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    //Ending the definition
+    data._writeLinesIntoDefinition = false;
+    data._actualFunctionName.clear();
+
+    data._scopes.pop();
+}
+
+///Instruction_repeat
+Instruction_repeat::Instruction_repeat(){}
+Instruction_repeat::~Instruction_repeat(){}
+
+std::string Instruction_repeat::getName() const
+{
+    return "repeat";
+}
+
+void Instruction_repeat::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 3 )
+    {//Check size
+        throw codeg::CompileError("repeat : bad arguments size (wanted 3 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argVar;
+    if ( !argVar.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VARIABLE, data) )
+    {//Check variable
+        throw codeg::CompileError("repeat : bad argument (argument 1 [variable] must be a valid variable)");
+    }
+
+    codeg::Keyword argValue;
+    if ( argValue.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+    {//A value
+        if (argValue._valueSize != 1)
+        {
+            throw codeg::CompileError("repeat : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+        }
+        if ( (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE) && (argValue._value == 0) )
+        {
+            throw codeg::CompileError("repeat : bad value (a constant count can't be 0)");
+        }
+    }
+    else if ( argValue._type != codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {
+        throw codeg::CompileError("repeat : bad argument (argument 2 \""+argValue._str+"\" is not a value)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    codeg::Repeat repeat;
+    repeat._counter = argVar._variable;
+    repeat._counterKeyword = input._keywords[1];
+    repeat._constant = (argValue._type == codeg::KeywordTypes::KEYWORD_VALUE) && (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE);
+    repeat._count = argValue._value;
+
+    ///Initializing the counter
+    if (argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE)
+    {//Copy of a variable with the ALU
+        argValue._variable->_link.push_back(data._code.getCursor());
+        data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_OPLEFT_CLK | codeg::READABLE_RAM);
+        data._code.pushDummy();
+        data._code.push(codeg::OPCODE_OPCHOOSE_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_OPRIGHT_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+
+        data._aluState.setLeft(false);
+        data._aluState.setOperation(true, 0x00);
+        data._aluState.setRight(true, 0x00);
+        data._dataflow.removeBus(codeg::ReadableBusses::READABLE_RESULT);
+
+        argValue._valueBus = codeg::ReadableBusses::READABLE_RESULT;
+    }
+
+    argVar._variable->_link.push_back(data._code.getCursor());
+    data._code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+    data._code.push(0x00);
+    data._code.push(codeg::OPCODE_RAMW | argValue._valueBus);
+    if (argValue._valueBus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        data._code.push(argValue._value);
+    }
+    else
+    {
+        data._code.pushDummy();
+    }
+    repeat._countIndex = data._code.getCursor()-1;
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_REPEAT, data._reader.getlineCount(), data._reader.getPath()); //New scope
+    repeat._scopeId = data._scopes.getScopeCount();
+    std::string scopeId = std::to_string(repeat._scopeId);
+
+    if (repeat._constant)
+    {//The loop is always entered
+        data._scopes.top()._dataflow.setUnreachable();
+    }
+    else
+    {//Skipping the code when the count is 0 (the RAM address is still the counter)
+        data._jumps._jumpPoints.push_back({"%%E"+scopeId, data._code.getCursor()});
+        data._code.push(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE);
+        data._code.push(0x00);
+        data._code.push(codeg::OPCODE_IF | codeg::READABLE_RAM);
+        data._code.pushDummy();
+        data._code.push(codeg::OPCODE_JMPSRC_CLK);
+
+        data._dataflow.remove(argVar._variable);
+        data._scopes.top()._dataflow = data._dataflow; //State when the code is skipped
+    }
+
+    ///Start of the body
+    if ( !data._jumps.addLabel({"%%L"+scopeId, 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("repeat : label error (label \"%%L"+scopeId+"\" already exist)");
+    }
+    data._aluState.clear(); //A label can be reached from anywhere
+    data._dataflow.clear();
+
+    repeat._bodyStart = data._code.getCursor();
+    repeat._readerLevel = data._reader.getSize();
+    data._repeats.push_back(std::move(repeat));
+}
+
+///Instruction_switch
+Instruction_switch::Instruction_switch(){}
+Instruction_switch::~Instruction_switch(){}
+
+std::string Instruction_switch::getName() const
+{
+    return "switch";
+}
+
+void Instruction_switch::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("switch : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argValue;
+    if ( argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) || argValue.forwardVariable(data) )
+    {//A value
+        if (argValue._valueSize != 1)
+        {
+            throw codeg::CompileError("switch : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+        }
+    }
+    else if ( argValue._type != codeg::KeywordTypes::KEYWORD_VARIABLE )
+    {
+        throw codeg::CompileError("switch : bad argument (argument 1 \""+argValue._str+"\" is not a value)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    data._scopes.newScope(codeg::ScopeStats::SCOPE_SWITCH, data._reader.getlineCount(), data._reader.getPath()); //New scope
+
+    codeg::Switch sw;
+    sw._scopeId = data._scopes.getScopeCount();
+    sw._variable = (argValue._type == codeg::KeywordTypes::KEYWORD_VARIABLE) ? argValue._variable : nullptr;
+    sw._valueBus = argValue._valueBus;
+    sw._value = argValue._value;
+
+    //The dispatch is placed at the end (the buses are not modified by the jump)
+    codeg::PushSwitchJump(data, "%%D"+std::to_string(sw._scopeId));
+    data._dataflow.setUnreachable();
+
+    data._switches.push_back(std::move(sw));
+}
+
+///Instruction_case
+Instruction_case::Instruction_case(){}
+Instruction_case::~Instruction_case(){}
+
+std::string Instruction_case::getName() const
+{
+    return "case";
+}
+
+void Instruction_case::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 2 )
+    {//Check size
+        throw codeg::CompileError("case : bad arguments size (wanted 2 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    if ( data._scopes.empty() || (data._scopes.top()._stat != codeg::ScopeStats::SCOPE_SWITCH) )
+    {
+        throw codeg::CompileError("case : scope error (case must be placed in a switch)");
+    }
+
+    codeg::Keyword argValue;
+    if ( !argValue.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_VALUE, data) || !argValue._valueIsConst )
+    {//Check const value
+        throw codeg::CompileError("case : bad argument (argument 1 [value] must be a valid constant value)");
+    }
+    if (argValue._valueSize != 1)
+    {
+        throw codeg::CompileError("case : bad value (require size is 1 byte got \""+std::to_string(argValue._valueSize)+"\")");
+    }
+
+    codeg::Switch& sw = data._switches.back();
+    uint8_t value = argValue._value;
+    if ( std::find(sw._cases.begin(), sw._cases.end(), value) != sw._cases.end() )
+    {
+        throw codeg::CompileError("case : bad value (case "+std::to_string(value)+" already exist)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    std::string scopeId = std::to_string(sw._scopeId);
+    if ( data._dataflow.isReachable() )
+    {//End of the previous case
+        codeg::PushSwitchJump(data, "%%E"+scopeId);
+    }
+
+    if ( !data._jumps.addLabel({"%%C"+scopeId+"_"+std::to_string(value), 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("case : label error (label \"%%C"+scopeId+"_"+std::to_string(value)+"\" already exist)");
+    }
+    sw._cases.push_back(value);
+
+    data._aluState.clear(); //A label can be reached from anywhere
+    data._dataflow.clear();
+}
+
+///Instruction_default
+Instruction_default::Instruction_default(){}
+Instruction_default::~Instruction_default(){}
+
+std::string Instruction_default::getName() const
+{
+    return "default";
+}
+
+void Instruction_default::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 1 )
+    {//Check size
+        throw codeg::CompileError("default : bad arguments size (wanted 1 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    if ( data._scopes.empty() || (data._scopes.top()._stat != codeg::ScopeStats::SCOPE_SWITCH) )
+    {
+        throw codeg::CompileError("default : scope error (default must be placed in a switch)");
+    }
+
+    codeg::Switch& sw = data._switches.back();
+    if (sw._default)
+    {
+        throw codeg::CompileError("default : scope error (default already exist in this switch)");
+    }
+
+    data._aluState.flush(data._code); //Emit the pending operation before the latches can be observed
+
+    std::string scopeId = std::to_string(sw._scopeId);
+    if ( data._dataflow.isReachable() )
+    {//End of the previous case
+        codeg::PushSwitchJump(data, "%%E"+scopeId);
+    }
+
+    if ( !data._jumps.addLabel({"%%C"+scopeId+"_D", 0, data._code.getCursor()}) )
+    {
+        throw codeg::CompileError("default : label error (label \"%%C"+scopeId+"_D\" already exist)");
+    }
+    sw._default = true;
+
+    data._aluState.clear(); //A label can be reached from anywhere
+    data._dataflow.clear();
+}
+
+///Instruction_wcet
+Instruction_wcet::Instruction_wcet(){}
+Instruction_wcet::~Instruction_wcet(){}
+
+std::string Instruction_wcet::getName() const
+{
+    return "wcet";
+}
+
+void Instruction_wcet::compile(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    if ( input._keywords.size() != 4 )
+    {//Check size
+        throw codeg::CompileError("wcet : bad arguments size (wanted 4 got "+std::to_string(input._keywords.size())+")");
+    }
+
+    codeg::Keyword argStr;
+    if ( !argStr.process(input._keywords[1], codeg::KeywordTypes::KEYWORD_STRING, data) )
+    {
+        throw codeg::CompileError("wcet : bad string (argument 1 is not a string)");
+    }
+    codeg::Keyword argName;
+    if ( !argName.process(input._keywords[2], codeg::KeywordTypes::KEYWORD_NAME, data) )
+    {
+        throw codeg::CompileError("wcet : bad argument (argument 2 [name] must be a valid name)");
+    }
+    codeg::Keyword argValue;
+    if ( !argValue.process(input._keywords[3], codeg::KeywordTypes::KEYWORD_VALUE, data) || !argValue._valueIsConst )
+    {
+        throw codeg::CompileError("wcet : bad argument (argument 3 [value] must be a valid constant value)");
+    }
+
+    if (argStr._str == "bound")
+    {
+        if (argValue._value == 0)
+        {
+            throw codeg::CompileError("wcet : bad value (a loop bound can't be 0)");
+        }
+        data._loopBounds.remove_if([&](const codeg::LoopBound& bound){ return bound._label == argName._str; });
+        data._loopBounds.push_back({argName._str, 1, argValue._value});
+    }
+    else if (argStr._str == "budget")
+    {
+        data._cycleBudgets.remove_if([&](const codeg::CycleBudget& budget){ return budget._name == argName._str; });
+        data._cycleBudgets.push_back({argName._str, argValue._value, data._reader.getPath(), data._reader.getlineCount()});
+    }
+    else
+    {
+        throw codeg::CompileError("wcet : bad argument (argument 1 [string] must be \"bound\" or \"budget\")");
+    }
+}
+
+}//end codeg
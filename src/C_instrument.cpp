@@ -0,0 +1,373 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_instrument.hpp"
+#include "C_sizeReport.hpp"
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_error.hpp"
+#include "C_json.hpp"
+#include <map>
+
+namespace codeg
+{
+
+const char* ReadableStringInstrumentKinds[] =
+{
+    "function",
+    "label",
+    "block"
+};
+
+static uint8_t GetAluOperation(const codeg::Alu& alu, const std::string& name)
+{
+    for (unsigned int i=0; i<256; ++i)
+    {
+        const codeg::AluOperation* operation = alu.getOperation(i);
+        if (operation == nullptr)
+        {
+            break;
+        }
+        if ( (operation->_name == name) && (operation->_function != nullptr) )
+        {
+            return i;
+        }
+    }
+    throw codeg::FatalError("instrumentation : the ALU don't have the operation \""+name+"\" (--alu=<revision>)");
+}
+
+static void PushAddress(codeg::CodeData& code, codeg::Variable* variable)
+{
+    variable->_link.push_back(code.getCursor());
+
+    code.push(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE);
+    code.push(0x00);
+    code.push(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE);
+    code.push(0x00);
+}
+static void PushOperation(codeg::CodeData& code, uint8_t opcode, codeg::ReadableBusses bus, uint8_t value=0)
+{
+    code.push(opcode | bus);
+    if (bus == codeg::ReadableBusses::READABLE_SOURCE)
+    {
+        code.push(value);
+    }
+    else
+    {
+        code.pushDummy();
+    }
+}
+
+void Instrumentation::clear()
+{
+    this->g_mode = codeg::InstrumentModes::INSTRUMENT_MODE_NONE;
+    this->g_counterSize = 1;
+    this->g_saturating = false;
+    this->g_readerLevel = 0;
+    this->g_scopeCount = 0;
+    this->g_counters.clear();
+}
+
+bool Instrumentation::setMode(const std::string& mode)
+{
+    if (mode == "functions")
+    {
+        this->g_mode = codeg::InstrumentModes::INSTRUMENT_MODE_FUNCTIONS;
+        return true;
+    }
+    if (mode == "blocks")
+    {
+        this->g_mode = codeg::InstrumentModes::INSTRUMENT_MODE_BLOCKS;
+        return true;
+    }
+    return false;
+}
+codeg::InstrumentModes Instrumentation::getMode() const
+{
+    return this->g_mode;
+}
+bool Instrumentation::isEnabled() const
+{
+    return this->g_mode != codeg::InstrumentModes::INSTRUMENT_MODE_NONE;
+}
+
+bool Instrumentation::setCounterBits(unsigned int bits)
+{
+    if ( (bits != 8) && (bits != 16) )
+    {
+        return false;
+    }
+    this->g_counterSize = bits/8;
+    return true;
+}
+unsigned int Instrumentation::getCounterSize() const
+{
+    return this->g_counterSize;
+}
+void Instrumentation::setSaturating(bool saturating)
+{
+    this->g_saturating = saturating;
+}
+bool Instrumentation::isSaturating() const
+{
+    return this->g_saturating;
+}
+
+void Instrumentation::setup(codeg::CompilerData& data)
+{
+    this->g_operationAdd = codeg::GetAluOperation(data._alu, "+");
+    this->g_operationLess = codeg::GetAluOperation(data._alu, "<");
+    this->g_operationAnd = codeg::GetAluOperation(data._alu, "&");
+    this->g_operationOr = codeg::GetAluOperation(data._alu, "|");
+
+    codeg::Pool instrumentPool(CODEG_INSTRUMENT_POOL);
+    instrumentPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+    instrumentPool.setAddress(0x00, 0x0000);
+    instrumentPool.addVariable({"RESULT", {}, {}}); //Saved "_result" while a counter is incremented
+    instrumentPool.setObservable(true);
+    if ( !data._pools.addPool(instrumentPool) )
+    {
+        throw codeg::FatalError("instrumentation : pool \"" CODEG_INSTRUMENT_POOL "\" already exist");
+    }
+}
+
+void Instrumentation::prepare(const codeg::StringDecomposer& input, const codeg::CompilerData& data)
+{
+    this->g_readerLevel = data._reader.getSize();
+    this->g_scopeCount = data._scopes.size();
+    if ( (input._keywords[0] == "end") && !data._scopes.empty() )
+    {
+        this->g_scopeStat = data._scopes.top()._stat;
+    }
+}
+
+void Instrumentation::instrument(const codeg::StringDecomposer& input, codeg::CompilerData& data)
+{
+    const std::string& keyword = input._keywords[0];
+    const codeg::Function* expanded = data._reader.getExpandedFunction();
+
+    if (keyword == "function")
+    {
+        this->addCounter(data, codeg::InstrumentKinds::INSTRUMENT_KIND_FUNCTION, data._actualFunctionName, data._actualFunctionName);
+        return;
+    }
+    if (keyword == "call")
+    {//The inlined function or the expanded definition is read now
+        if ( (data._reader.getSize() > this->g_readerLevel) && (expanded != nullptr) )
+        {
+            this->addCounter(data, codeg::InstrumentKinds::INSTRUMENT_KIND_FUNCTION, expanded->getName(), expanded->getName());
+        }
+        return;
+    }
+
+    if (this->g_mode != codeg::InstrumentModes::INSTRUMENT_MODE_BLOCKS)
+    {
+        return;
+    }
+
+    std::string function = (expanded != nullptr) ? expanded->getName() : data._actualFunctionName;
+    if (keyword == "label")
+    {
+        if (input._keywords.size() == 2)
+        {//A label with a fixed address is not a block of the code
+            this->addCounter(data, codeg::InstrumentKinds::INSTRUMENT_KIND_LABEL, input._keywords[1], function);
+        }
+        return;
+    }
+    if ( (keyword == "if") || (keyword == "if_not") || (keyword == "else") || (keyword == "case") || (keyword == "default") )
+    {
+        this->addCounter(data, codeg::InstrumentKinds::INSTRUMENT_KIND_BLOCK, keyword, function);
+        return;
+    }
+    if ( (keyword == "end") && (data._scopes.size() < this->g_scopeCount) )
+    {//Joining point of a conditional or a switch
+        if ( (this->g_scopeStat == codeg::ScopeStats::SCOPE_CONDITIONAL_TRUE) ||
+             (this->g_scopeStat == codeg::ScopeStats::SCOPE_CONDITIONAL_FALSE) ||
+             (this->g_scopeStat == codeg::ScopeStats::SCOPE_SWITCH) )
+        {
+            this->addCounter(data, codeg::InstrumentKinds::INSTRUMENT_KIND_BLOCK, keyword, function);
+        }
+    }
+}
+
+void Instrumentation::addCounter(codeg::CompilerData& data, codeg::InstrumentKinds kind, const std::string& name, const std::string& function)
+{
+    codeg::Pool* pool = data._pools.getPool(CODEG_INSTRUMENT_POOL);
+    if (pool == nullptr)
+    {
+        throw codeg::FatalError("instrumentation : the pool \"" CODEG_INSTRUMENT_POOL "\" is not created");
+    }
+
+    std::string variableName = "C"+std::to_string(this->g_counters.size());
+    pool->addVariable({variableName, {}, {}});
+    codeg::Variable* low = pool->getVariable(variableName);
+    codeg::Variable* high = nullptr;
+    if (this->g_counterSize == 2)
+    {
+        pool->addVariable({variableName+"_H", {}, {}});
+        high = pool->getVariable(variableName+"_H");
+    }
+
+    this->g_counters.push_back({kind, name, function, data._reader.getFilePath(), data._reader.getFilelineCount()});
+
+    if ( data._code.getOriginTracking() )
+    {
+        codeg::UpdateCodeOrigin(data, "instrument");
+    }
+    this->pushIncrement(data, low, high);
+}
+
+void Instrumentation::pushIncrement(codeg::CompilerData& data, codeg::Variable* low, codeg::Variable* high) const
+{
+    codeg::CodeData& code = data._code;
+    codeg::Variable* saved = data._pools.getPool(CODEG_INSTRUMENT_POOL)->getVariable("RESULT");
+
+    /*
+    A pending operation is not in the latches yet, it is emitted later.
+    When the 3 latches are known, they are simply written again after the increment,
+    else "_result" is saved in the RAM and the latches are set to "_result | 0".
+    */
+    bool pending = data._aluState.isPending();
+    bool known = data._aluState.getLeft()._known && data._aluState.getOperation()._known && data._aluState.getRight()._known;
+
+    if (!pending && !known)
+    {
+        codeg::PushAddress(code, saved);
+        codeg::PushOperation(code, codeg::OPCODE_RAMW, codeg::ReadableBusses::READABLE_RESULT);
+    }
+
+    if (high == nullptr)
+    {
+        codeg::PushAddress(code, low);
+        codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RAM);
+        if (this->g_saturating)
+        {//counter + (counter < 255)
+            codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationLess);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, 0xFF);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_RESULT);
+            codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationAdd);
+        }
+        else
+        {//counter + 1
+            codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationAdd);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, 0x01);
+        }
+        codeg::PushOperation(code, codeg::OPCODE_RAMW, codeg::ReadableBusses::READABLE_RESULT);
+    }
+    else
+    {
+        if (this->g_saturating)
+        {//increment = (high & low) < 255
+            codeg::PushAddress(code, high);
+            codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RAM);
+            codeg::PushAddress(code, low);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_RAM);
+            codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationAnd);
+            codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RESULT);
+            codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationLess);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, 0xFF);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_RESULT);
+        }
+        else
+        {//increment = 1
+            codeg::PushAddress(code, low);
+            codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, 0x01);
+        }
+        //low = low + increment, the carry is (low < increment)
+        codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RAM);
+        codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationAdd);
+        codeg::PushOperation(code, codeg::OPCODE_RAMW, codeg::ReadableBusses::READABLE_RESULT);
+        codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RESULT);
+        codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationLess);
+        //high = high + carry
+        codeg::PushAddress(code, high);
+        codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_RESULT);
+        codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RAM);
+        codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationAdd);
+        codeg::PushOperation(code, codeg::OPCODE_RAMW, codeg::ReadableBusses::READABLE_RESULT);
+    }
+
+    if (pending)
+    {
+        return;
+    }
+    if (known)
+    {
+        codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_SOURCE, data._aluState.getLeft()._value);
+        codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, data._aluState.getOperation()._value);
+        codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, data._aluState.getRight()._value);
+        return;
+    }
+
+    codeg::PushAddress(code, saved);
+    codeg::PushOperation(code, codeg::OPCODE_OPLEFT_CLK, codeg::ReadableBusses::READABLE_RAM);
+    codeg::PushOperation(code, codeg::OPCODE_OPCHOOSE_CLK, codeg::ReadableBusses::READABLE_SOURCE, this->g_operationOr);
+    codeg::PushOperation(code, codeg::OPCODE_OPRIGHT_CLK, codeg::ReadableBusses::READABLE_SOURCE, 0x00);
+    data._aluState.setLeft(false);
+    data._aluState.setOperation(true, this->g_operationOr);
+    data._aluState.setRight(true, 0x00);
+}
+
+void Instrumentation::writeJson(codeg::CompilerData& data, std::ostream& stream) const
+{
+    std::map<std::string, codeg::MemoryAddress> addresses;
+    codeg::MemoryAddress start = 0;
+    codeg::MemorySize size = 0;
+
+    codeg::Pool* pool = data._pools.getPool(CODEG_INSTRUMENT_POOL);
+    if ( (pool != nullptr) && pool->isResolved() )
+    {
+        start = pool->getResolvedAddress();
+        size = pool->getTotalSize();
+        std::size_t index = 0;
+        for (auto&& vVariable : pool->getVariables())
+        {
+            addresses[vVariable._name] = start + pool->getVariableOffset(index++);
+        }
+    }
+
+    stream << "{" << std::endl;
+    stream << "  \"mode\": \"" << ((this->g_mode == codeg::InstrumentModes::INSTRUMENT_MODE_BLOCKS) ? "blocks" : "functions") << "\"," << std::endl;
+    stream << "  \"counterSize\": " << this->g_counterSize << "," << std::endl;
+    stream << "  \"saturating\": " << (this->g_saturating ? "true" : "false") << "," << std::endl;
+    stream << "  \"pool\": {\"start\": " << start << ", \"size\": " << size << "}," << std::endl;
+
+    stream << "  \"counters\": [";
+    for (std::size_t i=0; i<this->g_counters.size(); ++i)
+    {
+        const codeg::InstrumentCounter& counter = this->g_counters[i];
+        std::string variableName = "C"+std::to_string(i);
+
+        stream << (i ? "," : "") << std::endl << "    {\"kind\": \"" << codeg::ReadableStringInstrumentKinds[counter._kind]
+               << "\", \"name\": \"" << codeg::JsonEscape(counter._name) << "\", \"function\": \"" << codeg::JsonEscape(counter._function)
+               << "\", \"file\": \"" << codeg::JsonEscape(counter._file) << "\", \"line\": " << counter._line
+               << ", \"address\": " << addresses[variableName];
+        if (this->g_counterSize == 2)
+        {
+            stream << ", \"addressHigh\": " << addresses[variableName+"_H"];
+        }
+        stream << "}";
+    }
+    stream << std::endl << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+const std::vector<codeg::InstrumentCounter>& Instrumentation::getCounters() const
+{
+    return this->g_counters;
+}
+
+}//end codeg
@@ -0,0 +1,350 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_json.hpp"
+#include "C_error.hpp"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+namespace codeg
+{
+
+std::string JsonEscape(const std::string& str)
+{
+    std::string result;
+    result.reserve(str.size()+2);
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\r':
+            result += "\\r";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        default:
+            if ( static_cast<unsigned char>(c) < 0x20 )
+            {
+                static const char hex[] = "0123456789abcdef";
+                result += "\\u00";
+                result += hex[(c>>4)&0x0F];
+                result += hex[c&0x0F];
+            }
+            else
+            {
+                result += c;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+///JsonParser
+
+class JsonParser
+{
+public:
+    JsonParser(const std::string& str) :
+        g_str(str)
+    {
+    }
+
+    codeg::JsonValue parseDocument()
+    {
+        codeg::JsonValue value = this->parseValue(0);
+        this->skipSpaces();
+        if (this->g_cursor != this->g_str.size())
+        {
+            this->error("unexpected data after the document");
+        }
+        return value;
+    }
+
+private:
+    void error(const std::string& what) const
+    {
+        throw codeg::SyntaxError("json : "+what+" (at offset "+std::to_string(this->g_cursor)+")");
+    }
+
+    void skipSpaces()
+    {
+        while ( (this->g_cursor < this->g_str.size()) &&
+                ((this->g_str[this->g_cursor] == ' ') || (this->g_str[this->g_cursor] == '\t') ||
+                 (this->g_str[this->g_cursor] == '\n') || (this->g_str[this->g_cursor] == '\r')) )
+        {
+            ++this->g_cursor;
+        }
+    }
+    bool consume(char c)
+    {
+        this->skipSpaces();
+        if ( (this->g_cursor < this->g_str.size()) && (this->g_str[this->g_cursor] == c) )
+        {
+            ++this->g_cursor;
+            return true;
+        }
+        return false;
+    }
+    void expect(char c)
+    {
+        if ( !this->consume(c) )
+        {
+            this->error(std::string("'")+c+"' expected");
+        }
+    }
+    bool consumeWord(const char* word)
+    {
+        std::size_t size = std::char_traits<char>::length(word);
+        if (this->g_str.compare(this->g_cursor, size, word) == 0)
+        {
+            this->g_cursor += size;
+            return true;
+        }
+        return false;
+    }
+
+    std::string parseString()
+    {
+        this->expect('"');
+        std::string result;
+        while (this->g_cursor < this->g_str.size())
+        {
+            char c = this->g_str[this->g_cursor++];
+            if (c == '"')
+            {
+                return result;
+            }
+            if (c != '\\')
+            {
+                result += c;
+                continue;
+            }
+            if (this->g_cursor >= this->g_str.size())
+            {
+                break;
+            }
+            c = this->g_str[this->g_cursor++];
+            switch (c)
+            {
+            case 'n':
+                result += '\n';
+                break;
+            case 'r':
+                result += '\r';
+                break;
+            case 't':
+                result += '\t';
+                break;
+            case 'b':
+                result += '\b';
+                break;
+            case 'f':
+                result += '\f';
+                break;
+            case 'u':
+            {
+                if (this->g_cursor+4 > this->g_str.size())
+                {
+                    this->error("bad escape");
+                }
+                unsigned long code = std::strtoul(this->g_str.substr(this->g_cursor, 4).c_str(), nullptr, 16);
+                this->g_cursor += 4;
+                if (code < 0x80)
+                {
+                    result += static_cast<char>(code);
+                }
+                else if (code < 0x800)
+                {
+                    result += static_cast<char>(0xC0 | (code>>6));
+                    result += static_cast<char>(0x80 | (code&0x3F));
+                }
+                else
+                {
+                    result += static_cast<char>(0xE0 | (code>>12));
+                    result += static_cast<char>(0x80 | ((code>>6)&0x3F));
+                    result += static_cast<char>(0x80 | (code&0x3F));
+                }
+                break;
+            }
+            default:
+                result += c;
+                break;
+            }
+        }
+        this->error("unterminated string");
+        return result;
+    }
+
+    codeg::JsonValue parseValue(unsigned int depth)
+    {
+        if (depth > 64)
+        {
+            this->error("too many nested values");
+        }
+
+        codeg::JsonValue value;
+        this->skipSpaces();
+        if (this->g_cursor >= this->g_str.size())
+        {
+            this->error("value expected");
+        }
+
+        char c = this->g_str[this->g_cursor];
+        if (c == '{')
+        {
+            ++this->g_cursor;
+            value.g_type = codeg::JsonValue::Types::TYPE_OBJECT;
+            if ( this->consume('}') )
+            {
+                return value;
+            }
+            do
+            {
+                this->skipSpaces();
+                std::string key = this->parseString();
+                this->expect(':');
+                value.g_object[key] = this->parseValue(depth+1);
+            }
+            while ( this->consume(',') );
+            this->expect('}');
+        }
+        else if (c == '[')
+        {
+            ++this->g_cursor;
+            value.g_type = codeg::JsonValue::Types::TYPE_ARRAY;
+            if ( this->consume(']') )
+            {
+                return value;
+            }
+            do
+            {
+                value.g_array.push_back(this->parseValue(depth+1));
+            }
+            while ( this->consume(',') );
+            this->expect(']');
+        }
+        else if (c == '"')
+        {
+            value.g_type = codeg::JsonValue::Types::TYPE_STRING;
+            value.g_string = this->parseString();
+        }
+        else if ( this->consumeWord("true") || this->consumeWord("false") )
+        {
+            value.g_type = codeg::JsonValue::Types::TYPE_BOOL;
+            value.g_bool = (c == 't');
+        }
+        else if ( this->consumeWord("null") )
+        {
+            value.g_type = codeg::JsonValue::Types::TYPE_NULL;
+        }
+        else
+        {
+            const char* start = this->g_str.c_str() + this->g_cursor;
+            char* end = nullptr;
+            value.g_number = std::strtod(start, &end);
+            if (end == start)
+            {
+                this->error("bad value");
+            }
+            value.g_type = codeg::JsonValue::Types::TYPE_NUMBER;
+            this->g_cursor += end - start;
+        }
+        return value;
+    }
+
+    const std::string& g_str;
+    std::size_t g_cursor = 0;
+};
+
+///JsonValue
+
+codeg::JsonValue JsonValue::parse(const std::string& str)
+{
+    codeg::JsonParser parser(str);
+    return parser.parseDocument();
+}
+bool JsonValue::parseFile(const std::string& path, codeg::JsonValue& value)
+{
+    std::ifstream file(path, std::ios::binary);
+    if ( !file )
+    {
+        return false;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    value = codeg::JsonValue::parse(content.str());
+    return true;
+}
+
+codeg::JsonValue::Types JsonValue::getType() const
+{
+    return this->g_type;
+}
+bool JsonValue::isNull() const
+{
+    return this->g_type == codeg::JsonValue::Types::TYPE_NULL;
+}
+
+bool JsonValue::getBool() const
+{
+    return this->g_bool;
+}
+double JsonValue::getNumber() const
+{
+    return this->g_number;
+}
+const std::string& JsonValue::getString() const
+{
+    return this->g_string;
+}
+
+std::size_t JsonValue::size() const
+{
+    return (this->g_type == codeg::JsonValue::Types::TYPE_ARRAY) ? this->g_array.size() : this->g_object.size();
+}
+const codeg::JsonValue& JsonValue::operator[](std::size_t index) const
+{
+    static const codeg::JsonValue nullValue;
+    return (index < this->g_array.size()) ? this->g_array[index] : nullValue;
+}
+const codeg::JsonValue& JsonValue::operator[](const std::string& key) const
+{
+    static const codeg::JsonValue nullValue;
+    std::map<std::string, codeg::JsonValue>::const_iterator it = this->g_object.find(key);
+    return (it != this->g_object.end()) ? it->second : nullValue;
+}
+bool JsonValue::has(const std::string& key) const
+{
+    return this->g_object.find(key) != this->g_object.end();
+}
+const std::map<std::string, codeg::JsonValue>& JsonValue::getMembers() const
+{
+    return this->g_object;
+}
+
+}//end codeg
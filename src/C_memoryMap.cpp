@@ -0,0 +1,206 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_memoryMap.hpp"
+#include "C_json.hpp"
+#include "C_string.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace codeg
+{
+
+void MemoryMap::clear()
+{
+    this->g_pools.clear();
+    this->g_gaps.clear();
+    this->g_reservedSize = 0;
+    this->g_usedSize = 0;
+    this->g_freeSize = CODEG_RAM_SIZE;
+    this->g_largestFreeBlock = CODEG_RAM_SIZE;
+}
+
+void MemoryMap::build(codeg::PoolList& pools)
+{
+    this->clear();
+
+    std::vector<bool> reserved(CODEG_RAM_SIZE, false);
+
+    for (auto&& vPool : pools.getPools())
+    {
+        codeg::MemoryMapPool pool;
+        pool._name = vPool.getName();
+        pool._static = (vPool.getStartAddressType() == codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC);
+        pool._placed = vPool.isResolved();
+        pool._start = pool._placed ? vPool.getResolvedAddress() : vPool.getStartAddress();
+        pool._reserved = pool._placed ? vPool.getTotalSize() : 0;
+        pool._used = pool._placed ? vPool.getSize() : 0;
+        pool._poolAccesses = vPool._link.size();
+
+        std::size_t index = 0;
+        for (auto&& vVariable : vPool.getVariables())
+        {
+            codeg::MemoryAddress address = pool._start + vPool.getVariableOffset(index++);
+            pool._variables.push_back({vVariable._name, address, static_cast<uint32_t>(vVariable._link.size() + vVariable._linkLsb.size())});
+        }
+
+        for (codeg::MemoryBigSize a=0; a<pool._reserved; ++a)
+        {
+            reserved[(pool._start + a) % CODEG_RAM_SIZE] = true;
+        }
+        this->g_reservedSize += pool._reserved;
+        this->g_usedSize += pool._used;
+
+        this->g_pools.push_back(std::move(pool));
+    }
+
+    std::stable_sort(this->g_pools.begin(), this->g_pools.end(), [](const codeg::MemoryMapPool& a, const codeg::MemoryMapPool& b)
+    {
+        return (a._placed != b._placed) ? a._placed : (a._start < b._start);
+    });
+
+    ///Free gaps
+    this->g_freeSize = 0;
+    this->g_largestFreeBlock = 0;
+    for (codeg::MemoryBigSize a=0; a<CODEG_RAM_SIZE;)
+    {
+        if ( reserved[a] )
+        {
+            ++a;
+            continue;
+        }
+        codeg::MemoryBigSize start = a;
+        while ( (a < CODEG_RAM_SIZE) && !reserved[a] )
+        {
+            ++a;
+        }
+        this->g_gaps.push_back({start, a-start});
+        this->g_freeSize += a-start;
+        this->g_largestFreeBlock = std::max(this->g_largestFreeBlock, a-start);
+    }
+}
+
+void MemoryMap::writeJson(std::ostream& stream) const
+{
+    stream << "{" << std::endl;
+    stream << "  \"size\": " << CODEG_RAM_SIZE << "," << std::endl;
+    stream << "  \"reserved\": " << this->g_reservedSize << "," << std::endl;
+    stream << "  \"used\": " << this->g_usedSize << "," << std::endl;
+    stream << "  \"free\": " << this->g_freeSize << "," << std::endl;
+    stream << "  \"largestFreeBlock\": " << this->g_largestFreeBlock << "," << std::endl;
+    stream << "  \"fragmentation\": " << std::fixed << std::setprecision(4) << this->getFragmentation() << "," << std::endl;
+
+    stream << "  \"pools\": [";
+    for (std::size_t i=0; i<this->g_pools.size(); ++i)
+    {
+        const codeg::MemoryMapPool& pool = this->g_pools[i];
+        stream << (i ? "," : "") << std::endl << "    {\"name\": \"" << codeg::JsonEscape(pool._name)
+               << "\", \"type\": \"" << (pool._static ? "static" : "dynamic") << "\", \"placed\": " << (pool._placed ? "true" : "false")
+               << ", \"start\": " << pool._start << ", \"reserved\": " << pool._reserved << ", \"used\": " << pool._used
+               << ", \"poolAccesses\": " << pool._poolAccesses << ", \"variables\": [";
+        for (std::size_t v=0; v<pool._variables.size(); ++v)
+        {
+            const codeg::MemoryMapVariable& variable = pool._variables[v];
+            stream << (v ? ", " : "") << "{\"name\": \"" << codeg::JsonEscape(variable._name) << "\", \"address\": " << variable._address
+                   << ", \"accesses\": " << variable._accesses << "}";
+        }
+        stream << "]}";
+    }
+    stream << std::endl << "  ]," << std::endl;
+
+    stream << "  \"gaps\": [";
+    for (std::size_t i=0; i<this->g_gaps.size(); ++i)
+    {
+        stream << (i ? ", " : "") << "{\"start\": " << this->g_gaps[i]._start << ", \"size\": " << this->g_gaps[i]._size << "}";
+    }
+    stream << "]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+void MemoryMap::writeText(std::ostream& stream) const
+{
+    stream << "RAM : " << this->g_reservedSize << " bytes reserved by the pools, " << this->g_usedSize << " bytes used by the variables, "
+           << this->g_freeSize << " bytes free (of " << CODEG_RAM_SIZE << " bytes)" << std::endl;
+    stream << "Largest free block : " << this->g_largestFreeBlock << " bytes, fragmentation index : "
+           << std::fixed << std::setprecision(3) << this->getFragmentation() << std::endl << std::endl;
+
+    stream << "Pools :" << std::endl;
+    for (auto&& vPool : this->g_pools)
+    {
+        stream << "\t\"" << vPool._name << "\" (" << (vPool._static ? "static" : "dynamic") << ") : ";
+        if ( !vPool._placed )
+        {
+            stream << "not placed (no variable and a dynamic size)" << std::endl;
+            continue;
+        }
+        stream << codeg::ValueToHex(vPool._start, 4) << " - " << codeg::ValueToHex(vPool._start + vPool._reserved - 1, 4)
+               << ", " << vPool._used << "/" << vPool._reserved << " bytes used";
+        if (vPool._poolAccesses > 0)
+        {
+            stream << ", " << vPool._poolAccesses << " accesses by offset";
+        }
+        stream << std::endl;
+        for (auto&& vVariable : vPool._variables)
+        {
+            stream << "\t\t" << codeg::ValueToHex(vVariable._address, 4) << " $" << vVariable._name << " : "
+                   << vVariable._accesses << " accesses" << std::endl;
+        }
+    }
+    stream << std::endl;
+
+    stream << "Free gaps :" << std::endl;
+    for (auto&& vGap : this->g_gaps)
+    {
+        stream << "\t" << codeg::ValueToHex(vGap._start, 4) << " - " << codeg::ValueToHex(vGap._start + vGap._size - 1, 4)
+               << " : " << vGap._size << " bytes" << std::endl;
+    }
+}
+
+const std::vector<codeg::MemoryMapPool>& MemoryMap::getPools() const
+{
+    return this->g_pools;
+}
+const std::vector<codeg::MemoryMapGap>& MemoryMap::getGaps() const
+{
+    return this->g_gaps;
+}
+
+codeg::MemoryBigSize MemoryMap::getReservedSize() const
+{
+    return this->g_reservedSize;
+}
+codeg::MemoryBigSize MemoryMap::getUsedSize() const
+{
+    return this->g_usedSize;
+}
+codeg::MemoryBigSize MemoryMap::getFreeSize() const
+{
+    return this->g_freeSize;
+}
+codeg::MemoryBigSize MemoryMap::getLargestFreeBlock() const
+{
+    return this->g_largestFreeBlock;
+}
+double MemoryMap::getFragmentation() const
+{
+    if (this->g_freeSize == 0)
+    {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(this->g_largestFreeBlock) / static_cast<double>(this->g_freeSize);
+}
+
+}//end codeg
@@ -0,0 +1,3079 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_optimizer.hpp"
+#include "C_compilerData.hpp"
+#include "C_readableBus.hpp"
+#include "C_error.hpp"
+#include "C_peephole.hpp"
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+namespace codeg
+{
+
+///MicroOp
+
+uint8_t MicroOp::getOpcode() const
+{
+    return this->_code & 0x1F;
+}
+uint8_t MicroOp::getBus() const
+{
+    return this->_code & 0xE0;
+}
+bool MicroOp::hasArgument() const
+{
+    return (this->getBus() == codeg::ReadableBusses::READABLE_SOURCE) && (this->getOpcode() != codeg::OPCODE_JMPSRC_CLK);
+}
+
+///Outlining
+
+enum RegisterBits : uint8_t
+{
+    REGISTER_BIT_JUMP_MSB = 0x01,
+    REGISTER_BIT_JUMP_MID = 0x02,
+    REGISTER_BIT_JUMP_LSB = 0x04,
+    REGISTER_BIT_RAM_ADDRESS = 0x08,
+
+    REGISTER_BIT_JUMP = 0x07,
+    REGISTER_BIT_ALL = 0x0F
+};
+
+static codeg::MicroOp MakeOutlineOp(uint8_t code, bool writeDummy)
+{
+    codeg::MicroOp op{code, 0, 1, 0, false, false};
+    if ( op.hasArgument() || (writeDummy && (op.getOpcode() != codeg::OPCODE_JMPSRC_CLK)) )
+    {
+        op._size = 2;
+    }
+    return op;
+}
+static codeg::Address GetOutlineSize(const std::vector<codeg::MicroOp>& ops, std::size_t count)
+{
+    codeg::Address size = 0;
+    for (std::size_t i=0; i<count; ++i)
+    {
+        size += ops[i]._size;
+    }
+    return size;
+}
+static void MakeOutlineOps(bool writeDummy, std::vector<codeg::MicroOp>& callOps, std::vector<codeg::MicroOp>& returnOps)
+{
+    /*
+    The code is never bigger than 64 KiB, the MSB of a return address is always 0 and is not written.
+    The 2 variables of the hidden pool are in the same page, only the LSB of the second is written.
+    */
+    callOps = {
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE, writeDummy), //Variable MID
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE, writeDummy), //Return address MID
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE, writeDummy), //Variable LSB
+        codeg::MakeOutlineOp(codeg::OPCODE_RAMW | codeg::READABLE_SOURCE, writeDummy), //Return address LSB
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE, writeDummy), //Subroutine
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_JMPSRC_CLK, writeDummy)
+    };
+    returnOps = {
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD2_CLK | codeg::READABLE_SOURCE, writeDummy), //Variable MID
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_RAM, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_BRAMADD1_CLK | codeg::READABLE_SOURCE, writeDummy), //Variable LSB
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_RAM, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE, writeDummy),
+        codeg::MakeOutlineOp(codeg::OPCODE_JMPSRC_CLK, writeDummy)
+    };
+}
+
+static void BuildSuffixArray(const std::vector<int64_t>& tokens, std::vector<std::size_t>& suffixes, std::vector<std::size_t>& lcp)
+{
+    std::size_t n = tokens.size();
+    suffixes.resize(n);
+    lcp.assign(n, 0);
+    if (n == 0)
+    {
+        return;
+    }
+    std::iota(suffixes.begin(), suffixes.end(), 0);
+
+    ///Prefix doubling
+    std::vector<int64_t> rank(tokens);
+    std::vector<int64_t> newRank(n);
+    for (std::size_t k=1; ; k<<=1)
+    {
+        auto compare = [&](std::size_t a, std::size_t b)
+        {
+            if (rank[a] != rank[b])
+            {
+                return rank[a] < rank[b];
+            }
+            int64_t nextA = (a+k < n) ? rank[a+k] : INT64_MIN;
+            int64_t nextB = (b+k < n) ? rank[b+k] : INT64_MIN;
+            return nextA < nextB;
+        };
+        std::sort(suffixes.begin(), suffixes.end(), compare);
+
+        newRank[suffixes[0]] = 0;
+        for (std::size_t i=1; i<n; ++i)
+        {
+            newRank[suffixes[i]] = newRank[suffixes[i-1]] + (compare(suffixes[i-1], suffixes[i]) ? 1 : 0);
+        }
+        rank = newRank;
+        if ( (static_cast<std::size_t>(rank[suffixes[n-1]]) == n-1) || (k >= n) )
+        {
+            break;
+        }
+    }
+
+    ///Longest common prefix with the previous suffix (Kasai)
+    std::vector<std::size_t> inverse(n);
+    for (std::size_t i=0; i<n; ++i)
+    {
+        inverse[suffixes[i]] = i;
+    }
+    std::size_t common = 0;
+    for (std::size_t i=0; i<n; ++i)
+    {
+        if (inverse[i] == 0)
+        {
+            common = 0;
+            continue;
+        }
+        std::size_t j = suffixes[inverse[i]-1];
+        while ( (i+common < n) && (j+common < n) && (tokens[i+common] == tokens[j+common]) )
+        {
+            ++common;
+        }
+        lcp[inverse[i]] = common;
+        if (common > 0)
+        {
+            --common;
+        }
+    }
+}
+
+///Optimizer
+
+bool Optimizer::decode(codeg::CompilerData& data)
+{
+    this->g_ops.clear();
+    this->g_opOrigins.clear();
+    this->g_blocks.clear();
+    this->g_labels.clear();
+    this->g_jumpSources.clear();
+    this->g_returnSources.clear();
+    this->g_returnPoints.clear();
+    this->g_tableSources.clear();
+    this->g_tables.clear();
+    this->g_ramLinks.clear();
+    this->g_poolLocations.clear();
+    this->g_poolVariableCount.clear();
+    this->g_poolLinked.clear();
+    this->g_overlays.clear();
+    this->g_poolInfos.clear();
+    this->g_pageLocks.clear();
+    this->g_observableLocations.clear();
+    this->g_lsbLinks.clear();
+    this->g_hoisted.clear();
+    this->g_functions.clear();
+    this->g_order.clear();
+    this->g_outlines.clear();
+    this->g_outlineSites.clear();
+    this->g_outlineIndex = 0;
+    this->g_locationCount = 0;
+
+    if ( !data._relocatableCode )
+    {
+        return false;
+    }
+
+    this->g_writeDummy = data._code.getWriteDummy();
+    this->g_endAddress = data._code.getCursor();
+
+    ///Instructions
+    for (codeg::Address i=0; i<this->g_endAddress;)
+    {
+        codeg::MicroOp op;
+        op._code = data._code[i];
+        op._argument = 0;
+        op._size = 1;
+        op._address = i;
+        op._removed = false;
+        op._moved = false;
+
+        if ( op.hasArgument() || (this->g_writeDummy && (op.getOpcode() != codeg::OPCODE_JMPSRC_CLK)) )
+        {
+            if (i+1 >= this->g_endAddress)
+            {//Truncated instruction
+                return false;
+            }
+            op._argument = data._code[i+1];
+            op._size = 2;
+        }
+
+        this->g_opOrigins.push_back(data._code.getOrigin(i));
+        i += op._size;
+        this->g_ops.push_back(op);
+    }
+
+    ///Labels
+    this->g_labelOps.assign(this->g_ops.size()+1, false);
+    for (auto&& vLabel : data._jumps._labels)
+    {
+        std::size_t index = this->getOpIndex(vLabel._addressStatic);
+        if (index > this->g_ops.size())
+        {//Not the start of an instruction
+            return false;
+        }
+        this->g_labels[vLabel._name] = index;
+        this->g_labelOps[index] = true;
+    }
+
+    ///Functions
+    for (auto&& vFunction : data._functions.getFunctions())
+    {
+        std::map<std::string, std::size_t>::const_iterator itBegin = this->g_labels.find("%%"+vFunction.getName());
+        std::map<std::string, std::size_t>::const_iterator itEnd = this->g_labels.find("%%E"+vFunction.getName());
+        if ( vFunction.isDefinition() || !vFunction.isComplete() ||
+             (itBegin == this->g_labels.end()) || (itEnd == this->g_labels.end()) || (itBegin->second > itEnd->second) )
+        {
+            continue;
+        }
+        this->g_functions.push_back({vFunction.getName(), itBegin->second, itEnd->second});
+    }
+    std::sort(this->g_functions.begin(), this->g_functions.end(),
+              [](const codeg::Optimizer::FunctionRange& a, const codeg::Optimizer::FunctionRange& b){ return a._begin < b._begin; });
+
+    ///Jump points
+    std::set<std::string> tableLabels;
+    for (auto&& vTable : data._jumps._jumpTables)
+    {
+        tableLabels.insert(vTable._labelName);
+    }
+    for (auto&& vJumpPoint : data._jumps._jumpPoints)
+    {
+        std::size_t index = this->getOpIndex(vJumpPoint._addressStatic);
+        if (index >= this->g_ops.size())
+        {//Not the start of an instruction
+            return false;
+        }
+
+        if (vJumpPoint._type == codeg::JumpPointTypes::JUMP_POINT_JUMP_SOURCE)
+        {
+            if ( (index+2 >= this->g_ops.size()) ||
+                 (this->g_ops[index]._code != (codeg::OPCODE_BJMPSRC3_CLK | codeg::READABLE_SOURCE)) ||
+                 (this->g_ops[index+1]._code != (codeg::OPCODE_BJMPSRC2_CLK | codeg::READABLE_SOURCE)) ||
+                 (this->g_ops[index+2]._code != (codeg::OPCODE_BJMPSRC1_CLK | codeg::READABLE_SOURCE)) )
+            {//Not a jump source sequence
+                return false;
+            }
+            this->g_jumpSources[index] = vJumpPoint._labelName;
+            this->g_jumpSources[index+1] = vJumpPoint._labelName;
+            this->g_jumpSources[index+2] = vJumpPoint._labelName;
+        }
+        else if ( tableLabels.count(vJumpPoint._labelName) > 0 )
+        {//Address of a jump table
+            this->g_tableSources[index] = vJumpPoint._labelName;
+        }
+        else
+        {//Return address of a call
+            if ( this->g_labels.find(vJumpPoint._labelName) == this->g_labels.end() )
+            {
+                return false;
+            }
+            this->g_returnSources[index] = vJumpPoint._labelName;
+        }
+    }
+    this->updateReturnPoints();
+
+    ///Jump tables
+    this->g_tableOps.assign(this->g_ops.size()+1, false);
+    this->g_jumpReloads.assign(this->g_ops.size()+1, false);
+    for (auto&& vTable : data._jumps._jumpTables)
+    {
+        std::map<std::string, std::size_t>::const_iterator itLabel = this->g_labels.find(vTable._labelName);
+        std::size_t padding = this->getOpIndex(vTable._paddingStatic);
+        if ( (itLabel == this->g_labels.end()) || (padding > itLabel->second) ||
+             (itLabel->second + 5*vTable._entryCount > this->g_ops.size()) )
+        {
+            return false;
+        }
+
+        for (std::size_t i=padding; i<itLabel->second; ++i)
+        {//The padding is computed again when encoding
+            if (this->g_ops[i]._code != codeg::OPCODE_JMPSRC_CLK)
+            {
+                return false;
+            }
+            this->g_ops[i]._removed = true;
+            this->g_tableOps[i] = true;
+        }
+        for (std::size_t i=itLabel->second; i<itLabel->second + 5*vTable._entryCount; ++i)
+        {//Entries : BJMPSRC3/2/1, JMPSRC and a padding byte
+            std::size_t position = (i - itLabel->second)%5;
+            if ( (position < 3) ? (this->g_jumpSources.find(i) == this->g_jumpSources.end()) :
+                                  (this->g_ops[i]._code != codeg::OPCODE_JMPSRC_CLK) )
+            {
+                return false;
+            }
+            this->g_tableOps[i] = true;
+        }
+        this->g_tables.push_back({vTable._labelName, itLabel->second, vTable._entryCount});
+    }
+
+    ///RAM locations
+    for (auto&& vPool : data._pools.getPools())
+    {
+        std::vector<std::size_t> locations;
+        std::map<codeg::Address, std::size_t> slots;
+
+        codeg::Address offset = 0;
+        for (auto&& vVariable : vPool.getVariables())
+        {
+            slots[offset] = this->g_locationCount;
+            locations.push_back(this->g_locationCount);
+            if ( vPool.isObservable() )
+            {
+                this->g_observableLocations.push_back(this->g_locationCount);
+            }
+            for (auto&& vLink : vVariable._link)
+            {
+                this->g_ramLinks[vLink] = {true, this->g_locationCount, this->g_poolLocations.size(), false};
+            }
+            ++this->g_locationCount;
+            ++offset;
+        }
+
+        for (auto&& vLink : vPool._link)
+        {
+            std::map<codeg::Address, std::size_t>::const_iterator it = slots.find(vLink._offset);
+            if (it == slots.end())
+            {
+                it = slots.insert({vLink._offset, this->g_locationCount++}).first;
+                locations.push_back(it->second);
+            }
+            this->g_ramLinks[vLink._address] = {true, it->second, this->g_poolLocations.size(), true};
+        }
+
+        this->g_poolLocations.push_back(std::move(locations));
+        this->g_poolVariableCount.push_back(vPool.getVariables().size());
+        this->g_poolLinked.push_back(!vPool._link.empty());
+        this->g_poolInfos.push_back({vPool.getStartAddressType() == codeg::Pool::StartAddressTypes::START_ADDRESS_STATIC,
+                                     vPool.getStartAddress(), vPool.getMaxSize()});
+    }
+    this->g_overlays.resize(this->g_poolLocations.size());
+    this->g_pageLocks.assign(this->g_poolLocations.size(), false);
+
+    for (auto&& vLink : this->g_ramLinks)
+    {
+        std::size_t index = this->getOpIndex(vLink.first);
+        if ( (index+1 >= this->g_ops.size()) || !this->isAddressPair(index) )
+        {//Not a RAM address sequence
+            return false;
+        }
+    }
+
+    return true;
+}
+void Optimizer::encode(codeg::CompilerData& data)
+{
+    std::vector<codeg::Address> newAddress;
+    std::map<std::size_t, codeg::Address> bodyAddress; //Copy of the instructions in a subroutine
+    this->computeLayout(newAddress, bodyAddress);
+
+    std::vector<codeg::MicroOp> callOps;
+    std::vector<codeg::MicroOp> returnOps;
+    codeg::MakeOutlineOps(this->g_writeDummy, callOps, returnOps);
+
+    std::vector<std::size_t> order;
+    this->getOrder(order);
+
+    ///Labels
+    for (auto&& vLabel : data._jumps._labels)
+    {
+        vLabel._addressStatic = newAddress[this->getOpIndex(vLabel._addressStatic)];
+    }
+
+    ///Jump points
+    for (std::list<codeg::JumpPoint>::iterator it=data._jumps._jumpPoints.begin(); it!=data._jumps._jumpPoints.end();)
+    {
+        std::size_t index = this->getOpIndex(it->_addressStatic);
+        if ( (it->_type == codeg::JumpPointTypes::JUMP_POINT_JUMP_SOURCE) && (index+2 < this->g_ops.size()) &&
+             (this->g_jumpReloads[index] || this->g_jumpReloads[index+1] || this->g_jumpReloads[index+2]) )
+        {//Only the remaining bytes of the address are written
+            static const codeg::JumpPointTypes types[3] = {codeg::JumpPointTypes::JUMP_POINT_BYTE_MSB,
+                                                           codeg::JumpPointTypes::JUMP_POINT_BYTE_MID,
+                                                           codeg::JumpPointTypes::JUMP_POINT_BYTE_LSB};
+            for (std::size_t i=0; i<3; ++i)
+            {
+                if ( !this->g_ops[index+i]._removed )
+                {
+                    data._jumps._jumpPoints.insert(it, {this->g_jumpSources[index+i], newAddress[index+i], types[i]});
+                }
+            }
+            it = data._jumps._jumpPoints.erase(it);
+        }
+        else if (this->g_ops[index]._removed)
+        {
+            it = data._jumps._jumpPoints.erase(it);
+        }
+        else
+        {
+            it->_addressStatic = newAddress[index];
+            if (it->_type == codeg::JumpPointTypes::JUMP_POINT_JUMP_SOURCE)
+            {
+                it->_labelName = this->g_jumpSources[index];
+            }
+            else if ( this->g_tableSources.find(index) == this->g_tableSources.end() )
+            {
+                it->_labelName = this->g_returnSources[index];
+            }
+            ++it;
+        }
+    }
+
+    ///Labels that share the same address
+    std::map<codeg::Address, std::string> addressLabels;
+    std::map<std::string, std::string> mergedLabels;
+    for (std::list<codeg::Label>::iterator it=data._jumps._labels.begin(); it!=data._jumps._labels.end();)
+    {
+        std::map<codeg::Address, std::string>::const_iterator itAddress = addressLabels.find(it->_addressStatic);
+        if (itAddress == addressLabels.end())
+        {
+            addressLabels[it->_addressStatic] = it->_name;
+            ++it;
+        }
+        else
+        {//Replaced by the first label with this address
+            mergedLabels[it->_name] = itAddress->second;
+            data._jumps._mergedLabels.push_back(*it);
+            it = data._jumps.removeLabel(it);
+        }
+    }
+    for (auto&& vJumpPoint : data._jumps._jumpPoints)
+    {
+        std::map<std::string, std::string>::const_iterator it = mergedLabels.find(vJumpPoint._labelName);
+        if (it != mergedLabels.end())
+        {
+            vJumpPoint._labelName = it->second;
+        }
+    }
+
+    ///RAM links
+    for (auto&& vPool : data._pools.getPools())
+    {
+        for (auto&& vVariable : vPool.getVariables())
+        {
+            std::list<codeg::Address> bodyLinks;
+            for (std::list<codeg::Address>::iterator it=vVariable._link.begin(); it!=vVariable._link.end();)
+            {
+                std::size_t index = this->getOpIndex(*it);
+                std::map<std::size_t, codeg::Address>::const_iterator itBody = bodyAddress.find(index);
+                if (itBody != bodyAddress.end())
+                {//Copied in a subroutine
+                    bodyLinks.push_back(itBody->second);
+                }
+
+                if (this->g_ops[index]._removed)
+                {
+                    std::map<std::size_t, std::size_t>::const_iterator itLsb = this->g_lsbLinks.find(index);
+                    if (itLsb != this->g_lsbLinks.end())
+                    {//Only the LSB is written
+                        vVariable._linkLsb.push_back(newAddress[itLsb->second]);
+                    }
+                    it = vVariable._link.erase(it);
+                }
+                else
+                {
+                    *it = newAddress[index];
+                    ++it;
+                }
+            }
+            vVariable._link.splice(vVariable._link.end(), bodyLinks);
+        }
+
+        std::list<codeg::Pool::PoolLink> bodyLinks;
+        for (std::list<codeg::Pool::PoolLink>::iterator it=vPool._link.begin(); it!=vPool._link.end();)
+        {
+            std::size_t index = this->getOpIndex(it->_address);
+            std::map<std::size_t, codeg::Address>::const_iterator itBody = bodyAddress.find(index);
+            if (itBody != bodyAddress.end())
+            {//Copied in a subroutine
+                bodyLinks.push_back({itBody->second, it->_offset});
+            }
+
+            if (this->g_ops[index]._removed)
+            {
+                it = vPool._link.erase(it);
+            }
+            else
+            {
+                it->_address = newAddress[index];
+                ++it;
+            }
+        }
+        vPool._link.splice(vPool._link.end(), bodyLinks);
+    }
+
+    ///RAM overlay and placement
+    std::size_t poolIndex = 0;
+    for (auto&& vPool : data._pools.getPools())
+    {
+        if ( !this->g_overlays[poolIndex].empty() )
+        {
+            vPool.setOverlay(this->g_overlays[poolIndex]);
+        }
+        if ( this->g_pageLocks[poolIndex] )
+        {
+            vPool.setPageLocked(true);
+        }
+        ++poolIndex;
+    }
+
+    ///Return address of the outlined sequences
+    codeg::Variable* outlineVariables[2] = {nullptr, nullptr};
+    if ( !this->g_outlines.empty() )
+    {
+        codeg::Pool outlinePool("%%outline");
+        outlinePool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+        outlinePool.setAddress(0x00, 0x0000);
+        outlinePool.addVariable({"MID", {}, {}});
+        outlinePool.addVariable({"LSB", {}, {}});
+        outlinePool.setPageLocked(true);
+        data._pools.addPool(outlinePool);
+
+        codeg::Pool* pool = data._pools.getPool("%%outline");
+        outlineVariables[0] = pool->getVariable("MID");
+        outlineVariables[1] = pool->getVariable("LSB");
+    }
+
+    ///Code
+    auto pushOp = [&](const codeg::MicroOp& op)
+    {
+        data._code.push(op._code);
+        if (op._size == 2)
+        {
+            data._code.push(op._argument);
+        }
+    };
+    auto pushIndex = [&](std::size_t index)
+    {
+        data._code.setOrigin(this->g_opOrigins[index]);
+        pushOp(this->g_ops[index]);
+    };
+
+    auto pushOutlines = [&]()
+    {
+        for (auto&& vOutline : this->g_outlines)
+        {
+            data._jumps.addLabel({vOutline._label, 0, data._code.getCursor()});
+            for (std::size_t index : vOutline._body)
+            {
+                pushIndex(index);
+            }
+
+            outlineVariables[0]->_link.push_back(data._code.getCursor());
+            outlineVariables[1]->_linkLsb.push_back(data._code.getCursor() + codeg::GetOutlineSize(returnOps, 3));
+            for (auto&& vOp : returnOps)
+            {
+                pushOp(vOp);
+            }
+        }
+    };
+    auto pushCall = [&](const codeg::Optimizer::Outline& outline, std::size_t site)
+    {
+        codeg::Address start = data._code.getCursor();
+        std::string returnLabel = outline._label+"_"+std::to_string(site+1);
+
+        outlineVariables[0]->_link.push_back(start);
+        data._jumps._jumpPoints.push_back({returnLabel, start + codeg::GetOutlineSize(callOps, 2), codeg::JumpPointTypes::JUMP_POINT_BYTE_MID});
+        outlineVariables[1]->_linkLsb.push_back(start + codeg::GetOutlineSize(callOps, 3));
+        data._jumps._jumpPoints.push_back({returnLabel, start + codeg::GetOutlineSize(callOps, 4), codeg::JumpPointTypes::JUMP_POINT_BYTE_LSB});
+        data._jumps._jumpPoints.push_back({outline._label, start + codeg::GetOutlineSize(callOps, 5), codeg::JumpPointTypes::JUMP_POINT_JUMP_SOURCE});
+        for (auto&& vOp : callOps)
+        {
+            pushOp(vOp);
+        }
+        data._jumps.addLabel({returnLabel, 0, data._code.getCursor()});
+    };
+
+    data._code.resize(data._code.getCapacity());
+    for (std::size_t i : order)
+    {
+        if ( (i == this->g_outlineIndex) && !this->g_outlines.empty() )
+        {
+            pushOutlines();
+        }
+
+        std::map<std::size_t, std::vector<std::size_t> >::const_iterator itHoisted = this->g_hoisted.find(i);
+        if (itHoisted != this->g_hoisted.end())
+        {
+            for (std::size_t index : itHoisted->second)
+            {
+                pushIndex(index);
+            }
+        }
+
+        data._code.setOrigin(this->g_opOrigins[i]);
+        if ( this->isTableStart(i) )
+        {//Padding (never executed, the previous instruction is a jump)
+            while ( (data._code.getCursor() & 0xFF) != 0 )
+            {
+                data._code.push(codeg::OPCODE_JMPSRC_CLK);
+            }
+        }
+        if ( !this->g_ops[i]._removed && !this->g_ops[i]._moved )
+        {
+            pushIndex(i);
+        }
+
+        std::map<std::size_t, std::size_t>::const_iterator itSite = this->g_outlineSites.find(i);
+        if (itSite != this->g_outlineSites.end())
+        {
+            data._code.setOrigin(this->g_opOrigins[i]);
+            const codeg::Optimizer::Outline& outline = this->g_outlines[itSite->second];
+            pushCall(outline, std::find(outline._sites.begin(), outline._sites.end(), i) - outline._sites.begin());
+        }
+    }
+    if ( (this->g_outlineIndex == this->g_ops.size()) && !this->g_outlines.empty() )
+    {
+        pushOutlines();
+    }
+}
+
+void Optimizer::getOrder(std::vector<std::size_t>& order) const
+{
+    if ( !this->g_order.empty() )
+    {
+        order = this->g_order;
+        return;
+    }
+    order.resize(this->g_ops.size());
+    std::iota(order.begin(), order.end(), 0);
+}
+void Optimizer::computeLayout(std::vector<codeg::Address>& newAddress, std::map<std::size_t, codeg::Address>& bodyAddress) const
+{
+    newAddress.assign(this->g_ops.size()+1, 0);
+    bodyAddress.clear();
+
+    std::vector<codeg::MicroOp> callOps;
+    std::vector<codeg::MicroOp> returnOps;
+    codeg::MakeOutlineOps(this->g_writeDummy, callOps, returnOps);
+
+    std::vector<std::size_t> order;
+    this->getOrder(order);
+
+    codeg::Address cursor = 0;
+    auto placeOutlines = [&]()
+    {
+        for (auto&& vOutline : this->g_outlines)
+        {
+            for (std::size_t index : vOutline._body)
+            {
+                bodyAddress[index] = cursor;
+                cursor += this->g_ops[index]._size;
+            }
+            cursor += codeg::GetOutlineSize(returnOps, returnOps.size());
+        }
+    };
+
+    for (std::size_t i : order)
+    {
+        if ( (i == this->g_outlineIndex) && !this->g_outlines.empty() )
+        {//Never reached by the previous instruction (unconditional jump)
+            placeOutlines();
+        }
+
+        std::map<std::size_t, std::vector<std::size_t> >::const_iterator itHoisted = this->g_hoisted.find(i);
+        if (itHoisted != this->g_hoisted.end())
+        {//Placed before the loop header (and before its label)
+            for (std::size_t index : itHoisted->second)
+            {
+                newAddress[index] = cursor;
+                cursor += this->g_ops[index]._size;
+            }
+        }
+
+        if (this->g_ops[i]._moved)
+        {
+            continue;
+        }
+        if ( this->isTableStart(i) )
+        {//Aligned to a 256 bytes page
+            cursor = (cursor + 0xFF) & ~codeg::Address(0xFF);
+        }
+        newAddress[i] = cursor;
+        if (!this->g_ops[i]._removed)
+        {
+            cursor += this->g_ops[i]._size;
+        }
+        if (this->g_outlineSites.find(i) != this->g_outlineSites.end())
+        {//Replaced by a call
+            cursor += codeg::GetOutlineSize(callOps, callOps.size());
+        }
+    }
+    if ( (this->g_outlineIndex == this->g_ops.size()) && !this->g_outlines.empty() )
+    {
+        placeOutlines();
+    }
+    newAddress[this->g_ops.size()] = cursor;
+}
+
+void Optimizer::buildControlFlow()
+{
+    std::size_t opSize = this->g_ops.size();
+
+    ///Leaders
+    std::vector<bool> leaders(opSize+1, false);
+    leaders[0] = true;
+    for (std::size_t i=0; i<opSize; ++i)
+    {
+        if ( this->g_labelOps[i] )
+        {
+            leaders[i] = true;
+        }
+        if ( this->g_ops[i]._removed )
+        {
+            continue;
+        }
+
+        uint8_t opcode = this->g_ops[i].getOpcode();
+        if (opcode == codeg::OPCODE_JMPSRC_CLK)
+        {
+            leaders[this->getNextOp(i)] = true;
+        }
+        else if ( (opcode == codeg::OPCODE_IF) || (opcode == codeg::OPCODE_IFNOT) )
+        {//The next instruction can be skipped
+            std::size_t next = this->getNextOp(i);
+            leaders[next] = true;
+            leaders[this->getNextOp(next)] = true;
+        }
+    }
+
+    ///Blocks
+    this->g_blocks.clear();
+    this->g_opBlock.assign(opSize+1, 0);
+    for (std::size_t i=0; i<opSize; ++i)
+    {
+        if (leaders[i])
+        {
+            if ( !this->g_blocks.empty() )
+            {
+                this->g_blocks.back()._end = i;
+            }
+            this->g_blocks.push_back({i, opSize, {}, false, false});
+        }
+        this->g_opBlock[i] = this->g_blocks.size()-1;
+    }
+    this->g_opBlock[opSize] = this->g_blocks.size(); //End of the code
+
+    auto addSuccessor = [&](codeg::Optimizer::Block& block, std::size_t opIndex)
+    {
+        if (opIndex >= opSize)
+        {
+            block._exit = true;
+        }
+        else
+        {
+            block._successors.push_back(this->g_opBlock[opIndex]);
+        }
+    };
+
+    ///Successors
+    codeg::JumpLatch latches[3];
+    for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+    {
+        codeg::Optimizer::Block& block = this->g_blocks[b];
+
+        std::size_t last = opSize;
+        for (std::size_t i=block._begin; i<block._end; ++i)
+        {
+            if (this->g_labelOps[i])
+            {//A label can be reached from anywhere
+                latches[0] = latches[1] = latches[2] = {codeg::LatchTypes::LATCH_UNKNOWN, "", 0};
+            }
+            if ( this->g_ops[i]._removed && !this->g_jumpReloads[i] )
+            {
+                continue;
+            }
+            if ( !this->g_ops[i]._removed )
+            {
+                last = i;
+            }
+
+            const codeg::MicroOp& op = this->g_ops[i];
+            uint8_t opcode = op.getOpcode();
+            if ( (opcode == codeg::OPCODE_BJMPSRC3_CLK) || (opcode == codeg::OPCODE_BJMPSRC2_CLK) || (opcode == codeg::OPCODE_BJMPSRC1_CLK) )
+            {
+                codeg::JumpLatch& latch = latches[codeg::OPCODE_BJMPSRC3_CLK - opcode];
+
+                std::map<std::size_t, std::string>::const_iterator it = this->g_jumpSources.find(i);
+                std::map<std::size_t, std::string>::const_iterator itTable = this->g_tableSources.find(i);
+                if (it != this->g_jumpSources.end())
+                {
+                    latch = {codeg::LatchTypes::LATCH_LABEL, it->second, 0};
+                }
+                else if (itTable != this->g_tableSources.end())
+                {
+                    latch = {codeg::LatchTypes::LATCH_LABEL, itTable->second, 0};
+                }
+                else if (op.getBus() == codeg::ReadableBusses::READABLE_SOURCE)
+                {
+                    latch = {codeg::LatchTypes::LATCH_CONSTANT, "", op._argument};
+                }
+                else
+                {
+                    latch = {codeg::LatchTypes::LATCH_COMPUTED, "", 0};
+                }
+            }
+        }
+
+        if (last == opSize)
+        {//Only removed instructions
+            addSuccessor(block, block._end);
+            continue;
+        }
+
+        uint8_t opcode = this->g_ops[last].getOpcode();
+        if (opcode == codeg::OPCODE_JMPSRC_CLK)
+        {
+            if ( (latches[0]._type == codeg::LatchTypes::LATCH_LABEL) &&
+                 (latches[1]._type == codeg::LatchTypes::LATCH_LABEL) &&
+                 (latches[2]._type == codeg::LatchTypes::LATCH_LABEL) &&
+                 (latches[0]._label == latches[1]._label) && (latches[1]._label == latches[2]._label) )
+            {//Jump to a label
+                addSuccessor(block, this->g_labels[latches[0]._label]);
+            }
+            else if ( (latches[0]._type == codeg::LatchTypes::LATCH_CONSTANT) &&
+                      (latches[1]._type == codeg::LatchTypes::LATCH_CONSTANT) &&
+                      (latches[2]._type == codeg::LatchTypes::LATCH_CONSTANT) &&
+                      ((latches[0]._value | latches[1]._value | latches[2]._value) == 0) )
+            {//Jump to the start of the program
+                addSuccessor(block, 0);
+            }
+            else if ( (latches[0]._type == codeg::LatchTypes::LATCH_LABEL) &&
+                      (latches[1]._type == codeg::LatchTypes::LATCH_LABEL) &&
+                      (latches[2]._type == codeg::LatchTypes::LATCH_COMPUTED) &&
+                      (latches[0]._label == latches[1]._label) &&
+                      std::any_of(this->g_tables.begin(), this->g_tables.end(), [&](const codeg::Optimizer::JumpTable& table){ return table._label == latches[0]._label; }) )
+            {//Computed jump in a jump table, any entry can be reached
+                for (auto&& vTable : this->g_tables)
+                {
+                    if (vTable._label != latches[0]._label)
+                    {
+                        continue;
+                    }
+                    for (std::size_t e=0; e<vTable._entryCount; ++e)
+                    {
+                        addSuccessor(block, vTable._begin + 5*e);
+                    }
+                }
+            }
+            else if ( (latches[0]._type != codeg::LatchTypes::LATCH_UNKNOWN) &&
+                      (latches[1]._type != codeg::LatchTypes::LATCH_UNKNOWN) &&
+                      (latches[2]._type != codeg::LatchTypes::LATCH_UNKNOWN) &&
+                      !this->g_returnPoints.empty() )
+            {//Computed jump, can only be a function return
+                for (std::size_t returnPoint : this->g_returnPoints)
+                {
+                    addSuccessor(block, returnPoint);
+                }
+            }
+            else
+            {
+                block._exit = true;
+                block._unknownJump = true;
+            }
+        }
+        else if ( (opcode == codeg::OPCODE_IF) || (opcode == codeg::OPCODE_IFNOT) )
+        {
+            std::size_t next = this->getNextOp(last);
+            addSuccessor(block, next);
+            addSuccessor(block, this->getNextOp(next));
+        }
+        else
+        {
+            addSuccessor(block, block._end);
+        }
+    }
+}
+
+uint32_t Optimizer::threadJumps()
+{
+    uint32_t count = 0;
+
+    //Jumps to a jump
+    for (auto&& vJumpSource : this->g_jumpSources)
+    {
+        std::size_t index = vJumpSource.first;
+        if ( (this->g_ops[index].getOpcode() != codeg::OPCODE_BJMPSRC3_CLK) || this->g_ops[index]._removed )
+        {
+            continue;
+        }
+
+        std::string label = this->getFinalLabel(vJumpSource.second);
+        if (label != vJumpSource.second)
+        {
+            this->g_jumpSources[index] = label;
+            this->g_jumpSources[index+1] = label;
+            this->g_jumpSources[index+2] = label;
+            ++count;
+        }
+    }
+
+    //Calls that return on a jump
+    for (auto&& vReturnSource : this->g_returnSources)
+    {
+        if ( this->g_ops[vReturnSource.first]._removed )
+        {
+            continue;
+        }
+
+        std::string label = this->getFinalLabel(vReturnSource.second);
+        if (label != vReturnSource.second)
+        {
+            vReturnSource.second = label;
+            ++count;
+        }
+    }
+    this->updateReturnPoints();
+
+    return count;
+}
+uint32_t Optimizer::removeUselessJumps()
+{
+    uint32_t count = 0;
+
+    for (std::size_t i=0; i<this->g_ops.size(); ++i)
+    {
+        std::string label;
+        if ( this->g_ops[i]._removed || !this->isLabelJump(i, label) || !this->isRemovable(i) )
+        {
+            continue;
+        }
+
+        std::size_t jumpSource = this->getNextOp(this->getNextOp(this->getNextOp(i)));
+        std::size_t target = this->g_labels[label];
+        if ( (target < this->g_ops.size()) && this->g_ops[target]._removed )
+        {
+            target = this->getNextOp(target);
+        }
+
+        if ( target == this->getNextOp(jumpSource) )
+        {//Jump to the next instruction
+            for (std::size_t j=i; j<=jumpSource; ++j)
+            {
+                this->g_ops[j]._removed = true;
+            }
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::removeUnreachableCode()
+{
+    this->buildControlFlow();
+
+    std::vector<bool> reachable(this->g_blocks.size(), false);
+    std::vector<std::size_t> pending;
+    if ( !this->g_blocks.empty() )
+    {
+        pending.push_back(0);
+    }
+
+    bool anyLabel = false;
+    while ( !pending.empty() )
+    {
+        std::size_t b = pending.back();
+        pending.pop_back();
+
+        if (reachable[b])
+        {
+            continue;
+        }
+        reachable[b] = true;
+
+        const codeg::Optimizer::Block& block = this->g_blocks[b];
+        pending.insert(pending.end(), block._successors.begin(), block._successors.end());
+
+        if (block._unknownJump && !anyLabel)
+        {//Every label can be reached
+            anyLabel = true;
+            for (std::size_t i=0; i<this->g_blocks.size(); ++i)
+            {
+                if ( this->g_labelOps[this->g_blocks[i]._begin] )
+                {
+                    pending.push_back(i);
+                }
+            }
+        }
+    }
+
+    uint32_t size = 0;
+    for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+    {
+        if (reachable[b])
+        {
+            continue;
+        }
+
+        for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+        {
+            if ( !this->g_ops[i]._removed && !this->g_tableOps[i] )
+            {
+                this->g_ops[i]._removed = true;
+                size += this->g_ops[i]._size;
+            }
+        }
+    }
+    return size;
+}
+
+uint32_t Optimizer::removeDeadStores()
+{
+    uint32_t count = 0;
+    std::size_t addressLocation = this->g_locationCount;
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        this->buildControlFlow();
+        this->computeRamTargets();
+
+        std::vector<codeg::Optimizer::LocationSet> liveOut;
+        this->computeLiveness(liveOut);
+
+        for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+        {
+            const codeg::Optimizer::Block& block = this->g_blocks[b];
+            codeg::Optimizer::LocationSet live = liveOut[b];
+
+            for (std::size_t i=block._end; i>block._begin;)
+            {
+                --i;
+                codeg::MicroOp& op = this->g_ops[i];
+                if (op._removed)
+                {
+                    continue;
+                }
+
+                const codeg::RamTarget& target = this->g_ramTargets[i];
+                if ( (op.getOpcode() == codeg::OPCODE_RAMW) && target._known && !live[target._location] &&
+                     ((op.getBus() == codeg::ReadableBusses::READABLE_SOURCE) || (op.getBus() == codeg::ReadableBusses::READABLE_RESULT)) &&
+                     this->isRemovable(i) )
+                {//The written value is never read
+                    op._removed = true;
+                    ++count;
+                    changed = true;
+
+                    std::size_t address1 = this->getPreviousOp(i);
+                    std::size_t address2 = this->getPreviousOp(address1);
+                    if ( !live[addressLocation] && (address2 < i) && (address2 >= block._begin) &&
+                         this->isAddressPair(address2) && (this->getNextOp(address2) == address1) &&
+                         (this->g_ramLinks.find(this->g_ops[address2]._address) != this->g_ramLinks.end()) &&
+                         this->isRemovable(address2) && !this->g_labelOps[address1] )
+                    {//The address is not used anymore
+                        this->g_ops[address1]._removed = true;
+                        this->g_ops[address2]._removed = true;
+                        i = address2;
+                    }
+                    continue;
+                }
+
+                this->applyLiveness(i, live);
+            }
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::applyPeephole(codeg::Peephole& peephole)
+{
+    struct Entry
+    {
+        std::size_t _index;
+        std::size_t _state; //State of the automaton after this instruction
+    };
+
+    uint32_t count = 0;
+    std::size_t opSize = this->g_ops.size();
+
+    std::vector<Entry> history; //Instructions that can be part of a sequence
+    std::vector<codeg::PeepholeValue> window;
+    std::vector<uint8_t> opcodes;
+    std::map<std::string, codeg::PeepholeValue> values;
+    std::vector<codeg::PeepholeInstruction> replacement;
+
+    std::size_t state = 0;
+    std::size_t i = 0;
+    while (i < opSize)
+    {
+        if ( this->g_labelOps[i] )
+        {//A sequence can start at a label but can't contain it
+            history.clear();
+            state = 0;
+        }
+
+        codeg::MicroOp& op = this->g_ops[i];
+        if (op._removed)
+        {
+            ++i;
+            continue;
+        }
+        if ( op._moved || this->isRelocated(i) )
+        {//The relocations are kept as they are
+            history.clear();
+            state = 0;
+            ++i;
+            continue;
+        }
+
+        state = peephole.getNextState(state, op.getOpcode());
+        history.push_back({i, state});
+
+        bool applied = false;
+        for (std::size_t rule : peephole.getMatches(state))
+        {
+            std::size_t size = peephole.getRules()[rule]._pattern.size();
+            std::size_t first = history[history.size()-size]._index;
+
+            std::size_t previous = this->getPreviousOp(first);
+            if ( (previous < opSize) &&
+                 ((this->g_ops[previous].getOpcode() == codeg::OPCODE_IF) || (this->g_ops[previous].getOpcode() == codeg::OPCODE_IFNOT)) )
+            {//The skipped instruction would change
+                continue;
+            }
+
+            window.clear();
+            opcodes.clear();
+            for (std::size_t h=history.size()-size; h<history.size(); ++h)
+            {
+                const codeg::MicroOp& windowOp = this->g_ops[history[h]._index];
+                window.push_back({windowOp.getBus(), windowOp.hasArgument() ? windowOp._argument : uint8_t(0)});
+                opcodes.push_back(windowOp.getOpcode());
+            }
+            if ( !peephole.match(rule, window, opcodes, values) )
+            {
+                continue;
+            }
+
+            ///The replacement take the place of the first instructions
+            peephole.getReplacement(rule, values, replacement);
+            for (std::size_t r=0; r<size; ++r)
+            {
+                codeg::MicroOp& windowOp = this->g_ops[history[history.size()-size+r]._index];
+                if (r >= replacement.size())
+                {
+                    windowOp._removed = true;
+                    continue;
+                }
+
+                const codeg::PeepholeOperand& operand = replacement[r]._operand;
+                bool constant = (operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_CONSTANT);
+                windowOp._code = replacement[r]._opcode | (constant ? uint8_t(codeg::ReadableBusses::READABLE_SOURCE) : operand._value);
+                windowOp._argument = constant ? operand._value : 0;
+                windowOp._size = ( windowOp.hasArgument() || (this->g_writeDummy && (windowOp.getOpcode() != codeg::OPCODE_JMPSRC_CLK)) ) ? 2 : 1;
+            }
+            peephole.addHit(rule);
+            ++count;
+
+            //The replacement can start another sequence
+            history.resize(history.size()-size);
+            state = history.empty() ? 0 : history.back()._state;
+            i = first;
+            applied = true;
+            break;
+        }
+
+        if (!applied)
+        {
+            ++i;
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::computeOverlays()
+{
+    std::size_t addressLocation = this->g_locationCount;
+    std::size_t setSize = this->g_locationCount+1;
+
+    this->buildControlFlow();
+    this->computeRamTargets();
+
+    for (std::size_t i=0; i<this->g_ops.size(); ++i)
+    {
+        const codeg::MicroOp& op = this->g_ops[i];
+        if ( op._removed )
+        {
+            continue;
+        }
+        if ( ((op.getBus() == codeg::ReadableBusses::READABLE_RAM) || (op.getOpcode() == codeg::OPCODE_RAMW)) &&
+             !this->g_ramTargets[i]._known )
+        {//Absolute or computed RAM address, the variables can be accessed without their names
+            return 0;
+        }
+    }
+
+    std::vector<codeg::Optimizer::LocationSet> liveOut;
+    this->computeLiveness(liveOut);
+
+    ///Interference graph
+    std::vector<codeg::Optimizer::LocationSet> interference(setSize, codeg::Optimizer::LocationSet(setSize, false));
+    auto addLiveSet = [&](const codeg::Optimizer::LocationSet& live)
+    {
+        std::vector<std::size_t> locations;
+        for (std::size_t i=0; i<addressLocation; ++i)
+        {
+            if (live[i])
+            {
+                locations.push_back(i);
+            }
+        }
+        for (std::size_t a=0; a<locations.size(); ++a)
+        {
+            for (std::size_t b=a+1; b<locations.size(); ++b)
+            {
+                interference[locations[a]][locations[b]] = true;
+                interference[locations[b]][locations[a]] = true;
+            }
+        }
+    };
+
+    for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+    {
+        const codeg::Optimizer::Block& block = this->g_blocks[b];
+        if ( std::all_of(this->g_ops.begin()+block._begin, this->g_ops.begin()+block._end, [](const codeg::MicroOp& op){ return op._removed; }) )
+        {//Removed code
+            continue;
+        }
+
+        codeg::Optimizer::LocationSet live = liveOut[b];
+        addLiveSet(live);
+
+        for (std::size_t i=block._end; i>block._begin;)
+        {
+            --i;
+            if (this->g_ops[i]._removed)
+            {
+                continue;
+            }
+
+            const codeg::RamTarget& target = this->g_ramTargets[i];
+            if ( (this->g_ops[i].getOpcode() == codeg::OPCODE_RAMW) && target._known )
+            {//The written variable can't share its address with a variable that is still needed
+                for (std::size_t l=0; l<addressLocation; ++l)
+                {
+                    if ( live[l] && (l != target._location) )
+                    {
+                        interference[l][target._location] = true;
+                        interference[target._location][l] = true;
+                    }
+                }
+            }
+
+            codeg::Optimizer::LocationSet previous = live;
+            this->applyLiveness(i, live);
+            if (live != previous)
+            {
+                addLiveSet(live);
+            }
+        }
+    }
+
+    ///Coloring every pool
+    uint32_t saved = 0;
+    for (std::size_t p=0; p<this->g_poolLocations.size(); ++p)
+    {
+        this->g_overlays[p].clear();
+
+        std::size_t count = this->g_poolVariableCount[p];
+        if ( this->g_poolLinked[p] || (count < 2) )
+        {//The pool is used as an array
+            continue;
+        }
+
+        const std::vector<std::size_t>& locations = this->g_poolLocations[p];
+        std::vector<codeg::MemoryAddress> offsets(count, 0);
+        codeg::MemoryAddress maxOffset = 0;
+
+        for (std::size_t v=0; v<count; ++v)
+        {
+            std::vector<bool> used(count, false);
+            for (std::size_t u=0; u<v; ++u)
+            {
+                if ( interference[locations[v]][locations[u]] )
+                {
+                    used[offsets[u]] = true;
+                }
+            }
+
+            codeg::MemoryAddress offset = 0;
+            while ( used[offset] )
+            {
+                ++offset;
+            }
+            offsets[v] = offset;
+            maxOffset = std::max(maxOffset, offset);
+        }
+
+        if (static_cast<std::size_t>(maxOffset)+1 < count)
+        {
+            saved += count - (maxOffset+1);
+            this->g_overlays[p] = std::move(offsets);
+        }
+    }
+
+    return saved;
+}
+
+void Optimizer::setProfile(const std::map<std::string, uint64_t>& profile)
+{
+    this->g_profile = profile;
+}
+
+void Optimizer::computeLoops()
+{
+    std::size_t blockSize = this->g_blocks.size();
+
+    this->g_loops.clear();
+    this->g_loopDepth.assign(blockSize, 0);
+
+    ///Predecessors
+    std::vector<std::vector<std::size_t> > predecessors(blockSize);
+    bool anyLabel = false;
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        for (std::size_t successor : this->g_blocks[b]._successors)
+        {
+            predecessors[successor].push_back(b);
+        }
+        anyLabel |= this->g_blocks[b]._unknownJump;
+    }
+
+    ///Dominators
+    this->g_dominators.assign(blockSize, codeg::Optimizer::LocationSet(blockSize, true));
+    auto isRoot = [&](std::size_t b)
+    {//Can be reached without a known predecessor
+        return (b == 0) || (anyLabel && this->g_labelOps[this->g_blocks[b]._begin]);
+    };
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (std::size_t b=0; b<blockSize; ++b)
+        {
+            codeg::Optimizer::LocationSet dominators(blockSize, !isRoot(b));
+            if ( !isRoot(b) )
+            {
+                for (std::size_t predecessor : predecessors[b])
+                {
+                    for (std::size_t i=0; i<blockSize; ++i)
+                    {
+                        dominators[i] = dominators[i] && this->g_dominators[predecessor][i];
+                    }
+                }
+            }
+            dominators[b] = true;
+
+            if (dominators != this->g_dominators[b])
+            {
+                this->g_dominators[b] = std::move(dominators);
+                changed = true;
+            }
+        }
+    }
+
+    ///Natural loops (back edges to a dominator)
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        for (std::size_t header : this->g_blocks[b]._successors)
+        {
+            if ( !this->g_dominators[b][header] )
+            {
+                continue;
+            }
+
+            std::vector<codeg::Optimizer::Loop>::iterator itLoop = std::find_if(this->g_loops.begin(), this->g_loops.end(),
+                [&](const codeg::Optimizer::Loop& loop){ return loop._header == header; });
+            if (itLoop == this->g_loops.end())
+            {
+                this->g_loops.push_back({header, codeg::Optimizer::LocationSet(blockSize, false), {}});
+                itLoop = this->g_loops.end()-1;
+                itLoop->_blocks[header] = true;
+            }
+            itLoop->_backEdges.push_back(b);
+
+            std::vector<std::size_t> pending{b};
+            while ( !pending.empty() )
+            {
+                std::size_t actual = pending.back();
+                pending.pop_back();
+                if (itLoop->_blocks[actual])
+                {
+                    continue;
+                }
+                itLoop->_blocks[actual] = true;
+                pending.insert(pending.end(), predecessors[actual].begin(), predecessors[actual].end());
+            }
+        }
+    }
+
+    for (auto&& vLoop : this->g_loops)
+    {
+        for (std::size_t b=0; b<blockSize; ++b)
+        {
+            if (vLoop._blocks[b])
+            {
+                ++this->g_loopDepth[b];
+            }
+        }
+    }
+}
+void Optimizer::computeBlockWeights(std::vector<uint64_t>& weights) const
+{
+    weights.assign(this->g_blocks.size(), 1);
+
+    if ( !this->g_profile.empty() )
+    {//Execution count of the last label
+        std::map<std::size_t, uint64_t> labelCounts;
+        for (auto&& vLabel : this->g_labels)
+        {
+            std::map<std::string, uint64_t>::const_iterator it = this->g_profile.find(vLabel.first);
+            if (it != this->g_profile.end())
+            {
+                labelCounts[vLabel.second] = it->second;
+            }
+        }
+
+        uint64_t count = 1;
+        for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+        {
+            for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+            {
+                std::map<std::size_t, uint64_t>::const_iterator it = labelCounts.find(i);
+                if (it != labelCounts.end())
+                {
+                    count = it->second;
+                }
+            }
+            weights[b] = count;
+        }
+        return;
+    }
+
+    for (std::size_t b=0; b<this->g_blocks.size(); ++b)
+    {//Every loop level is considered to be executed 8 times
+        weights[b] = uint64_t(1) << (3*std::min<std::size_t>(this->g_loopDepth[b], 5));
+    }
+}
+
+uint32_t Optimizer::placeVariables()
+{
+    this->buildControlFlow();
+    this->computeLoops();
+    this->computeRamTargets();
+
+    std::vector<uint64_t> weights;
+    this->computeBlockWeights(weights);
+
+    ///Access count of every variable
+    std::vector<uint64_t> accesses(this->g_locationCount, 0);
+    for (std::size_t i=0; i<this->g_ops.size(); ++i)
+    {
+        if ( this->g_ops[i]._removed || (this->g_ops[i].getOpcode() != codeg::OPCODE_BRAMADD2_CLK) )
+        {
+            continue;
+        }
+        std::map<codeg::Address, codeg::RamTarget>::const_iterator it = this->g_ramLinks.find(this->g_ops[i]._address);
+        if (it != this->g_ramLinks.end())
+        {
+            accesses[it->second._location] += weights[this->g_opBlock[i]];
+        }
+    }
+
+    ///Most accessed variables first
+    uint32_t count = 0;
+    for (std::size_t p=0; p<this->g_poolLocations.size(); ++p)
+    {
+        std::size_t variableCount = this->g_poolVariableCount[p];
+        if ( this->g_poolLinked[p] || (variableCount < 2) )
+        {//The pool is used as an array
+            continue;
+        }
+
+        std::vector<codeg::MemoryAddress> offsets = this->g_overlays[p];
+        if ( offsets.empty() )
+        {
+            for (std::size_t v=0; v<variableCount; ++v)
+            {
+                offsets.push_back(v);
+            }
+        }
+        std::size_t slotCount = *std::max_element(offsets.begin(), offsets.end()) + 1;
+
+        std::vector<uint64_t> slotAccesses(slotCount, 0);
+        for (std::size_t v=0; v<variableCount; ++v)
+        {
+            slotAccesses[offsets[v]] += accesses[this->g_poolLocations[p][v]];
+        }
+
+        std::vector<codeg::MemoryAddress> order(slotCount);
+        for (std::size_t s=0; s<slotCount; ++s)
+        {
+            order[s] = s;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](codeg::MemoryAddress a, codeg::MemoryAddress b){ return slotAccesses[a] > slotAccesses[b]; });
+
+        std::vector<codeg::MemoryAddress> newSlots(slotCount);
+        bool moved = false;
+        for (std::size_t s=0; s<slotCount; ++s)
+        {
+            newSlots[order[s]] = s;
+            moved |= (order[s] != s);
+        }
+        if (!moved)
+        {
+            continue;
+        }
+
+        for (std::size_t v=0; v<variableCount; ++v)
+        {
+            offsets[v] = newSlots[offsets[v]];
+        }
+        this->g_overlays[p] = std::move(offsets);
+        ++count;
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::placeFunctions()
+{
+    std::size_t opSize = this->g_ops.size();
+    if ( this->g_functions.empty() )
+    {
+        return 0;
+    }
+
+    this->buildControlFlow();
+    this->computeLoops();
+    std::vector<uint64_t> weights;
+    this->computeBlockWeights(weights);
+
+    auto isUnconditionalJump = [&](std::size_t index)
+    {
+        if ( (index >= opSize) || (this->g_ops[index].getOpcode() != codeg::OPCODE_JMPSRC_CLK) )
+        {
+            return false;
+        }
+        std::size_t previous = this->getPreviousOp(index);
+        return (previous >= opSize) ||
+               ((this->g_ops[previous].getOpcode() != codeg::OPCODE_IF) && (this->g_ops[previous].getOpcode() != codeg::OPCODE_IFNOT));
+    };
+
+    ///Functions that are only entered and left by a jump
+    std::vector<std::size_t> owners(opSize+1, 0); //0 is the main code
+    std::vector<const codeg::Optimizer::FunctionRange*> functions{nullptr};
+    std::map<std::string, std::size_t> functionLabels;
+    for (auto&& vFunction : this->g_functions)
+    {
+        std::size_t previous = this->getPreviousOp(vFunction._begin);
+        std::size_t last = this->getPreviousOp(vFunction._end);
+        if ( !isUnconditionalJump(previous) || (last < vFunction._begin) || (last >= vFunction._end) || !isUnconditionalJump(last) ||
+             (owners[vFunction._begin] != 0) )
+        {
+            continue;
+        }
+
+        for (std::size_t i=vFunction._begin; i<vFunction._end; ++i)
+        {
+            owners[i] = functions.size();
+        }
+        functionLabels["%%"+vFunction._name] = functions.size();
+        functions.push_back(&vFunction);
+    }
+    if (functions.size() == 1)
+    {
+        return 0;
+    }
+
+    ///Jumps over a function body, useless when the function is moved
+    auto getNextMain = [&](std::size_t index)
+    {
+        while ( (index < opSize) && (this->g_ops[index]._removed || (owners[index] != 0)) )
+        {
+            ++index;
+        }
+        return index;
+    };
+    std::vector<std::pair<std::size_t, std::size_t> > jumpOvers; //First instruction with the jump
+    for (std::size_t f=1; f<functions.size(); ++f)
+    {
+        std::size_t jump = this->getPreviousOp(functions[f]->_begin);
+        std::size_t source = jump;
+        for (std::size_t i=0; (i<3) && (source<opSize); ++i)
+        {
+            source = this->getPreviousOp(source);
+        }
+        std::string label;
+        if ( (source >= opSize) || (owners[source] != 0) || !this->isLabelJump(source, label) || !this->isRemovable(source) )
+        {
+            continue;
+        }
+        std::size_t target = this->g_labels.at(label);
+        if ( (target < opSize) && this->g_ops[target]._removed )
+        {
+            target = this->getNextOp(target);
+        }
+        if ( (target >= opSize) ? (getNextMain(functions[f]->_end) == opSize) :
+                                  ((owners[target] == 0) && (getNextMain(functions[f]->_end) == target)) )
+        {
+            jumpOvers.push_back({source, jump});
+        }
+    }
+
+    ///The functions are placed after the last unconditional jump of the main code
+    std::size_t insertion = opSize+1;
+    for (std::size_t i=0; i<opSize; ++i)
+    {
+        if ( (owners[i] == 0) && !this->g_ops[i]._removed && !this->g_tableOps[i] && isUnconditionalJump(i) &&
+             std::none_of(jumpOvers.begin(), jumpOvers.end(), [&](const std::pair<std::size_t, std::size_t>& jumpOver){ return i == jumpOver.second; }) )
+        {
+            insertion = i+1;
+        }
+    }
+    if (insertion > opSize)
+    {//The end of the main code can be reached by the previous instruction
+        return 0;
+    }
+    for (auto&& vJumpOver : jumpOvers)
+    {
+        std::size_t i = vJumpOver.first;
+        while (i <= vJumpOver.second)
+        {
+            std::size_t next = this->getNextOp(i);
+            this->g_ops[i]._removed = true;
+            i = next;
+        }
+    }
+
+    ///Call graph, the weight of a call is the weight of its block
+    std::map<std::pair<std::size_t, std::size_t>, uint64_t> calls;
+    for (auto&& vJumpSource : this->g_jumpSources)
+    {
+        std::size_t index = vJumpSource.first;
+        std::map<std::string, std::size_t>::const_iterator itFunction = functionLabels.find(vJumpSource.second);
+        if ( (itFunction == functionLabels.end()) || this->g_ops[index]._removed ||
+             (this->g_ops[index].getOpcode() != codeg::OPCODE_BJMPSRC3_CLK) || (owners[index] == itFunction->second) )
+        {
+            continue;
+        }
+        std::pair<std::size_t, std::size_t> edge = std::minmax(owners[index], itFunction->second);
+        calls[edge] += weights[this->g_opBlock[index]];
+    }
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, uint64_t> > sortedCalls(calls.begin(), calls.end());
+    std::stable_sort(sortedCalls.begin(), sortedCalls.end(), [](const std::pair<std::pair<std::size_t, std::size_t>, uint64_t>& a,
+                                                                const std::pair<std::pair<std::size_t, std::size_t>, uint64_t>& b){ return a.second > b.second; });
+
+    ///Chains of functions (Pettis-Hansen), the caller and the callee of the heaviest calls are placed side by side
+    std::vector<std::vector<std::size_t> > chains(functions.size());
+    std::vector<std::size_t> chainOf(functions.size());
+    for (std::size_t f=0; f<functions.size(); ++f)
+    {
+        chains[f] = {f};
+        chainOf[f] = f;
+    }
+    for (auto&& vCall : sortedCalls)
+    {
+        std::size_t caller = vCall.first.first;
+        std::size_t callee = vCall.first.second;
+        if (chainOf[caller] == chainOf[callee])
+        {
+            continue;
+        }
+        if (chainOf[callee] == chainOf[0])
+        {//The main code stay first
+            std::swap(caller, callee);
+        }
+
+        std::vector<std::size_t>& first = chains[chainOf[caller]];
+        std::vector<std::size_t>& second = chains[chainOf[callee]];
+        if ( (chainOf[caller] != chainOf[0]) && (first.back() != caller) && (first.front() == caller) )
+        {
+            std::reverse(first.begin(), first.end());
+        }
+        if ( (second.front() != callee) && (second.back() == callee) )
+        {
+            std::reverse(second.begin(), second.end());
+        }
+
+        std::size_t merged = chainOf[caller];
+        for (std::size_t f : second)
+        {
+            chainOf[f] = merged;
+            first.push_back(f);
+        }
+        second.clear();
+    }
+
+    std::vector<std::size_t> placement;
+    for (std::size_t f : chains[chainOf[0]])
+    {
+        if (f != 0)
+        {
+            placement.push_back(f);
+        }
+    }
+    for (std::size_t c=0; c<chains.size(); ++c)
+    {
+        if (c != chainOf[0])
+        {
+            placement.insert(placement.end(), chains[c].begin(), chains[c].end());
+        }
+    }
+
+    ///Order of the instructions
+    auto placeBodies = [&]()
+    {
+        for (std::size_t f : placement)
+        {
+            for (std::size_t i=functions[f]->_begin; i<functions[f]->_end; ++i)
+            {
+                this->g_order.push_back(i);
+            }
+        }
+    };
+    this->g_order.clear();
+    for (std::size_t i=0; i<opSize; ++i)
+    {
+        if (i == insertion)
+        {
+            placeBodies();
+        }
+        if (owners[i] == 0)
+        {
+            this->g_order.push_back(i);
+        }
+    }
+    if (insertion == opSize)
+    {
+        placeBodies();
+    }
+
+    return static_cast<uint32_t>(placement.size());
+}
+
+uint32_t Optimizer::removeAddressReloads()
+{
+    const int STATE_NONE = -2; //Not reached yet
+    const int STATE_UNKNOWN = -1;
+
+    this->buildControlFlow();
+    this->computeRamTargets();
+
+    ///Pools that stay in one page
+    std::vector<bool> pagePools(this->g_poolLocations.size(), false);
+    for (std::size_t p=0; p<this->g_poolLocations.size(); ++p)
+    {
+        std::size_t size = this->g_overlays[p].empty() ? this->g_poolVariableCount[p] :
+                           (*std::max_element(this->g_overlays[p].begin(), this->g_overlays[p].end()) + 1);
+        if (this->g_poolInfos[p]._maxSize != 0)
+        {
+            size = this->g_poolInfos[p]._maxSize;
+        }
+
+        if (this->g_poolInfos[p]._static)
+        {
+            pagePools[p] = (this->g_poolInfos[p]._startAddress & 0x00FF) + size <= 0x100;
+        }
+        else
+        {//The pool will be placed in one page if needed
+            pagePools[p] = size <= 0x100;
+        }
+    }
+
+    auto getPagePool = [&](std::size_t index) -> int
+    {
+        std::map<codeg::Address, codeg::RamTarget>::const_iterator it = this->g_ramLinks.find(this->g_ops[index]._address);
+        if ( (it == this->g_ramLinks.end()) || !this->isAddressPair(index) || !pagePools[it->second._pool] )
+        {
+            return STATE_UNKNOWN;
+        }
+        return static_cast<int>(it->second._pool);
+    };
+    auto transfer = [&](std::size_t b, int state)
+    {
+        for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+        {
+            if (this->g_outlineSites.find(i) != this->g_outlineSites.end())
+            {//The call write the return address
+                state = STATE_UNKNOWN;
+            }
+            if ( !this->g_ops[i]._removed && (this->g_ops[i].getOpcode() == codeg::OPCODE_BRAMADD2_CLK) )
+            {
+                state = getPagePool(i);
+            }
+        }
+        return state;
+    };
+
+    ///Page of the address MSB at the start of every block
+    std::size_t blockSize = this->g_blocks.size();
+    std::vector<int> states(blockSize, STATE_NONE);
+    std::vector<std::size_t> pending;
+    bool anyLabel = std::any_of(this->g_blocks.begin(), this->g_blocks.end(), [](const codeg::Optimizer::Block& block){ return block._unknownJump; });
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        if ( (b == 0) || (anyLabel && this->g_labelOps[this->g_blocks[b]._begin]) )
+        {
+            states[b] = STATE_UNKNOWN;
+            pending.push_back(b);
+        }
+    }
+    while ( !pending.empty() )
+    {
+        std::size_t b = pending.back();
+        pending.pop_back();
+
+        int state = transfer(b, states[b]);
+        for (std::size_t successor : this->g_blocks[b]._successors)
+        {
+            int newState = (states[successor] == STATE_NONE) ? state : ((states[successor] == state) ? state : STATE_UNKNOWN);
+            if (newState != states[successor])
+            {
+                states[successor] = newState;
+                pending.push_back(successor);
+            }
+        }
+    }
+
+    ///Removing the MSB writes that are already done
+    uint32_t count = 0;
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        int state = (states[b] == STATE_NONE) ? STATE_UNKNOWN : states[b];
+        for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+        {
+            if (this->g_outlineSites.find(i) != this->g_outlineSites.end())
+            {
+                state = STATE_UNKNOWN;
+            }
+            if ( this->g_ops[i]._removed || (this->g_ops[i].getOpcode() != codeg::OPCODE_BRAMADD2_CLK) )
+            {
+                continue;
+            }
+
+            int pool = getPagePool(i);
+            if ( (pool != STATE_UNKNOWN) && (pool == state) &&
+                 !this->g_ramLinks[this->g_ops[i]._address]._poolLink && this->isRemovable(i) )
+            {
+                std::size_t lsbIndex = this->getNextOp(i);
+                this->g_ops[i]._removed = true;
+                this->g_lsbLinks[i] = lsbIndex;
+                if ( !this->g_poolInfos[pool]._static )
+                {
+                    this->g_pageLocks[pool] = true;
+                }
+                ++count;
+            }
+            state = pool;
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::hoistLoopInvariants()
+{
+    enum Registers
+    {
+        REGISTER_JUMP_SOURCE,
+        REGISTER_RAM_ADDRESS
+    };
+    struct Setup
+    {
+        std::vector<std::size_t> _ops;
+        std::size_t _key; //Label or RAM location that is written
+        bool _full; //Every byte of the register is written
+    };
+
+    this->buildControlFlow();
+    this->computeLoops();
+
+    std::size_t blockSize = this->g_blocks.size();
+    std::vector<std::vector<std::size_t> > predecessors(blockSize);
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        for (std::size_t successor : this->g_blocks[b]._successors)
+        {
+            predecessors[successor].push_back(b);
+        }
+    }
+
+    std::map<std::string, std::size_t> labelKeys;
+    for (auto&& vLabel : this->g_labels)
+    {
+        labelKeys.insert({vLabel.first, labelKeys.size()});
+    }
+
+    auto isWrite = [&](Registers reg, std::size_t index)
+    {
+        uint8_t opcode = this->g_ops[index].getOpcode();
+        if (reg == REGISTER_JUMP_SOURCE)
+        {
+            return (opcode == codeg::OPCODE_BJMPSRC3_CLK) || (opcode == codeg::OPCODE_BJMPSRC2_CLK) || (opcode == codeg::OPCODE_BJMPSRC1_CLK);
+        }
+        return (opcode == codeg::OPCODE_BRAMADD2_CLK) || (opcode == codeg::OPCODE_BRAMADD1_CLK);
+    };
+    auto isRead = [&](Registers reg, std::size_t index)
+    {
+        if (reg == REGISTER_JUMP_SOURCE)
+        {
+            return this->g_ops[index].getOpcode() == codeg::OPCODE_JMPSRC_CLK;
+        }
+        return (this->g_ops[index].getOpcode() == codeg::OPCODE_RAMW) || (this->g_ops[index].getBus() == codeg::ReadableBusses::READABLE_RAM);
+    };
+    auto getSetup = [&](Registers reg, std::size_t index, Setup& setup)
+    {//Recognize a complete register setup with a known value starting at this instruction
+        setup._ops = {index};
+        setup._full = true;
+
+        if (reg == REGISTER_JUMP_SOURCE)
+        {
+            std::string label;
+            std::map<std::size_t, std::string>::const_iterator itSource = this->g_jumpSources.find(index);
+            if ( (itSource == this->g_jumpSources.end()) || (this->g_ops[index].getOpcode() != codeg::OPCODE_BJMPSRC3_CLK) )
+            {
+                return false;
+            }
+            std::size_t next = index;
+            for (uint8_t opcode : {codeg::OPCODE_BJMPSRC2_CLK, codeg::OPCODE_BJMPSRC1_CLK})
+            {
+                next = this->getNextOp(next);
+                std::map<std::size_t, std::string>::const_iterator it = this->g_jumpSources.find(next);
+                if ( (next >= this->g_ops.size()) || this->g_labelOps[next] || (it == this->g_jumpSources.end()) ||
+                     (it->second != itSource->second) || (this->g_ops[next].getOpcode() != opcode) )
+                {
+                    return false;
+                }
+                setup._ops.push_back(next);
+            }
+            setup._key = labelKeys[itSource->second];
+            return true;
+        }
+
+        if ( this->isAddressPair(index) )
+        {
+            std::map<codeg::Address, codeg::RamTarget>::const_iterator it = this->g_ramLinks.find(this->g_ops[index]._address);
+            if ( (it == this->g_ramLinks.end()) || it->second._poolLink )
+            {
+                return false;
+            }
+            setup._ops.push_back(this->getNextOp(index));
+            setup._key = it->second._location;
+            return true;
+        }
+        for (auto&& vLsbLink : this->g_lsbLinks)
+        {
+            if (vLsbLink.second == index)
+            {//Only the LSB, the MSB is already set
+                setup._key = this->g_ramLinks.at(this->g_ops[vLsbLink.first]._address)._location;
+                setup._full = false;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    uint32_t count = 0;
+    for (auto&& vLoop : this->g_loops)
+    {
+        std::size_t header = vLoop._header;
+        std::size_t headerIndex = this->g_blocks[header]._begin;
+
+        ///Only the innermost loops
+        if ( std::any_of(this->g_loops.begin(), this->g_loops.end(), [&](const codeg::Optimizer::Loop& loop){
+                return (loop._header != header) && vLoop._blocks[loop._header]; }) )
+        {
+            continue;
+        }
+
+        ///The loop must be entered by falling through the previous instruction (preheader)
+        std::vector<std::size_t> entries;
+        for (std::size_t predecessor : predecessors[header])
+        {
+            if ( !vLoop._blocks[predecessor] )
+            {
+                entries.push_back(predecessor);
+            }
+        }
+        std::size_t previous = this->getPreviousOp(headerIndex);
+        if ( (header == 0) || !this->g_labelOps[headerIndex] || (entries.size() != 1) ||
+             (previous >= this->g_ops.size()) || (this->g_opBlock[previous] != entries.front()) )
+        {
+            continue;
+        }
+        uint8_t previousOpcode = this->g_ops[previous].getOpcode();
+        if ( (previousOpcode == codeg::OPCODE_JMPSRC_CLK) || (previousOpcode == codeg::OPCODE_IF) || (previousOpcode == codeg::OPCODE_IFNOT) )
+        {
+            continue;
+        }
+
+        for (Registers reg : {REGISTER_JUMP_SOURCE, REGISTER_RAM_ADDRESS})
+        {
+            ///Every write must set the same value
+            std::vector<Setup> setups;
+            bool invariant = true;
+            for (std::size_t b=0; (b<blockSize) && invariant; ++b)
+            {
+                if ( !vLoop._blocks[b] )
+                {
+                    continue;
+                }
+                for (std::size_t i=this->g_blocks[b]._begin; (i<this->g_blocks[b]._end) && invariant; ++i)
+                {
+                    if (this->g_outlineSites.find(i) != this->g_outlineSites.end())
+                    {//A call to an outlined sequence modify both registers
+                        invariant = false;
+                        break;
+                    }
+                    if ( this->g_ops[i]._removed || this->g_ops[i]._moved || !isWrite(reg, i) )
+                    {
+                        continue;
+                    }
+
+                    Setup setup;
+                    if ( (i <= headerIndex) || !getSetup(reg, i, setup) || !this->isRemovable(i) ||
+                         (!setups.empty() && (setups.front()._key != setup._key)) ||
+                         (this->g_opBlock[setup._ops.back()] != b) )
+                    {
+                        invariant = false;
+                        break;
+                    }
+                    i = setup._ops.back();
+                    setups.push_back(std::move(setup));
+                }
+            }
+            if ( !invariant || setups.empty() )
+            {
+                continue;
+            }
+
+            ///The register must be written again before being read and before leaving the loop
+            std::vector<bool> writtenIn(blockSize, true);
+            std::vector<bool> writtenOut(blockSize, true);
+            writtenIn[header] = false;
+            bool changed = true;
+            while (changed)
+            {
+                changed = false;
+                for (std::size_t b=0; b<blockSize; ++b)
+                {
+                    if ( !vLoop._blocks[b] )
+                    {
+                        continue;
+                    }
+                    bool written = writtenIn[b];
+                    if (b != header)
+                    {
+                        written = true;
+                        for (std::size_t predecessor : predecessors[b])
+                        {
+                            written = written && (!vLoop._blocks[predecessor] || writtenOut[predecessor]);
+                        }
+                        writtenIn[b] = written;
+                    }
+                    for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+                    {
+                        written = written || (!this->g_ops[i]._removed && isWrite(reg, i));
+                    }
+                    if (written != writtenOut[b])
+                    {
+                        writtenOut[b] = written;
+                        changed = true;
+                    }
+                }
+            }
+
+            for (std::size_t b=0; (b<blockSize) && invariant; ++b)
+            {
+                if ( !vLoop._blocks[b] )
+                {
+                    continue;
+                }
+                bool written = writtenIn[b];
+                for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+                {
+                    if (this->g_ops[i]._removed)
+                    {
+                        continue;
+                    }
+                    if ( !written && isRead(reg, i) )
+                    {
+                        invariant = false;
+                    }
+                    written = written || isWrite(reg, i);
+                }
+
+                bool leaving = this->g_blocks[b]._exit || std::any_of(this->g_blocks[b]._successors.begin(), this->g_blocks[b]._successors.end(),
+                                                                      [&](std::size_t successor){ return !vLoop._blocks[successor]; });
+                if (leaving && !written)
+                {
+                    invariant = false;
+                }
+            }
+            if (!invariant)
+            {
+                continue;
+            }
+
+            ///Moving one setup before the loop header and removing the others
+            std::vector<Setup>::iterator itMoved = std::find_if(setups.begin(), setups.end(),
+                [](const Setup& setup){ return setup._full; });
+            if (itMoved == setups.end())
+            {
+                itMoved = setups.begin();
+            }
+
+            for (std::vector<Setup>::iterator it=setups.begin(); it!=setups.end(); ++it)
+            {
+                for (std::size_t index : it->_ops)
+                {
+                    if (it == itMoved)
+                    {
+                        this->g_ops[index]._moved = true;
+                        this->g_hoisted[headerIndex].push_back(index);
+                        continue;
+                    }
+
+                    this->g_ops[index]._removed = true;
+                    for (std::map<std::size_t, std::size_t>::iterator itLsb=this->g_lsbLinks.begin(); itLsb!=this->g_lsbLinks.end(); ++itLsb)
+                    {
+                        if (itLsb->second == index)
+                        {//The LSB is not written anymore
+                            this->g_lsbLinks.erase(itLsb);
+                            break;
+                        }
+                    }
+                }
+            }
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::outlineSequences()
+{
+    struct Unit
+    {
+        std::size_t _first;
+        std::size_t _last; //Second half of an address pair
+        codeg::Address _size;
+    };
+    struct Candidate
+    {
+        int64_t _saved;
+        std::size_t _length;
+        std::vector<std::size_t> _positions;
+    };
+
+    std::size_t opSize = this->g_ops.size();
+    this->buildControlFlow();
+
+    ///Subroutines are placed after the last unconditional jump
+    std::vector<std::size_t> order;
+    this->getOrder(order);
+    this->g_outlineIndex = opSize+1;
+    for (std::size_t o=0; o<opSize; ++o)
+    {
+        std::size_t i = order[o];
+        const codeg::MicroOp& op = this->g_ops[i];
+        if ( op._removed || op._moved || this->g_tableOps[i] || (op.getOpcode() != codeg::OPCODE_JMPSRC_CLK) )
+        {
+            continue;
+        }
+        std::size_t previous = this->getPreviousOp(i);
+        if ( (previous < opSize) &&
+             ((this->g_ops[previous].getOpcode() == codeg::OPCODE_IF) || (this->g_ops[previous].getOpcode() == codeg::OPCODE_IFNOT)) )
+        {//Conditional jump
+            continue;
+        }
+        this->g_outlineIndex = (o+1 < opSize) ? order[o+1] : opSize;
+    }
+    if (this->g_outlineIndex > opSize)
+    {//Every place can be reached by the previous instruction
+        return 0;
+    }
+
+    std::vector<uint8_t> liveIn;
+    this->computeRegisterLiveness(liveIn);
+
+    std::vector<codeg::MicroOp> callOps;
+    std::vector<codeg::MicroOp> returnOps;
+    codeg::MakeOutlineOps(this->g_writeDummy, callOps, returnOps);
+    int64_t callSize = codeg::GetOutlineSize(callOps, callOps.size());
+    int64_t returnSize = codeg::GetOutlineSize(returnOps, returnOps.size());
+
+    std::set<std::size_t> lsbOps;
+    for (auto&& vLsbLink : this->g_lsbLinks)
+    {
+        lsbOps.insert(vLsbLink.second);
+    }
+
+    ///Instructions (and address pairs) as tokens, equal tokens are the same bytes with the same relocations
+    std::vector<Unit> units;
+    std::vector<int64_t> tokens;
+    std::map<std::string, int64_t> keys;
+    int64_t separator = -1;
+    bool barrier = true;
+    for (std::size_t i=0; i<opSize; ++i)
+    {
+        if ( this->g_labelOps[i] || (this->g_hoisted.find(i) != this->g_hoisted.end()) )
+        {//A sequence can start at a label but can't contain it
+            barrier = true;
+        }
+        const codeg::MicroOp& op = this->g_ops[i];
+        if (op._removed || op._moved)
+        {
+            continue;
+        }
+        if (barrier)
+        {
+            units.push_back({opSize, opSize, 0});
+            tokens.push_back(separator--);
+            barrier = false;
+        }
+
+        Unit unit{i, i, op._size};
+        std::string key{static_cast<char>(op._code), static_cast<char>(op._argument)};
+        uint8_t opcode = op.getOpcode();
+        bool valid = this->isRemovable(i) &&
+                     (opcode != codeg::OPCODE_BJMPSRC3_CLK) && (opcode != codeg::OPCODE_BJMPSRC2_CLK) &&
+                     (opcode != codeg::OPCODE_BJMPSRC1_CLK) && (opcode != codeg::OPCODE_JMPSRC_CLK) &&
+                     (opcode != codeg::OPCODE_IF) && (opcode != codeg::OPCODE_IFNOT) &&
+                     (this->g_returnSources.find(i) == this->g_returnSources.end()) &&
+                     (this->g_tableSources.find(i) == this->g_tableSources.end()) &&
+                     (lsbOps.count(i) == 0);
+
+        std::map<codeg::Address, codeg::RamTarget>::const_iterator itLink = this->g_ramLinks.find(op._address);
+        if ( (opcode == codeg::OPCODE_BRAMADD2_CLK) && this->isAddressPair(i) )
+        {
+            unit._last = this->getNextOp(i);
+            const codeg::MicroOp& second = this->g_ops[unit._last];
+            unit._size += second._size;
+            key += {static_cast<char>(second._code), static_cast<char>(second._argument)};
+            if (itLink != this->g_ramLinks.end())
+            {//Relocated, the address is only known after the pools are resolved
+                key += "@"+std::to_string(itLink->second._location)+(itLink->second._poolLink ? "P" : "V");
+            }
+            for (std::size_t j=i+1; j<=unit._last; ++j)
+            {
+                valid = valid && !this->g_labelOps[j] && !this->g_ops[j]._moved;
+            }
+        }
+        else if (itLink != this->g_ramLinks.end())
+        {
+            valid = false;
+        }
+
+        units.push_back(unit);
+        if (valid)
+        {
+            std::map<std::string, int64_t>::const_iterator itKey = keys.find(key);
+            if (itKey == keys.end())
+            {
+                itKey = keys.insert({key, static_cast<int64_t>(keys.size())}).first;
+            }
+            tokens.push_back(itKey->second);
+        }
+        else
+        {
+            tokens.push_back(separator--);
+        }
+        i = unit._last;
+    }
+
+    std::vector<int64_t> unitBytes(units.size()+1, 0);
+    for (std::size_t u=0; u<units.size(); ++u)
+    {
+        unitBytes[u+1] = unitBytes[u] + units[u]._size;
+    }
+
+    ///Repeated sequences (suffix array), the most profitable one is outlined first
+    uint32_t saved = 0;
+    std::vector<std::size_t> suffixes;
+    std::vector<std::size_t> lcp;
+    while (true)
+    {
+        codeg::BuildSuffixArray(tokens, suffixes, lcp);
+
+        Candidate best{0, 0, {}};
+        auto evaluate = [&](std::size_t length, std::size_t left, std::size_t right)
+        {
+            int64_t size = unitBytes[suffixes[left]+length] - unitBytes[suffixes[left]];
+            int64_t count = static_cast<int64_t>(right-left+1);
+            if (count*(size-callSize) - size - returnSize <= best._saved)
+            {
+                return;
+            }
+
+            std::vector<std::size_t> positions(suffixes.begin()+left, suffixes.begin()+right+1);
+            std::sort(positions.begin(), positions.end());
+
+            Candidate candidate{0, length, {}};
+            std::size_t nextFree = 0;
+            for (std::size_t position : positions)
+            {
+                std::size_t end = units[position+length-1]._last + 1;
+                if ( (position < nextFree) || ((liveIn[units[position]._first] | liveIn[end]) != 0) )
+                {//Overlapping or the call would modify a used register
+                    continue;
+                }
+                candidate._positions.push_back(position);
+                nextFree = position+length;
+            }
+
+            count = static_cast<int64_t>(candidate._positions.size());
+            candidate._saved = count*(size-callSize) - size - returnSize;
+            if ( (count >= 2) && (candidate._saved > best._saved) )
+            {
+                best = std::move(candidate);
+            }
+        };
+
+        std::vector<std::pair<std::size_t, std::size_t> > intervals{{0, 0}}; //Common length and left bound
+        for (std::size_t i=1; i<=suffixes.size(); ++i)
+        {
+            std::size_t common = (i < suffixes.size()) ? lcp[i] : 0;
+            std::size_t left = i-1;
+            while (common < intervals.back().first)
+            {
+                std::pair<std::size_t, std::size_t> interval = intervals.back();
+                intervals.pop_back();
+                evaluate(interval.first, interval.second, i-1);
+                left = interval.second;
+            }
+            if (common > intervals.back().first)
+            {
+                intervals.push_back({common, left});
+            }
+        }
+
+        if (best._saved <= 0)
+        {
+            break;
+        }
+
+        codeg::Optimizer::Outline outline{"%%O"+std::to_string(this->g_outlines.size()+1), {}, {}};
+        for (std::size_t u=best._positions.front(); u<best._positions.front()+best._length; ++u)
+        {
+            outline._body.push_back(units[u]._first);
+            if (units[u]._last != units[u]._first)
+            {
+                outline._body.push_back(units[u]._last);
+            }
+        }
+        for (std::size_t position : best._positions)
+        {
+            outline._sites.push_back(units[position]._first);
+            this->g_outlineSites[units[position]._first] = this->g_outlines.size();
+            for (std::size_t u=position; u<position+best._length; ++u)
+            {
+                this->g_ops[units[u]._first]._removed = true;
+                this->g_ops[units[u]._last]._removed = true;
+                tokens[u] = separator--;
+            }
+        }
+        this->g_outlines.push_back(std::move(outline));
+        saved += static_cast<uint32_t>(best._saved);
+    }
+
+    return saved;
+}
+
+uint32_t Optimizer::removeJumpReloads()
+{
+    struct State
+    {
+        bool _reached;
+        codeg::JumpLatch _latches[3];
+    };
+    struct Candidate
+    {
+        std::size_t _index;
+        std::string _label;
+        codeg::JumpLatch _latch; //Value of the register before the instruction
+    };
+
+    std::size_t opSize = this->g_ops.size();
+    this->buildControlFlow();
+    std::size_t blockSize = this->g_blocks.size();
+
+    const codeg::JumpLatch unknown{codeg::LatchTypes::LATCH_UNKNOWN, "", 0};
+
+    auto transfer = [&](std::size_t i, codeg::JumpLatch* latches)
+    {
+        std::map<std::size_t, std::vector<std::size_t> >::const_iterator itHoisted = this->g_hoisted.find(i);
+        if (itHoisted != this->g_hoisted.end())
+        {//Only written before the loop, the header can be reached with another value
+            for (std::size_t index : itHoisted->second)
+            {
+                uint8_t opcode = this->g_ops[index].getOpcode();
+                if ( (opcode == codeg::OPCODE_BJMPSRC3_CLK) || (opcode == codeg::OPCODE_BJMPSRC2_CLK) || (opcode == codeg::OPCODE_BJMPSRC1_CLK) )
+                {
+                    latches[codeg::OPCODE_BJMPSRC3_CLK - opcode] = unknown;
+                }
+            }
+        }
+
+        //A removed setup keep the register with the same value, a moved one is written at its original place
+        const codeg::MicroOp& op = this->g_ops[i];
+        uint8_t opcode = op.getOpcode();
+        if ( (!op._removed || this->g_jumpReloads[i]) &&
+             ((opcode == codeg::OPCODE_BJMPSRC3_CLK) || (opcode == codeg::OPCODE_BJMPSRC2_CLK) || (opcode == codeg::OPCODE_BJMPSRC1_CLK)) )
+        {
+            codeg::JumpLatch& latch = latches[codeg::OPCODE_BJMPSRC3_CLK - opcode];
+
+            std::map<std::size_t, std::string>::const_iterator it = this->g_jumpSources.find(i);
+            std::map<std::size_t, std::string>::const_iterator itTable = this->g_tableSources.find(i);
+            if (it != this->g_jumpSources.end())
+            {
+                latch = {codeg::LatchTypes::LATCH_LABEL, it->second, 0};
+            }
+            else if (itTable != this->g_tableSources.end())
+            {
+                latch = {codeg::LatchTypes::LATCH_LABEL, itTable->second, 0};
+            }
+            else if (op.getBus() == codeg::ReadableBusses::READABLE_SOURCE)
+            {
+                latch = {codeg::LatchTypes::LATCH_CONSTANT, "", op._argument};
+            }
+            else
+            {
+                latch = unknown;
+            }
+        }
+
+        if (this->g_outlineSites.find(i) != this->g_outlineSites.end())
+        {//The call and the return write every register
+            latches[0] = latches[1] = latches[2] = unknown;
+        }
+    };
+
+    ///Value of the registers at the start of every block
+    std::vector<State> states(blockSize, {false, {unknown, unknown, unknown}});
+    std::vector<std::size_t> pending;
+    bool unknownJump = std::any_of(this->g_blocks.begin(), this->g_blocks.end(), [](const codeg::Optimizer::Block& block){ return block._unknownJump; });
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        if ( (b == 0) || (unknownJump && this->g_labelOps[this->g_blocks[b]._begin]) )
+        {
+            states[b]._reached = true;
+            pending.push_back(b);
+        }
+    }
+    while ( !pending.empty() )
+    {
+        std::size_t b = pending.back();
+        pending.pop_back();
+
+        State state = states[b];
+        for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+        {
+            transfer(i, state._latches);
+        }
+
+        for (std::size_t successor : this->g_blocks[b]._successors)
+        {
+            State& next = states[successor];
+            bool changed = !next._reached;
+            for (std::size_t l=0; l<3; ++l)
+            {
+                const codeg::JumpLatch& latch = state._latches[l];
+                if ( !next._reached )
+                {
+                    next._latches[l] = latch;
+                }
+                else if ( (next._latches[l]._type != codeg::LatchTypes::LATCH_UNKNOWN) &&
+                          ((next._latches[l]._type != latch._type) || (next._latches[l]._label != latch._label) || (next._latches[l]._value != latch._value)) )
+                {
+                    next._latches[l] = unknown;
+                    changed = true;
+                }
+            }
+            next._reached = true;
+            if (changed)
+            {
+                pending.push_back(successor);
+            }
+        }
+    }
+
+    ///Setups that write the value already in the register
+    uint32_t count = 0;
+    std::vector<Candidate> candidates; //The MID of the address depend on the placement
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        if ( !states[b]._reached )
+        {
+            continue;
+        }
+
+        State state = states[b];
+        for (std::size_t i=this->g_blocks[b]._begin; i<this->g_blocks[b]._end; ++i)
+        {
+            std::string label;
+            const codeg::MicroOp& op = this->g_ops[i];
+            if ( !op._removed && !op._moved && !this->g_tableOps[i] && (i+3 < opSize) &&
+                 (op.getOpcode() == codeg::OPCODE_BJMPSRC3_CLK) && this->isLabelJump(i, label) &&
+                 (this->getNextOp(i) == i+1) && (this->getNextOp(i+1) == i+2) &&
+                 !this->g_ops[i+1]._moved && !this->g_ops[i+2]._moved )
+            {
+                const codeg::JumpLatch* latches = state._latches;
+                if ( ((latches[0]._type == codeg::LatchTypes::LATCH_LABEL) ||
+                      ((latches[0]._type == codeg::LatchTypes::LATCH_CONSTANT) && (latches[0]._value == 0))) &&
+                     this->isRemovable(i) )
+                {//The MSB of a code address is always 0
+                    this->g_ops[i]._removed = true;
+                    this->g_jumpReloads[i] = true;
+                    ++count;
+                }
+
+                if ( (latches[1]._type == codeg::LatchTypes::LATCH_LABEL) && (latches[1]._label == label) && this->isRemovable(i+1) )
+                {
+                    this->g_ops[i+1]._removed = true;
+                    this->g_jumpReloads[i+1] = true;
+                    ++count;
+                }
+                else if ( ((latches[1]._type == codeg::LatchTypes::LATCH_LABEL) || (latches[1]._type == codeg::LatchTypes::LATCH_CONSTANT)) &&
+                          this->isRemovable(i+1) )
+                {//Same 256 bytes page
+                    candidates.push_back({i+1, label, latches[1]});
+                }
+
+                if ( (latches[2]._type == codeg::LatchTypes::LATCH_LABEL) && (latches[2]._label == label) && this->isRemovable(i+2) )
+                {
+                    this->g_ops[i+2]._removed = true;
+                    this->g_jumpReloads[i+2] = true;
+                    ++count;
+                }
+            }
+
+            transfer(i, state._latches);
+        }
+    }
+
+    ///The candidates are removed while the placement keep them valid
+    while ( !candidates.empty() )
+    {
+        for (auto&& vCandidate : candidates)
+        {
+            this->g_ops[vCandidate._index]._removed = true;
+            this->g_jumpReloads[vCandidate._index] = true;
+        }
+
+        std::vector<codeg::Address> newAddress;
+        std::map<std::size_t, codeg::Address> bodyAddress;
+        this->computeLayout(newAddress, bodyAddress);
+
+        auto getMid = [&](const std::string& label, uint8_t& mid)
+        {
+            std::map<std::string, std::size_t>::const_iterator it = this->g_labels.find(label);
+            if (it == this->g_labels.end())
+            {
+                return false;
+            }
+            mid = static_cast<uint8_t>(newAddress[it->second] >> 8);
+            return true;
+        };
+
+        std::size_t validSize = candidates.size();
+        for (std::vector<Candidate>::iterator it=candidates.begin(); it!=candidates.end();)
+        {
+            uint8_t mid = 0;
+            uint8_t actual = it->_latch._value;
+            if ( !getMid(it->_label, mid) ||
+                 ((it->_latch._type == codeg::LatchTypes::LATCH_LABEL) && !getMid(it->_latch._label, actual)) ||
+                 (mid != actual) )
+            {
+                this->g_ops[it->_index]._removed = false;
+                this->g_jumpReloads[it->_index] = false;
+                it = candidates.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (candidates.size() == validSize)
+        {
+            count += static_cast<uint32_t>(candidates.size());
+            break;
+        }
+    }
+
+    return count;
+}
+
+uint32_t Optimizer::getSize() const
+{
+    uint32_t size = 0;
+    for (auto&& op : this->g_ops)
+    {
+        if (!op._removed)
+        {
+            size += op._size;
+        }
+    }
+    return size;
+}
+
+const std::vector<codeg::MicroOp>& Optimizer::getOps() const
+{
+    return this->g_ops;
+}
+const std::vector<codeg::Optimizer::Block>& Optimizer::getBlocks() const
+{
+    return this->g_blocks;
+}
+
+std::size_t Optimizer::getOpIndex(codeg::Address address) const
+{
+    if (address >= this->g_endAddress)
+    {
+        return (address == this->g_endAddress) ? this->g_ops.size() : this->g_ops.size()+1;
+    }
+
+    std::vector<codeg::MicroOp>::const_iterator it = std::lower_bound(this->g_ops.begin(), this->g_ops.end(), address,
+        [](const codeg::MicroOp& op, codeg::Address value){ return op._address < value; });
+
+    if ( (it == this->g_ops.end()) || (it->_address != address) )
+    {
+        return this->g_ops.size()+1;
+    }
+    return it - this->g_ops.begin();
+}
+std::size_t Optimizer::getNextOp(std::size_t index) const
+{
+    do
+    {
+        ++index;
+    }
+    while ( (index < this->g_ops.size()) && this->g_ops[index]._removed );
+    return std::min(index, this->g_ops.size());
+}
+std::size_t Optimizer::getPreviousOp(std::size_t index) const
+{
+    while (index > 0)
+    {
+        --index;
+        if (!this->g_ops[index]._removed)
+        {
+            return index;
+        }
+    }
+    return this->g_ops.size();
+}
+
+bool Optimizer::isLabelJump(std::size_t index, std::string& label) const
+{
+    static const uint8_t sequence[3] = {codeg::OPCODE_BJMPSRC3_CLK, codeg::OPCODE_BJMPSRC2_CLK, codeg::OPCODE_BJMPSRC1_CLK};
+
+    std::map<std::size_t, std::string>::const_iterator itSource = this->g_jumpSources.find(index);
+    if (itSource == this->g_jumpSources.end())
+    {
+        return false;
+    }
+
+    for (std::size_t i=0; i<3; ++i)
+    {
+        std::map<std::size_t, std::string>::const_iterator it = this->g_jumpSources.find(index);
+        if ( (index >= this->g_ops.size()) || (it == this->g_jumpSources.end()) || (it->second != itSource->second) ||
+             (this->g_ops[index].getOpcode() != sequence[i]) || (i > 0 && this->g_labelOps[index]) )
+        {
+            return false;
+        }
+        index = this->getNextOp(index);
+    }
+
+    if ( (index >= this->g_ops.size()) || this->g_labelOps[index] || (this->g_ops[index].getOpcode() != codeg::OPCODE_JMPSRC_CLK) )
+    {//Not directly followed by the jump
+        return false;
+    }
+
+    label = itSource->second;
+    return true;
+}
+std::string Optimizer::getFinalLabel(const std::string& label) const
+{
+    std::string actual = label;
+    std::vector<std::string> visited{label};
+
+    while (true)
+    {
+        std::size_t target = this->g_labels.at(actual);
+        if ( (target < this->g_ops.size()) && this->g_ops[target]._removed )
+        {
+            target = this->getNextOp(target);
+        }
+
+        std::string next;
+        if ( (target >= this->g_ops.size()) || !this->isLabelJump(target, next) ||
+             (std::find(visited.begin(), visited.end(), next) != visited.end()) )
+        {
+            return actual;
+        }
+
+        visited.push_back(next);
+        actual = next;
+    }
+}
+void Optimizer::updateReturnPoints()
+{
+    this->g_returnPoints.clear();
+    for (auto&& vReturnSource : this->g_returnSources)
+    {
+        if ( this->g_ops[vReturnSource.first]._removed )
+        {
+            continue;
+        }
+
+        std::size_t returnPoint = this->g_labels.at(vReturnSource.second);
+        if ( std::find(this->g_returnPoints.begin(), this->g_returnPoints.end(), returnPoint) == this->g_returnPoints.end() )
+        {
+            this->g_returnPoints.push_back(returnPoint);
+        }
+    }
+}
+
+bool Optimizer::isTableStart(std::size_t index) const
+{
+    return std::any_of(this->g_tables.begin(), this->g_tables.end(), [&](const codeg::Optimizer::JumpTable& table){ return table._begin == index; });
+}
+
+bool Optimizer::isAddressPair(std::size_t index) const
+{
+    if (this->g_ops[index].getOpcode() != codeg::OPCODE_BRAMADD2_CLK)
+    {
+        return false;
+    }
+    std::size_t next = this->getNextOp(index);
+    return (next < this->g_ops.size()) && !this->g_labelOps[next] && (this->g_ops[next].getOpcode() == codeg::OPCODE_BRAMADD1_CLK);
+}
+bool Optimizer::isRemovable(std::size_t index) const
+{
+    if ( this->g_tableOps[index] )
+    {//The entries of a jump table must keep their size
+        return false;
+    }
+    std::size_t previous = this->getPreviousOp(index);
+    if (previous < this->g_ops.size())
+    {
+        uint8_t opcode = this->g_ops[previous].getOpcode();
+        if ( (opcode == codeg::OPCODE_IF) || (opcode == codeg::OPCODE_IFNOT) )
+        {//Removing this instruction would change the skipped one
+            return false;
+        }
+    }
+    return true;
+}
+bool Optimizer::isRelocated(std::size_t index) const
+{
+    if ( (this->g_jumpSources.find(index) != this->g_jumpSources.end()) ||
+         (this->g_returnSources.find(index) != this->g_returnSources.end()) ||
+         (this->g_tableSources.find(index) != this->g_tableSources.end()) ||
+         this->g_tableOps[index] || (this->g_ramLinks.find(this->g_ops[index]._address) != this->g_ramLinks.end()) ||
+         std::any_of(this->g_lsbLinks.begin(), this->g_lsbLinks.end(), [&](const std::pair<const std::size_t, std::size_t>& link){ return link.second == index; }) )
+    {
+        return true;
+    }
+
+    //Second instruction of a RAM address pair
+    std::size_t previous = this->getPreviousOp(index);
+    return (previous < this->g_ops.size()) && (this->g_ramLinks.find(this->g_ops[previous]._address) != this->g_ramLinks.end()) &&
+           (this->getNextOp(previous) == index);
+}
+
+void Optimizer::computeRamTargets()
+{
+    this->g_ramTargets.assign(this->g_ops.size(), {false, 0, 0, false});
+
+    codeg::RamTarget actual{false, 0, 0, false};
+    for (std::size_t i=0; i<this->g_ops.size(); ++i)
+    {
+        if (this->g_labelOps[i])
+        {//A label can be reached from anywhere
+            actual._known = false;
+        }
+        if (this->g_ops[i]._removed)
+        {
+            continue;
+        }
+
+        this->g_ramTargets[i] = actual;
+
+        uint8_t opcode = this->g_ops[i].getOpcode();
+        if (opcode == codeg::OPCODE_BRAMADD2_CLK)
+        {
+            std::map<codeg::Address, codeg::RamTarget>::const_iterator it = this->g_ramLinks.find(this->g_ops[i]._address);
+            if ( (it != this->g_ramLinks.end()) && this->isAddressPair(i) )
+            {
+                actual = it->second;
+            }
+            else
+            {//Absolute or computed address
+                actual._known = false;
+            }
+        }
+        else if (opcode == codeg::OPCODE_BRAMADD1_CLK)
+        {
+            std::size_t previous = this->getPreviousOp(i);
+            if ( (previous < this->g_ops.size()) && this->isAddressPair(previous) )
+            {//Second half of the address
+                this->g_ramTargets[i]._known = false;
+            }
+            else
+            {
+                actual._known = false;
+            }
+        }
+    }
+}
+void Optimizer::applyLiveness(std::size_t index, codeg::Optimizer::LocationSet& live) const
+{
+    const codeg::MicroOp& op = this->g_ops[index];
+    const codeg::RamTarget& target = this->g_ramTargets[index];
+    std::size_t addressLocation = this->g_locationCount;
+    uint8_t opcode = op.getOpcode();
+
+    //Definitions
+    if ( (opcode == codeg::OPCODE_RAMW) && target._known )
+    {
+        live[target._location] = false;
+    }
+    bool addressPair = this->isAddressPair(index);
+    if (addressPair)
+    {
+        live[addressLocation] = false;
+    }
+
+    //Uses
+    if (op.getBus() == codeg::ReadableBusses::READABLE_RAM)
+    {
+        if (!target._known)
+        {
+            std::fill(live.begin(), live.end(), true);
+        }
+        else if (target._poolLink)
+        {
+            for (std::size_t location : this->g_poolLocations[target._pool])
+            {
+                live[location] = true;
+            }
+        }
+        else
+        {
+            live[target._location] = true;
+        }
+        live[addressLocation] = true;
+    }
+    if (opcode == codeg::OPCODE_RAMW)
+    {
+        live[addressLocation] = true;
+    }
+    else if ( (opcode == codeg::OPCODE_BRAMADD2_CLK) && !addressPair )
+    {//Only the MSB is modified
+        live[addressLocation] = true;
+    }
+    else if (opcode == codeg::OPCODE_BRAMADD1_CLK)
+    {
+        std::size_t previous = this->getPreviousOp(index);
+        if ( (previous >= this->g_ops.size()) || !this->isAddressPair(previous) )
+        {//Only the LSB is modified
+            live[addressLocation] = true;
+        }
+    }
+}
+uint8_t Optimizer::applyRegisterLiveness(std::size_t index, uint8_t live) const
+{
+    const codeg::MicroOp& op = this->g_ops[index];
+
+    switch (op.getOpcode())
+    {
+    case codeg::OPCODE_BJMPSRC3_CLK:
+        live &= ~codeg::RegisterBits::REGISTER_BIT_JUMP_MSB;
+        break;
+    case codeg::OPCODE_BJMPSRC2_CLK:
+        live &= ~codeg::RegisterBits::REGISTER_BIT_JUMP_MID;
+        break;
+    case codeg::OPCODE_BJMPSRC1_CLK:
+        live &= ~codeg::RegisterBits::REGISTER_BIT_JUMP_LSB;
+        break;
+    case codeg::OPCODE_JMPSRC_CLK:
+        live |= codeg::RegisterBits::REGISTER_BIT_JUMP;
+        break;
+    case codeg::OPCODE_BRAMADD2_CLK:
+        if ( this->isAddressPair(index) )
+        {
+            live &= ~codeg::RegisterBits::REGISTER_BIT_RAM_ADDRESS;
+        }
+        else
+        {//Only the MSB is modified
+            live |= codeg::RegisterBits::REGISTER_BIT_RAM_ADDRESS;
+        }
+        break;
+    case codeg::OPCODE_BRAMADD1_CLK:
+    {
+        std::size_t previous = this->getPreviousOp(index);
+        if ( (previous >= this->g_ops.size()) || !this->isAddressPair(previous) )
+        {//Only the LSB is modified
+            live |= codeg::RegisterBits::REGISTER_BIT_RAM_ADDRESS;
+        }
+        break;
+    }
+    case codeg::OPCODE_RAMW:
+        live |= codeg::RegisterBits::REGISTER_BIT_RAM_ADDRESS;
+        break;
+    default:
+        break;
+    }
+
+    if (op.getBus() == codeg::ReadableBusses::READABLE_RAM)
+    {
+        live |= codeg::RegisterBits::REGISTER_BIT_RAM_ADDRESS;
+    }
+    return live;
+}
+void Optimizer::computeRegisterLiveness(std::vector<uint8_t>& liveIn) const
+{
+    //The moved instructions are ignored, their registers are used from the start of the loop
+    std::size_t blockSize = this->g_blocks.size();
+    std::vector<uint8_t> blockLiveIn(blockSize, 0);
+
+    auto getLiveOut = [&](std::size_t b)
+    {
+        uint8_t live = this->g_blocks[b]._exit ? codeg::RegisterBits::REGISTER_BIT_ALL : 0;
+        for (std::size_t successor : this->g_blocks[b]._successors)
+        {
+            live |= blockLiveIn[successor];
+        }
+        return live;
+    };
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (std::size_t b=blockSize; b>0;)
+        {
+            --b;
+            uint8_t live = getLiveOut(b);
+            for (std::size_t i=this->g_blocks[b]._end; i>this->g_blocks[b]._begin;)
+            {
+                --i;
+                if ( !this->g_ops[i]._removed && !this->g_ops[i]._moved )
+                {
+                    live = this->applyRegisterLiveness(i, live);
+                }
+            }
+            if (live != blockLiveIn[b])
+            {
+                blockLiveIn[b] = live;
+                changed = true;
+            }
+        }
+    }
+
+    liveIn.assign(this->g_ops.size()+1, codeg::RegisterBits::REGISTER_BIT_ALL);
+    for (std::size_t b=0; b<blockSize; ++b)
+    {
+        uint8_t live = getLiveOut(b);
+        for (std::size_t i=this->g_blocks[b]._end; i>this->g_blocks[b]._begin;)
+        {
+            --i;
+            if ( !this->g_ops[i]._removed && !this->g_ops[i]._moved )
+            {
+                live = this->applyRegisterLiveness(i, live);
+            }
+            liveIn[i] = live;
+        }
+    }
+}
+void Optimizer::computeLiveness(std::vector<codeg::Optimizer::LocationSet>& liveOut) const
+{
+    std::size_t setSize = this->g_locationCount+1; //Locations and the RAM address
+    std::vector<codeg::Optimizer::LocationSet> liveIn(this->g_blocks.size(), codeg::Optimizer::LocationSet(setSize, false));
+    liveOut.assign(this->g_blocks.size(), codeg::Optimizer::LocationSet(setSize, false));
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        for (std::size_t b=this->g_blocks.size(); b>0;)
+        {
+            --b;
+            const codeg::Optimizer::Block& block = this->g_blocks[b];
+
+            codeg::Optimizer::LocationSet live(setSize, block._exit);
+            for (std::size_t location : this->g_observableLocations)
+            {
+                live[location] = true;
+            }
+            for (std::size_t successor : block._successors)
+            {
+                for (std::size_t i=0; i<setSize; ++i)
+                {
+                    if (liveIn[successor][i])
+                    {
+                        live[i] = true;
+                    }
+                }
+            }
+            liveOut[b] = live;
+
+            for (std::size_t i=block._end; i>block._begin;)
+            {
+                --i;
+                if (!this->g_ops[i]._removed)
+                {
+                    this->applyLiveness(i, live);
+                }
+            }
+
+            if (live != liveIn[b])
+            {
+                liveIn[b] = std::move(live);
+                changed = true;
+            }
+        }
+    }
+}
+
+}//end codeg
@@ -0,0 +1,495 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_peephole.hpp"
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_value.hpp"
+#include "C_error.hpp"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+namespace codeg
+{
+
+///Default rules
+
+static const char* DefaultPeepholeRules[]=
+{
+    //Value written in a latch that is overwritten before being observed
+    "oplefts : OPLEFT_CLK * ; OPLEFT_CLK $b => OPLEFT_CLK $b if $b != RESULT",
+    "oprights : OPRIGHT_CLK * ; OPRIGHT_CLK $b => OPRIGHT_CLK $b if $b != RESULT",
+    "opchooses : OPCHOOSE_CLK * ; OPCHOOSE_CLK $b => OPCHOOSE_CLK $b if $b != RESULT",
+    "jumpsources1 : BJMPSRC1_CLK * ; BJMPSRC1_CLK $b => BJMPSRC1_CLK $b",
+    "jumpsources2 : BJMPSRC2_CLK * ; BJMPSRC2_CLK $b => BJMPSRC2_CLK $b",
+    "jumpsources3 : BJMPSRC3_CLK * ; BJMPSRC3_CLK $b => BJMPSRC3_CLK $b",
+    "ramaddresses1 : BRAMADD1_CLK * ; BRAMADD1_CLK $b => BRAMADD1_CLK $b if $b != RAM",
+    "ramaddresses2 : BRAMADD2_CLK * ; BRAMADD2_CLK $b => BRAMADD2_CLK $b if $b != RAM",
+    "operations : OPLEFT_CLK * ; OPCHOOSE_CLK * ; OPRIGHT_CLK * ; OPLEFT_CLK $l ; OPCHOOSE_CLK $o ; OPRIGHT_CLK $r => "
+        "OPLEFT_CLK $l ; OPCHOOSE_CLK $o ; OPRIGHT_CLK $r if $l != RESULT, $o != RESULT, $r != RESULT",
+
+    //Bus written twice with the same value (a different value can be a strobe, it is kept)
+    "writes1 : BWRITE1_CLK $a ; BWRITE1_CLK $a => BWRITE1_CLK $a if $a != BREAD1, $a != BREAD2, $a != SPI, $a != EXT1, $a != EXT2",
+    "writes2 : BWRITE2_CLK $a ; BWRITE2_CLK $a => BWRITE2_CLK $a if $a != BREAD1, $a != BREAD2, $a != SPI, $a != EXT1, $a != EXT2",
+
+    //RAM written twice at the same address, or with its own value
+    "ramwrites : RAMW * ; RAMW $b => RAMW $b if $b != RAM",
+    "ramcopy : RAMW RAM => -",
+
+    //Constant conditions
+    "if_never : IF 0 => -",
+    "if_always : IF $c ; * => - if $c == SOURCE, $c != 0",
+    "ifnot_never : IFNOT $c => - if $c == SOURCE, $c != 0",
+    "ifnot_always : IFNOT 0 ; * => -",
+
+    //Conditional jump followed by a jump with the same source
+    "if_jump : IF * ; JMPSRC_CLK ; JMPSRC_CLK => JMPSRC_CLK",
+    "ifnot_jump : IFNOT * ; JMPSRC_CLK ; JMPSRC_CLK => JMPSRC_CLK"
+};
+
+///Parsing
+
+static bool IsValidOpcode(uint8_t opcode)
+{
+    return (opcode <= codeg::OPCODE_RAMW) || (opcode == codeg::OPCODE_LTICK);
+}
+
+static bool GetPeepholeOpcode(const std::string& str, uint8_t& opcode)
+{
+    for (uint8_t i=0; i<32; ++i)
+    {
+        if ( codeg::IsValidOpcode(i) && (str == codeg::ReadableStringBinaryOpcodes[i]) )
+        {
+            opcode = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static codeg::PeepholeOperand GetPeepholeOperand(const std::string& str)
+{
+    if (str == "*")
+    {
+        return {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_ANY, 0, ""};
+    }
+    if ( (str.size() > 1) && (str[0] == '$') )
+    {
+        return {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED, 0, str};
+    }
+    for (uint8_t i=0; i<8; ++i)
+    {
+        if (str == codeg::ReadableStringBusses[i])
+        {
+            return {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_BUS, static_cast<uint8_t>(i<<5), ""};
+        }
+    }
+
+    uint32_t value = 0;
+    if ( (codeg::GetIntegerFromString(str, value) == 0) || (value > 0xFF) )
+    {
+        throw codeg::SyntaxError("bad operand \""+str+"\" (wanted a bus, a 8-bit constant, \"*\" or \"$name\")");
+    }
+    return {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_CONSTANT, static_cast<uint8_t>(value), ""};
+}
+
+static void GetPeepholeInstructions(const std::vector<std::string>& tokens, std::size_t begin, std::size_t end, bool pattern,
+                                    std::vector<codeg::PeepholeInstruction>& instructions)
+{
+    if ( !pattern && (end == begin+1) && (tokens[begin] == "-") )
+    {//Empty replacement
+        return;
+    }
+
+    std::size_t i = begin;
+    while (i < end)
+    {
+        codeg::PeepholeInstruction instruction{false, 0, {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_ANY, 0, ""}};
+        if ( pattern && (tokens[i] == "*") )
+        {
+            instruction._anyOpcode = true;
+        }
+        else if ( !codeg::GetPeepholeOpcode(tokens[i], instruction._opcode) )
+        {
+            throw codeg::SyntaxError("unknown opcode \""+tokens[i]+"\"");
+        }
+        ++i;
+
+        if ( (i < end) && (tokens[i] != ";") )
+        {
+            if (instruction._anyOpcode)
+            {
+                throw codeg::SyntaxError("\"*\" is any instruction, it can't have an operand");
+            }
+            instruction._operand = codeg::GetPeepholeOperand(tokens[i]);
+            ++i;
+        }
+        else if ( !pattern && (instruction._opcode != codeg::OPCODE_JMPSRC_CLK) )
+        {
+            throw codeg::SyntaxError("the instruction \""+tokens[i-1]+"\" of the replacement need an operand");
+        }
+
+        if (i < end)
+        {
+            if (tokens[i] != ";")
+            {
+                throw codeg::SyntaxError("unexpected \""+tokens[i]+"\" (instructions are separated by \";\")");
+            }
+            if (++i == end)
+            {
+                throw codeg::SyntaxError("missing instruction after \";\"");
+            }
+        }
+        instructions.push_back(instruction);
+    }
+}
+
+///Peephole
+
+void Peephole::clear()
+{
+    this->g_rules.clear();
+    this->g_nodes.clear();
+}
+
+void Peephole::addDefaultRules()
+{
+    for (const char* rule : codeg::DefaultPeepholeRules)
+    {
+        this->addRule(rule);
+    }
+}
+void Peephole::addRule(const std::string& line)
+{
+    //Separators are tokens even without spaces
+    std::string spaced;
+    for (char c : line)
+    {
+        if ( (c == ';') || (c == ',') )
+        {
+            spaced += std::string(" ")+c+" ";
+        }
+        else
+        {
+            spaced += c;
+        }
+    }
+
+    std::vector<std::string> tokens;
+    std::istringstream stream(spaced);
+    std::string token;
+    while (stream >> token)
+    {
+        tokens.push_back(token);
+    }
+
+    std::vector<std::string>::iterator itArrow = std::find(tokens.begin(), tokens.end(), "=>");
+    if ( (tokens.size() < 5) || (tokens[1] != ":") || (itArrow == tokens.end()) )
+    {
+        throw codeg::SyntaxError("bad rule \""+line+"\" (wanted \"name : pattern => replacement [if guards]\")");
+    }
+
+    codeg::PeepholeRule rule{tokens[0], {}, {}, {}, 0};
+    std::size_t arrow = itArrow - tokens.begin();
+    std::size_t guards = std::find(tokens.begin()+arrow, tokens.end(), "if") - tokens.begin();
+
+    try
+    {
+        if ( (arrow == 2) || (guards == arrow+1) )
+        {
+            throw codeg::SyntaxError("empty pattern or replacement");
+        }
+        codeg::GetPeepholeInstructions(tokens, 2, arrow, true, rule._pattern);
+        codeg::GetPeepholeInstructions(tokens, arrow+1, guards, false, rule._replacement);
+
+        for (std::size_t i=guards+1; i<tokens.size(); i+=4)
+        {
+            if ( (i+2 >= tokens.size()) || ((tokens[i+1] != "==") && (tokens[i+1] != "!=")) ||
+                 ((i+3 < tokens.size()) && (tokens[i+3] != ",")) )
+            {
+                throw codeg::SyntaxError("bad guard (wanted \"$name == operand\" or \"$name != operand\")");
+            }
+            codeg::PeepholeGuard guard{tokens[i], tokens[i+1] == "==", codeg::GetPeepholeOperand(tokens[i+2])};
+            if ( (tokens[i][0] != '$') || (guard._operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_ANY) )
+            {
+                throw codeg::SyntaxError("bad guard (wanted \"$name == operand\" or \"$name != operand\")");
+            }
+            rule._guards.push_back(guard);
+        }
+    }
+    catch (const codeg::SyntaxError& e)
+    {
+        throw codeg::SyntaxError("rule \""+rule._name+"\" : "+e.what());
+    }
+
+    ///Checking the rule
+    if (rule._replacement.size() >= rule._pattern.size())
+    {
+        throw codeg::SyntaxError("rule \""+rule._name+"\" : the replacement must have less instructions than the pattern");
+    }
+
+    std::vector<std::string> names;
+    for (auto&& vInstruction : rule._pattern)
+    {
+        if (vInstruction._operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED)
+        {
+            names.push_back(vInstruction._operand._name);
+        }
+    }
+    auto checkName = [&](const codeg::PeepholeOperand& operand)
+    {
+        if ( (operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED) &&
+             (std::find(names.begin(), names.end(), operand._name) == names.end()) )
+        {
+            throw codeg::SyntaxError("rule \""+rule._name+"\" : the operand \""+operand._name+"\" is not in the pattern");
+        }
+    };
+    for (auto&& vInstruction : rule._replacement)
+    {
+        checkName(vInstruction._operand);
+        if ( (vInstruction._opcode != codeg::OPCODE_JMPSRC_CLK) &&
+             ((vInstruction._operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_ANY) ||
+              ((vInstruction._operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_BUS) &&
+               (vInstruction._operand._value == codeg::ReadableBusses::READABLE_SOURCE))) )
+        {
+            throw codeg::SyntaxError("rule \""+rule._name+"\" : an operand of the replacement must be known");
+        }
+    }
+    for (auto&& vGuard : rule._guards)
+    {
+        checkName({codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED, 0, vGuard._name});
+        checkName(vGuard._operand);
+    }
+
+    this->g_rules.push_back(std::move(rule));
+    this->g_nodes.clear();
+}
+bool Peephole::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if ( !file )
+    {
+        return false;
+    }
+
+    std::string line;
+    unsigned int lineCount = 0;
+    while ( std::getline(file, line) )
+    {
+        ++lineCount;
+        if ( !line.empty() && (line.back() == '\r') )
+        {
+            line.pop_back();
+        }
+        std::size_t first = line.find_first_not_of(" \t");
+        if ( (first == std::string::npos) || (line[first] == '#') )
+        {//Empty line or comment
+            continue;
+        }
+
+        try
+        {
+            this->addRule(line);
+        }
+        catch (const codeg::SyntaxError& e)
+        {
+            throw codeg::SyntaxError("at line "+std::to_string(lineCount)+" : "+e.what());
+        }
+    }
+    return true;
+}
+
+void Peephole::compile()
+{
+    this->g_nodes.assign(1, {{}, 0, {}});
+
+    ///Trie of the opcodes, "*" is every opcode
+    std::vector<std::pair<std::size_t, std::size_t> > pending; //Node, next instruction of the pattern
+    for (std::size_t r=0; r<this->g_rules.size(); ++r)
+    {
+        const std::vector<codeg::PeepholeInstruction>& pattern = this->g_rules[r]._pattern;
+
+        pending.assign(1, {0, 0});
+        while ( !pending.empty() )
+        {
+            std::pair<std::size_t, std::size_t> actual = pending.back();
+            pending.pop_back();
+
+            if (actual.second == pattern.size())
+            {
+                this->g_nodes[actual.first]._matches.push_back(r);
+                continue;
+            }
+
+            for (uint8_t opcode=0; opcode<32; ++opcode)
+            {
+                const codeg::PeepholeInstruction& instruction = pattern[actual.second];
+                if ( !codeg::IsValidOpcode(opcode) || (!instruction._anyOpcode && (instruction._opcode != opcode)) )
+                {
+                    continue;
+                }
+
+                std::size_t next = this->g_nodes[actual.first]._next[opcode];
+                if (next == 0)
+                {
+                    next = this->g_nodes.size();
+                    this->g_nodes[actual.first]._next[opcode] = next;
+                    this->g_nodes.push_back({{}, 0, {}});
+                }
+                pending.push_back({next, actual.second+1});
+            }
+        }
+    }
+
+    ///Failure links, the missing transitions are taken from the longest suffix
+    std::vector<std::size_t> queue;
+    for (uint8_t opcode=0; opcode<32; ++opcode)
+    {
+        if (this->g_nodes[0]._next[opcode] != 0)
+        {
+            queue.push_back(this->g_nodes[0]._next[opcode]);
+        }
+    }
+    for (std::size_t q=0; q<queue.size(); ++q)
+    {
+        std::size_t node = queue[q];
+        std::size_t fail = this->g_nodes[node]._fail;
+
+        std::vector<std::size_t>& matches = this->g_nodes[node]._matches;
+        matches.insert(matches.end(), this->g_nodes[fail]._matches.begin(), this->g_nodes[fail]._matches.end());
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        for (uint8_t opcode=0; opcode<32; ++opcode)
+        {
+            std::size_t next = this->g_nodes[node]._next[opcode];
+            if (next == 0)
+            {
+                this->g_nodes[node]._next[opcode] = this->g_nodes[fail]._next[opcode];
+            }
+            else
+            {
+                this->g_nodes[next]._fail = this->g_nodes[fail]._next[opcode];
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+std::size_t Peephole::getNextState(std::size_t state, uint8_t opcode) const
+{
+    return this->g_nodes[state]._next[opcode & 0x1F];
+}
+const std::vector<std::size_t>& Peephole::getMatches(std::size_t state) const
+{
+    return this->g_nodes[state]._matches;
+}
+
+bool Peephole::match(std::size_t rule, const std::vector<codeg::PeepholeValue>& window, const std::vector<uint8_t>& opcodes,
+                     std::map<std::string, codeg::PeepholeValue>& values) const
+{
+    const codeg::PeepholeRule& actualRule = this->g_rules[rule];
+    if ( (window.size() != actualRule._pattern.size()) || (opcodes.size() != window.size()) )
+    {
+        return false;
+    }
+
+    auto isEqual = [](const codeg::PeepholeValue& a, const codeg::PeepholeValue& b)
+    {
+        return (a._bus == b._bus) && ((a._bus != codeg::ReadableBusses::READABLE_SOURCE) || (a._argument == b._argument));
+    };
+    auto isMatching = [&](const codeg::PeepholeValue& value, const codeg::PeepholeOperand& operand)
+    {
+        switch (operand._type)
+        {
+        case codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_BUS:
+            return value._bus == operand._value;
+        case codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_CONSTANT:
+            return (value._bus == codeg::ReadableBusses::READABLE_SOURCE) && (value._argument == operand._value);
+        case codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED:
+            return isEqual(value, values.at(operand._name));
+        default:
+            return true;
+        }
+    };
+
+    values.clear();
+    for (std::size_t i=0; i<window.size(); ++i)
+    {
+        const codeg::PeepholeInstruction& instruction = actualRule._pattern[i];
+        if ( !instruction._anyOpcode && (instruction._opcode != opcodes[i]) )
+        {
+            return false;
+        }
+
+        const codeg::PeepholeOperand& operand = instruction._operand;
+        if ( (operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED) && (values.find(operand._name) == values.end()) )
+        {
+            values[operand._name] = window[i];
+        }
+        else if ( !isMatching(window[i], operand) )
+        {
+            return false;
+        }
+    }
+
+    for (auto&& vGuard : actualRule._guards)
+    {
+        if (isMatching(values.at(vGuard._name), vGuard._operand) != vGuard._equal)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+void Peephole::getReplacement(std::size_t rule, const std::map<std::string, codeg::PeepholeValue>& values,
+                              std::vector<codeg::PeepholeInstruction>& replacement) const
+{
+    replacement = this->g_rules[rule]._replacement;
+    for (auto&& vInstruction : replacement)
+    {
+        codeg::PeepholeOperand& operand = vInstruction._operand;
+        if (operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_NAMED)
+        {
+            const codeg::PeepholeValue& value = values.at(operand._name);
+            if (value._bus == codeg::ReadableBusses::READABLE_SOURCE)
+            {
+                operand = {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_CONSTANT, value._argument, ""};
+            }
+            else
+            {
+                operand = {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_BUS, value._bus, ""};
+            }
+        }
+        else if (operand._type == codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_ANY)
+        {//Instruction without argument
+            operand = {codeg::PeepholeOperandTypes::PEEPHOLE_OPERAND_BUS, codeg::ReadableBusses::READABLE_SOURCE, ""};
+        }
+    }
+}
+
+void Peephole::addHit(std::size_t rule)
+{
+    ++this->g_rules[rule]._hits;
+}
+
+const std::vector<codeg::PeepholeRule>& Peephole::getRules() const
+{
+    return this->g_rules;
+}
+
+}//end codeg
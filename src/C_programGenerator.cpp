@@ -0,0 +1,181 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_programGenerator.hpp"
+#include "C_string.hpp"
+#include <fstream>
+#include <algorithm>
+
+namespace codeg
+{
+
+void ProgramGenerator::setSettings(const codeg::ProgramGeneratorSettings& settings)
+{
+    this->g_settings = settings;
+}
+const codeg::ProgramGeneratorSettings& ProgramGenerator::getSettings() const
+{
+    return this->g_settings;
+}
+
+bool ProgramGenerator::generate(const std::string& mainPath)
+{
+    this->g_random.seed(this->g_settings._seed);
+    this->g_lineCount = 0;
+    this->g_files.clear();
+
+    this->g_pools = std::max<uint32_t>(this->scaled(this->g_settings._pools), 1);
+    this->g_variablesPerPool = std::max<uint32_t>(this->g_settings._variablesPerPool, 1);
+    uint32_t labels = std::max<uint32_t>(this->scaled(this->g_settings._labels), 1);
+    uint32_t statements = this->scaled(this->g_settings._statements);
+    uint32_t imports = this->scaled(this->g_settings._imports);
+    uint32_t definitions = this->scaled(this->g_settings._definitions);
+    uint32_t calls = (definitions > 0) ? this->scaled(this->g_settings._calls) : 0;
+
+    std::string directory = codeg::GetRelativePath(mainPath);
+    std::string mainName = mainPath.substr(directory.size());
+
+    std::ofstream fileMain(mainPath, std::ios::trunc);
+    if ( !fileMain )
+    {
+        return false;
+    }
+    this->g_files.push_back(mainPath);
+
+    this->writeLine(fileMain, 0, "# Generated program (seed "+std::to_string(this->g_settings._seed)+", scale "+std::to_string(this->g_settings._scale)+")");
+
+    ///Pools and variables
+    for (uint32_t p=0; p<this->g_pools; ++p)
+    {
+        this->writeLine(fileMain, 0, "pool POOL"+std::to_string(p)+" 0");
+    }
+    for (uint32_t p=0; p<this->g_pools; ++p)
+    {
+        for (uint32_t v=0; v<this->g_variablesPerPool; ++v)
+        {
+            this->writeLine(fileMain, 0, "var v"+std::to_string(p)+"_"+std::to_string(v)+" POOL"+std::to_string(p));
+        }
+    }
+
+    ///Definitions, in the imported files (or in the main file without import)
+    std::vector<std::ofstream> fileImports;
+    for (uint32_t i=0; i<imports; ++i)
+    {
+        std::string importName = mainName+".lib"+std::to_string(i);
+        fileImports.emplace_back(directory+importName, std::ios::trunc);
+        if ( !fileImports.back() )
+        {
+            return false;
+        }
+        this->g_files.push_back(directory+importName);
+        this->writeLine(fileMain, 0, "import \""+importName+"\"");
+    }
+    for (uint32_t d=0; d<definitions; ++d)
+    {
+        std::ostream& stream = imports ? static_cast<std::ostream&>(fileImports[d%imports]) : static_cast<std::ostream&>(fileMain);
+        this->writeLine(stream, 0, "definition D"+std::to_string(d));
+        uint32_t remaining = 2;
+        while (remaining > 0)
+        {
+            this->writeStatement(stream, 1, remaining, 0);
+        }
+        this->writeLine(stream, 0, "end_def");
+    }
+
+    ///Main code, the statements and the calls are shared between the labels
+    uint32_t remainingStatements = statements;
+    uint32_t remainingCalls = calls;
+    for (uint32_t l=0; l<labels; ++l)
+    {
+        this->writeLine(fileMain, 0, "label L"+std::to_string(l));
+
+        uint32_t labelStatements = remainingStatements/(labels-l);
+        remainingStatements -= labelStatements;
+        while (labelStatements > 0)
+        {
+            this->writeStatement(fileMain, 0, labelStatements, l+1);
+        }
+
+        uint32_t labelCalls = remainingCalls/(labels-l);
+        remainingCalls -= labelCalls;
+        for (uint32_t c=0; c<labelCalls; ++c)
+        {
+            this->writeLine(fileMain, 0, "call D"+std::to_string(this->random(definitions)));
+        }
+    }
+    this->writeLine(fileMain, 0, "jump L0");
+
+    return true;
+}
+
+uint32_t ProgramGenerator::getLineCount() const
+{
+    return this->g_lineCount;
+}
+const std::vector<std::string>& ProgramGenerator::getFiles() const
+{
+    return this->g_files;
+}
+
+uint32_t ProgramGenerator::random(uint32_t count)
+{
+    return (count > 0) ? (this->g_random() % count) : 0;
+}
+uint32_t ProgramGenerator::scaled(uint32_t count) const
+{
+    return count * this->g_settings._scale;
+}
+
+std::string ProgramGenerator::getVariable()
+{
+    uint32_t pool = this->random(this->g_pools);
+    return "$v"+std::to_string(pool)+"_"+std::to_string(this->random(this->g_variablesPerPool))+":POOL"+std::to_string(pool);
+}
+void ProgramGenerator::writeLine(std::ostream& stream, unsigned int depth, const std::string& line)
+{
+    stream << std::string(depth*4, ' ') << line << '\n';
+    ++this->g_lineCount;
+}
+void ProgramGenerator::writeStatement(std::ostream& stream, unsigned int depth, uint32_t& remaining, uint32_t labelCount)
+{
+    --remaining;
+
+    uint32_t choice = this->random(8);
+    if ( (choice >= 6) && (depth < this->g_settings._ifDepth) && (remaining > 0) )
+    {//Condition with a few statements inside
+        this->writeLine(stream, depth, "if "+this->getVariable());
+        uint32_t inside = 1 + this->random(std::min<uint32_t>(remaining, 3));
+        while ( (inside-- > 0) && (remaining > 0) )
+        {
+            this->writeStatement(stream, depth+1, remaining, labelCount);
+        }
+        if ( (labelCount > 0) && (this->random(4) == 0) )
+        {//Backward jump (the labels must be known)
+            this->writeLine(stream, depth+1, "jump L"+std::to_string(this->random(labelCount)));
+        }
+        this->writeLine(stream, depth, "end");
+    }
+    else if (choice >= 4)
+    {
+        this->writeLine(stream, depth, "write 1 "+this->getVariable());
+    }
+    else
+    {
+        this->writeLine(stream, depth, "affect "+this->getVariable()+" "+codeg::ValueToHex(this->random(256), 2));
+    }
+}
+
+}//end codeg
@@ -1,61 +1,111 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "C_reserved.hpp"
-
-namespace codeg
-{
-
-void ReservedList::clear()
-{
-    this->g_data.clear();
-}
-
-bool ReservedList::isReserved(const std::string& str)
-{
-    for (auto& val : this->g_data)
-    {
-        if (val == str)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-void ReservedList::push(const std::string& str)
-{
-    for (auto& val : this->g_data)
-    {
-        if (val == str)
-        {
-            return;
-        }
-    }
-    this->g_data.push_front(str);
-}
-void ReservedList::push(std::string&& str)
-{
-    for (auto& val : this->g_data)
-    {
-        if (val == str)
-        {
-            return;
-        }
-    }
-    this->g_data.push_front(std::move(str));
-}
-
-}//end codeg
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_reserved.hpp"
+
+namespace codeg
+{
+
+void ReservedList::clear()
+{
+    this->g_data.clear();
+}
+
+bool ReservedList::isReserved(const std::string& str)
+{
+    for (auto& val : this->g_data)
+    {
+        if (val == str)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+void ReservedList::push(const std::string& str)
+{
+    for (auto& val : this->g_data)
+    {
+        if (val == str)
+        {
+            return;
+        }
+    }
+    this->g_data.push_front(str);
+}
+void ReservedList::push(std::string&& str)
+{
+    for (auto& val : this->g_data)
+    {
+        if (val == str)
+        {
+            return;
+        }
+    }
+    this->g_data.push_front(std::move(str));
+}
+
+void ReservedList::pushDefaultKeywords()
+{
+    this->push("set");
+    this->push("unset");
+    this->push("var");
+    this->push("label");
+    this->push("affect");
+    this->push("get");
+    this->push("function");
+    this->push("do");
+    this->push("if_not");
+    this->push("else");
+    this->push("end");
+    this->push("choose");
+    this->push("OP");
+    this->push("P");
+    this->push("write");
+    this->push("if");
+    this->push("brut");
+    this->push("jump");
+    this->push("call");
+    this->push("restart");
+    this->push("PERIPHERAL");
+    this->push("OPERATION");
+    this->push("tick");
+    this->push("simple");
+    this->push("long");
+    this->push("repeat");
+    this->push("switch");
+    this->push("case");
+    this->push("default");
+    this->push("_src");
+    this->push("_bread1");
+    this->push("_bread2");
+    this->push("_result");
+    this->push("_ram");
+    this->push("_spi");
+    this->push("_ext1");
+    this->push("_ext2");
+    this->push("pool");
+    this->push("#");
+    this->push("#[");
+    this->push("]#");
+    this->push("SPI");
+    this->push("import");
+    this->push("definition");
+    this->push("end_def");
+    this->push("wcet");
+}
+
+}//end codeg
@@ -0,0 +1,393 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_simulator.hpp"
+#include "C_instruction.hpp"
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__)
+    #define CODEG_SIMULATOR_THREADED
+#endif
+
+namespace codeg
+{
+
+const char* ReadableStringSimulatorStops[]=
+{
+    "end of the code",
+    "instruction limit",
+    "bad jump",
+    "unknown opcode"
+};
+
+///Handlers
+
+//Every opcode in the order of its value (LTICK is after RAMW)
+#define CODEG_SIMULATOR_OPCODES(X) \
+    X(BWRITE1) X(BWRITE2) X(BPCS) X(OPLEFT) X(OPRIGHT) X(OPCHOOSE) X(PERIPHERAL) \
+    X(BJMPSRC1) X(BJMPSRC2) X(BJMPSRC3) X(JMPSRC) X(BRAMADD1) X(BRAMADD2) X(SPI) X(BCFGSPI) \
+    X(STICK) X(IF) X(IFNOT) X(RAMW) X(LTICK)
+
+enum SimulatorKinds : uint16_t
+{
+    //Every opcode have a handler for each operand : constant, external bus, RAM and ALU result
+    #define CODEG_SIMULATOR_KINDS(name) SIMULATOR_KIND_##name##_CONSTANT, SIMULATOR_KIND_##name##_BUS, \
+                                        SIMULATOR_KIND_##name##_RAM, SIMULATOR_KIND_##name##_RESULT,
+    CODEG_SIMULATOR_OPCODES(CODEG_SIMULATOR_KINDS)
+    #undef CODEG_SIMULATOR_KINDS
+
+    SIMULATOR_KIND_UNKNOWN,
+    SIMULATOR_KIND_END
+};
+
+static uint16_t GetSimulatorKind(uint8_t code)
+{
+    uint8_t opcode = code & 0x1F;
+    uint16_t base;
+    if (opcode <= codeg::OPCODE_RAMW)
+    {
+        base = opcode;
+    }
+    else if (opcode == codeg::OPCODE_LTICK)
+    {
+        base = codeg::OPCODE_RAMW+1;
+    }
+    else
+    {
+        return codeg::SimulatorKinds::SIMULATOR_KIND_UNKNOWN;
+    }
+
+    switch (code & 0xE0)
+    {
+    case codeg::ReadableBusses::READABLE_SOURCE:
+        return base*4;
+    case codeg::ReadableBusses::READABLE_RAM:
+        return base*4 + 2;
+    case codeg::ReadableBusses::READABLE_RESULT:
+        return base*4 + 3;
+    default:
+        return base*4 + 1;
+    }
+}
+
+///Simulator
+
+Simulator::Simulator()
+{
+    std::fill(std::begin(this->g_alu), std::end(this->g_alu), nullptr);
+    std::fill(std::begin(this->g_inputs), std::end(this->g_inputs), 0);
+    this->clear();
+}
+
+void Simulator::clear()
+{
+    this->g_ops.assign(2, {nullptr, 0, codeg::SimulatorKinds::SIMULATOR_KIND_END, 0, 0});
+    this->g_opIndex.assign(1, 0);
+    this->g_threaded = false;
+    this->reset();
+}
+
+bool Simulator::load(const std::vector<uint8_t>& code, bool writeDummy)
+{
+    this->g_ops.clear();
+    this->g_opIndex.assign(code.size()+1, std::numeric_limits<uint32_t>::max());
+    this->g_threaded = false;
+
+    for (std::size_t i=0; i<code.size();)
+    {
+        uint8_t opcode = code[i] & 0x1F;
+        uint8_t bus = code[i] & 0xE0;
+        bool argument = (opcode != codeg::OPCODE_JMPSRC_CLK) && (writeDummy || (bus == codeg::ReadableBusses::READABLE_SOURCE));
+        if ( argument && (i+1 >= code.size()) )
+        {//Truncated instruction
+            this->clear();
+            return false;
+        }
+
+        codeg::SimulatorOp op;
+        op._handler = nullptr;
+        op._address = i;
+        op._kind = codeg::GetSimulatorKind(code[i]);
+        op._value = (bus == codeg::ReadableBusses::READABLE_SOURCE) ? (argument ? code[i+1] : 0) : (bus >> 5);
+        op._cycles = ToOpcodeCycles(opcode);
+
+        this->g_opIndex[i] = this->g_ops.size();
+        this->g_ops.push_back(op);
+        i += argument ? 2 : 1;
+    }
+
+    //A skipped instruction can't go after the end
+    this->g_opIndex[code.size()] = this->g_ops.size();
+    this->g_ops.push_back({nullptr, static_cast<uint32_t>(code.size()), codeg::SimulatorKinds::SIMULATOR_KIND_END, 0, 0});
+    this->g_ops.push_back(this->g_ops.back());
+
+    this->reset();
+    return true;
+}
+bool Simulator::loadFromFile(const std::string& path, bool writeDummy)
+{
+    std::ifstream file(path, std::ios::binary);
+    if ( !file )
+    {
+        return false;
+    }
+    std::vector<uint8_t> code{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return this->load(code, writeDummy);
+}
+std::size_t Simulator::getInstructionCount() const
+{
+    return this->g_ops.size()-2;
+}
+
+void Simulator::setAlu(const codeg::Alu& alu)
+{
+    for (unsigned int i=0; i<256; ++i)
+    {
+        const codeg::AluOperation* operation = alu.getOperation(i);
+        this->g_alu[i] = (operation != nullptr) ? operation->_function : nullptr;
+    }
+}
+void Simulator::setInput(codeg::ReadableBusses bus, uint8_t value)
+{
+    this->g_inputs[bus >> 5] = value;
+}
+
+void Simulator::reset()
+{
+    this->g_counters = codeg::SimulatorCounters();
+    this->g_registers = codeg::SimulatorRegisters();
+    this->g_ram.assign(0x10000, 0);
+    this->g_actualOp = 0;
+}
+codeg::SimulatorStops Simulator::run(uint64_t maxInstructions)
+{
+    return this->execute(maxInstructions);
+}
+
+const codeg::SimulatorCounters& Simulator::getCounters() const
+{
+    return this->g_counters;
+}
+const codeg::SimulatorRegisters& Simulator::getRegisters() const
+{
+    return this->g_registers;
+}
+uint8_t Simulator::getRam(uint16_t address) const
+{
+    return this->g_ram[address];
+}
+
+#if defined(CODEG_SIMULATOR_THREADED)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpedantic"
+
+    #define CODEG_SIMULATOR_CASE(kind) HANDLER_##kind:
+    #define CODEG_SIMULATOR_DISPATCH goto *op->_handler;
+#else
+    #define CODEG_SIMULATOR_CASE(kind) case codeg::SimulatorKinds::SIMULATOR_KIND_##kind:
+    #define CODEG_SIMULATOR_DISPATCH continue;
+#endif
+
+#define CODEG_SIMULATOR_COUNT ++instructions; cycles += op->_cycles;
+#define CODEG_SIMULATOR_NEXT CODEG_SIMULATOR_COUNT ++op; CODEG_SIMULATOR_DISPATCH
+
+#define CODEG_SIMULATOR_UPDATE_RESULT \
+    if (resultDirty) \
+    { \
+        codeg::AluFunction function = this->g_alu[operation]; \
+        result = (function != nullptr) ? function(left, right) : 0; \
+        resultDirty = false; \
+    }
+
+#define CODEG_SIMULATOR_HANDLER(name, ...) \
+    CODEG_SIMULATOR_CASE(name##_CONSTANT) { [[maybe_unused]] const uint8_t value = op->_value; __VA_ARGS__ } \
+    CODEG_SIMULATOR_CASE(name##_BUS) { [[maybe_unused]] const uint8_t value = inputs[op->_value]; __VA_ARGS__ } \
+    CODEG_SIMULATOR_CASE(name##_RAM) { [[maybe_unused]] const uint8_t value = ram[ramAddress]; __VA_ARGS__ } \
+    CODEG_SIMULATOR_CASE(name##_RESULT) { CODEG_SIMULATOR_UPDATE_RESULT [[maybe_unused]] const uint8_t value = result; __VA_ARGS__ }
+
+codeg::SimulatorStops Simulator::execute(uint64_t maxInstructions)
+{
+    #if defined(CODEG_SIMULATOR_THREADED)
+    static const void* handlers[]=
+    {
+        #define CODEG_SIMULATOR_LABELS(name) &&HANDLER_##name##_CONSTANT, &&HANDLER_##name##_BUS, \
+                                             &&HANDLER_##name##_RAM, &&HANDLER_##name##_RESULT,
+        CODEG_SIMULATOR_OPCODES(CODEG_SIMULATOR_LABELS)
+        #undef CODEG_SIMULATOR_LABELS
+
+        &&HANDLER_UNKNOWN,
+        &&HANDLER_END
+    };
+    if ( !this->g_threaded )
+    {
+        for (codeg::SimulatorOp& vOp : this->g_ops)
+        {
+            vOp._handler = handlers[vOp._kind];
+        }
+        this->g_threaded = true;
+    }
+    #endif
+
+    ///Local copy of the machine, written back when stopping
+    const codeg::SimulatorOp* const ops = this->g_ops.data();
+    const uint32_t* const opIndex = this->g_opIndex.data();
+    const std::size_t codeSize = this->g_opIndex.size();
+    uint8_t* const ram = this->g_ram.data();
+    const uint8_t* const inputs = this->g_inputs;
+
+    const codeg::SimulatorOp* op = ops + this->g_actualOp;
+    codeg::SimulatorRegisters registers = this->g_registers;
+    codeg::SimulatorCounters counters = this->g_counters;
+
+    uint8_t left = registers._left;
+    uint8_t operation = registers._operation;
+    uint8_t right = registers._right;
+    uint8_t result = 0;
+    bool resultDirty = true;
+    uint16_t ramAddress = registers._ramAddress;
+    uint64_t instructions = counters._instructions;
+    uint64_t cycles = counters._cycles;
+    codeg::SimulatorStops stop = codeg::SimulatorStops::SIMULATOR_STOP_END;
+
+    if (instructions >= maxInstructions)
+    {
+        return codeg::SimulatorStops::SIMULATOR_STOP_LIMIT;
+    }
+
+    #if defined(CODEG_SIMULATOR_THREADED)
+    CODEG_SIMULATOR_DISPATCH
+    #else
+    for (;;)
+    {
+    switch (op->_kind)
+    {
+    #endif
+
+    CODEG_SIMULATOR_HANDLER(BWRITE1, registers._bus1 = value; ++counters._writes1; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BWRITE2, registers._bus2 = value; ++counters._writes2; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BPCS, registers._peripheral = value; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(OPLEFT, left = value; resultDirty = true; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(OPRIGHT, right = value; resultDirty = true; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(OPCHOOSE, operation = value; resultDirty = true; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(PERIPHERAL, ++counters._peripheralClocks; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(BJMPSRC1, registers._jump[0] = value; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BJMPSRC2, registers._jump[1] = value; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BJMPSRC3, registers._jump[2] = value; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(JMPSRC,
+    {
+        uint32_t target = (static_cast<uint32_t>(registers._jump[2])<<16) |
+                          (static_cast<uint32_t>(registers._jump[1])<<8) | registers._jump[0];
+        if ( (target >= codeSize) || (opIndex[target] == std::numeric_limits<uint32_t>::max()) )
+        {
+            stop = codeg::SimulatorStops::SIMULATOR_STOP_BAD_JUMP;
+            goto stopping;
+        }
+        CODEG_SIMULATOR_COUNT
+        ++counters._jumps;
+        op = ops + opIndex[target];
+
+        //The straight code is limited by the code size, the limit is only checked when jumping
+        if (instructions >= maxInstructions)
+        {
+            stop = codeg::SimulatorStops::SIMULATOR_STOP_LIMIT;
+            goto stopping;
+        }
+        CODEG_SIMULATOR_DISPATCH
+    })
+
+    CODEG_SIMULATOR_HANDLER(BRAMADD1, ramAddress = (ramAddress&0xFF00) | value; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BRAMADD2, ramAddress = (ramAddress&0x00FF) | (static_cast<uint16_t>(value)<<8); CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(SPI, registers._spi = value; ++counters._spiClocks; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(BCFGSPI, registers._spiConfig = value; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(STICK, ++counters._ticks; CODEG_SIMULATOR_NEXT)
+    CODEG_SIMULATOR_HANDLER(LTICK, ++counters._longTicks; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_HANDLER(IF,
+    {
+        CODEG_SIMULATOR_COUNT
+        if (value != 0)
+        {
+            ++counters._skipped;
+            cycles += op[1]._cycles;
+            op += 2;
+        }
+        else
+        {
+            ++op;
+        }
+        CODEG_SIMULATOR_DISPATCH
+    })
+    CODEG_SIMULATOR_HANDLER(IFNOT,
+    {
+        CODEG_SIMULATOR_COUNT
+        if (value == 0)
+        {
+            ++counters._skipped;
+            cycles += op[1]._cycles;
+            op += 2;
+        }
+        else
+        {
+            ++op;
+        }
+        CODEG_SIMULATOR_DISPATCH
+    })
+
+    CODEG_SIMULATOR_HANDLER(RAMW, ram[ramAddress] = value; ++counters._ramWrites; CODEG_SIMULATOR_NEXT)
+
+    CODEG_SIMULATOR_CASE(UNKNOWN)
+        stop = codeg::SimulatorStops::SIMULATOR_STOP_UNKNOWN_OPCODE;
+        goto stopping;
+    CODEG_SIMULATOR_CASE(END)
+        stop = codeg::SimulatorStops::SIMULATOR_STOP_END;
+        goto stopping;
+
+    #if !defined(CODEG_SIMULATOR_THREADED)
+    default:
+        stop = codeg::SimulatorStops::SIMULATOR_STOP_UNKNOWN_OPCODE;
+        goto stopping;
+    }
+    }
+    #endif
+
+stopping:
+    registers._left = left;
+    registers._operation = operation;
+    registers._right = right;
+    registers._ramAddress = ramAddress;
+    registers._address = op->_address;
+    counters._instructions = instructions;
+    counters._cycles = cycles;
+
+    this->g_registers = registers;
+    this->g_counters = counters;
+    this->g_actualOp = op - ops;
+    return stop;
+}
+
+#if defined(CODEG_SIMULATOR_THREADED)
+    #pragma GCC diagnostic pop
+#endif
+
+}//end codeg
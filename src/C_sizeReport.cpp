@@ -0,0 +1,460 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_sizeReport.hpp"
+#include "C_compilerData.hpp"
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_json.hpp"
+#include "C_error.hpp"
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <cstdlib>
+
+namespace codeg
+{
+
+const char* ReadableStringSizeClasses[]=
+{
+    "address",
+    "jump",
+    "alu",
+    "bus",
+    "condition",
+    "tick",
+    "brut"
+};
+
+namespace
+{
+
+const char* ReadableStringSizeClassesLong[]=
+{
+    "address setup (BRAMADD*)",
+    "jump setup (BJMPSRC*, JMPSRC)",
+    "ALU (OPLEFT, OPRIGHT, OPCHOOSE, UOP)",
+    "bus writes (BWRITE*, BPCS, PERIPHERAL, SPI, RAMW)",
+    "conditions (IF, IFNOT)",
+    "ticks (STICK, LTICK)",
+    "brut"
+};
+
+#define CODEG_SIZEREPORT_TEXT_LINES 20
+
+std::string GetFunctionName(const std::string& name, bool definition)
+{
+    if ( name.empty() )
+    {
+        return "main code";
+    }
+    return (definition ? "definition \"" : "function \"")+name+"\"";
+}
+
+std::string GetPercent(uint32_t value, uint32_t total)
+{
+    if (total == 0)
+    {
+        return "0.0%";
+    }
+    uint32_t permil = static_cast<uint32_t>((static_cast<uint64_t>(value)*1000 + total/2) / total);
+    return std::to_string(permil/10)+"."+std::to_string(permil%10)+"%";
+}
+
+void WriteClasses(std::ostream& stream, const codeg::SizeEntry& entry)
+{
+    stream << "{";
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        stream << (i ? ", " : "") << "\"" << codeg::ReadableStringSizeClasses[i] << "\": " << entry._classes[i];
+    }
+    stream << "}";
+}
+void ReadClasses(const codeg::JsonValue& value, codeg::SizeEntry& entry)
+{
+    entry._bytes = static_cast<uint32_t>(value["bytes"].getNumber());
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        entry._classes[i] = static_cast<uint32_t>(value["classes"][codeg::ReadableStringSizeClasses[i]].getNumber());
+    }
+}
+
+void AddBytes(codeg::SizeEntry& entry, codeg::SizeClasses sizeClass, uint32_t bytes)
+{
+    entry._bytes += bytes;
+    entry._classes[sizeClass] += bytes;
+}
+
+}//end
+
+codeg::SizeClasses GetSizeClass(uint8_t opcode)
+{
+    switch (opcode & 0x1F)
+    {
+    case codeg::OPCODE_BRAMADD1_CLK:
+    case codeg::OPCODE_BRAMADD2_CLK:
+        return codeg::SizeClasses::SIZE_CLASS_ADDRESS;
+    case codeg::OPCODE_BJMPSRC1_CLK:
+    case codeg::OPCODE_BJMPSRC2_CLK:
+    case codeg::OPCODE_BJMPSRC3_CLK:
+    case codeg::OPCODE_JMPSRC_CLK:
+        return codeg::SizeClasses::SIZE_CLASS_JUMP;
+    case codeg::OPCODE_BWRITE1_CLK:
+    case codeg::OPCODE_BWRITE2_CLK:
+    case codeg::OPCODE_BPCS_CLK:
+    case codeg::OPCODE_PERIPHERAL_CLK:
+    case codeg::OPCODE_SPI_CLK:
+    case codeg::OPCODE_BCFG_SPI_CLK:
+    case codeg::OPCODE_RAMW:
+        return codeg::SizeClasses::SIZE_CLASS_BUS;
+    case codeg::OPCODE_IF:
+    case codeg::OPCODE_IFNOT:
+        return codeg::SizeClasses::SIZE_CLASS_CONDITION;
+    case codeg::OPCODE_STICK:
+    case codeg::OPCODE_LTICK:
+        return codeg::SizeClasses::SIZE_CLASS_TICK;
+    default:
+        return codeg::SizeClasses::SIZE_CLASS_ALU;
+    }
+}
+
+void UpdateCodeOrigin(codeg::CompilerData& data, const std::string& keyword)
+{
+    if ( data._codeOrigins.empty() )
+    {//Bytes emitted by the compiler itself
+        data._codeOrigins.push_back({"", false, "", 0, ""});
+    }
+
+    const codeg::Function* expanded = data._reader.getExpandedFunction();
+    const std::string& function = (expanded != nullptr) ? expanded->getName() : data._actualFunctionName;
+    bool definition = (expanded != nullptr) && expanded->isDefinition();
+    std::string file = data._reader.getFilePath();
+    unsigned int line = data._reader.getFilelineCount();
+
+    const codeg::CodeOrigin& last = data._codeOrigins.back();
+    if ( (last._line != line) || (last._keyword != keyword) || (last._function != function) ||
+         (last._definition != definition) || (last._file != file) )
+    {
+        data._codeOrigins.push_back({function, definition, file, line, keyword});
+    }
+    data._code.setOrigin(data._codeOrigins.size()-1);
+}
+
+///SizeReport
+
+void SizeReport::clear()
+{
+    this->g_total = 0;
+    this->g_capacity = 0;
+    this->g_classes = codeg::SizeEntry();
+    this->g_functions.clear();
+    this->g_keywords.clear();
+    this->g_lines.clear();
+}
+
+void SizeReport::build(codeg::CompilerData& data)
+{
+    this->clear();
+
+    const uint8_t* code = data._code.getData();
+    const uint32_t size = data._code.getCursor();
+    const bool writeDummy = data._code.getWriteDummy();
+    const codeg::CodeOrigin unknown{"", false, "", 0, ""};
+
+    this->g_total = size;
+    this->g_capacity = data._code.getCapacity();
+
+    for (uint32_t i=0; i<size;)
+    {
+        uint32_t originIndex = data._code.getOrigin(i);
+        const codeg::CodeOrigin& origin = (originIndex < data._codeOrigins.size()) ? data._codeOrigins[originIndex] : unknown;
+
+        uint8_t opcode = code[i] & 0x1F;
+        uint32_t bytes = 1;
+        codeg::SizeClasses sizeClass = codeg::SizeClasses::SIZE_CLASS_BRUT;
+        if (origin._keyword != "brut")
+        {//Brut bytes are counted one by one, they can be anything
+            if ( (opcode != codeg::OPCODE_JMPSRC_CLK) && (writeDummy || ((code[i]&0xE0) == codeg::ReadableBusses::READABLE_SOURCE)) )
+            {
+                bytes = std::min<uint32_t>(2, size-i);
+            }
+            sizeClass = codeg::GetSizeClass(opcode);
+        }
+
+        AddBytes(this->g_classes, sizeClass, bytes);
+
+        codeg::SizeEntry& function = this->g_functions[origin._function];
+        function._definition = origin._definition;
+        AddBytes(function, sizeClass, bytes);
+
+        AddBytes(this->g_keywords[origin._keyword], sizeClass, bytes);
+        AddBytes(this->g_lines[{origin._file, origin._line}], sizeClass, bytes);
+
+        i += bytes;
+    }
+}
+
+bool SizeReport::loadJson(const std::string& path)
+{
+    codeg::JsonValue document;
+    if ( !codeg::JsonValue::parseFile(path, document) )
+    {
+        return false;
+    }
+    if (document.getType() != codeg::JsonValue::Types::TYPE_OBJECT)
+    {
+        throw codeg::SyntaxError("json : the size report must be an object");
+    }
+
+    this->clear();
+    this->g_total = static_cast<uint32_t>(document["total"].getNumber());
+    this->g_capacity = static_cast<uint32_t>(document["capacity"].getNumber());
+
+    this->g_classes._bytes = this->g_total;
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        this->g_classes._classes[i] = static_cast<uint32_t>(document["classes"][codeg::ReadableStringSizeClasses[i]].getNumber());
+    }
+
+    const codeg::JsonValue& functions = document["functions"];
+    for (std::size_t i=0; i<functions.size(); ++i)
+    {
+        codeg::SizeEntry& entry = this->g_functions[functions[i]["name"].getString()];
+        ReadClasses(functions[i], entry);
+        entry._definition = functions[i]["definition"].getBool();
+    }
+    const codeg::JsonValue& keywords = document["keywords"];
+    for (std::size_t i=0; i<keywords.size(); ++i)
+    {
+        ReadClasses(keywords[i], this->g_keywords[keywords[i]["name"].getString()]);
+    }
+    const codeg::JsonValue& lines = document["lines"];
+    for (std::size_t i=0; i<lines.size(); ++i)
+    {
+        ReadClasses(lines[i], this->g_lines[{lines[i]["file"].getString(), static_cast<unsigned int>(lines[i]["line"].getNumber())}]);
+    }
+    return true;
+}
+
+void SizeReport::writeJson(std::ostream& stream) const
+{
+    stream << "{" << std::endl;
+    stream << "  \"total\": " << this->g_total << "," << std::endl;
+    stream << "  \"capacity\": " << this->g_capacity << "," << std::endl;
+    stream << "  \"classes\": ";
+    WriteClasses(stream, this->g_classes);
+    stream << "," << std::endl;
+
+    stream << "  \"functions\": [";
+    bool first = true;
+    for (auto&& vFunction : this->g_functions)
+    {
+        stream << (first ? "" : ",") << std::endl << "    {\"name\": \"" << codeg::JsonEscape(vFunction.first)
+               << "\", \"definition\": " << (vFunction.second._definition ? "true" : "false")
+               << ", \"bytes\": " << vFunction.second._bytes << ", \"classes\": ";
+        WriteClasses(stream, vFunction.second);
+        stream << "}";
+        first = false;
+    }
+    stream << std::endl << "  ]," << std::endl;
+
+    stream << "  \"keywords\": [";
+    first = true;
+    for (auto&& vKeyword : this->g_keywords)
+    {
+        stream << (first ? "" : ",") << std::endl << "    {\"name\": \"" << codeg::JsonEscape(vKeyword.first)
+               << "\", \"bytes\": " << vKeyword.second._bytes << ", \"classes\": ";
+        WriteClasses(stream, vKeyword.second);
+        stream << "}";
+        first = false;
+    }
+    stream << std::endl << "  ]," << std::endl;
+
+    stream << "  \"lines\": [";
+    first = true;
+    for (auto&& vLine : this->g_lines)
+    {
+        stream << (first ? "" : ",") << std::endl << "    {\"file\": \"" << codeg::JsonEscape(vLine.first.first)
+               << "\", \"line\": " << vLine.first.second << ", \"bytes\": " << vLine.second._bytes << ", \"classes\": ";
+        WriteClasses(stream, vLine.second);
+        stream << "}";
+        first = false;
+    }
+    stream << std::endl << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+void SizeReport::writeText(std::ostream& stream) const
+{
+    stream << "Code size : " << this->g_total << " bytes (" << GetPercent(this->g_total, this->g_capacity)
+           << " of " << this->g_capacity << " bytes)" << std::endl << std::endl;
+
+    stream << "By opcode class :" << std::endl;
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        stream << "\t" << ReadableStringSizeClassesLong[i] << " : " << this->g_classes._classes[i]
+               << " bytes (" << GetPercent(this->g_classes._classes[i], this->g_total) << ")" << std::endl;
+    }
+    stream << std::endl;
+
+    std::vector<std::pair<std::string, const codeg::SizeEntry*> > sorted;
+    auto sortEntries = [&]()
+    {
+        std::stable_sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, const codeg::SizeEntry*>& a,
+                                                          const std::pair<std::string, const codeg::SizeEntry*>& b)
+        {
+            return a.second->_bytes > b.second->_bytes;
+        });
+    };
+    auto writeEntries = [&](std::size_t maxCount)
+    {
+        for (std::size_t i=0; (i<sorted.size()) && (i<maxCount); ++i)
+        {
+            const codeg::SizeEntry& entry = *sorted[i].second;
+            stream << "\t" << sorted[i].first << " : " << entry._bytes << " bytes (" << GetPercent(entry._bytes, this->g_total) << ") [";
+            bool first = true;
+            for (uint8_t c=0; c<codeg::SizeClasses::SIZE_CLASS_COUNT; ++c)
+            {
+                if (entry._classes[c] > 0)
+                {
+                    stream << (first ? "" : ", ") << codeg::ReadableStringSizeClasses[c] << " " << entry._classes[c];
+                    first = false;
+                }
+            }
+            stream << "]" << std::endl;
+        }
+        if (sorted.size() > maxCount)
+        {
+            stream << "\t... " << (sorted.size()-maxCount) << " more" << std::endl;
+        }
+        stream << std::endl;
+    };
+
+    stream << "By function/definition :" << std::endl;
+    sorted.clear();
+    for (auto&& vFunction : this->g_functions)
+    {
+        sorted.push_back({GetFunctionName(vFunction.first, vFunction.second._definition), &vFunction.second});
+    }
+    sortEntries();
+    writeEntries(sorted.size());
+
+    stream << "By instruction keyword :" << std::endl;
+    sorted.clear();
+    for (auto&& vKeyword : this->g_keywords)
+    {
+        sorted.push_back({vKeyword.first.empty() ? "(compiler)" : vKeyword.first, &vKeyword.second});
+    }
+    sortEntries();
+    writeEntries(sorted.size());
+
+    stream << "By source line (biggest first) :" << std::endl;
+    sorted.clear();
+    for (auto&& vLine : this->g_lines)
+    {
+        sorted.push_back({vLine.first.first.empty() ? "(compiler)" : (vLine.first.first+":"+std::to_string(vLine.first.second)), &vLine.second});
+    }
+    sortEntries();
+    writeEntries(CODEG_SIZEREPORT_TEXT_LINES);
+}
+
+void SizeReport::getEntries(std::map<std::string, int64_t>& entries) const
+{
+    entries.clear();
+    entries["total"] = this->g_total;
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        entries[std::string("class ")+codeg::ReadableStringSizeClasses[i]] = this->g_classes._classes[i];
+    }
+    for (auto&& vFunction : this->g_functions)
+    {
+        entries[GetFunctionName(vFunction.first, vFunction.second._definition)] = vFunction.second._bytes;
+    }
+    for (auto&& vKeyword : this->g_keywords)
+    {
+        entries["keyword "+(vKeyword.first.empty() ? std::string("(compiler)") : vKeyword.first)] = vKeyword.second._bytes;
+    }
+    for (auto&& vLine : this->g_lines)
+    {
+        entries["line "+(vLine.first.first.empty() ? std::string("(compiler)") : (vLine.first.first+":"+std::to_string(vLine.first.second)))] = vLine.second._bytes;
+    }
+}
+
+int64_t SizeReport::writeDiff(const codeg::SizeReport& previous, std::ostream& stream) const
+{
+    std::map<std::string, int64_t> before;
+    std::map<std::string, int64_t> after;
+    previous.getEntries(before);
+    this->getEntries(after);
+
+    std::vector<std::pair<std::string, int64_t> > changes;
+    for (auto&& vEntry : after)
+    {
+        std::map<std::string, int64_t>::const_iterator it = before.find(vEntry.first);
+        int64_t delta = vEntry.second - ((it != before.end()) ? it->second : 0);
+        if ( (delta != 0) && (vEntry.first != "total") )
+        {
+            changes.push_back({vEntry.first, delta});
+        }
+    }
+    for (auto&& vEntry : before)
+    {
+        if ( (after.find(vEntry.first) == after.end()) && (vEntry.second != 0) )
+        {//Removed
+            changes.push_back({vEntry.first, -vEntry.second});
+        }
+    }
+    std::stable_sort(changes.begin(), changes.end(), [](const std::pair<std::string, int64_t>& a, const std::pair<std::string, int64_t>& b)
+    {
+        return std::abs(a.second) > std::abs(b.second);
+    });
+
+    int64_t total = static_cast<int64_t>(this->g_total) - static_cast<int64_t>(previous.g_total);
+    stream << "Code size : " << previous.g_total << " -> " << this->g_total << " bytes ("
+           << (total >= 0 ? "+" : "") << total << ")" << std::endl;
+    for (auto&& vChange : changes)
+    {
+        stream << "\t" << vChange.first << " : " << (vChange.second >= 0 ? "+" : "") << vChange.second << " bytes" << std::endl;
+    }
+    return total;
+}
+
+uint32_t SizeReport::getTotal() const
+{
+    return this->g_total;
+}
+uint32_t SizeReport::getCapacity() const
+{
+    return this->g_capacity;
+}
+const codeg::SizeEntry& SizeReport::getClasses() const
+{
+    return this->g_classes;
+}
+const std::map<std::string, codeg::SizeEntry>& SizeReport::getFunctions() const
+{
+    return this->g_functions;
+}
+const std::map<std::string, codeg::SizeEntry>& SizeReport::getKeywords() const
+{
+    return this->g_keywords;
+}
+const std::map<std::pair<std::string, unsigned int>, codeg::SizeEntry>& SizeReport::getLines() const
+{
+    return this->g_lines;
+}
+
+}//end codeg
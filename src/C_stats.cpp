@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_stats.hpp"
+#include "C_compilerData.hpp"
+#include "C_peephole.hpp"
+#include "C_json.hpp"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <iomanip>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+
+std::atomic<uint64_t> gAllocationCount{0};
+
+void* CountedAllocation(std::size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+///Global allocation functions, only counting the calls
+
+void* operator new(std::size_t size)
+{
+    return CountedAllocation(size);
+}
+void* operator new[](std::size_t size)
+{
+    return CountedAllocation(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace codeg
+{
+
+const char* ReadableStringStatsPhases[]=
+{
+    "reading",
+    "decomposing",
+    "compiling",
+    "optimizing",
+    "jumps",
+    "pools",
+    "reports",
+    "writing"
+};
+
+uint64_t GetAllocationCount()
+{
+    return gAllocationCount.load(std::memory_order_relaxed);
+}
+uint64_t GetPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) )
+    {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if ( getrusage(RUSAGE_SELF, &usage) != 0 )
+    {
+        return 0;
+    }
+    #ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss); //Bytes
+    #else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; //Kilobytes
+    #endif
+#endif
+}
+
+void Statistics::enable()
+{
+    this->g_enabled = true;
+    this->g_startTime = codeg::Statistics::Clock::now();
+}
+bool Statistics::isEnabled() const
+{
+    return this->g_enabled;
+}
+
+codeg::Statistics::Clock::time_point Statistics::now() const
+{
+    return this->g_enabled ? codeg::Statistics::Clock::now() : codeg::Statistics::Clock::time_point();
+}
+void Statistics::addTime(codeg::StatsPhases phase, const codeg::Statistics::Clock::time_point& since)
+{
+    if ( this->g_enabled )
+    {
+        this->g_phaseTimes[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(codeg::Statistics::Clock::now() - since).count();
+    }
+}
+void Statistics::addInstructionTime(const std::string& keyword, const codeg::Statistics::Clock::time_point& since)
+{
+    if ( this->g_enabled )
+    {
+        uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(codeg::Statistics::Clock::now() - since).count();
+        this->g_phaseTimes[codeg::StatsPhases::STATS_PHASE_COMPILING] += duration;
+
+        codeg::StatsInstruction& instruction = this->g_instructions[keyword];
+        ++instruction._count;
+        instruction._nanoseconds += duration;
+    }
+}
+void Statistics::addLine(std::size_t tokens)
+{
+    if ( this->g_enabled )
+    {
+        ++this->g_lines;
+        this->g_tokens += tokens;
+    }
+}
+
+void Statistics::collect(codeg::CompilerData& data, const codeg::Peephole& peephole)
+{
+    if ( !this->g_enabled )
+    {
+        return;
+    }
+    this->g_totalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(codeg::Statistics::Clock::now() - this->g_startTime).count();
+
+    this->g_macroReplacements = data._macroReplacements;
+    this->g_keywordClassifications = data._keywordClassifications;
+    this->g_labels = data._jumps._labels.size() + data._jumps._mergedLabels.size();
+    this->g_jumpPoints = data._jumps._jumpPoints.size();
+    this->g_codeSize = data._code.getCursor();
+
+    this->g_variableLinks = 0;
+    for (auto&& vPool : data._pools.getPools())
+    {
+        this->g_variableLinks += vPool._link.size();
+        for (auto&& vVariable : vPool.getVariables())
+        {
+            this->g_variableLinks += vVariable._link.size() + vVariable._linkLsb.size();
+        }
+    }
+
+    this->g_peepholeHits.clear();
+    for (auto&& vRule : peephole.getRules())
+    {
+        this->g_peepholeHits.emplace_back(vRule._name, vRule._hits);
+    }
+
+    this->g_peakMemory = codeg::GetPeakMemoryUsage();
+    this->g_allocations = codeg::GetAllocationCount();
+}
+
+void Statistics::writeJson(std::ostream& stream) const
+{
+    stream << "{" << std::endl;
+    stream << "  \"totalNs\": " << this->g_totalTime << "," << std::endl;
+    stream << "  \"phasesNs\": {";
+    for (uint8_t i=0; i<codeg::StatsPhases::STATS_PHASE_COUNT; ++i)
+    {
+        stream << (i ? ", " : "") << "\"" << codeg::ReadableStringStatsPhases[i] << "\": " << this->g_phaseTimes[i];
+    }
+    stream << "}," << std::endl;
+
+    stream << "  \"instructions\": {";
+    bool first = true;
+    for (auto&& vInstruction : this->g_instructions)
+    {
+        stream << (first ? "" : ",") << std::endl << "    \"" << codeg::JsonEscape(vInstruction.first) << "\": {\"count\": "
+               << vInstruction.second._count << ", \"ns\": " << vInstruction.second._nanoseconds << "}";
+        first = false;
+    }
+    stream << std::endl << "  }," << std::endl;
+
+    stream << "  \"counters\": {\"lines\": " << this->g_lines << ", \"tokens\": " << this->g_tokens
+           << ", \"macroReplacements\": " << this->g_macroReplacements << ", \"keywordClassifications\": " << this->g_keywordClassifications
+           << ", \"labels\": " << this->g_labels << ", \"jumpPoints\": " << this->g_jumpPoints
+           << ", \"variableLinks\": " << this->g_variableLinks << ", \"codeSize\": " << this->g_codeSize << "}," << std::endl;
+    stream << "  \"memory\": {\"peakRss\": " << this->g_peakMemory << ", \"allocations\": " << this->g_allocations << "}," << std::endl;
+
+    stream << "  \"peephole\": {";
+    for (std::size_t i=0; i<this->g_peepholeHits.size(); ++i)
+    {
+        stream << (i ? ", " : "") << "\"" << codeg::JsonEscape(this->g_peepholeHits[i].first) << "\": " << this->g_peepholeHits[i].second;
+    }
+    stream << "}" << std::endl;
+    stream << "}" << std::endl;
+}
+void Statistics::writeText(std::ostream& stream) const
+{
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "Time : " << static_cast<double>(this->g_totalTime)/1000000.0 << " ms" << std::endl;
+    for (uint8_t i=0; i<codeg::StatsPhases::STATS_PHASE_COUNT; ++i)
+    {
+        stream << "\t" << codeg::ReadableStringStatsPhases[i] << " : " << static_cast<double>(this->g_phaseTimes[i])/1000000.0 << " ms" << std::endl;
+    }
+
+    stream << "Instructions (calls, time) :" << std::endl;
+    for (auto&& vInstruction : this->g_instructions)
+    {
+        stream << "\t" << vInstruction.first << " : " << vInstruction.second._count << ", "
+               << static_cast<double>(vInstruction.second._nanoseconds)/1000000.0 << " ms" << std::endl;
+    }
+
+    stream << "Counters :" << std::endl;
+    stream << "\tlines : " << this->g_lines << ", tokens : " << this->g_tokens << std::endl;
+    stream << "\tmacro replacements : " << this->g_macroReplacements << ", keyword classifications : " << this->g_keywordClassifications << std::endl;
+    stream << "\tlabels : " << this->g_labels << ", jump points : " << this->g_jumpPoints << ", variable links : " << this->g_variableLinks << std::endl;
+    stream << "\tcode size : " << this->g_codeSize << " bytes" << std::endl;
+
+    stream << "Memory : peak RSS " << this->g_peakMemory/1024 << " KiB, " << this->g_allocations << " allocations" << std::endl;
+
+    stream << "Peephole rules (applied) :" << std::endl;
+    for (auto&& vRule : this->g_peepholeHits)
+    {
+        stream << "\t" << vRule.first << " : " << vRule.second << std::endl;
+    }
+}
+
+uint64_t Statistics::getPhaseTime(codeg::StatsPhases phase) const
+{
+    return this->g_phaseTimes[phase];
+}
+uint64_t Statistics::getTotalTime() const
+{
+    return this->g_totalTime;
+}
+const std::map<std::string, codeg::StatsInstruction>& Statistics::getInstructions() const
+{
+    return this->g_instructions;
+}
+
+}//end codeg
@@ -0,0 +1,824 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_superoptimizer.hpp"
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_error.hpp"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <random>
+
+namespace codeg
+{
+
+///Machine model
+
+struct SuperoptimizerInput
+{
+    uint64_t _seed; //Initial RAM content and ALU function
+
+    uint8_t _left;
+    uint8_t _operation;
+    uint8_t _right;
+    uint16_t _ramAddress;
+    uint8_t _jump[3];
+
+    uint8_t _a;
+    uint8_t _b;
+};
+
+struct SuperoptimizerState
+{
+    uint8_t _left;
+    uint8_t _operation;
+    uint8_t _right;
+    uint16_t _ramAddress;
+    uint8_t _jump[3];
+
+    uint8_t _writeCount;
+    uint16_t _writes[CODEG_SUPEROPTIMIZER_MAX_LENGTH]; //Opcode and value of the bus writes
+
+    uint8_t _ramCount;
+    uint16_t _ramAddresses[CODEG_SUPEROPTIMIZER_MAX_LENGTH];
+    uint8_t _ramValues[CODEG_SUPEROPTIMIZER_MAX_LENGTH];
+};
+
+static uint64_t MixBits(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static uint8_t GetInitialRam(const codeg::SuperoptimizerInput& input, uint16_t address)
+{
+    return static_cast<uint8_t>( codeg::MixBits(input._seed ^ (0x10000ULL+address)) );
+}
+static uint8_t GetAluResult(const codeg::SuperoptimizerInput& input, uint8_t left, uint8_t operation, uint8_t right)
+{//Unknown function of the 3 latches
+    return static_cast<uint8_t>( codeg::MixBits(input._seed + ((static_cast<uint64_t>(left)<<40) |
+                                                               (static_cast<uint64_t>(operation)<<32) |
+                                                               (static_cast<uint64_t>(right)<<24))) );
+}
+
+static void Run(const codeg::SuperoptimizerSequence& sequence, const std::vector<uint8_t>& opcodes,
+                const codeg::SuperoptimizerInput& input, codeg::SuperoptimizerState& state)
+{
+    state._left = input._left;
+    state._operation = input._operation;
+    state._right = input._right;
+    state._ramAddress = input._ramAddress;
+    state._jump[0] = input._jump[0];
+    state._jump[1] = input._jump[1];
+    state._jump[2] = input._jump[2];
+    state._writeCount = 0;
+    state._ramCount = 0;
+
+    for (uint8_t instruction : sequence)
+    {
+        uint8_t value = 0;
+        switch (instruction % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT)
+        {
+        case codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_RESULT:
+            value = codeg::GetAluResult(input, state._left, state._operation, state._right);
+            break;
+        case codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_RAM:
+        {
+            value = codeg::GetInitialRam(input, state._ramAddress);
+            for (uint8_t i=0; i<state._ramCount; ++i)
+            {
+                if (state._ramAddresses[i] == state._ramAddress)
+                {
+                    value = state._ramValues[i];
+                    break;
+                }
+            }
+            break;
+        }
+        case codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A:
+            value = input._a;
+            break;
+        default:
+            value = input._b;
+            break;
+        }
+
+        uint8_t opcode = opcodes[instruction / codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT];
+        switch (opcode)
+        {
+        case codeg::OPCODE_OPLEFT_CLK:
+            state._left = value;
+            break;
+        case codeg::OPCODE_OPCHOOSE_CLK:
+            state._operation = value;
+            break;
+        case codeg::OPCODE_OPRIGHT_CLK:
+            state._right = value;
+            break;
+        case codeg::OPCODE_BRAMADD1_CLK:
+            state._ramAddress = (state._ramAddress&0xFF00) | value;
+            break;
+        case codeg::OPCODE_BRAMADD2_CLK:
+            state._ramAddress = (state._ramAddress&0x00FF) | (static_cast<uint16_t>(value)<<8);
+            break;
+        case codeg::OPCODE_BJMPSRC1_CLK:
+        case codeg::OPCODE_BJMPSRC2_CLK:
+        case codeg::OPCODE_BJMPSRC3_CLK:
+            state._jump[opcode - codeg::OPCODE_BJMPSRC1_CLK] = value;
+            break;
+        case codeg::OPCODE_RAMW:
+        {
+            uint8_t i = 0;
+            while ( (i < state._ramCount) && (state._ramAddresses[i] != state._ramAddress) )
+            {
+                ++i;
+            }
+            if (i == state._ramCount)
+            {
+                state._ramAddresses[state._ramCount++] = state._ramAddress;
+            }
+            state._ramValues[i] = value;
+            break;
+        }
+        default:
+            //Bus writes are observed in order (a bus can be a strobe)
+            state._writes[state._writeCount++] = (static_cast<uint16_t>(opcode)<<8) | value;
+            break;
+        }
+    }
+
+    ///Only the modified RAM is observed, sorted by address
+    uint8_t count = 0;
+    for (uint8_t i=0; i<state._ramCount; ++i)
+    {
+        uint16_t address = state._ramAddresses[i];
+        uint8_t ramValue = state._ramValues[i];
+        if (ramValue != codeg::GetInitialRam(input, address))
+        {
+            uint8_t j = count++;
+            while ( (j > 0) && (state._ramAddresses[j-1] > address) )
+            {
+                state._ramAddresses[j] = state._ramAddresses[j-1];
+                state._ramValues[j] = state._ramValues[j-1];
+                --j;
+            }
+            state._ramAddresses[j] = address;
+            state._ramValues[j] = ramValue;
+        }
+    }
+    state._ramCount = count;
+}
+
+static bool IsSameState(const codeg::SuperoptimizerState& a, const codeg::SuperoptimizerState& b)
+{
+    if ( (a._left != b._left) || (a._operation != b._operation) || (a._right != b._right) ||
+         (a._ramAddress != b._ramAddress) || (a._jump[0] != b._jump[0]) || (a._jump[1] != b._jump[1]) || (a._jump[2] != b._jump[2]) ||
+         (a._writeCount != b._writeCount) || (a._ramCount != b._ramCount) )
+    {
+        return false;
+    }
+    return std::equal(a._writes, a._writes+a._writeCount, b._writes) &&
+           std::equal(a._ramAddresses, a._ramAddresses+a._ramCount, b._ramAddresses) &&
+           std::equal(a._ramValues, a._ramValues+a._ramCount, b._ramValues);
+}
+static uint64_t GetStateHash(const codeg::SuperoptimizerState& state)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto add = [&](uint64_t value)
+    {
+        hash = (hash ^ value) * 0x100000001B3ULL;
+    };
+
+    add(state._left);
+    add(state._operation);
+    add(state._right);
+    add(state._ramAddress);
+    add(state._jump[0]);
+    add(state._jump[1]);
+    add(state._jump[2]);
+    add(state._writeCount);
+    for (uint8_t i=0; i<state._writeCount; ++i)
+    {
+        add(state._writes[i]);
+    }
+    add(state._ramCount);
+    for (uint8_t i=0; i<state._ramCount; ++i)
+    {
+        add((static_cast<uint64_t>(state._ramAddresses[i])<<8) | state._ramValues[i]);
+    }
+    return hash;
+}
+
+static codeg::SuperoptimizerInput GetRandomInput(std::mt19937_64& generator)
+{
+    codeg::SuperoptimizerInput input;
+    input._seed = generator();
+
+    uint64_t value = generator();
+    input._left = static_cast<uint8_t>(value);
+    input._operation = static_cast<uint8_t>(value>>8);
+    input._right = static_cast<uint8_t>(value>>16);
+    input._ramAddress = static_cast<uint16_t>(value>>24);
+    input._jump[0] = static_cast<uint8_t>(value>>40);
+    input._jump[1] = static_cast<uint8_t>(value>>48);
+    input._jump[2] = static_cast<uint8_t>(value>>56);
+
+    value = generator();
+    input._a = static_cast<uint8_t>(value);
+    input._b = static_cast<uint8_t>(value>>8);
+    return input;
+}
+
+///Sequences
+
+static uint64_t PackSequence(const codeg::SuperoptimizerSequence& sequence)
+{
+    uint64_t key = 0;
+    for (std::size_t i=0; i<sequence.size(); ++i)
+    {
+        key |= static_cast<uint64_t>(sequence[i]+1) << (8*i);
+    }
+    return key;
+}
+static void UnpackSequence(uint64_t key, codeg::SuperoptimizerSequence& sequence)
+{
+    sequence.clear();
+    while (key != 0)
+    {
+        sequence.push_back(static_cast<uint8_t>((key&0xFF)-1));
+        key >>= 8;
+    }
+}
+
+static uint8_t GetNamedOperands(const codeg::SuperoptimizerSequence& sequence)
+{
+    uint8_t names = 0;
+    for (uint8_t instruction : sequence)
+    {
+        uint8_t operand = instruction % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        if (operand >= codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A)
+        {
+            names |= 1 << (operand - codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A);
+        }
+    }
+    return names;
+}
+static bool IsCanonical(const codeg::SuperoptimizerSequence& sequence, std::size_t begin=0)
+{//"$a" is always the first named operand
+    for (std::size_t i=begin; i<sequence.size(); ++i)
+    {
+        uint8_t operand = sequence[i] % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        if (operand >= codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A)
+        {
+            return operand == codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A;
+        }
+    }
+    return true;
+}
+static void SwapNames(codeg::SuperoptimizerSequence& sequence)
+{
+    for (uint8_t& instruction : sequence)
+    {
+        uint8_t operand = instruction % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        if (operand == codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A)
+        {
+            ++instruction;
+        }
+        else if (operand == codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_B)
+        {
+            --instruction;
+        }
+    }
+}
+
+static bool IsMoreGeneral(const codeg::SuperoptimizerSequence& general, const codeg::SuperoptimizerSequence& sequence)
+{//Every named operand of the general sequence is a named operand of the sequence, with the same opcodes
+    if ( (general.size() != sequence.size()) || (general == sequence) )
+    {
+        return false;
+    }
+
+    uint8_t names[2]={0, 0};
+    for (std::size_t i=0; i<general.size(); ++i)
+    {
+        uint8_t operand = general[i] % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        uint8_t sequenceOperand = sequence[i] % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        if ( general[i]/codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT != sequence[i]/codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT )
+        {
+            return false;
+        }
+
+        if (operand < codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A)
+        {
+            if (operand != sequenceOperand)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            uint8_t& name = names[operand - codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A];
+            if ( (sequenceOperand < codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A) ||
+                 ((name != 0) && (name != sequenceOperand)) )
+            {
+                return false;
+            }
+            name = sequenceOperand;
+        }
+    }
+    return true;
+}
+
+///Equivalence
+
+static const std::size_t SuperoptimizerFingerprintInputs = 8;
+
+static const std::vector<codeg::SuperoptimizerInput>& GetFingerprintInputs()
+{
+    static const std::vector<codeg::SuperoptimizerInput> inputs = []()
+    {
+        std::mt19937_64 generator(0x636F646547ULL);
+        std::vector<codeg::SuperoptimizerInput> result;
+        for (std::size_t i=0; i<codeg::SuperoptimizerFingerprintInputs; ++i)
+        {
+            result.push_back(codeg::GetRandomInput(generator));
+        }
+        //The named constants are the same and alias the RAM address
+        result[0]._b = result[0]._a;
+        result[1]._ramAddress = (result[1]._ramAddress&0xFF00) | result[1]._a;
+        return result;
+    }();
+    return inputs;
+}
+
+static uint64_t GetFingerprint(const codeg::SuperoptimizerSequence& sequence, const std::vector<uint8_t>& opcodes)
+{
+    uint64_t fingerprint = 0;
+    codeg::SuperoptimizerState state;
+    for (const codeg::SuperoptimizerInput& input : codeg::GetFingerprintInputs())
+    {
+        codeg::Run(sequence, opcodes, input, state);
+        fingerprint = codeg::MixBits(fingerprint ^ codeg::GetStateHash(state));
+    }
+    return fingerprint;
+}
+
+static bool IsEquivalent(const codeg::SuperoptimizerSequence& pattern, const codeg::SuperoptimizerSequence& replacement,
+                         const std::vector<uint8_t>& opcodes)
+{
+    uint8_t names = codeg::GetNamedOperands(pattern);
+    if ( (codeg::GetNamedOperands(replacement) & ~names) != 0 )
+    {//An unknown value can't be used by the replacement
+        return false;
+    }
+
+    unsigned int countA = (names&0x01) ? 256 : 1;
+    unsigned int countB = (names&0x02) ? 256 : 1;
+    unsigned int repeat = 4096 / (countA*countB) + 1;
+
+    std::mt19937_64 generator(codeg::PackSequence(pattern));
+    codeg::SuperoptimizerState statePattern;
+    codeg::SuperoptimizerState stateReplacement;
+
+    ///Every value of the named constants, with random machine states
+    for (unsigned int a=0; a<countA; ++a)
+    {
+        for (unsigned int b=0; b<countB; ++b)
+        {
+            for (unsigned int r=0; r<repeat; ++r)
+            {
+                codeg::SuperoptimizerInput input = codeg::GetRandomInput(generator);
+                input._a = static_cast<uint8_t>(a);
+                input._b = static_cast<uint8_t>(b);
+                if (r&0x01)
+                {//RAM address aliasing
+                    input._ramAddress = (input._ramAddress&0xFF00) | ((r&0x02) ? input._b : input._a);
+                }
+
+                codeg::Run(pattern, opcodes, input, statePattern);
+                codeg::Run(replacement, opcodes, input, stateReplacement);
+                if ( !codeg::IsSameState(statePattern, stateReplacement) )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void GetCost(const codeg::SuperoptimizerSequence& sequence, const std::vector<uint8_t>& opcodes, uint32_t cost[3])
+{//Instructions, cycles, bytes
+    cost[0] = sequence.size();
+    cost[1] = 0;
+    cost[2] = 0;
+    for (uint8_t instruction : sequence)
+    {
+        cost[1] += ToOpcodeCycles(opcodes[instruction / codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT]);
+        cost[2] += ((instruction % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT) >= codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_A) ? 2 : 1;
+    }
+}
+
+///Superoptimizer
+
+void Superoptimizer::clear()
+{
+    this->g_sequences.clear();
+    this->g_cached.clear();
+    this->g_fingerprints.clear();
+    this->g_rewrites.clear();
+}
+
+const std::vector<uint8_t>& Superoptimizer::getDefaultOpcodes()
+{
+    static const std::vector<uint8_t> opcodes{
+        codeg::OPCODE_OPLEFT_CLK, codeg::OPCODE_OPCHOOSE_CLK, codeg::OPCODE_OPRIGHT_CLK,
+        codeg::OPCODE_BRAMADD1_CLK, codeg::OPCODE_BRAMADD2_CLK, codeg::OPCODE_RAMW,
+        codeg::OPCODE_BWRITE1_CLK, codeg::OPCODE_BWRITE2_CLK,
+        codeg::OPCODE_BJMPSRC1_CLK, codeg::OPCODE_BJMPSRC2_CLK, codeg::OPCODE_BJMPSRC3_CLK};
+    return opcodes;
+}
+bool Superoptimizer::isSupportedOpcode(uint8_t opcode)
+{
+    const std::vector<uint8_t>& opcodes = codeg::Superoptimizer::getDefaultOpcodes();
+    return std::find(opcodes.begin(), opcodes.end(), opcode) != opcodes.end();
+}
+
+void Superoptimizer::setOpcodes(const std::vector<uint8_t>& opcodes)
+{
+    for (uint8_t opcode : opcodes)
+    {
+        if ( !codeg::Superoptimizer::isSupportedOpcode(opcode) )
+        {
+            throw codeg::FatalError("the opcode \""+std::string(ToReadableOpcode(opcode))+"\" is not supported by the superoptimizer");
+        }
+    }
+    this->g_opcodes = opcodes;
+    this->clear();
+}
+const std::vector<uint8_t>& Superoptimizer::getOpcodes() const
+{
+    return this->g_opcodes;
+}
+
+void Superoptimizer::setThreadCount(unsigned int count)
+{
+    this->g_threadCount = (count > 0) ? count : 1;
+}
+void Superoptimizer::setCachePath(const std::string& path)
+{
+    this->g_cachePath = path;
+}
+
+void Superoptimizer::search(std::size_t length)
+{
+    if (length > CODEG_SUPEROPTIMIZER_MAX_LENGTH)
+    {
+        throw codeg::FatalError("the length of the sequences can't be more than "+std::to_string(CODEG_SUPEROPTIMIZER_MAX_LENGTH));
+    }
+
+    if ( this->g_sequences.empty() )
+    {//The empty sequence
+        this->g_sequences.assign(1, {0});
+        this->g_cached.assign(1, false);
+        this->addFingerprints(0);
+    }
+
+    for (std::size_t l=this->g_sequences.size(); l<=length; ++l)
+    {
+        this->g_sequences.emplace_back();
+        this->g_cached.push_back( this->loadCache(l) );
+        if ( !this->g_cached.back() )
+        {
+            this->searchLength(l);
+            this->saveCache(l);
+        }
+        this->addFingerprints(l);
+    }
+}
+
+std::size_t Superoptimizer::getSequenceCount(std::size_t length) const
+{
+    return (length < this->g_sequences.size()) ? this->g_sequences[length].size() : 0;
+}
+bool Superoptimizer::isCached(std::size_t length) const
+{
+    return (length < this->g_cached.size()) ? this->g_cached[length] : false;
+}
+
+const std::vector<codeg::SuperoptimizerRewrite>& Superoptimizer::getRewrites() const
+{
+    return this->g_rewrites;
+}
+std::string Superoptimizer::getRule(std::size_t index) const
+{
+    const codeg::SuperoptimizerRewrite& rewrite = this->g_rewrites[index];
+
+    auto getInstructions = [&](const codeg::SuperoptimizerSequence& sequence)
+    {
+        static const char* operands[]={"RESULT", "RAM", "$a", "$b"};
+
+        if ( sequence.empty() )
+        {
+            return std::string("-");
+        }
+        std::string str;
+        for (uint8_t instruction : sequence)
+        {
+            if ( !str.empty() )
+            {
+                str += " ; ";
+            }
+            str += std::string(ToReadableOpcode(this->g_opcodes[instruction / codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT]))+" "+
+                   operands[instruction % codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT];
+        }
+        return str;
+    };
+
+    std::string rule = "superopt_"+std::to_string(index)+" : "+
+                       getInstructions(rewrite._pattern)+" => "+getInstructions(rewrite._replacement);
+
+    uint8_t names = codeg::GetNamedOperands(rewrite._pattern);
+    if (names == 0x01)
+    {
+        rule += " if $a == SOURCE";
+    }
+    else if (names == 0x03)
+    {
+        rule += " if $a == SOURCE, $b == SOURCE";
+    }
+    return rule;
+}
+
+void Superoptimizer::searchLength(std::size_t length)
+{
+    const std::vector<uint64_t>& prefixes = this->g_sequences[length-1];
+    std::size_t alphabetSize = this->g_opcodes.size()*codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+
+    struct Result
+    {
+        std::vector<uint64_t> _sequences;
+        std::vector<codeg::SuperoptimizerRewrite> _rewrites;
+    };
+    std::vector<Result> results(this->g_threadCount);
+    std::atomic<std::size_t> nextPrefix{0};
+
+    auto work = [&](Result& result)
+    {
+        codeg::SuperoptimizerSequence candidate;
+        codeg::SuperoptimizerSequence suffix;
+        codeg::SuperoptimizerSequence replacement;
+
+        for (std::size_t p=nextPrefix++; p<prefixes.size(); p=nextPrefix++)
+        {
+            codeg::UnpackSequence(prefixes[p], candidate);
+            candidate.push_back(0);
+
+            for (std::size_t instruction=0; instruction<alphabetSize; ++instruction)
+            {
+                candidate.back() = static_cast<uint8_t>(instruction);
+                if ( !codeg::IsCanonical(candidate) )
+                {
+                    continue;
+                }
+
+                //The suffix must be a sequence that can't be reduced too
+                suffix.assign(candidate.begin()+1, candidate.end());
+                if ( !codeg::IsCanonical(suffix) )
+                {
+                    codeg::SwapNames(suffix);
+                }
+                const std::vector<uint64_t>& shorter = this->g_sequences[length-1];
+                if ( !std::binary_search(shorter.begin(), shorter.end(), codeg::PackSequence(suffix)) )
+                {
+                    continue;
+                }
+
+                std::map<uint64_t, uint64_t>::const_iterator it = this->g_fingerprints.find( codeg::GetFingerprint(candidate, this->g_opcodes) );
+                if (it != this->g_fingerprints.end())
+                {
+                    codeg::UnpackSequence(it->second, replacement);
+                    if ( (replacement.size() < candidate.size()) && codeg::IsEquivalent(candidate, replacement, this->g_opcodes) )
+                    {
+                        result._rewrites.push_back({candidate, replacement});
+                        continue;
+                    }
+                }
+                result._sequences.push_back( codeg::PackSequence(candidate) );
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t=1; t<this->g_threadCount; ++t)
+    {
+        threads.emplace_back(work, std::ref(results[t]));
+    }
+    work(results[0]);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ///Merging the results in the same order whatever the number of threads
+    std::vector<uint64_t>& sequences = this->g_sequences[length];
+    std::vector<codeg::SuperoptimizerRewrite> rewrites;
+    for (Result& result : results)
+    {
+        sequences.insert(sequences.end(), result._sequences.begin(), result._sequences.end());
+        rewrites.insert(rewrites.end(), result._rewrites.begin(), result._rewrites.end());
+    }
+    std::sort(sequences.begin(), sequences.end());
+    std::sort(rewrites.begin(), rewrites.end(), [](const codeg::SuperoptimizerRewrite& a, const codeg::SuperoptimizerRewrite& b)
+    {
+        return a._pattern < b._pattern;
+    });
+
+    ///A rewrite is not kept if a more general one is found ("$a ; $a" is also matched by "$a ; $b")
+    std::map<codeg::SuperoptimizerSequence, std::vector<std::size_t> > sameOpcodes;
+    for (std::size_t r=0; r<rewrites.size(); ++r)
+    {
+        codeg::SuperoptimizerSequence opcodes = rewrites[r]._pattern;
+        for (uint8_t& instruction : opcodes)
+        {
+            instruction /= codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        }
+        sameOpcodes[opcodes].push_back(r);
+    }
+    for (std::size_t r=0; r<rewrites.size(); ++r)
+    {
+        codeg::SuperoptimizerSequence opcodes = rewrites[r]._pattern;
+        for (uint8_t& instruction : opcodes)
+        {
+            instruction /= codeg::SuperoptimizerOperands::SUPEROPTIMIZER_OPERAND_COUNT;
+        }
+
+        bool general = true;
+        for (std::size_t other : sameOpcodes[opcodes])
+        {
+            if ( codeg::IsMoreGeneral(rewrites[other]._pattern, rewrites[r]._pattern) )
+            {
+                general = false;
+                break;
+            }
+        }
+        if (general)
+        {
+            this->g_rewrites.push_back(rewrites[r]);
+        }
+    }
+}
+void Superoptimizer::addFingerprints(std::size_t length)
+{
+    codeg::SuperoptimizerSequence sequence;
+    uint32_t cost[3];
+    uint32_t actualCost[3];
+
+    auto add = [&]()
+    {
+        uint64_t key = codeg::PackSequence(sequence);
+        std::pair<std::map<uint64_t, uint64_t>::iterator, bool> result =
+            this->g_fingerprints.emplace(codeg::GetFingerprint(sequence, this->g_opcodes), key);
+        if ( !result.second )
+        {//Keeping the cheapest sequence
+            codeg::SuperoptimizerSequence actual;
+            codeg::UnpackSequence(result.first->second, actual);
+            codeg::GetCost(sequence, this->g_opcodes, cost);
+            codeg::GetCost(actual, this->g_opcodes, actualCost);
+            if ( std::lexicographical_compare(cost, cost+3, actualCost, actualCost+3) )
+            {
+                result.first->second = key;
+            }
+        }
+    };
+
+    for (uint64_t key : this->g_sequences[length])
+    {
+        codeg::UnpackSequence(key, sequence);
+        add();
+        if (codeg::GetNamedOperands(sequence) != 0)
+        {//The same sequence with the other names
+            codeg::SwapNames(sequence);
+            add();
+        }
+    }
+}
+
+bool Superoptimizer::loadCache(std::size_t length)
+{
+    if ( this->g_cachePath.empty() )
+    {
+        return false;
+    }
+    std::ifstream file(this->getCacheFilePath(length));
+    if ( !file )
+    {
+        return false;
+    }
+
+    std::string header;
+    std::size_t fileLength = 0;
+    std::size_t sequenceCount = 0;
+    std::size_t rewriteCount = 0;
+    if ( !(file >> header >> fileLength >> sequenceCount) || (header != "codeGSuperopt") || (fileLength != length) )
+    {
+        return false;
+    }
+
+    std::vector<uint64_t> sequences(sequenceCount);
+    for (uint64_t& key : sequences)
+    {
+        file >> std::hex >> key;
+    }
+    file >> std::dec >> rewriteCount;
+
+    std::vector<codeg::SuperoptimizerRewrite> rewrites(rewriteCount);
+    for (codeg::SuperoptimizerRewrite& rewrite : rewrites)
+    {
+        uint64_t pattern = 0;
+        uint64_t replacement = 0;
+        file >> std::hex >> pattern >> replacement;
+        codeg::UnpackSequence(pattern, rewrite._pattern);
+        codeg::UnpackSequence(replacement, rewrite._replacement);
+    }
+    if ( !file )
+    {//Incomplete file
+        return false;
+    }
+
+    this->g_sequences[length] = std::move(sequences);
+    this->g_rewrites.insert(this->g_rewrites.end(), rewrites.begin(), rewrites.end());
+    return true;
+}
+void Superoptimizer::saveCache(std::size_t length) const
+{
+    if ( this->g_cachePath.empty() )
+    {
+        return;
+    }
+    std::ofstream file(this->getCacheFilePath(length));
+    if ( !file )
+    {
+        return;
+    }
+
+    file << "codeGSuperopt " << length << " " << this->g_sequences[length].size() << std::endl;
+    file << std::hex;
+    for (uint64_t key : this->g_sequences[length])
+    {
+        file << key << std::endl;
+    }
+
+    std::size_t rewriteCount = 0;
+    for (const codeg::SuperoptimizerRewrite& rewrite : this->g_rewrites)
+    {
+        rewriteCount += (rewrite._pattern.size() == length) ? 1 : 0;
+    }
+    file << std::dec << rewriteCount << std::endl << std::hex;
+    for (const codeg::SuperoptimizerRewrite& rewrite : this->g_rewrites)
+    {
+        if (rewrite._pattern.size() == length)
+        {
+            file << codeg::PackSequence(rewrite._pattern) << " " << codeg::PackSequence(rewrite._replacement) << std::endl;
+        }
+    }
+}
+std::string Superoptimizer::getCacheFilePath(std::size_t length) const
+{
+    //The cache depend on the alphabet and on the model version
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (char c : std::string("codeGSuperopt model 1"))
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+    }
+    for (uint8_t opcode : this->g_opcodes)
+    {
+        hash = (hash ^ opcode) * 0x100000001B3ULL;
+    }
+
+    std::ostringstream path;
+    path << this->g_cachePath << "/superopt_" << std::hex << hash << "_" << std::dec << length << ".txt";
+    return path.str();
+}
+
+}//end codeg
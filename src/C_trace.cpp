@@ -0,0 +1,205 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_trace.hpp"
+#include "C_compilerData.hpp"
+#include "C_json.hpp"
+#include <iomanip>
+
+namespace codeg
+{
+
+void Tracer::enable()
+{
+    this->g_enabled = true;
+    this->g_events.reserve(CODEG_TRACE_BUFFER_SIZE);
+    this->g_startTime = codeg::Tracer::Clock::now();
+}
+bool Tracer::isEnabled() const
+{
+    return this->g_enabled;
+}
+
+void Tracer::begin(const std::string& category, const std::string& name, const codeg::CompilerData& data, codeg::TraceTracks track)
+{
+    if ( this->g_enabled )
+    {
+        this->pushEvent(this->getNameIndex(name), this->getNameIndex(category), true, track, data);
+        ++this->g_openedSpans[track];
+    }
+}
+void Tracer::end(const codeg::CompilerData& data, codeg::TraceTracks track)
+{
+    if ( this->g_enabled && (this->g_openedSpans[track] > 0) )
+    {
+        this->pushEvent(0, 0, false, track, data);
+        --this->g_openedSpans[track];
+    }
+}
+
+void Tracer::readLine(const codeg::CompilerData& data)
+{
+    if ( !this->g_enabled )
+    {
+        return;
+    }
+    bool closedReader = (data._reader.getSize() < this->g_readers.size());
+    this->syncReader(data);
+    if ( !closedReader )
+    {
+        ++this->g_lines;
+    }
+}
+void Tracer::syncReader(const codeg::CompilerData& data)
+{
+    if ( !this->g_enabled )
+    {
+        return;
+    }
+
+    ///Readers
+    unsigned int readerSize = data._reader.getSize();
+    std::size_t same = 0;
+    while ( (same < this->g_readers.size()) && (same < readerSize) && (this->g_readers[same] == data._reader.getData(same)) )
+    {
+        ++same;
+    }
+    while (this->g_readers.size() > same)
+    {
+        this->end(data);
+        this->g_readers.pop_back();
+    }
+    for (unsigned int i=same; i<readerSize; ++i)
+    {
+        codeg::ReaderData* reader = data._reader.getData(i);
+        if ( codeg::ReaderData_definition* definition = dynamic_cast<codeg::ReaderData_definition*>(reader) )
+        {
+            this->begin("definition", definition->getfunction()->getName(), data);
+        }
+        else if ( codeg::ReaderData_inline* inlined = dynamic_cast<codeg::ReaderData_inline*>(reader) )
+        {
+            this->begin("inline", inlined->getfunction()->getName(), data);
+        }
+        else if ( dynamic_cast<codeg::ReaderData_repeat*>(reader) != nullptr )
+        {
+            this->begin("repeat", reader->getPath(), data);
+        }
+        else
+        {
+            this->begin("file", reader->getPath(), data);
+        }
+        this->g_readers.push_back(reader);
+    }
+
+    ///Function body
+    if (this->g_function != data._actualFunctionName)
+    {
+        if ( !this->g_function.empty() )
+        {
+            this->end(data, codeg::TraceTracks::TRACE_TRACK_FUNCTIONS);
+        }
+        this->g_function = data._actualFunctionName;
+        if ( !this->g_function.empty() )
+        {
+            this->begin(data._writeLinesIntoDefinition ? "definition body" : "function", this->g_function, data,
+                        codeg::TraceTracks::TRACE_TRACK_FUNCTIONS);
+        }
+    }
+}
+void Tracer::finish(const codeg::CompilerData& data)
+{
+    while (this->g_openedSpans[codeg::TraceTracks::TRACE_TRACK_FUNCTIONS] > 0)
+    {
+        this->end(data, codeg::TraceTracks::TRACE_TRACK_FUNCTIONS);
+    }
+    while (this->g_openedSpans[codeg::TraceTracks::TRACE_TRACK_COMPILER] > 0)
+    {
+        this->end(data);
+    }
+    this->g_readers.clear();
+    this->g_function.clear();
+}
+
+void Tracer::writeJson(std::ostream& stream) const
+{
+    ///Matching the begin and end events
+    std::vector<std::size_t> endIndexes(this->g_events.size(), this->g_events.size());
+    std::vector<std::size_t> opened[codeg::TraceTracks::TRACE_TRACK_FUNCTIONS+1];
+    for (std::size_t i=0; i<this->g_events.size(); ++i)
+    {
+        std::vector<std::size_t>& stack = opened[this->g_events[i]._track];
+        if ( this->g_events[i]._begin )
+        {
+            stack.push_back(i);
+        }
+        else if ( !stack.empty() )
+        {
+            endIndexes[stack.back()] = i;
+            stack.pop_back();
+        }
+    }
+
+    stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << std::endl;
+    stream << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << static_cast<unsigned int>(codeg::TraceTracks::TRACE_TRACK_COMPILER)
+           << ", \"args\": {\"name\": \"compiler\"}}," << std::endl;
+    stream << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << static_cast<unsigned int>(codeg::TraceTracks::TRACE_TRACK_FUNCTIONS)
+           << ", \"args\": {\"name\": \"functions\"}}";
+
+    stream << std::fixed << std::setprecision(3);
+    for (std::size_t i=0; i<this->g_events.size(); ++i)
+    {
+        if ( endIndexes[i] == this->g_events.size() )
+        {
+            continue;
+        }
+        const codeg::TraceEvent& eventBegin = this->g_events[i];
+        const codeg::TraceEvent& eventEnd = this->g_events[endIndexes[i]];
+
+        stream << ",\n  {\"name\": \"" << codeg::JsonEscape(this->g_names[eventBegin._name])
+               << "\", \"cat\": \"" << codeg::JsonEscape(this->g_names[eventBegin._category])
+               << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << static_cast<unsigned int>(eventBegin._track)
+               << ", \"ts\": " << static_cast<double>(eventBegin._time)/1000.0
+               << ", \"dur\": " << static_cast<double>(eventEnd._time - eventBegin._time)/1000.0
+               << ", \"args\": {\"lines\": " << (eventEnd._lines - eventBegin._lines)
+               << ", \"bytes\": " << (static_cast<int64_t>(eventEnd._cursor) - static_cast<int64_t>(eventBegin._cursor)) << "}}";
+    }
+    stream << std::endl << "]}" << std::endl;
+}
+
+std::size_t Tracer::getEventCount() const
+{
+    return this->g_events.size();
+}
+
+uint32_t Tracer::getNameIndex(const std::string& name)
+{
+    std::unordered_map<std::string, uint32_t>::const_iterator it = this->g_nameIndexes.find(name);
+    if ( it != this->g_nameIndexes.cend() )
+    {
+        return it->second;
+    }
+    uint32_t index = this->g_names.size();
+    this->g_names.push_back(name);
+    this->g_nameIndexes[name] = index;
+    return index;
+}
+void Tracer::pushEvent(uint32_t name, uint32_t category, bool begin, codeg::TraceTracks track, const codeg::CompilerData& data)
+{
+    uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(codeg::Tracer::Clock::now() - this->g_startTime).count();
+    this->g_events.push_back({name, category, begin, track, time, this->g_lines, data._code.getCursor()});
+}
+
+}//end codeg
@@ -0,0 +1,1082 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "C_wcet.hpp"
+#include "C_compilerData.hpp"
+#include "C_instruction.hpp"
+#include "C_readableBus.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_error.hpp"
+#include <fstream>
+#include <algorithm>
+#include <array>
+
+#define CODEG_WCET_NONE std::numeric_limits<uint32_t>::max()
+
+namespace codeg
+{
+
+namespace
+{
+
+enum JumpByteKinds : uint8_t
+{
+    JUMP_BYTE_NONE = 0, //Not reached
+    JUMP_BYTE_KNOWN,
+    JUMP_BYTE_RAM,
+    JUMP_BYTE_RESULT,
+    JUMP_BYTE_UNKNOWN
+};
+
+struct JumpByte
+{
+    uint8_t _kind;
+    uint8_t _value;
+
+    bool operator==(const JumpByte& r) const
+    {
+        return (this->_kind == r._kind) && ((this->_kind != JUMP_BYTE_KNOWN) || (this->_value == r._value));
+    }
+    bool operator!=(const JumpByte& r) const
+    {
+        return !(*this == r);
+    }
+};
+
+using JumpState = std::array<JumpByte, 3>; //LSB, MID, MSB
+
+JumpState MakeJumpState(codeg::Address address)
+{
+    return {JumpByte{JUMP_BYTE_KNOWN, static_cast<uint8_t>(address&0xFF)},
+            JumpByte{JUMP_BYTE_KNOWN, static_cast<uint8_t>((address>>8)&0xFF)},
+            JumpByte{JUMP_BYTE_KNOWN, static_cast<uint8_t>((address>>16)&0xFF)}};
+}
+
+bool MergeJumpState(JumpState& state, const JumpState& other)
+{
+    bool changed = false;
+    for (std::size_t i=0; i<3; ++i)
+    {
+        if ( (other[i]._kind == JUMP_BYTE_NONE) || (state[i] == other[i]) || (state[i]._kind == JUMP_BYTE_UNKNOWN) )
+        {
+            continue;
+        }
+        state[i] = (state[i]._kind == JUMP_BYTE_NONE) ? other[i] : JumpByte{JUMP_BYTE_UNKNOWN, 0};
+        changed = true;
+    }
+    return changed;
+}
+
+uint64_t AddCycles(uint64_t a, uint64_t b)
+{
+    if ( (a == CODEG_WCET_UNBOUNDED) || (b == CODEG_WCET_UNBOUNDED) || (a > CODEG_WCET_UNBOUNDED-b) )
+    {
+        return CODEG_WCET_UNBOUNDED;
+    }
+    return a+b;
+}
+uint64_t MultiplyCycles(uint64_t a, uint64_t b)
+{
+    if ( (a == 0) || (b == 0) )
+    {
+        return 0;
+    }
+    if ( (a == CODEG_WCET_UNBOUNDED) || (b == CODEG_WCET_UNBOUNDED) || (a > CODEG_WCET_UNBOUNDED/b) )
+    {
+        return CODEG_WCET_UNBOUNDED;
+    }
+    return a*b;
+}
+
+bool IsUserLabel(const std::string& name)
+{//Internal labels start with %%, the copies of a user label (repeat, inlining) have a %% suffix
+    return name.compare(0, 2, "%%") != 0;
+}
+std::string GetBaseLabel(const std::string& name)
+{
+    return IsUserLabel(name) ? name.substr(0, name.find("%%")) : name;
+}
+
+}//end
+
+WcetAnalyzer::WcetAnalyzer()
+{
+    this->clear();
+}
+
+void WcetAnalyzer::clear()
+{
+    for (uint8_t i=0; i<CODEG_WCET_OPCODE_COUNT; ++i)
+    {
+        this->g_costs[i] = ToOpcodeCycles(i);
+    }
+    this->g_skippedCost = 1;
+
+    this->g_ops.clear();
+    this->g_opIndex.clear();
+    this->g_reached.clear();
+    this->g_jumpKinds.clear();
+    this->g_jumpTargets.clear();
+    this->g_leaders.clear();
+    this->g_blocks.clear();
+    this->g_opBlock.clear();
+    this->g_labels.clear();
+    this->g_entries.clear();
+    this->g_boundaries.clear();
+    this->g_returnPoints.clear();
+    this->g_bounds.clear();
+    this->g_functions.clear();
+    this->g_evaluating.clear();
+    this->g_results.clear();
+}
+
+bool WcetAnalyzer::loadCosts(const std::string& path)
+{
+    std::ifstream file(path);
+    if ( !file )
+    {
+        return false;
+    }
+
+    std::string line;
+    unsigned int lineCount = 0;
+    while ( std::getline(file, line) )
+    {
+        ++lineCount;
+        if ( !line.empty() && (line.back() == '\r') )
+        {
+            line.pop_back();
+        }
+        std::size_t first = line.find_first_not_of(" \t");
+        if ( (first == std::string::npos) || (line[first] == '#') )
+        {//Empty line or comment
+            continue;
+        }
+
+        std::vector<std::string> words;
+        codeg::SplitKeywords(line, words);
+        uint32_t cycles = 0;
+        if ( (words.size() != 2) || (codeg::GetIntegerFromString(words[1], cycles) == 0) )
+        {
+            throw codeg::SyntaxError("at line "+std::to_string(lineCount)+" : bad cost (wanted \"OPCODE cycles\")");
+        }
+
+        if (words[0] == "SKIPPED")
+        {//Instruction skipped by IF/IFNOT
+            this->g_skippedCost = cycles;
+            continue;
+        }
+
+        bool found = false;
+        for (uint8_t i=0; i<CODEG_WCET_OPCODE_COUNT; ++i)
+        {
+            if (words[0] == codeg::ReadableStringBinaryOpcodes[i])
+            {
+                this->g_costs[i] = cycles;
+                found = true;
+            }
+        }
+        if ( !found )
+        {
+            throw codeg::SyntaxError("at line "+std::to_string(lineCount)+" : unknown opcode \""+words[0]+"\"");
+        }
+    }
+    return true;
+}
+void WcetAnalyzer::setCost(uint8_t opcode, uint32_t cycles)
+{
+    this->g_costs[(opcode&0x1F) >= CODEG_WCET_OPCODE_COUNT ? 0x13 : (opcode&0x1F)] = cycles;
+}
+uint32_t WcetAnalyzer::getCost(uint8_t opcode) const
+{
+    return this->g_costs[(opcode&0x1F) >= CODEG_WCET_OPCODE_COUNT ? 0x13 : (opcode&0x1F)];
+}
+void WcetAnalyzer::setSkippedCost(uint32_t cycles)
+{
+    this->g_skippedCost = cycles;
+}
+uint32_t WcetAnalyzer::getSkippedCost() const
+{
+    return this->g_skippedCost;
+}
+
+void WcetAnalyzer::decode(codeg::CompilerData& data)
+{
+    const uint8_t* code = data._code.getData();
+    uint32_t size = data._code.getCursor();
+    bool writeDummy = data._code.getWriteDummy();
+
+    this->g_ops.clear();
+    this->g_opIndex.assign(size+1, CODEG_WCET_NONE);
+
+    for (uint32_t i=0; i<size;)
+    {
+        uint8_t opcode = code[i] & 0x1F;
+        bool argument = (opcode != codeg::OPCODE_JMPSRC_CLK) && (writeDummy || ((code[i]&0xE0) == codeg::ReadableBusses::READABLE_SOURCE));
+
+        this->g_opIndex[i] = this->g_ops.size();
+        this->g_ops.push_back({i, code[i], static_cast<uint8_t>((argument && (i+1 < size)) ? code[i+1] : 0)});
+        i += argument ? 2 : 1;
+    }
+    this->g_opIndex[size] = this->g_ops.size(); //End of the code
+}
+
+void WcetAnalyzer::followJumps(codeg::CompilerData& data)
+{
+    const std::size_t opCount = this->g_ops.size();
+    std::vector<JumpState> states(opCount, JumpState{});
+
+    this->g_reached.assign(opCount, false);
+    this->g_jumpKinds.assign(opCount, codeg::WcetAnalyzer::JumpKinds::JUMP_NONE);
+    this->g_jumpTargets.assign(opCount, {});
+
+    //Jump tables, the entries are 8 bytes
+    std::map<codeg::Address, std::vector<codeg::Address> > tablePages;
+    for (auto&& vTable : data._jumps._jumpTables)
+    {
+        std::list<codeg::Label>::iterator itLabel = data._jumps.getLabel(vTable._labelName);
+        if (itLabel != data._jumps._labels.end())
+        {
+            std::vector<codeg::Address>& entries = tablePages[itLabel->_addressStatic>>8];
+            for (uint32_t i=0; i<vTable._entryCount; ++i)
+            {
+                entries.push_back(itLabel->_addressStatic + 8*i);
+            }
+        }
+    }
+
+    auto classify = [&](std::size_t index, const JumpState& state, std::vector<std::size_t>& targets)
+    {
+        targets.clear();
+        if ( (state[0]._kind == JUMP_BYTE_KNOWN) && (state[1]._kind == JUMP_BYTE_KNOWN) && (state[2]._kind == JUMP_BYTE_KNOWN) )
+        {
+            codeg::Address address = (static_cast<codeg::Address>(state[2]._value)<<16) |
+                                      (static_cast<codeg::Address>(state[1]._value)<<8) | state[0]._value;
+            if ( (address >= this->g_opIndex.size()) || (this->g_opIndex[address] == CODEG_WCET_NONE) )
+            {
+                return codeg::WcetAnalyzer::JumpKinds::JUMP_UNKNOWN;
+            }
+            targets.push_back(this->g_opIndex[address]);
+            codeg::Address next = (index+1 < opCount) ? this->g_ops[index+1]._address : data._code.getCursor();
+            if ( (this->g_entries.count(address) > 0) && (this->g_returnPoints.count(next) > 0) )
+            {//The code continue after the call
+                targets.push_back(index+1);
+                return codeg::WcetAnalyzer::JumpKinds::JUMP_CALL;
+            }
+            return codeg::WcetAnalyzer::JumpKinds::JUMP_KNOWN;
+        }
+        for (std::size_t i=0; i<3; ++i)
+        {
+            if (state[i]._kind == JUMP_BYTE_RAM)
+            {//Return address
+                return codeg::WcetAnalyzer::JumpKinds::JUMP_RETURN;
+            }
+        }
+        if ( (state[0]._kind == JUMP_BYTE_RESULT) && (state[1]._kind == JUMP_BYTE_KNOWN) && (state[2]._kind == JUMP_BYTE_KNOWN) )
+        {//Jump table
+            std::map<codeg::Address, std::vector<codeg::Address> >::const_iterator itPage =
+                    tablePages.find((static_cast<codeg::Address>(state[2]._value)<<8) | state[1]._value);
+            if (itPage != tablePages.end())
+            {
+                for (codeg::Address address : itPage->second)
+                {
+                    if ( (address >= this->g_opIndex.size()) || (this->g_opIndex[address] == CODEG_WCET_NONE) )
+                    {
+                        targets.clear();
+                        return codeg::WcetAnalyzer::JumpKinds::JUMP_UNKNOWN;
+                    }
+                    targets.push_back(this->g_opIndex[address]);
+                }
+                return codeg::WcetAnalyzer::JumpKinds::JUMP_TABLE;
+            }
+        }
+        return codeg::WcetAnalyzer::JumpKinds::JUMP_UNKNOWN;
+    };
+
+    std::vector<std::size_t> work;
+    auto push = [&](std::size_t index, const JumpState& state)
+    {
+        if (index >= opCount)
+        {//End of the code
+            return;
+        }
+        if ( MergeJumpState(states[index], state) || !this->g_reached[index] )
+        {
+            this->g_reached[index] = true;
+            work.push_back(index);
+        }
+    };
+
+    JumpState unknown;
+    unknown.fill(JumpByte{JUMP_BYTE_UNKNOWN, 0});
+    push(0, unknown);
+
+    std::vector<std::size_t> targets;
+    while ( !work.empty() )
+    {
+        std::size_t index = work.back();
+        work.pop_back();
+
+        const codeg::WcetAnalyzer::Op& op = this->g_ops[index];
+        JumpState state = states[index];
+        uint8_t opcode = op._code & 0x1F;
+        uint8_t bus = op._code & 0xE0;
+
+        switch (opcode)
+        {
+        case codeg::OPCODE_BJMPSRC1_CLK:
+        case codeg::OPCODE_BJMPSRC2_CLK:
+        case codeg::OPCODE_BJMPSRC3_CLK:
+        {
+            JumpByte& byte = state[opcode - codeg::OPCODE_BJMPSRC1_CLK];
+            switch (bus)
+            {
+            case codeg::ReadableBusses::READABLE_SOURCE:
+                byte = {JUMP_BYTE_KNOWN, op._argument};
+                break;
+            case codeg::ReadableBusses::READABLE_RAM:
+                byte = {JUMP_BYTE_RAM, 0};
+                break;
+            case codeg::ReadableBusses::READABLE_RESULT:
+                byte = {JUMP_BYTE_RESULT, 0};
+                break;
+            default:
+                byte = {JUMP_BYTE_UNKNOWN, 0};
+                break;
+            }
+            push(index+1, state);
+            break;
+        }
+        case codeg::OPCODE_IF:
+        case codeg::OPCODE_IFNOT:
+            if (bus == codeg::ReadableBusses::READABLE_SOURCE)
+            {//Constant condition
+                bool skip = (opcode == codeg::OPCODE_IF) ? (op._argument != 0) : (op._argument == 0);
+                push(index + (skip ? 2 : 1), state);
+            }
+            else
+            {
+                push(index+1, state);
+                push(index+2, state);
+            }
+            break;
+        case codeg::OPCODE_JMPSRC_CLK:
+            switch ( classify(index, state, targets) )
+            {
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_KNOWN:
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_TABLE:
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_CALL:
+                for (std::size_t target : targets)
+                {//The jump source register have the address of the target (the return address after a call)
+                    push(target, MakeJumpState(target < opCount ? this->g_ops[target]._address : data._code.getCursor()));
+                }
+                break;
+            default:
+                break;
+            }
+            break;
+        default:
+            push(index+1, state);
+            break;
+        }
+    }
+
+    //Final jumps
+    for (std::size_t i=0; i<opCount; ++i)
+    {
+        if ( this->g_reached[i] && ((this->g_ops[i]._code&0x1F) == codeg::OPCODE_JMPSRC_CLK) )
+        {
+            this->g_jumpKinds[i] = classify(i, states[i], this->g_jumpTargets[i]);
+        }
+    }
+}
+
+void WcetAnalyzer::buildBlocks()
+{
+    const std::size_t opCount = this->g_ops.size();
+
+    this->g_leaders.assign(opCount+1, false);
+    this->g_leaders[0] = true;
+    for (std::size_t i=0; i<opCount; ++i)
+    {
+        uint8_t opcode = this->g_ops[i]._code & 0x1F;
+        if ( (opcode == codeg::OPCODE_IF) || (opcode == codeg::OPCODE_IFNOT) || (opcode == codeg::OPCODE_JMPSRC_CLK) )
+        {
+            this->g_leaders[i+1] = true;
+            if (opcode != codeg::OPCODE_JMPSRC_CLK)
+            {
+                this->g_leaders[std::min(i+2, opCount)] = true;
+            }
+        }
+        for (std::size_t target : this->g_jumpTargets[i])
+        {
+            this->g_leaders[target] = true;
+        }
+        if ( this->g_boundaries.count(this->g_ops[i]._address) || this->g_entries.count(this->g_ops[i]._address) )
+        {
+            this->g_leaders[i] = true;
+        }
+    }
+
+    this->g_blocks.clear();
+    this->g_opBlock.assign(opCount, CODEG_WCET_NONE);
+    for (std::size_t i=0; i<opCount; ++i)
+    {
+        if ( !this->g_reached[i] )
+        {
+            continue;
+        }
+        if ( this->g_leaders[i] || (i == 0) || !this->g_reached[i-1] || (this->g_opBlock[i-1] == CODEG_WCET_NONE) )
+        {
+            this->g_blocks.push_back({i, i, 0, {}, false, this->g_boundaries.count(this->g_ops[i]._address) > 0});
+        }
+        codeg::WcetAnalyzer::Block& block = this->g_blocks.back();
+        block._end = i+1;
+        block._cycles += this->getCost(this->g_ops[i]._code);
+        this->g_opBlock[i] = this->g_blocks.size()-1;
+    }
+
+    auto getBlock = [&](std::size_t index)
+    {
+        return (index >= opCount) ? CODEG_WCET_NONE : this->g_opBlock[index];
+    };
+    auto getSkipped = [&](std::size_t index)
+    {
+        return (index >= opCount) ? 0 : this->g_skippedCost;
+    };
+
+    for (auto&& vBlock : this->g_blocks)
+    {
+        std::size_t last = vBlock._end-1;
+        const codeg::WcetAnalyzer::Op& op = this->g_ops[last];
+        uint8_t opcode = op._code & 0x1F;
+
+        if ( (opcode == codeg::OPCODE_IF) || (opcode == codeg::OPCODE_IFNOT) )
+        {
+            bool constant = ((op._code&0xE0) == codeg::ReadableBusses::READABLE_SOURCE);
+            bool skip = (opcode == codeg::OPCODE_IF) ? (op._argument != 0) : (op._argument == 0);
+            if ( !constant || !skip )
+            {
+                vBlock._successors.push_back({getBlock(last+1), 0, CODEG_WCET_NONE});
+            }
+            if ( !constant || skip )
+            {//The skipped instruction still take cycles
+                vBlock._successors.push_back({getBlock(last+2), getSkipped(last+1), CODEG_WCET_NONE});
+            }
+        }
+        else if (opcode == codeg::OPCODE_JMPSRC_CLK)
+        {
+            const std::vector<std::size_t>& targets = this->g_jumpTargets[last];
+            switch (this->g_jumpKinds[last])
+            {
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_KNOWN:
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_TABLE:
+                for (std::size_t target : targets)
+                {
+                    vBlock._successors.push_back({getBlock(target), 0, CODEG_WCET_NONE});
+                }
+                break;
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_CALL:
+                vBlock._successors.push_back({getBlock(targets[1]), 0, getBlock(targets[0])});
+                break;
+            case codeg::WcetAnalyzer::JumpKinds::JUMP_RETURN:
+                vBlock._successors.push_back({CODEG_WCET_NONE, 0, CODEG_WCET_NONE});
+                break;
+            default:
+                vBlock._unknownJump = true;
+                break;
+            }
+        }
+        else
+        {
+            vBlock._successors.push_back({getBlock(last+1), 0, CODEG_WCET_NONE});
+        }
+    }
+}
+
+codeg::WcetAnalyzer::Summary WcetAnalyzer::evaluate(uint32_t entry, bool function)
+{
+    codeg::WcetAnalyzer::Summary summary{0, 0, ""};
+    auto unbounded = [&](const std::string& reason)
+    {
+        if ( summary._reason.empty() )
+        {
+            summary._reason = reason;
+        }
+    };
+
+    ///Blocks of the code, a label is measured until the next user label
+    auto isInside = [&](uint32_t block)
+    {
+        return (block != CODEG_WCET_NONE) && (function || !this->g_blocks[block]._boundary);
+    };
+
+    std::map<uint32_t, uint32_t> local; //Block with its local index
+    std::vector<uint32_t> nodes; //Reverse post order
+    {
+        std::vector<uint32_t> postOrder;
+        std::vector<std::pair<uint32_t, std::size_t> > stack{{entry, 0}};
+        local[entry] = 0;
+        while ( !stack.empty() )
+        {
+            uint32_t block = stack.back().first;
+            std::size_t& next = stack.back().second;
+            const std::vector<codeg::WcetAnalyzer::Edge>& successors = this->g_blocks[block]._successors;
+            if (next < successors.size())
+            {
+                uint32_t target = successors[next++]._target;
+                if ( isInside(target) && (local.find(target) == local.end()) )
+                {
+                    local[target] = 0;
+                    stack.push_back({target, 0});
+                }
+                continue;
+            }
+            postOrder.push_back(block);
+            stack.pop_back();
+        }
+        nodes.assign(postOrder.rbegin(), postOrder.rend());
+        for (uint32_t i=0; i<nodes.size(); ++i)
+        {
+            local[nodes[i]] = i;
+        }
+    }
+    const uint32_t nodeCount = nodes.size();
+
+    ///Edges with their cycles (the cost of the called functions is included)
+    struct LocalEdge
+    {
+        uint32_t _target; //Local index, CODEG_WCET_NONE if the code is left
+        uint64_t _worst;
+        uint64_t _best;
+    };
+    std::vector<std::vector<LocalEdge> > edges(nodeCount);
+    std::vector<std::vector<uint32_t> > predecessors(nodeCount);
+    for (uint32_t i=0; i<nodeCount; ++i)
+    {
+        const codeg::WcetAnalyzer::Block& block = this->g_blocks[nodes[i]];
+        if (block._unknownJump)
+        {
+            unbounded("unknown jump at address "+std::to_string(this->g_ops[block._end-1]._address));
+            edges[i].push_back({CODEG_WCET_NONE, CODEG_WCET_UNBOUNDED, block._cycles});
+        }
+        for (auto&& vEdge : block._successors)
+        {
+            uint64_t worst = block._cycles + vEdge._cycles;
+            uint64_t best = worst;
+            if (vEdge._callee != CODEG_WCET_NONE)
+            {
+                codeg::WcetAnalyzer::Summary callee;
+                if ( this->g_evaluating.count(vEdge._callee) > 0 )
+                {
+                    callee = {0, CODEG_WCET_UNBOUNDED, "recursive call of "+this->getName(this->g_ops[this->g_blocks[vEdge._callee]._begin]._address)};
+                }
+                else
+                {
+                    std::map<uint32_t, codeg::WcetAnalyzer::Summary>::const_iterator itFunction = this->g_functions.find(vEdge._callee);
+                    if (itFunction == this->g_functions.end())
+                    {
+                        this->g_evaluating.insert(vEdge._callee);
+                        callee = this->evaluate(vEdge._callee, true);
+                        this->g_evaluating.erase(vEdge._callee);
+                        this->g_functions[vEdge._callee] = callee;
+                    }
+                    else
+                    {
+                        callee = itFunction->second;
+                    }
+                }
+                if (callee._worst == CODEG_WCET_UNBOUNDED)
+                {
+                    unbounded(callee._reason.empty() ? ("call of "+this->getName(this->g_ops[this->g_blocks[vEdge._callee]._begin]._address)) : callee._reason);
+                }
+                worst = codeg::AddCycles(worst, callee._worst);
+                best = codeg::AddCycles(best, callee._best);
+            }
+
+            uint32_t target = isInside(vEdge._target) ? local[vEdge._target] : CODEG_WCET_NONE;
+            edges[i].push_back({target, worst, best});
+            if (target != CODEG_WCET_NONE)
+            {
+                predecessors[target].push_back(i);
+            }
+        }
+    }
+
+    ///Dominators (nodes are in reverse post order)
+    std::vector<uint32_t> dominator(nodeCount, CODEG_WCET_NONE);
+    dominator[0] = 0;
+    for (bool changed=true; changed;)
+    {
+        changed = false;
+        for (uint32_t i=1; i<nodeCount; ++i)
+        {
+            uint32_t newDominator = CODEG_WCET_NONE;
+            for (uint32_t predecessor : predecessors[i])
+            {
+                if (dominator[predecessor] == CODEG_WCET_NONE)
+                {
+                    continue;
+                }
+                if (newDominator == CODEG_WCET_NONE)
+                {
+                    newDominator = predecessor;
+                    continue;
+                }
+                uint32_t a = predecessor;
+                uint32_t b = newDominator;
+                while (a != b)
+                {
+                    while (a > b)
+                    {
+                        a = dominator[a];
+                    }
+                    while (b > a)
+                    {
+                        b = dominator[b];
+                    }
+                }
+                newDominator = a;
+            }
+            if (dominator[i] != newDominator)
+            {
+                dominator[i] = newDominator;
+                changed = true;
+            }
+        }
+    }
+    auto dominates = [&](uint32_t a, uint32_t b)
+    {
+        while (b != a)
+        {
+            if (b == 0)
+            {
+                return false;
+            }
+            b = dominator[b];
+        }
+        return true;
+    };
+
+    ///Natural loops
+    struct Loop
+    {
+        uint32_t _header;
+        std::vector<bool> _body;
+        std::size_t _size;
+        uint32_t _parent;
+        std::vector<codeg::WcetAnalyzer::Exit> _exits; //Cost from the header to every exit (the iterations included)
+    };
+    std::vector<Loop> loops;
+    std::vector<uint32_t> headerLoop(nodeCount, CODEG_WCET_NONE);
+    for (uint32_t i=0; i<nodeCount; ++i)
+    {
+        for (auto&& vEdge : edges[i])
+        {
+            if ( (vEdge._target == CODEG_WCET_NONE) || (vEdge._target > i) )
+            {
+                continue;
+            }
+            if ( !dominates(vEdge._target, i) )
+            {
+                unbounded("irreducible loop at "+this->getName(this->g_ops[this->g_blocks[nodes[vEdge._target]]._begin]._address));
+                summary._worst = CODEG_WCET_UNBOUNDED;
+                return summary;
+            }
+
+            uint32_t header = vEdge._target;
+            if (headerLoop[header] == CODEG_WCET_NONE)
+            {
+                headerLoop[header] = loops.size();
+                loops.push_back({header, std::vector<bool>(nodeCount, false), 1, CODEG_WCET_NONE, {}});
+                loops.back()._body[header] = true;
+            }
+            Loop& loop = loops[headerLoop[header]];
+            std::vector<uint32_t> work{i};
+            while ( !work.empty() )
+            {
+                uint32_t node = work.back();
+                work.pop_back();
+                if ( loop._body[node] )
+                {
+                    continue;
+                }
+                loop._body[node] = true;
+                ++loop._size;
+                work.insert(work.end(), predecessors[node].begin(), predecessors[node].end());
+            }
+        }
+    }
+
+    //Inner loops first
+    std::vector<uint32_t> loopOrder(loops.size());
+    for (uint32_t i=0; i<loops.size(); ++i)
+    {
+        loopOrder[i] = i;
+    }
+    std::sort(loopOrder.begin(), loopOrder.end(), [&](uint32_t a, uint32_t b){ return loops[a]._size < loops[b]._size; });
+
+    std::vector<uint32_t> innerLoop(nodeCount, CODEG_WCET_NONE);
+    for (std::size_t i=0; i<loopOrder.size(); ++i)
+    {
+        Loop& loop = loops[loopOrder[i]];
+        for (uint32_t node=0; node<nodeCount; ++node)
+        {
+            if ( loop._body[node] && (innerLoop[node] == CODEG_WCET_NONE) )
+            {
+                innerLoop[node] = loopOrder[i];
+            }
+        }
+        for (std::size_t j=i+1; j<loopOrder.size(); ++j)
+        {
+            if ( loops[loopOrder[j]]._body[loop._header] )
+            {
+                loop._parent = loopOrder[j];
+                break;
+            }
+        }
+    }
+
+    //Node that represent a block in a loop (the header of the outermost inner loop)
+    auto represent = [&](uint32_t node, uint32_t context)
+    {
+        uint32_t loop = innerLoop[node];
+        if ( (loop == CODEG_WCET_NONE) || (loop == context) )
+        {
+            return node;
+        }
+        while (loops[loop]._parent != context)
+        {
+            loop = loops[loop]._parent;
+        }
+        return loops[loop]._header;
+    };
+
+    ///Longest and shortest paths from the start of a loop (or the entry) to its exits
+    auto walk = [&](uint32_t context, uint32_t start, std::vector<codeg::WcetAnalyzer::Exit>& exits,
+                    uint64_t& iterationWorst, uint64_t& iterationBest)
+    {
+        auto isMember = [&](uint32_t node)
+        {
+            return (node != CODEG_WCET_NONE) && ((context == CODEG_WCET_NONE) || loops[context]._body[node]);
+        };
+        auto getEdges = [&](uint32_t node)
+        {
+            std::vector<LocalEdge> result;
+            uint32_t loop = headerLoop[node];
+            if ( (loop != CODEG_WCET_NONE) && (loop != context) )
+            {
+                for (auto&& vExit : loops[loop]._exits)
+                {
+                    result.push_back({vExit._target, vExit._worst, vExit._best});
+                }
+                return result;
+            }
+            return edges[node];
+        };
+
+        //Topological order
+        std::vector<uint32_t> order;
+        std::vector<uint8_t> visited(nodeCount, 0);
+        std::vector<std::pair<uint32_t, std::vector<LocalEdge> > > stack;
+        stack.push_back({start, getEdges(start)});
+        visited[start] = 1;
+        while ( !stack.empty() )
+        {
+            std::vector<LocalEdge>& nodeEdges = stack.back().second;
+            if ( !nodeEdges.empty() )
+            {
+                uint32_t target = nodeEdges.back()._target;
+                nodeEdges.pop_back();
+                if ( !isMember(target) || ((context != CODEG_WCET_NONE) && (target == loops[context]._header)) )
+                {
+                    continue;
+                }
+                target = represent(target, context);
+                if (visited[target] == 0)
+                {
+                    visited[target] = 1;
+                    stack.push_back({target, getEdges(target)});
+                }
+                continue;
+            }
+            order.push_back(stack.back().first);
+            visited[stack.back().first] = 2;
+            stack.pop_back();
+        }
+        std::reverse(order.begin(), order.end());
+
+        std::vector<uint64_t> worst(nodeCount, 0);
+        std::vector<uint64_t> best(nodeCount, CODEG_WCET_UNBOUNDED);
+        best[start] = 0;
+        iterationWorst = 0;
+        iterationBest = CODEG_WCET_UNBOUNDED;
+
+        std::map<uint32_t, std::size_t> exitIndex;
+        for (uint32_t node : order)
+        {
+            if (best[node] == CODEG_WCET_UNBOUNDED)
+            {//Not reached
+                continue;
+            }
+            for (auto&& vEdge : getEdges(node))
+            {
+                uint64_t pathWorst = codeg::AddCycles(worst[node], vEdge._worst);
+                uint64_t pathBest = codeg::AddCycles(best[node], vEdge._best);
+
+                if ( !isMember(vEdge._target) )
+                {
+                    std::map<uint32_t, std::size_t>::const_iterator itExit = exitIndex.find(vEdge._target);
+                    if (itExit == exitIndex.end())
+                    {
+                        exitIndex[vEdge._target] = exits.size();
+                        exits.push_back({vEdge._target, pathWorst, pathBest});
+                    }
+                    else
+                    {
+                        exits[itExit->second]._worst = std::max(exits[itExit->second]._worst, pathWorst);
+                        exits[itExit->second]._best = std::min(exits[itExit->second]._best, pathBest);
+                    }
+                }
+                else if ( (context != CODEG_WCET_NONE) && (vEdge._target == loops[context]._header) )
+                {
+                    iterationWorst = std::max(iterationWorst, pathWorst);
+                    iterationBest = std::min(iterationBest, pathBest);
+                }
+                else
+                {
+                    uint32_t target = represent(vEdge._target, context);
+                    worst[target] = std::max(worst[target], pathWorst);
+                    best[target] = std::min(best[target], pathBest);
+                }
+            }
+        }
+    };
+
+    for (uint32_t index : loopOrder)
+    {
+        Loop& loop = loops[index];
+        std::vector<codeg::WcetAnalyzer::Exit> exits;
+        uint64_t iterationWorst;
+        uint64_t iterationBest;
+        walk(index, loop._header, exits, iterationWorst, iterationBest);
+
+        codeg::Address address = this->g_ops[this->g_blocks[nodes[loop._header]]._begin]._address;
+        std::map<codeg::Address, std::pair<uint32_t, uint32_t> >::const_iterator itBound = this->g_bounds.find(address);
+        uint64_t minCount = 1;
+        uint64_t maxCount = CODEG_WCET_UNBOUNDED;
+        if (itBound != this->g_bounds.end())
+        {
+            minCount = std::max<uint32_t>(itBound->second.first, 1);
+            maxCount = std::max<uint32_t>(itBound->second.second, minCount);
+        }
+        else
+        {
+            unbounded("loop at "+this->getName(address)+" without bound");
+        }
+
+        for (auto&& vExit : exits)
+        {
+            vExit._worst = codeg::AddCycles(codeg::MultiplyCycles(maxCount-(maxCount==CODEG_WCET_UNBOUNDED ? 0 : 1), iterationWorst), vExit._worst);
+            vExit._best = codeg::AddCycles(codeg::MultiplyCycles(minCount-1, iterationBest), vExit._best);
+        }
+        loop._exits = std::move(exits);
+    }
+
+    std::vector<codeg::WcetAnalyzer::Exit> exits;
+    uint64_t iterationWorst;
+    uint64_t iterationBest;
+    walk(CODEG_WCET_NONE, represent(0, CODEG_WCET_NONE), exits, iterationWorst, iterationBest);
+
+    if ( exits.empty() )
+    {
+        unbounded("the code never leave");
+        summary._worst = CODEG_WCET_UNBOUNDED;
+        return summary;
+    }
+    summary._best = CODEG_WCET_UNBOUNDED;
+    for (auto&& vExit : exits)
+    {
+        summary._worst = std::max(summary._worst, vExit._worst);
+        summary._best = std::min(summary._best, vExit._best);
+    }
+    return summary;
+}
+
+std::string WcetAnalyzer::getName(codeg::Address address) const
+{
+    std::string name;
+    for (auto it=this->g_labels.lower_bound(address); (it!=this->g_labels.end()) && (it->first == address); ++it)
+    {
+        if ( IsUserLabel(it->second) )
+        {
+            return "\""+it->second+"\"";
+        }
+        if (it->second.compare(0, 2, "%%") == 0 && name.empty() && this->g_entries.count(address) > 0)
+        {
+            name = "\""+it->second.substr(2)+"\"";
+        }
+    }
+    return name.empty() ? ("address "+std::to_string(address)) : name;
+}
+
+void WcetAnalyzer::analyze(codeg::CompilerData& data)
+{
+    this->g_ops.clear();
+    this->g_labels.clear();
+    this->g_entries.clear();
+    this->g_boundaries.clear();
+    this->g_returnPoints.clear();
+    this->g_bounds.clear();
+    this->g_functions.clear();
+    this->g_evaluating.clear();
+    this->g_results.clear();
+
+    ///Labels
+    std::map<std::string, std::pair<uint32_t, uint32_t> > bounds;
+    for (auto&& vBound : data._loopBounds)
+    {
+        bounds[vBound._label] = {vBound._min, vBound._max};
+    }
+
+    std::map<std::string, codeg::Address> functions;
+    for (auto&& vFunction : data._functions.getFunctions())
+    {
+        if ( !vFunction.isDefinition() )
+        {
+            functions[vFunction.getName()] = 0;
+        }
+    }
+
+    std::vector<const codeg::Label*> labels;
+    for (auto&& vLabel : data._jumps._labels)
+    {
+        labels.push_back(&vLabel);
+    }
+    for (auto&& vLabel : data._jumps._mergedLabels)
+    {
+        labels.push_back(&vLabel);
+    }
+
+    for (const codeg::Label* label : labels)
+    {
+        const codeg::Label& vLabel = *label;
+        const codeg::Address address = vLabel._addressStatic;
+        this->g_labels.insert({address, vLabel._name});
+
+        if ( IsUserLabel(vLabel._name) )
+        {
+            this->g_boundaries.insert(address);
+        }
+        else if ( functions.count(vLabel._name.substr(2)) > 0 )
+        {
+            functions[vLabel._name.substr(2)] = address;
+            this->g_entries.insert(address);
+        }
+        else if ( (vLabel._name.compare(0, 3, "%%O") == 0) && (vLabel._name.size() > 3) &&
+                  (vLabel._name.find_first_not_of("0123456789", 3) == std::string::npos) )
+        {//Outlined sequence
+            this->g_entries.insert(address);
+        }
+        else if ( (vLabel._name.compare(0, 3, "%%R") == 0) ||
+                  ((vLabel._name.compare(0, 3, "%%O") == 0) && (vLabel._name.find('_') != std::string::npos)) )
+        {//Return address of a call
+            this->g_returnPoints.insert(address);
+        }
+
+        std::map<std::string, std::pair<uint32_t, uint32_t> >::const_iterator itBound = bounds.find(GetBaseLabel(vLabel._name));
+        if (itBound != bounds.end())
+        {
+            this->g_bounds.insert({address, itBound->second});
+        }
+    }
+
+    ///Control flow
+    this->decode(data);
+    this->followJumps(data);
+    this->buildBlocks();
+
+    ///Functions and user labels
+    for (auto&& vFunction : functions)
+    {
+        if ( this->g_entries.count(vFunction.second) == 0 )
+        {
+            continue;
+        }
+        uint32_t index = this->g_opIndex[vFunction.second];
+        if ( (index == CODEG_WCET_NONE) || (index >= this->g_ops.size()) || !this->g_reached[index] )
+        {//Never called
+            continue;
+        }
+
+        uint32_t block = this->g_opBlock[index];
+        std::map<uint32_t, codeg::WcetAnalyzer::Summary>::const_iterator itFunction = this->g_functions.find(block);
+        codeg::WcetAnalyzer::Summary summary;
+        if (itFunction == this->g_functions.end())
+        {
+            this->g_evaluating.insert(block);
+            summary = this->evaluate(block, true);
+            this->g_evaluating.erase(block);
+            this->g_functions[block] = summary;
+        }
+        else
+        {
+            summary = itFunction->second;
+        }
+        this->g_results.push_back({vFunction.first, true, vFunction.second, summary._best, summary._worst, summary._reason});
+    }
+    for (const codeg::Label* label : labels)
+    {
+        const codeg::Label& vLabel = *label;
+        if ( !IsUserLabel(vLabel._name) || (vLabel._name.find("%%") != std::string::npos) ||
+             (vLabel._addressStatic >= this->g_opIndex.size()) )
+        {
+            continue;
+        }
+        uint32_t index = this->g_opIndex[vLabel._addressStatic];
+        if ( (index == CODEG_WCET_NONE) || (index >= this->g_ops.size()) || !this->g_reached[index] )
+        {//Never reached
+            continue;
+        }
+
+        codeg::WcetAnalyzer::Summary summary = this->evaluate(this->g_opBlock[index], false);
+        this->g_results.push_back({vLabel._name, false, vLabel._addressStatic, summary._best, summary._worst, summary._reason});
+    }
+
+    std::stable_sort(this->g_results.begin(), this->g_results.end(), [](const codeg::WcetResult& a, const codeg::WcetResult& b)
+    {
+        return (a._function != b._function) ? a._function : (a._address < b._address);
+    });
+}
+
+const std::vector<codeg::WcetResult>& WcetAnalyzer::getResults() const
+{
+    return this->g_results;
+}
+const codeg::WcetResult* WcetAnalyzer::getResult(const std::string& name) const
+{
+    for (auto&& vResult : this->g_results)
+    {
+        if (vResult._name == name)
+        {
+            return &vResult;
+        }
+    }
+    return nullptr;
+}
+
+}//end codeg
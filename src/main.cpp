@@ -1,403 +1,991 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Copyright 2021 Guillaume Guillet                                            //
-//                                                                             //
-// Licensed under the Apache License, Version 2.0 (the "License");             //
-// you may not use this file except in compliance with the License.            //
-// You may obtain a copy of the License at                                     //
-//                                                                             //
-//     http://www.apache.org/licenses/LICENSE-2.0                              //
-//                                                                             //
-// Unless required by applicable law or agreed to in writing, software         //
-// distributed under the License is distributed on an "AS IS" BASIS,           //
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
-// See the License for the specific language governing permissions and         //
-// limitations under the License.                                              //
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "main.hpp"
-
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <stack>
-#include <vector>
-#include <string>
-
-#include "C_target.hpp"
-#include "C_value.hpp"
-#include "C_variable.hpp"
-#include "C_keyword.hpp"
-#include "C_compilerData.hpp"
-#include "C_console.hpp"
-#include "C_error.hpp"
-
-#include "CMakeConfig.hpp"
-
-using namespace std;
-
-void printHelp()
-{
-    std::cout << "codeGGcompiler usage :" << std::endl << std::endl;
-
-    std::cout << "Set the input file to be compiled" << std::endl;
-    std::cout << "\tcodeGGcompiler --in=<path>" << std::endl << std::endl;
-
-    std::cout << "Set the output file (default is the input path+.cg)" << std::endl;
-    std::cout << "\tcodeGGcompiler --out=<path>" << std::endl << std::endl;
-
-    std::cout << "Print the version (and do nothing else)" << std::endl;
-    std::cout << "\tcodeGGcompiler --version" << std::endl << std::endl;
-
-    std::cout << "Print the help page (and do nothing else)" << std::endl;
-    std::cout << "\tcodeGGcompiler --help" << std::endl << std::endl;
-
-    std::cout << "Ask the user how he want to compile his file (interactive compiling)" << std::endl;
-    std::cout << "\tcodeGGcompiler --ask" << std::endl << std::endl;
-}
-void printVersion()
-{
-    std::cout << "codeGGcompiler created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
-}
-
-int main(int argc, char **argv)
-{
-    if ( int err = codeg::ConsoleInit() )
-    {
-        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
-    }
-
-    std::string fileInPath;
-    std::string fileOutPath;
-
-    std::vector<std::string> commands(argv, argv + argc);
-
-    if (commands.size() <= 1)
-    {
-        printHelp();
-        return -1;
-    }
-
-    for (unsigned int i=1; i<commands.size(); ++i)
-    {
-        //Commands
-        if ( commands[i] == "--help")
-        {
-            printHelp();
-            return 0;
-        }
-        if ( commands[i] == "--version")
-        {
-            printVersion();
-            return 0;
-        }
-        if ( commands[i] == "--ask")
-        {
-            std::cout << "Please insert the input path of the file"<< std::endl <<"> ";
-            std::getline(std::cin, fileInPath);
-            continue;
-        }
-
-        //Commands with an argument
-        std::vector<std::string> splitedCommand;
-        codeg::Split(commands[i], splitedCommand, '=');
-
-        if (splitedCommand.size() == 2)
-        {
-            if ( splitedCommand[0] == "--in")
-            {
-                fileInPath = splitedCommand[1];
-                continue;
-            }
-            if ( splitedCommand[0] == "--out")
-            {
-                fileOutPath = splitedCommand[1];
-                continue;
-            }
-        }
-
-        //Unknown command
-        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
-        return -1;
-    }
-
-    if ( fileInPath.empty() )
-    {
-        std::cout << "No input file !" << std::endl;
-        return -1;
-    }
-    if ( fileOutPath.empty() )
-    {
-        fileOutPath = fileInPath+".cg";
-    }
-
-    ///Compiler data
-    codeg::CompilerData data;
-
-    ///Opening files
-    if ( !data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_file(fileInPath)) ) )
-    {
-        std::cout << "Can't read the file \""<< fileInPath <<"\"" << std::endl;
-        return -1;
-    }
-    data._relativePath = codeg::GetRelativePath(fileInPath);
-
-    std::ofstream fileOutBinary( fileOutPath, std::ios::binary | std::ios::trunc );
-    if ( !fileOutBinary )
-    {
-        std::cout << "Can't write the file \""<< fileOutPath <<".cg\"" << std::endl;
-        return -1;
-    }
-    std::ofstream fileOutReadable( fileInPath+".rcg", std::ios::trunc );
-    if ( !fileOutReadable )
-    {
-        std::cout << "Can't write the file \""<< fileInPath <<".rcg\"" << std::endl;
-        return -1;
-    }
-
-    std::cout << "Input file : \""<< fileInPath <<"\"" << std::endl;
-    std::cout << "Output file : \""<< fileOutPath <<"\"" << std::endl;
-
-    ///Creating default pool
-    codeg::Pool defaultPool("global");
-    defaultPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
-    defaultPool.setAddress(0x00, 0x0000);
-
-    ///Set default pool
-    data._defaultPool = "global";
-    data._pools.addPool(defaultPool);
-
-    ///Reserved keywords
-    data._reservedKeywords.push("set");
-    data._reservedKeywords.push("unset");
-    data._reservedKeywords.push("var");
-    data._reservedKeywords.push("label");
-    data._reservedKeywords.push("affect");
-    data._reservedKeywords.push("get");
-    data._reservedKeywords.push("function");
-    data._reservedKeywords.push("do");
-    data._reservedKeywords.push("if_not");
-    data._reservedKeywords.push("else");
-    data._reservedKeywords.push("end");
-    data._reservedKeywords.push("choose");
-    data._reservedKeywords.push("OP");
-    data._reservedKeywords.push("P");
-    data._reservedKeywords.push("write");
-    data._reservedKeywords.push("if");
-    data._reservedKeywords.push("brut");
-    data._reservedKeywords.push("jump");
-    data._reservedKeywords.push("call");
-    data._reservedKeywords.push("restart");
-    data._reservedKeywords.push("PERIPHERAL");
-    data._reservedKeywords.push("OPERATION");
-    data._reservedKeywords.push("tick");
-    data._reservedKeywords.push("simple");
-    data._reservedKeywords.push("long");
-    data._reservedKeywords.push("repeat");
-    data._reservedKeywords.push("_src");
-    data._reservedKeywords.push("_bread1");
-    data._reservedKeywords.push("_bread2");
-    data._reservedKeywords.push("_result");
-    data._reservedKeywords.push("_ram");
-    data._reservedKeywords.push("_spi");
-    data._reservedKeywords.push("_ext1");
-    data._reservedKeywords.push("_ext2");
-    data._reservedKeywords.push("pool");
-    data._reservedKeywords.push("#");
-    data._reservedKeywords.push("#[");
-    data._reservedKeywords.push("]#");
-    data._reservedKeywords.push("SPI");
-    data._reservedKeywords.push("import");
-    data._reservedKeywords.push("definition");
-    data._reservedKeywords.push("end_def");
-
-    ///Instructions
-    data._instructions.push(new codeg::Instruction_set());
-    data._instructions.push(new codeg::Instruction_unset());
-    data._instructions.push(new codeg::Instruction_var());
-    data._instructions.push(new codeg::Instruction_label());
-    data._instructions.push(new codeg::Instruction_jump());
-    data._instructions.push(new codeg::Instruction_restart());
-    data._instructions.push(new codeg::Instruction_affect());
-    data._instructions.push(new codeg::Instruction_get());
-    data._instructions.push(new codeg::Instruction_write());
-    data._instructions.push(new codeg::Instruction_choose());
-    data._instructions.push(new codeg::Instruction_do());
-    data._instructions.push(new codeg::Instruction_tick());
-    data._instructions.push(new codeg::Instruction_brut());
-    data._instructions.push(new codeg::Instruction_function());
-    data._instructions.push(new codeg::Instruction_if());
-    data._instructions.push(new codeg::Instruction_else());
-    data._instructions.push(new codeg::Instruction_ifnot());
-    data._instructions.push(new codeg::Instruction_end());
-    data._instructions.push(new codeg::Instruction_call());
-    data._instructions.push(new codeg::Instruction_clock());
-    data._instructions.push(new codeg::Instruction_pool());
-    data._instructions.push(new codeg::Instruction_import());
-    data._instructions.push(new codeg::Instruction_definition());
-    data._instructions.push(new codeg::Instruction_enddef());
-
-    ///Code
-    data._code.resize(65536);
-
-    std::string readedLine;
-
-    try
-    {
-        ///First step reading and compiling
-        codeg::ConsoleInfoWrite("Step 1 : Reading and compiling ...");
-
-        while( data._reader.getline(readedLine) )
-        {
-            data._decomposer.decompose(readedLine, data._decomposer._flags);
-
-            if (data._decomposer._keywords.size() > 0)
-            {
-                codeg::Instruction* instruction = data._instructions.get( data._decomposer._keywords[0] );
-
-                if (instruction != nullptr)
-                {//Instruction founded
-                    if ( data._writeLinesIntoDefinition )
-                    {//Compile in a definition (detect the end_def keyword)
-                        instruction->compileDefinition(data._decomposer, data);
-                    }
-                    else
-                    {//Compile
-                        instruction->compile(data._decomposer, data);
-                    }
-                }
-                else
-                {//Bad instruction
-                    throw codeg::FatalError("unknown instruction \""+data._decomposer._keywords[0]+"\"");
-                }
-            }
-        }
-
-        if ( data._scopes.size() > 0 )
-        {//A scope is not terminated by 'end'
-            throw codeg::CompileError("scope without an 'end' (maybe at line: "+std::to_string(data._scopes.top()._startLine)+" and file: "+data._scopes.top()._startFile+")");
-        }
-
-        codeg::ConsoleInfoWrite("Step 1 : OK !\n");
-        codeg::ConsoleInfoWrite("Compiled size : "+std::to_string(data._code.getCursor())+" bytes\n");
-
-        ///Second step resolving jumplist
-        codeg::ConsoleInfoWrite("Step 2 : Resolving jumpList ...");
-
-        data._jumps.resolve(data);
-
-        codeg::ConsoleInfoWrite("Step 2 : OK !\n");
-
-        ///Third step resolving pools
-        codeg::ConsoleInfoWrite("Step 3 : Resolving pools ...");
-
-        data._pools.resolve(data);
-
-        codeg::ConsoleInfoWrite("Step 3 : OK !\n");
-
-        ///Writing on the output file
-        codeg::ConsoleInfoWrite("Writing codeG file (binary size : "+std::to_string(data._code.getCursor())+" bytes) ...");
-        fileOutBinary.write(reinterpret_cast<char*>(data._code.getData()), data._code.getCursor());
-        fileOutBinary.close();
-
-        codeg::ConsoleInfoWrite("Writing readable codeG file ...");
-
-        bool tmpFlagOpcode = true;
-        uint8_t* dataPtr = data._code.getData();
-        for (uint32_t i = 0; i<data._code.getCursor(); ++i)
-        {
-            fileOutReadable << "["<<codeg::ValueToHex(dataPtr[i], 2)<<"]";
-
-            if ( tmpFlagOpcode )
-            {
-                if ((dataPtr[i]&0x1F) != codeg::OPCODE_JMPSRC_CLK)
-                {//The jump instruction does not have an argument
-                    tmpFlagOpcode = false;
-                }
-                fileOutReadable << " " << ToReadableOpcode(dataPtr[i]) << " <" << ToReadableBus(dataPtr[i]) << ">";
-            }
-            else
-            {
-                tmpFlagOpcode = true;
-            }
-
-            fileOutReadable << std::endl;
-        }
-
-        fileOutReadable.close();
-        codeg::ConsoleInfoWrite("OK !\n");
-    }
-    catch (const codeg::CompileError& e)
-    {
-        std::string tmpPath = data._reader.getPath();
-        unsigned int tmpLine = data._reader.getlineCount();
-        if (!tmpPath.empty())
-        {
-            codeg::ConsoleErrorWrite("at file "+data._reader.getPath());
-        }
-        if (tmpLine > 0)
-        {
-            codeg::ConsoleErrorWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
-        }
-        else
-        {
-            codeg::ConsoleErrorWrite(e.what());
-        }
-        return -1;
-    }
-    catch (const codeg::FatalError& e)
-    {
-        std::string tmpPath = data._reader.getPath();
-        unsigned int tmpLine = data._reader.getlineCount();
-        if (!tmpPath.empty())
-        {
-            codeg::ConsoleFatalWrite("at file "+data._reader.getPath());
-        }
-        if (tmpLine > 0)
-        {
-            codeg::ConsoleFatalWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
-        }
-        else
-        {
-            codeg::ConsoleFatalWrite(e.what());
-        }
-        return -1;
-    }
-    catch (const codeg::SyntaxError& e)
-    {
-        std::string tmpPath = data._reader.getPath();
-        unsigned int tmpLine = data._reader.getlineCount();
-        if (!tmpPath.empty())
-        {
-            codeg::ConsoleSyntaxWrite("at file "+data._reader.getPath());
-        }
-        if (tmpLine > 0)
-        {
-            codeg::ConsoleSyntaxWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
-        }
-        else
-        {
-            codeg::ConsoleSyntaxWrite(e.what());
-        }
-        return -1;
-    }
-    catch (const std::exception& e)
-    {
-        std::string tmpPath = data._reader.getPath();
-        unsigned int tmpLine = data._reader.getlineCount();
-        if (!tmpPath.empty())
-        {
-            codeg::ConsoleFatalWrite("at file "+data._reader.getPath());
-        }
-        if (tmpLine > 0)
-        {
-            codeg::ConsoleFatalWrite("at line "+std::to_string(data._reader.getlineCount())+" : unknown exception : "+std::string(e.what()) );
-        }
-        else
-        {
-            codeg::ConsoleFatalWrite("unknown exception : "+std::string(e.what()));
-        }
-        return -1;
-    }
-
-    return 0;
-}
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "main.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stack>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "C_target.hpp"
+#include "C_value.hpp"
+#include "C_variable.hpp"
+#include "C_keyword.hpp"
+#include "C_compilerData.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+#include "C_optimizer.hpp"
+#include "C_peephole.hpp"
+#include "C_wcet.hpp"
+#include "C_sizeReport.hpp"
+#include "C_memoryMap.hpp"
+#include "C_stats.hpp"
+#include "C_trace.hpp"
+#include "C_instrument.hpp"
+
+#include "CMakeConfig.hpp"
+
+using namespace std;
+
+void printHelp()
+{
+    std::cout << "codeGGcompiler usage :" << std::endl << std::endl;
+
+    std::cout << "Set the input file to be compiled" << std::endl;
+    std::cout << "\tcodeGGcompiler --in=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the output file (default is the input path+.cg)" << std::endl;
+    std::cout << "\tcodeGGcompiler --out=<path>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGGcompiler --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGGcompiler --help" << std::endl << std::endl;
+
+    std::cout << "Ask the user how he want to compile his file (interactive compiling)" << std::endl;
+    std::cout << "\tcodeGGcompiler --ask" << std::endl << std::endl;
+
+    std::cout << "Set the optimization level (default is -O0, no optimization, -Os is -O2 that favor the code size," << std::endl;
+    std::cout << "-Oz is -Os that also move the repeated sequences in subroutines)" << std::endl;
+    std::cout << "\tcodeGGcompiler -O0|-O1|-O2|-Os|-Oz" << std::endl << std::endl;
+
+    std::cout << "Set the ALU revision used to compute constant operations (GP8B_V1, GP8B_V4)" << std::endl;
+    std::cout << "\tcodeGGcompiler --alu=<revision>" << std::endl << std::endl;
+
+    std::cout << "Variables that are never used at the same time share the same address (need -O1 or more)" << std::endl;
+    std::cout << "\tcodeGGcompiler --overlay" << std::endl << std::endl;
+
+    std::cout << "Use the execution count of the labels to place the most used variables (lines \"LABEL COUNT\", need -O2)" << std::endl;
+    std::cout << "\tcodeGGcompiler --profile=<path>" << std::endl << std::endl;
+
+    std::cout << "Load more peephole rules (one rule by line \"name : pattern => replacement [if guards]\", need -O1 or more)" << std::endl;
+    std::cout << "\tcodeGGcompiler --peephole=<path>" << std::endl << std::endl;
+
+    std::cout << "Print statistics about the compilation (time of every phase and instruction, counters, memory usage and" << std::endl;
+    std::cout << "number of times every peephole rule is applied), \"json\" also write them in \"<output>.stats.json\"" << std::endl;
+    std::cout << "\tcodeGGcompiler --stats[=json]" << std::endl << std::endl;
+
+    std::cout << "Print the best and the worst case cycles of every function and user label (the \"wcet budget\" are always checked)" << std::endl;
+    std::cout << "\tcodeGGcompiler --wcet" << std::endl << std::endl;
+
+    std::cout << "Load the cycles of the opcodes used by the WCET analysis (lines \"OPCODE CYCLES\", SKIPPED for an instruction skipped by IF/IFNOT)" << std::endl;
+    std::cout << "\tcodeGGcompiler --wcet-costs=<path>" << std::endl << std::endl;
+
+    std::cout << "Write the code size by function/definition, source line, keyword and opcode class in \"<output>.size.json\" or \"<output>.size.txt\"" << std::endl;
+    std::cout << "\tcodeGGcompiler --size-report=json|text" << std::endl << std::endl;
+
+    std::cout << "Print the code size differences with a previous JSON size report (fail when the code grow more than --size-diff-max bytes)" << std::endl;
+    std::cout << "\tcodeGGcompiler --size-diff=<path> [--size-diff-max=<bytes>]" << std::endl << std::endl;
+
+    std::cout << "Write the RAM map (pools, variables, free gaps and fragmentation) in \"<output>.memmap.json\" or \"<output>.memmap.txt\"" << std::endl;
+    std::cout << "\tcodeGGcompiler --memmap=json|text" << std::endl << std::endl;
+
+    std::cout << "Write a timeline of the compilation (steps, imported files, definitions and functions) in the Chrome trace event format" << std::endl;
+    std::cout << "\tcodeGGcompiler --trace=<path>" << std::endl << std::endl;
+
+    std::cout << "Count the executions of the function entries (functions) or also of the user labels and the conditional/switch blocks (blocks)" << std::endl;
+    std::cout << "in the RAM pool \"%%instrument\" (need --alu), the counters are described in \"<output>.instr.json\" (read a RAM dump with codeGProfile)" << std::endl;
+    std::cout << "\tcodeGGcompiler --instrument=functions|blocks [--instrument-counter=8|16] [--instrument-saturate]" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGGcompiler created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string fileInPath;
+    std::string fileOutPath;
+    std::string aluRevision;
+    std::string profilePath;
+    std::string peepholePath;
+    std::string wcetCostsPath;
+    std::string sizeReportFormat;
+    std::string sizeDiffPath;
+    int64_t sizeDiffMax = -1;
+    std::string memmapFormat;
+    std::string tracePath;
+    codeg::Instrumentation instrumentation;
+    codeg::OptimizationLevels optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_0;
+    codeg::OptimizationPolicies policy = codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SPEED;
+    bool ramOverlay = false;
+    bool outlining = false;
+    bool stats = false;
+    bool statsJson = false;
+    bool wcet = false;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    if (commands.size() <= 1)
+    {
+        printHelp();
+        return -1;
+    }
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+        if ( commands[i] == "--ask")
+        {
+            std::cout << "Please insert the input path of the file"<< std::endl <<"> ";
+            std::getline(std::cin, fileInPath);
+            continue;
+        }
+        if ( commands[i] == "-O0")
+        {
+            optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_0;
+            continue;
+        }
+        if ( commands[i] == "-O1")
+        {
+            optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1;
+            continue;
+        }
+        if ( commands[i] == "-O2")
+        {
+            optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2;
+            policy = codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SPEED;
+            continue;
+        }
+        if ( commands[i] == "--overlay")
+        {
+            ramOverlay = true;
+            continue;
+        }
+        if ( commands[i] == "--stats")
+        {
+            stats = true;
+            continue;
+        }
+        if ( commands[i] == "--wcet")
+        {
+            wcet = true;
+            continue;
+        }
+        if ( commands[i] == "--instrument-saturate")
+        {
+            instrumentation.setSaturating(true);
+            continue;
+        }
+        if ( commands[i] == "-Os")
+        {
+            optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2;
+            policy = codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SIZE;
+            continue;
+        }
+        if ( commands[i] == "-Oz")
+        {
+            optimization = codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2;
+            policy = codeg::OptimizationPolicies::OPTIMIZATION_POLICY_SIZE;
+            outlining = true;
+            continue;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--in")
+            {
+                fileInPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--out")
+            {
+                fileOutPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--alu")
+            {
+                aluRevision = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--profile")
+            {
+                profilePath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--peephole")
+            {
+                peepholePath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--wcet-costs")
+            {
+                wcetCostsPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--size-report")
+            {
+                sizeReportFormat = splitedCommand[1];
+                if ( (sizeReportFormat != "json") && (sizeReportFormat != "text") )
+                {
+                    std::cout << "Bad size report format : \""<< sizeReportFormat <<"\" (json or text) !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--stats")
+            {
+                if (splitedCommand[1] != "json")
+                {
+                    std::cout << "Bad statistics format : \""<< splitedCommand[1] <<"\" (json) !" << std::endl;
+                    return -1;
+                }
+                stats = true;
+                statsJson = true;
+                continue;
+            }
+            if ( splitedCommand[0] == "--memmap")
+            {
+                memmapFormat = splitedCommand[1];
+                if ( (memmapFormat != "json") && (memmapFormat != "text") )
+                {
+                    std::cout << "Bad memory map format : \""<< memmapFormat <<"\" (json or text) !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--trace")
+            {
+                tracePath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--instrument")
+            {
+                if ( !instrumentation.setMode(splitedCommand[1]) )
+                {
+                    std::cout << "Bad instrumentation mode : \""<< splitedCommand[1] <<"\" (functions or blocks) !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--instrument-counter")
+            {
+                uint32_t value = 0;
+                if ( (codeg::GetIntegerFromString(splitedCommand[1], value) == 0) || !instrumentation.setCounterBits(value) )
+                {
+                    std::cout << "Bad counter size : \""<< splitedCommand[1] <<"\" (8 or 16) !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--size-diff")
+            {
+                sizeDiffPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--size-diff-max")
+            {
+                uint32_t value = 0;
+                if ( codeg::GetIntegerFromString(splitedCommand[1], value) == 0 )
+                {
+                    std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                    return -1;
+                }
+                sizeDiffMax = value;
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( fileInPath.empty() )
+    {
+        std::cout << "No input file !" << std::endl;
+        return -1;
+    }
+    if ( fileOutPath.empty() )
+    {
+        fileOutPath = fileInPath+".cg";
+    }
+
+    ///Statistics
+    codeg::Statistics statistics;
+    if ( stats )
+    {
+        statistics.enable();
+    }
+    codeg::Tracer tracer;
+    if ( !tracePath.empty() )
+    {
+        tracer.enable();
+    }
+
+    ///Compiler data
+    codeg::CompilerData data;
+
+    ///Opening files
+    if ( !data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_file(fileInPath)) ) )
+    {
+        std::cout << "Can't read the file \""<< fileInPath <<"\"" << std::endl;
+        return -1;
+    }
+    data._relativePath = codeg::GetRelativePath(fileInPath);
+
+    std::ofstream fileOutBinary( fileOutPath, std::ios::binary | std::ios::trunc );
+    if ( !fileOutBinary )
+    {
+        std::cout << "Can't write the file \""<< fileOutPath <<".cg\"" << std::endl;
+        return -1;
+    }
+    std::ofstream fileOutReadable( fileInPath+".rcg", std::ios::trunc );
+    if ( !fileOutReadable )
+    {
+        std::cout << "Can't write the file \""<< fileInPath <<".rcg\"" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Input file : \""<< fileInPath <<"\"" << std::endl;
+    std::cout << "Output file : \""<< fileOutPath <<"\"" << std::endl;
+
+    ///Creating default pool
+    codeg::Pool defaultPool("global");
+    defaultPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+    defaultPool.setAddress(0x00, 0x0000);
+
+    ///Set default pool
+    data._defaultPool = "global";
+    data._pools.addPool(defaultPool);
+
+    ///Reserved keywords
+    data._reservedKeywords.pushDefaultKeywords();
+
+    ///Instructions
+    data._instructions.pushDefaultInstructions();
+
+    ///Code
+    data._code.resize(65536);
+    data._code.setOriginTracking( !sizeReportFormat.empty() || !sizeDiffPath.empty() );
+    data._optimization = optimization;
+    data._policy = policy;
+    data._ramOverlay = ramOverlay;
+    data._outlining = outlining;
+
+    if ( !aluRevision.empty() )
+    {
+        if ( !data._alu.setRevision(aluRevision) )
+        {
+            std::cout << "Unknown ALU revision : \""<< aluRevision <<"\" !" << std::endl;
+            return -1;
+        }
+    }
+    else if ( optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1 )
+    {
+        codeg::ConsoleWarningWrite("no ALU revision set (--alu=<revision>), constant operations can't be computed");
+    }
+    if ( instrumentation.isEnabled() )
+    {
+        if ( aluRevision.empty() )
+        {
+            std::cout << "The instrumentation (--instrument) need an ALU revision (--alu=<revision>) !" << std::endl;
+            return -1;
+        }
+        instrumentation.setup(data);
+    }
+    if ( ramOverlay && (optimization < codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1) )
+    {
+        codeg::ConsoleWarningWrite("the RAM overlay (--overlay) need an optimization level (-O1 or more), it will be ignored");
+    }
+
+    std::map<std::string, uint64_t> profile;
+    if ( !profilePath.empty() )
+    {
+        std::ifstream fileProfile(profilePath);
+        if ( !fileProfile )
+        {
+            std::cout << "Can't read the profile file \""<< profilePath <<"\"" << std::endl;
+            return -1;
+        }
+
+        std::string label;
+        uint64_t count;
+        while (fileProfile >> label >> count)
+        {
+            profile[label] = count;
+        }
+
+        if ( optimization < codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2 )
+        {
+            codeg::ConsoleWarningWrite("the profile (--profile) need an optimization level (-O2), it will be ignored");
+        }
+    }
+
+    codeg::Peephole peephole;
+    try
+    {
+        peephole.addDefaultRules();
+        if ( !peepholePath.empty() && !peephole.loadFromFile(peepholePath) )
+        {
+            std::cout << "Can't read the peephole rules file \""<< peepholePath <<"\"" << std::endl;
+            return -1;
+        }
+        peephole.compile();
+    }
+    catch (const codeg::SyntaxError& e)
+    {
+        std::cout << "Bad peephole rule : " << e.what() << std::endl;
+        return -1;
+    }
+
+    codeg::WcetAnalyzer wcetAnalyzer;
+    try
+    {
+        if ( !wcetCostsPath.empty() && !wcetAnalyzer.loadCosts(wcetCostsPath) )
+        {
+            std::cout << "Can't read the WCET costs file \""<< wcetCostsPath <<"\"" << std::endl;
+            return -1;
+        }
+    }
+    catch (const codeg::SyntaxError& e)
+    {
+        std::cout << "Bad WCET cost : " << e.what() << std::endl;
+        return -1;
+    }
+
+    std::string readedLine;
+
+    try
+    {
+        ///First step reading and compiling
+        codeg::ConsoleInfoWrite("Step 1 : Reading and compiling ...");
+        tracer.begin("step", "reading and compiling", data);
+
+        codeg::Statistics::Clock::time_point timeStart = statistics.now();
+        while( data._reader.getline(readedLine) )
+        {
+            statistics.addTime(codeg::StatsPhases::STATS_PHASE_READING, timeStart);
+            tracer.readLine(data);
+
+            timeStart = statistics.now();
+            data._decomposer.decompose(readedLine, data._decomposer._flags);
+            statistics.addTime(codeg::StatsPhases::STATS_PHASE_DECOMPOSING, timeStart);
+            statistics.addLine(data._decomposer._keywords.size());
+
+            if (data._decomposer._keywords.size() > 0)
+            {
+                codeg::Instruction* instruction = data._instructions.get( data._decomposer._keywords[0] );
+
+                if (instruction != nullptr)
+                {//Instruction founded
+                    timeStart = statistics.now();
+                    if ( data._writeLinesIntoDefinition )
+                    {//Compile in a definition (detect the end_def keyword)
+                        instruction->compileDefinition(data._decomposer, data);
+                    }
+                    else
+                    {//Compile
+                        codeg::Function* recordedFunction = (data._reader.getSize() == data._recordedFunctionLevel) ? data._recordedFunction : nullptr;
+                        unsigned int readerLevel = data._reader.getSize();
+                        std::size_t repeatCount = data._repeats.size();
+                        if ( data._code.getOriginTracking() )
+                        {
+                            codeg::UpdateCodeOrigin(data, data._decomposer._keywords[0]);
+                        }
+                        if ( instrumentation.isEnabled() )
+                        {
+                            instrumentation.prepare(data._decomposer, data);
+                        }
+                        instruction->compile(data._decomposer, data);
+                        if ( instrumentation.isEnabled() )
+                        {
+                            instrumentation.instrument(data._decomposer, data);
+                        }
+
+                        if ( (recordedFunction != nullptr) && (recordedFunction == data._recordedFunction) )
+                        {//Keep the line of the function body for inlining
+                            recordedFunction->addLine(data._decomposer._cleaned);
+                        }
+
+                        std::list<codeg::Repeat>::iterator itRepeat = data._repeats.begin();
+                        for (std::size_t i=0; (i<repeatCount) && (itRepeat!=data._repeats.end()); ++i, ++itRepeat)
+                        {//Keep the line of the repeated code
+                            if ( !itRepeat->_duplicated && (itRepeat->_readerLevel == readerLevel) )
+                            {
+                                itRepeat->_lines.push_back(data._decomposer._cleaned);
+                            }
+                        }
+                    }
+                    statistics.addInstructionTime(data._decomposer._keywords[0], timeStart);
+                }
+                else
+                {//Bad instruction
+                    throw codeg::FatalError("unknown instruction \""+data._decomposer._keywords[0]+"\"");
+                }
+            }
+
+            tracer.syncReader(data);
+            timeStart = statistics.now();
+        }
+        statistics.addTime(codeg::StatsPhases::STATS_PHASE_READING, timeStart);
+        tracer.syncReader(data);
+
+        data._aluState.flush(data._code); //Emit the last pending operation
+
+        if ( data._scopes.size() > 0 )
+        {//A scope is not terminated by 'end'
+            throw codeg::CompileError("scope without an 'end' (maybe at line: "+std::to_string(data._scopes.top()._startLine)+" and file: "+data._scopes.top()._startFile+")");
+        }
+
+        tracer.end(data);
+        codeg::ConsoleInfoWrite("Step 1 : OK !\n");
+        codeg::ConsoleInfoWrite("Compiled size : "+std::to_string(data._code.getCursor())+" bytes\n");
+        if ( data._aluState.getRemovedCount() > 0 )
+        {
+            codeg::ConsoleInfoWrite("Constant operations removed : "+std::to_string(data._aluState.getRemovedCount())+"\n");
+        }
+        if ( (data._forwardedReads > 0) || (data._foldedConditions > 0) )
+        {
+            codeg::ConsoleInfoWrite("Variable reads forwarded : "+std::to_string(data._forwardedReads)+", conditions folded : "+std::to_string(data._foldedConditions)+"\n");
+        }
+        if ( data._inlinedCalls > 0 )
+        {
+            codeg::ConsoleInfoWrite("Inlined calls : "+std::to_string(data._inlinedCalls)+"\n");
+        }
+        if ( !data._delays.empty() )
+        {
+            codeg::ConsoleInfoWrite("Delay loops : "+std::to_string(data._delays.size()));
+            for (auto&& vDelay : data._delays)
+            {
+                std::string guarantee = vDelay._exact ? (std::to_string(vDelay._cycles)+" cycles (cycle exact)") :
+                                        (std::to_string(vDelay._count)+" exact in "+std::to_string(vDelay._cycles)+" cycles");
+                codeg::ConsoleInfoWrite("\t"+vDelay._file+" line "+std::to_string(vDelay._line)+" : \""+vDelay._description+"\" : "+guarantee);
+            }
+            codeg::ConsoleInfoWrite("");
+        }
+
+        ///Optimizing the compiled code
+        if (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_1)
+        {
+            codeg::ConsoleInfoWrite("Optimizing ...");
+            timeStart = statistics.now();
+            tracer.begin("step", "optimizing", data);
+
+            codeg::Optimizer optimizer;
+            if ( optimizer.decode(data) )
+            {
+                uint32_t threadedJumps = optimizer.threadJumps();
+                uint32_t unreachableSize = optimizer.removeUnreachableCode();
+                uint32_t deadStores = optimizer.removeDeadStores();
+                uint32_t peepholeCount = optimizer.applyPeephole(peephole);
+                uint32_t uselessJumps = optimizer.removeUselessJumps();
+                uint32_t overlaySize = data._ramOverlay ? optimizer.computeOverlays() : 0;
+                uint32_t placedPools = 0;
+                uint32_t addressReloads = 0;
+                uint32_t hoistedSetups = 0;
+                uint32_t outlinedSize = 0;
+                uint32_t placedFunctions = 0;
+                uint32_t jumpReloads = 0;
+                if (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2)
+                {
+                    optimizer.setProfile(profile);
+                    placedPools = optimizer.placeVariables();
+                    placedFunctions = optimizer.placeFunctions();
+                    outlinedSize = data._outlining ? optimizer.outlineSequences() : 0;
+                    addressReloads = optimizer.removeAddressReloads();
+                    hoistedSetups = optimizer.hoistLoopInvariants();
+                    jumpReloads = optimizer.removeJumpReloads();
+                }
+                optimizer.encode(data);
+
+                codeg::ConsoleInfoWrite("Jumps threaded : "+std::to_string(threadedJumps)+", useless jumps removed : "+std::to_string(uselessJumps));
+                codeg::ConsoleInfoWrite("Unreachable code removed : "+std::to_string(unreachableSize)+" bytes");
+                codeg::ConsoleInfoWrite("Dead stores removed : "+std::to_string(deadStores));
+                codeg::ConsoleInfoWrite("Peephole rules applied : "+std::to_string(peepholeCount));
+                if (data._optimization >= codeg::OptimizationLevels::OPTIMIZATION_LEVEL_2)
+                {
+                    codeg::ConsoleInfoWrite("Pools reordered : "+std::to_string(placedPools)+", RAM address reloads removed : "+std::to_string(addressReloads));
+                    codeg::ConsoleInfoWrite("Loop invariant setups hoisted : "+std::to_string(hoistedSetups));
+                    codeg::ConsoleInfoWrite("Functions placed : "+std::to_string(placedFunctions)+", jump setups shortened : "+std::to_string(jumpReloads));
+                }
+                if ( data._outlining )
+                {
+                    codeg::ConsoleInfoWrite("Outlined sequences : "+std::to_string(outlinedSize)+" bytes saved");
+                }
+                if ( data._ramOverlay )
+                {
+                    codeg::ConsoleInfoWrite("RAM overlay : "+std::to_string(overlaySize)+" bytes saved");
+                    for (auto&& vPool : data._pools.getPools())
+                    {
+                        if ( !vPool.getOverlay().empty() )
+                        {
+                            codeg::ConsoleInfoWrite("\tPool \""+vPool.getName()+"\" : "+std::to_string(vPool.getVariables().size())+" variables in "+std::to_string(vPool.getSize())+" bytes");
+                        }
+                    }
+                }
+                codeg::ConsoleInfoWrite("Optimized size : "+std::to_string(data._code.getCursor())+" bytes\n");
+            }
+            else
+            {
+                codeg::ConsoleWarningWrite("the code can't be moved (\"brut\", fixed label or absolute jump), optimization skipped\n");
+            }
+            statistics.addTime(codeg::StatsPhases::STATS_PHASE_OPTIMIZING, timeStart);
+            tracer.end(data);
+        }
+
+        ///Second step resolving jumplist
+        codeg::ConsoleInfoWrite("Step 2 : Resolving jumpList ...");
+
+        timeStart = statistics.now();
+        tracer.begin("step", "resolving jumps", data);
+        data._jumps.resolve(data);
+        tracer.end(data);
+        statistics.addTime(codeg::StatsPhases::STATS_PHASE_JUMPS, timeStart);
+
+        codeg::ConsoleInfoWrite("Step 2 : OK !\n");
+
+        ///Third step resolving pools
+        codeg::ConsoleInfoWrite("Step 3 : Resolving pools ...");
+
+        timeStart = statistics.now();
+        tracer.begin("step", "resolving pools", data);
+        data._pools.resolve(data);
+        tracer.end(data);
+        statistics.addTime(codeg::StatsPhases::STATS_PHASE_POOLS, timeStart);
+
+        codeg::ConsoleInfoWrite("Step 3 : OK !\n");
+
+        timeStart = statistics.now();
+        tracer.begin("step", "reports", data);
+
+        ///Instrumentation side table
+        if ( instrumentation.isEnabled() )
+        {
+            std::string instrumentPath = fileOutPath+".instr.json";
+            codeg::ConsoleInfoWrite("Writing instrumentation table \""+instrumentPath+"\" ...");
+
+            std::ofstream fileInstrument(instrumentPath, std::ios::trunc);
+            if ( !fileInstrument )
+            {
+                throw codeg::FatalError("can't write the file \""+instrumentPath+"\"");
+            }
+            instrumentation.writeJson(data, fileInstrument);
+            codeg::ConsoleInfoWrite("Instrumentation counters : "+std::to_string(instrumentation.getCounters().size())+" of "+
+                                    std::to_string(instrumentation.getCounterSize()*8)+" bits");
+            codeg::ConsoleInfoWrite("OK !\n");
+        }
+
+        ///RAM map
+        if ( !memmapFormat.empty() )
+        {
+            codeg::MemoryMap memoryMap;
+            memoryMap.build(data._pools);
+
+            std::string memmapPath = fileOutPath+((memmapFormat == "json") ? ".memmap.json" : ".memmap.txt");
+            codeg::ConsoleInfoWrite("Writing RAM map \""+memmapPath+"\" ...");
+
+            std::ofstream fileMemmap(memmapPath, std::ios::trunc);
+            if ( !fileMemmap )
+            {
+                throw codeg::FatalError("can't write the file \""+memmapPath+"\"");
+            }
+            if (memmapFormat == "json")
+            {
+                memoryMap.writeJson(fileMemmap);
+            }
+            else
+            {
+                memoryMap.writeText(fileMemmap);
+            }
+            codeg::ConsoleInfoWrite("RAM : "+std::to_string(memoryMap.getUsedSize())+" bytes used, "+std::to_string(memoryMap.getFreeSize())+
+                                    " bytes free, largest free block "+std::to_string(memoryMap.getLargestFreeBlock())+" bytes");
+            codeg::ConsoleInfoWrite("OK !\n");
+        }
+
+        ///Static cycle analysis
+        if ( wcet || !data._cycleBudgets.empty() )
+        {
+            codeg::ConsoleInfoWrite("Analyzing cycles ...");
+
+            wcetAnalyzer.analyze(data);
+
+            if ( wcet )
+            {
+                for (auto&& vResult : wcetAnalyzer.getResults())
+                {
+                    std::string worst = (vResult._worst == CODEG_WCET_UNBOUNDED) ? ("worst unbounded ("+vResult._reason+")") :
+                                        ("worst "+std::to_string(vResult._worst)+" cycles");
+                    codeg::ConsoleInfoWrite(std::string(vResult._function ? "\tfunction " : "\tlabel ")+"\""+vResult._name+"\" : best "+
+                                            std::to_string(vResult._best)+" cycles, "+worst);
+                }
+            }
+
+            for (auto&& vBudget : data._cycleBudgets)
+            {
+                const codeg::WcetResult* result = wcetAnalyzer.getResult(vBudget._name);
+                std::string where = " (at line: "+std::to_string(vBudget._line)+" and file: "+vBudget._file+")";
+                if (result == nullptr)
+                {
+                    throw codeg::CompileError("cycle budget of \""+vBudget._name+"\" : unknown or unreachable function/label"+where);
+                }
+                if (result->_worst == CODEG_WCET_UNBOUNDED)
+                {
+                    throw codeg::CompileError("cycle budget of \""+vBudget._name+"\" : the worst case is unbounded ("+result->_reason+")"+where);
+                }
+                if (result->_worst > vBudget._cycles)
+                {
+                    throw codeg::CompileError("cycle budget of \""+vBudget._name+"\" exceeded : worst case "+std::to_string(result->_worst)+
+                                              " cycles for a budget of "+std::to_string(vBudget._cycles)+" cycles"+where);
+                }
+            }
+
+            codeg::ConsoleInfoWrite("OK !\n");
+        }
+
+        ///Code size report
+        if ( data._code.getOriginTracking() )
+        {
+            codeg::SizeReport sizeReport;
+            sizeReport.build(data);
+
+            if ( !sizeReportFormat.empty() )
+            {
+                std::string sizeReportPath = fileOutPath+((sizeReportFormat == "json") ? ".size.json" : ".size.txt");
+                codeg::ConsoleInfoWrite("Writing size report \""+sizeReportPath+"\" ...");
+
+                std::ofstream fileSizeReport(sizeReportPath, std::ios::trunc);
+                if ( !fileSizeReport )
+                {
+                    throw codeg::FatalError("can't write the file \""+sizeReportPath+"\"");
+                }
+                if (sizeReportFormat == "json")
+                {
+                    sizeReport.writeJson(fileSizeReport);
+                }
+                else
+                {
+                    sizeReport.writeText(fileSizeReport);
+                }
+                codeg::ConsoleInfoWrite("OK !\n");
+            }
+
+            if ( !sizeDiffPath.empty() )
+            {
+                codeg::SizeReport previousReport;
+                try
+                {
+                    if ( !previousReport.loadJson(sizeDiffPath) )
+                    {
+                        throw codeg::FatalError("can't read the size report \""+sizeDiffPath+"\"");
+                    }
+                }
+                catch (const codeg::SyntaxError& e)
+                {
+                    throw codeg::FatalError("bad size report \""+sizeDiffPath+"\" : "+e.what());
+                }
+
+                std::ostringstream diff;
+                int64_t growth = sizeReport.writeDiff(previousReport, diff);
+                codeg::ConsoleInfoWrite("Size differences with \""+sizeDiffPath+"\" :");
+                std::istringstream diffLines(diff.str());
+                std::string diffLine;
+                while ( std::getline(diffLines, diffLine) )
+                {
+                    codeg::ConsoleInfoWrite("\t"+diffLine);
+                }
+                codeg::ConsoleInfoWrite("");
+
+                if ( (sizeDiffMax >= 0) && (growth > sizeDiffMax) )
+                {
+                    throw codeg::CompileError("the code grew by "+std::to_string(growth)+" bytes (max is "+std::to_string(sizeDiffMax)+" bytes)");
+                }
+            }
+        }
+
+        tracer.end(data);
+        statistics.addTime(codeg::StatsPhases::STATS_PHASE_REPORTS, timeStart);
+
+        ///Writing on the output file
+        timeStart = statistics.now();
+        tracer.begin("step", "writing", data);
+        codeg::ConsoleInfoWrite("Writing codeG file (binary size : "+std::to_string(data._code.getCursor())+" bytes) ...");
+        fileOutBinary.write(reinterpret_cast<char*>(data._code.getData()), data._code.getCursor());
+        fileOutBinary.close();
+
+        codeg::ConsoleInfoWrite("Writing readable codeG file ...");
+
+        bool tmpFlagOpcode = true;
+        uint8_t* dataPtr = data._code.getData();
+        for (uint32_t i = 0; i<data._code.getCursor(); ++i)
+        {
+            fileOutReadable << "["<<codeg::ValueToHex(dataPtr[i], 2)<<"]";
+
+            if ( tmpFlagOpcode )
+            {
+                if ((dataPtr[i]&0x1F) != codeg::OPCODE_JMPSRC_CLK)
+                {//The jump instruction does not have an argument
+                    tmpFlagOpcode = false;
+                }
+                fileOutReadable << " " << ToReadableOpcode(dataPtr[i]) << " <" << ToReadableBus(dataPtr[i]) << ">";
+            }
+            else
+            {
+                tmpFlagOpcode = true;
+            }
+
+            fileOutReadable << std::endl;
+        }
+
+        fileOutReadable.close();
+        tracer.end(data);
+        statistics.addTime(codeg::StatsPhases::STATS_PHASE_WRITING, timeStart);
+        codeg::ConsoleInfoWrite("OK !\n");
+
+        ///Compilation timeline
+        if ( tracer.isEnabled() )
+        {
+            tracer.finish(data);
+            codeg::ConsoleInfoWrite("Writing trace \""+tracePath+"\" ("+std::to_string(tracer.getEventCount())+" events) ...");
+
+            std::ofstream fileTrace(tracePath, std::ios::trunc);
+            if ( !fileTrace )
+            {
+                throw codeg::FatalError("can't write the file \""+tracePath+"\"");
+            }
+            tracer.writeJson(fileTrace);
+            codeg::ConsoleInfoWrite("OK !\n");
+        }
+
+        ///Statistics
+        if ( stats )
+        {
+            statistics.collect(data, peephole);
+
+            codeg::ConsoleInfoWrite("Statistics :");
+            std::ostringstream statsText;
+            statistics.writeText(statsText);
+            std::istringstream statsLines(statsText.str());
+            std::string statsLine;
+            while ( std::getline(statsLines, statsLine) )
+            {
+                codeg::ConsoleInfoWrite("\t"+statsLine);
+            }
+
+            if ( statsJson )
+            {
+                std::string statsPath = fileOutPath+".stats.json";
+                codeg::ConsoleInfoWrite("Writing statistics \""+statsPath+"\" ...");
+
+                std::ofstream fileStats(statsPath, std::ios::trunc);
+                if ( !fileStats )
+                {
+                    throw codeg::FatalError("can't write the file \""+statsPath+"\"");
+                }
+                statistics.writeJson(fileStats);
+                codeg::ConsoleInfoWrite("OK !\n");
+            }
+        }
+    }
+    catch (const codeg::CompileError& e)
+    {
+        std::string tmpPath = data._reader.getPath();
+        unsigned int tmpLine = data._reader.getlineCount();
+        if (!tmpPath.empty())
+        {
+            codeg::ConsoleErrorWrite("at file "+data._reader.getPath());
+        }
+        if (tmpLine > 0)
+        {
+            codeg::ConsoleErrorWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
+        }
+        else
+        {
+            codeg::ConsoleErrorWrite(e.what());
+        }
+        return -1;
+    }
+    catch (const codeg::FatalError& e)
+    {
+        std::string tmpPath = data._reader.getPath();
+        unsigned int tmpLine = data._reader.getlineCount();
+        if (!tmpPath.empty())
+        {
+            codeg::ConsoleFatalWrite("at file "+data._reader.getPath());
+        }
+        if (tmpLine > 0)
+        {
+            codeg::ConsoleFatalWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
+        }
+        else
+        {
+            codeg::ConsoleFatalWrite(e.what());
+        }
+        return -1;
+    }
+    catch (const codeg::SyntaxError& e)
+    {
+        std::string tmpPath = data._reader.getPath();
+        unsigned int tmpLine = data._reader.getlineCount();
+        if (!tmpPath.empty())
+        {
+            codeg::ConsoleSyntaxWrite("at file "+data._reader.getPath());
+        }
+        if (tmpLine > 0)
+        {
+            codeg::ConsoleSyntaxWrite("at line "+std::to_string(data._reader.getlineCount())+" : "+e.what());
+        }
+        else
+        {
+            codeg::ConsoleSyntaxWrite(e.what());
+        }
+        return -1;
+    }
+    catch (const std::exception& e)
+    {
+        std::string tmpPath = data._reader.getPath();
+        unsigned int tmpLine = data._reader.getlineCount();
+        if (!tmpPath.empty())
+        {
+            codeg::ConsoleFatalWrite("at file "+data._reader.getPath());
+        }
+        if (tmpLine > 0)
+        {
+            codeg::ConsoleFatalWrite("at line "+std::to_string(data._reader.getlineCount())+" : unknown exception : "+std::string(e.what()) );
+        }
+        else
+        {
+            codeg::ConsoleFatalWrite("unknown exception : "+std::string(e.what()));
+        }
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,699 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+#include <cstdlib>
+
+#include "C_compilerData.hpp"
+#include "C_keyword.hpp"
+#include "C_value.hpp"
+#include "C_string.hpp"
+#include "C_json.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+#include "C_programGenerator.hpp"
+
+#include "CMakeConfig.hpp"
+
+struct BenchmarkResult
+{
+    std::string _name;
+    std::size_t _items; //Kernel calls by pass
+    uint64_t _passes; //Passes by sample
+    std::vector<double> _samples; //Nanoseconds by kernel call
+
+    double _median;
+    double _min;
+    double _mad; //Median absolute deviation
+};
+
+struct BenchmarkLine
+{
+    std::string _line;
+    std::string _cleaned;
+    std::vector<std::string> _keywords;
+};
+
+struct BenchmarkKeyword
+{
+    std::string _str;
+    codeg::CompilerData* _data;
+};
+
+struct BenchmarkCorpus
+{
+    std::vector<std::unique_ptr<codeg::CompilerData> > _data; //Compiled examples, needed by Keyword::process
+    std::vector<BenchmarkLine> _lines;
+
+    std::vector<std::string> _integers[4]; //Hex, binary, decimal, char
+    std::vector<BenchmarkKeyword> _keywords[codeg::KeywordTypes::KEYWORD_INSTRUCTION+1];
+    std::vector<std::string> _instructions; //First keyword of the lines
+    std::vector<std::string> _arguments; //Other keywords of the lines
+};
+
+struct ScalingResult
+{
+    uint32_t _scale;
+    uint64_t _lines; //Lines read by the compiler
+    uint32_t _codeSize;
+    double _frontEndNs; //Reading, decomposing, compiling, jumps and pools (best of the runs)
+    double _lineNs; //Front-end time by line
+};
+
+const char* ReadableIntegerTypes[]=
+{
+    "hex",
+    "binary",
+    "decimal",
+    "char"
+};
+const char* ReadableKeywordTypes[]=
+{
+    "string",
+    "name",
+    "target",
+    "bus",
+    "value",
+    "variable",
+    "constant",
+    "instruction"
+};
+
+volatile std::size_t gSink = 0; //Results of the kernels, so they can't be removed by the compiler
+
+void printHelp()
+{
+    std::cout << "codeGBench usage :" << std::endl << std::endl;
+
+    std::cout << "Add a codeG source file to the corpus (the tokens of the benchmarks are taken from it, default is example/pong)" << std::endl;
+    std::cout << "\tcodeGBench --in=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the number of timed samples of every benchmark (default is 15)" << std::endl;
+    std::cout << "\tcodeGBench --samples=<count>" << std::endl << std::endl;
+
+    std::cout << "Set the minimum duration of a sample in milliseconds (default is 5)" << std::endl;
+    std::cout << "\tcodeGBench --min-time=<ms>" << std::endl << std::endl;
+
+    std::cout << "Only run the benchmarks with a name that contain the text" << std::endl;
+    std::cout << "\tcodeGBench --filter=<text>" << std::endl << std::endl;
+
+    std::cout << "Run the end-to-end scaling benchmark instead : generated programs at 10x, 100x and 1000x sizes are compiled" << std::endl;
+    std::cout << "with the given compiler (in the working directory) and the front-end time by line must stay near-linear" << std::endl;
+    std::cout << "\tcodeGBench --scaling=<compiler path>" << std::endl << std::endl;
+
+    std::cout << "Set the maximum growth of the time by line between 2 scales in percent (default is 250)" << std::endl;
+    std::cout << "\tcodeGBench --max-growth=<percent>" << std::endl << std::endl;
+
+    std::cout << "Write the results in a JSON file" << std::endl;
+    std::cout << "\tcodeGBench --json=<path>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGBench --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGBench --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGBench created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+int GetIntegerType(const std::string& str)
+{
+    if ( (str.size() > 2) && (str[0] == '0') && (str[1] == 'x') )
+    {
+        return 0;
+    }
+    if ( (str.size() > 2) && (str[0] == '0') && (str[1] == 'b') )
+    {
+        return 1;
+    }
+    if ( !str.empty() && (str[0] == '\'') )
+    {
+        return 3;
+    }
+    return 2;
+}
+
+///Compile a source file (step 1 only) and keep its lines and tokens
+bool LoadCorpusFile(const std::string& path, BenchmarkCorpus& corpus)
+{
+    std::unique_ptr<codeg::CompilerData> dataPtr(new codeg::CompilerData());
+    codeg::CompilerData& data = *dataPtr;
+
+    if ( !data._reader.open( std::shared_ptr<codeg::ReaderData>(new codeg::ReaderData_file(path)) ) )
+    {
+        std::cout << "Can't read the file \""<< path <<"\"" << std::endl;
+        return false;
+    }
+    data._relativePath = codeg::GetRelativePath(path);
+
+    codeg::Pool defaultPool("global");
+    defaultPool.setStartAddressType(codeg::Pool::StartAddressTypes::START_ADDRESS_DYNAMIC);
+    defaultPool.setAddress(0x00, 0x0000);
+    data._defaultPool = "global";
+    data._pools.addPool(defaultPool);
+
+    data._reservedKeywords.pushDefaultKeywords();
+    data._instructions.pushDefaultInstructions();
+    data._code.resize(65536);
+
+    std::vector<BenchmarkLine> lines;
+    std::string readedLine;
+    try
+    {
+        while( data._reader.getline(readedLine) )
+        {
+            data._decomposer.decompose(readedLine, data._decomposer._flags);
+            lines.push_back({readedLine, data._decomposer._cleaned, data._decomposer._keywords});
+
+            if (data._decomposer._keywords.size() > 0)
+            {
+                codeg::Instruction* instruction = data._instructions.get( data._decomposer._keywords[0] );
+                if (instruction == nullptr)
+                {
+                    throw codeg::FatalError("unknown instruction \""+data._decomposer._keywords[0]+"\"");
+                }
+                if ( data._writeLinesIntoDefinition )
+                {
+                    instruction->compileDefinition(data._decomposer, data);
+                }
+                else
+                {
+                    instruction->compile(data._decomposer, data);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        codeg::ConsoleWarningWrite("file \""+path+"\" ignored, it can't be compiled (at line "+std::to_string(data._reader.getlineCount())+" : "+e.what()+")");
+        return false;
+    }
+
+    ///Tokens
+    for (auto&& vLine : lines)
+    {
+        for (std::size_t i=0; i<vLine._keywords.size(); ++i)
+        {
+            const std::string& keyword = vLine._keywords[i];
+            if (i == 0)
+            {
+                corpus._instructions.push_back(keyword);
+                continue;
+            }
+            corpus._arguments.push_back(keyword);
+
+            codeg::Keyword classification;
+            try
+            {
+                uint32_t value;
+                if ( codeg::GetIntegerFromString(keyword, value) > 0 )
+                {
+                    corpus._integers[GetIntegerType(keyword)].push_back(keyword);
+                }
+                classification.process(keyword, codeg::KeywordTypes::KEYWORD_NAME, data);
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+            corpus._keywords[classification._type].push_back({keyword, &data});
+        }
+    }
+
+    corpus._lines.insert(corpus._lines.end(), lines.begin(), lines.end());
+    corpus._data.push_back(std::move(dataPtr));
+    return true;
+}
+
+///Time a pass over the items of a kernel, the pass return a value that is kept in the sink
+bool RunBenchmark(const std::string& name, std::size_t items, const std::function<std::size_t()>& pass,
+                  uint32_t samples, double minTime, const std::string& filter, std::vector<BenchmarkResult>& results)
+{
+    if ( (items == 0) || (!filter.empty() && (name.find(filter) == std::string::npos)) )
+    {
+        return false;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    ///Warming up and calibrating the number of passes by sample
+    uint64_t passes = 1;
+    while (true)
+    {
+        auto start = Clock::now();
+        for (uint64_t p=0; p<passes; ++p)
+        {
+            gSink = gSink + pass();
+        }
+        double duration = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if ( (duration >= minTime) || (passes >= (uint64_t(1)<<30)) )
+        {
+            break;
+        }
+        passes = (duration <= 0.0) ? passes*10 : std::max<uint64_t>(passes+1, static_cast<uint64_t>(passes * minTime*1.2 / duration));
+    }
+
+    BenchmarkResult result;
+    result._name = name;
+    result._items = items;
+    result._passes = passes;
+
+    for (uint32_t s=0; s<samples; ++s)
+    {
+        auto start = Clock::now();
+        for (uint64_t p=0; p<passes; ++p)
+        {
+            gSink = gSink + pass();
+        }
+        double duration = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        result._samples.push_back(duration / static_cast<double>(passes*items));
+    }
+
+    std::vector<double> sorted = result._samples;
+    std::sort(sorted.begin(), sorted.end());
+    result._median = sorted[sorted.size()/2];
+    result._min = sorted.front();
+
+    std::vector<double> deviations;
+    for (double vSample : sorted)
+    {
+        deviations.push_back(std::abs(vSample - result._median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    result._mad = deviations[deviations.size()/2];
+
+    std::cout << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << result._median << " ns/call (min " << result._min << ", MAD "
+              << std::setprecision(1) << (result._median > 0.0 ? 100.0*result._mad/result._median : 0.0) << "%), "
+              << items << " calls x " << passes << " passes" << std::endl;
+
+    results.push_back(std::move(result));
+    return true;
+}
+
+bool RunScaling(const std::string& compilerPath, uint32_t scale, uint32_t runs, ScalingResult& result)
+{
+    codeg::ProgramGeneratorSettings settings;
+    settings._scale = scale;
+
+    codeg::ProgramGenerator generator;
+    generator.setSettings(settings);
+
+    std::string path = "scaling_"+std::to_string(scale);
+    if ( !generator.generate(path) )
+    {
+        std::cout << "Can't write the program \""<< path <<"\"" << std::endl;
+        return false;
+    }
+
+    result._scale = scale;
+    result._lines = 0;
+    result._codeSize = 0;
+    result._frontEndNs = 0.0;
+
+    const char* frontEndPhases[]={"reading", "decomposing", "compiling", "jumps", "pools"};
+
+    for (uint32_t r=0; r<runs; ++r)
+    {
+        std::string command = "\""+compilerPath+"\" --in=\""+path+"\" --out=\""+path+".cg\" --stats=json > \""+path+".log\" 2>&1";
+        if ( std::system(command.c_str()) != 0 )
+        {
+            std::cout << "The compilation of \""<< path <<"\" failed (see \""<< path <<".log\")" << std::endl;
+            return false;
+        }
+
+        codeg::JsonValue stats;
+        if ( !codeg::JsonValue::parseFile(path+".cg.stats.json", stats) )
+        {
+            std::cout << "Can't read the statistics of \""<< path <<"\"" << std::endl;
+            return false;
+        }
+
+        double frontEnd = 0.0;
+        for (const char* vPhase : frontEndPhases)
+        {
+            frontEnd += stats["phasesNs"][vPhase].getNumber();
+        }
+        if ( (r == 0) || (frontEnd < result._frontEndNs) )
+        {
+            result._frontEndNs = frontEnd;
+        }
+        result._lines = static_cast<uint64_t>(stats["counters"]["lines"].getNumber());
+        result._codeSize = static_cast<uint32_t>(stats["counters"]["codeSize"].getNumber());
+    }
+
+    result._lineNs = (result._lines > 0) ? result._frontEndNs / static_cast<double>(result._lines) : 0.0;
+
+    std::cout << std::right << std::setw(6) << scale << "x : " << std::setw(8) << result._lines << " lines, "
+              << std::setw(6) << result._codeSize << " bytes, " << std::fixed << std::setprecision(3)
+              << std::setw(10) << result._frontEndNs/1000000.0 << " ms, " << std::setprecision(1)
+              << std::setw(8) << result._lineNs << " ns/line" << std::endl;
+    return true;
+}
+
+void WriteScalingJson(std::ostream& stream, const std::vector<ScalingResult>& results, double maxGrowth)
+{
+    stream << "{" << std::endl;
+    stream << "  \"version\": \"" << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << "\"," << std::endl;
+    stream << "  \"maxGrowth\": " << std::fixed << std::setprecision(3) << maxGrowth << "," << std::endl;
+    stream << "  \"scales\": [";
+    for (std::size_t i=0; i<results.size(); ++i)
+    {
+        const ScalingResult& result = results[i];
+        stream << (i ? "," : "") << std::endl << "    {\"scale\": " << result._scale << ", \"lines\": " << result._lines
+               << ", \"codeSize\": " << result._codeSize << ", \"frontEndNs\": " << result._frontEndNs
+               << ", \"lineNs\": " << result._lineNs << "}";
+    }
+    stream << std::endl << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+void WriteJson(std::ostream& stream, const std::vector<BenchmarkResult>& results, uint32_t samples)
+{
+    stream << "{" << std::endl;
+    stream << "  \"version\": \"" << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << "\"," << std::endl;
+    stream << "  \"samples\": " << samples << "," << std::endl;
+    stream << "  \"benchmarks\": [";
+    for (std::size_t i=0; i<results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        stream << (i ? "," : "") << std::endl << std::fixed << std::setprecision(3)
+               << "    {\"name\": \"" << codeg::JsonEscape(result._name) << "\", \"calls\": " << result._items
+               << ", \"passes\": " << result._passes << ", \"medianNs\": " << result._median
+               << ", \"minNs\": " << result._min << ", \"madNs\": " << result._mad << "}";
+    }
+    stream << std::endl << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::vector<std::string> fileInPaths;
+    std::string jsonPath;
+    std::string filter;
+    std::string scalingCompilerPath;
+    uint32_t samples = 15;
+    uint32_t minTime = 5;
+    uint32_t maxGrowth = 250;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--in")
+            {
+                fileInPaths.push_back(splitedCommand[1]);
+                continue;
+            }
+            if ( splitedCommand[0] == "--json")
+            {
+                jsonPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--filter")
+            {
+                filter = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--scaling")
+            {
+                scalingCompilerPath = splitedCommand[1];
+                continue;
+            }
+
+            uint32_t value = 0;
+            if ( codeg::GetIntegerFromString(splitedCommand[1], value) == 0 )
+            {
+                std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                return -1;
+            }
+
+            if ( splitedCommand[0] == "--samples")
+            {
+                samples = (value > 0) ? value : 1;
+                continue;
+            }
+            if ( splitedCommand[0] == "--min-time")
+            {
+                minTime = (value > 0) ? value : 1;
+                continue;
+            }
+            if ( splitedCommand[0] == "--max-growth")
+            {
+                maxGrowth = (value > 100) ? value : 100;
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    ///Scaling
+    if ( !scalingCompilerPath.empty() )
+    {
+        const uint32_t scales[]={10, 100, 1000};
+        double growthLimit = static_cast<double>(maxGrowth)/100.0;
+
+        std::vector<ScalingResult> results;
+        for (uint32_t vScale : scales)
+        {
+            ScalingResult result;
+            if ( !RunScaling(scalingCompilerPath, vScale, 3, result) )
+            {
+                return -1;
+            }
+            results.push_back(result);
+        }
+
+        if ( !jsonPath.empty() )
+        {
+            std::ofstream fileJson(jsonPath, std::ios::trunc);
+            if ( !fileJson )
+            {
+                std::cout << "Can't write the file \""<< jsonPath <<"\"" << std::endl;
+                return -1;
+            }
+            WriteScalingJson(fileJson, results, growthLimit);
+        }
+
+        //The time by line of the small programs is dominated by the fixed costs, so it can only be smaller
+        bool linear = true;
+        for (std::size_t i=1; i<results.size(); ++i)
+        {
+            double growth = (results[i-1]._lineNs > 0.0) ? results[i]._lineNs/results[i-1]._lineNs : 0.0;
+            std::cout << "Time by line from " << results[i-1]._scale << "x to " << results[i]._scale << "x : "
+                      << std::fixed << std::setprecision(2) << growth << "x (maximum " << growthLimit << "x)" << std::endl;
+            if (growth > growthLimit)
+            {
+                linear = false;
+            }
+        }
+
+        if ( !linear )
+        {
+            std::cout << "The compilation time is not near-linear !" << std::endl;
+            return -1;
+        }
+        std::cout << "OK !" << std::endl;
+        return 0;
+    }
+
+    if ( fileInPaths.empty() )
+    {
+        fileInPaths.push_back("example/pong");
+    }
+
+    ///Corpus
+    BenchmarkCorpus corpus;
+    for (auto&& vPath : fileInPaths)
+    {
+        if ( LoadCorpusFile(vPath, corpus) )
+        {
+            std::cout << "Corpus file : \""<< vPath <<"\"" << std::endl;
+        }
+    }
+    if ( corpus._lines.empty() )
+    {
+        std::cout << "No corpus file can be compiled !" << std::endl;
+        return -1;
+    }
+
+    //Integer types that are not in the corpus
+    const char* defaultIntegers[]={"0x1F", "0b10100101", "42", "'A'"};
+    for (int i=0; i<4; ++i)
+    {
+        if ( corpus._integers[i].empty() )
+        {
+            corpus._integers[i].push_back(defaultIntegers[i]);
+        }
+    }
+
+    std::cout << "Lines : "<< corpus._lines.size() <<", instructions : "<< corpus._instructions.size()
+              <<", arguments : "<< corpus._arguments.size() << std::endl << std::endl;
+
+    ///Benchmarks
+    std::vector<BenchmarkResult> results;
+    double minTimeMs = static_cast<double>(minTime);
+
+    RunBenchmark("StringDecomposer::decompose", corpus._lines.size(), [&]()
+    {
+        codeg::StringDecomposer decomposer;
+        std::size_t count = 0;
+        for (auto&& vLine : corpus._lines)
+        {
+            decomposer.decompose(vLine._line, decomposer._flags);
+            count += decomposer._keywords.size();
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+
+    RunBenchmark("SplitKeywords", corpus._lines.size(), [&]()
+    {
+        std::vector<std::string> keywords;
+        std::size_t count = 0;
+        for (auto&& vLine : corpus._lines)
+        {
+            count += codeg::SplitKeywords(vLine._cleaned, keywords);
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+
+    RunBenchmark("GetKeywordsFromString (with the line copy)", corpus._lines.size(), [&]()
+    {
+        codeg::KeywordsList keywords;
+        std::string line;
+        std::size_t count = 0;
+        for (auto&& vLine : corpus._lines)
+        {
+            line = vLine._line;
+            count += codeg::GetKeywordsFromString(line, keywords) ? keywords.size() : 0;
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+
+    for (int i=0; i<4; ++i)
+    {
+        RunBenchmark(std::string("GetIntegerFromString (")+ReadableIntegerTypes[i]+")", corpus._integers[i].size(), [&]()
+        {
+            uint32_t value = 0;
+            std::size_t count = 0;
+            for (auto&& vInteger : corpus._integers[i])
+            {
+                count += codeg::GetIntegerFromString(vInteger, value) + value;
+            }
+            return count;
+        }, samples, minTimeMs, filter, results);
+    }
+
+    for (uint8_t i=codeg::KeywordTypes::KEYWORD_NAME; i<=codeg::KeywordTypes::KEYWORD_INSTRUCTION; ++i)
+    {
+        codeg::KeywordTypes type = static_cast<codeg::KeywordTypes>(i);
+        RunBenchmark(std::string("Keyword::process (")+ReadableKeywordTypes[i]+")", corpus._keywords[i].size(), [&]()
+        {
+            codeg::Keyword keyword;
+            std::size_t count = 0;
+            for (auto&& vKeyword : corpus._keywords[type])
+            {
+                count += keyword.process(vKeyword._str, type, *vKeyword._data) ? 1 : 0;
+            }
+            return count;
+        }, samples, minTimeMs, filter, results);
+    }
+
+    codeg::MacroList& macros = corpus._data.front()->_macros;
+    RunBenchmark("MacroList::replace", corpus._arguments.size(), [&]()
+    {
+        std::string str;
+        std::size_t count = 0;
+        for (auto&& vArgument : corpus._arguments)
+        {
+            str = vArgument;
+            count += macros.replace(str) ? 1 : 0;
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+
+    const codeg::InstructionList& instructions = corpus._data.front()->_instructions;
+    RunBenchmark("InstructionList::get (instructions)", corpus._instructions.size(), [&]()
+    {
+        std::size_t count = 0;
+        for (auto&& vInstruction : corpus._instructions)
+        {
+            count += (instructions.get(vInstruction) != nullptr) ? 1 : 0;
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+    RunBenchmark("InstructionList::get (arguments)", corpus._arguments.size(), [&]()
+    {
+        std::size_t count = 0;
+        for (auto&& vArgument : corpus._arguments)
+        {
+            count += (instructions.get(vArgument) != nullptr) ? 1 : 0;
+        }
+        return count;
+    }, samples, minTimeMs, filter, results);
+
+    if ( !jsonPath.empty() )
+    {
+        std::ofstream fileJson(jsonPath, std::ios::trunc);
+        if ( !fileJson )
+        {
+            std::cout << "Can't write the file \""<< jsonPath <<"\"" << std::endl;
+            return -1;
+        }
+        WriteJson(fileJson, results, samples);
+        std::cout << std::endl << "Results written in \""<< jsonPath <<"\"" << std::endl;
+    }
+
+    std::cout << "OK !" << std::endl;
+    return 0;
+}
@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "C_programGenerator.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+
+#include "CMakeConfig.hpp"
+
+void printHelp()
+{
+    std::cout << "codeGGen usage :" << std::endl << std::endl;
+
+    std::cout << "Set the path of the generated main file (the imported files are \"<path>.lib<index>\")" << std::endl;
+    std::cout << "\tcodeGGen --out=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the seed of the random numbers (default is 1), the same seed always generate the same program" << std::endl;
+    std::cout << "\tcodeGGen --seed=<value>" << std::endl << std::endl;
+
+    std::cout << "Multiply every count except the if nesting and the variables by pool (default is 1)" << std::endl;
+    std::cout << "\tcodeGGen --scale=<value>" << std::endl << std::endl;
+
+    std::cout << "Set the counts of the generated program (defaults are 6 statements, 1 label, 2 nested if, 1 pool of 4 variables," << std::endl;
+    std::cout << "1 import, 1 definition and 1 call)" << std::endl;
+    std::cout << "\tcodeGGen --statements=<count> --labels=<count> --if-depth=<count> --pools=<count> --variables=<count>" << std::endl;
+    std::cout << "\t         --imports=<count> --definitions=<count> --calls=<count>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGGen --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGGen --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGGen created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string fileOutPath;
+    codeg::ProgramGeneratorSettings settings;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    if (commands.size() <= 1)
+    {
+        printHelp();
+        return -1;
+    }
+
+    const std::pair<const char*, uint32_t*> counts[]=
+    {
+        {"--seed", &settings._seed},
+        {"--scale", &settings._scale},
+        {"--statements", &settings._statements},
+        {"--labels", &settings._labels},
+        {"--if-depth", &settings._ifDepth},
+        {"--pools", &settings._pools},
+        {"--variables", &settings._variablesPerPool},
+        {"--imports", &settings._imports},
+        {"--definitions", &settings._definitions},
+        {"--calls", &settings._calls}
+    };
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--out")
+            {
+                fileOutPath = splitedCommand[1];
+                continue;
+            }
+
+            bool found = false;
+            for (auto&& vCount : counts)
+            {
+                if ( splitedCommand[0] == vCount.first )
+                {
+                    uint32_t value = 0;
+                    try
+                    {
+                        if ( codeg::GetIntegerFromString(splitedCommand[1], value) == 0 )
+                        {
+                            throw codeg::SyntaxError("not a value");
+                        }
+                    }
+                    catch (const codeg::SyntaxError&)
+                    {
+                        std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                        return -1;
+                    }
+                    *vCount.second = value;
+                    found = true;
+                    break;
+                }
+            }
+            if ( found )
+            {
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( fileOutPath.empty() )
+    {
+        std::cout << "No output file !" << std::endl;
+        return -1;
+    }
+
+    codeg::ProgramGenerator generator;
+    generator.setSettings(settings);
+    if ( !generator.generate(fileOutPath) )
+    {
+        std::cout << "Can't write the file \""<< fileOutPath <<"\" (or an imported file)" << std::endl;
+        return -1;
+    }
+
+    for (auto&& vFile : generator.getFiles())
+    {
+        std::cout << "Generated file : \""<< vFile <<"\"" << std::endl;
+    }
+    std::cout << "Lines : "<< generator.getLineCount() << std::endl;
+    std::cout << "OK !" << std::endl;
+    return 0;
+}
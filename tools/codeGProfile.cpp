@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+
+#include "C_json.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+
+#include "CMakeConfig.hpp"
+
+struct ProfileCounter
+{
+    std::string _kind;
+    std::string _name;
+    std::string _function; //Empty for the main code
+    std::string _file;
+    unsigned int _line;
+    uint32_t _count;
+    bool _saturated;
+};
+
+struct ProfileFunction
+{
+    std::string _name;
+    uint64_t _entries = 0; //Counters of the function entries
+    uint64_t _hits = 0; //All the counters of the function
+    std::vector<const ProfileCounter*> _counters;
+};
+
+void printHelp()
+{
+    std::cout << "codeGProfile usage :" << std::endl << std::endl;
+
+    std::cout << "Set the instrumentation table written by the compiler (--instrument, \"<output>.instr.json\")" << std::endl;
+    std::cout << "\tcodeGProfile --table=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the RAM dump of the target (a binary file, the first byte is at --dump-start, default is 0)" << std::endl;
+    std::cout << "\tcodeGProfile --dump=<path> [--dump-start=<address>]" << std::endl << std::endl;
+
+    std::cout << "Set the number of hot spots printed for every function (default is 5)" << std::endl;
+    std::cout << "\tcodeGProfile --top=<count>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGProfile --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGProfile --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGProfile created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+bool ReadCounter(const std::vector<uint8_t>& dump, uint32_t dumpStart, const codeg::JsonValue& address, uint8_t& value)
+{
+    uint32_t a = static_cast<uint32_t>(address.getNumber());
+    if ( address.isNull() || (a < dumpStart) || (a-dumpStart >= dump.size()) )
+    {
+        return false;
+    }
+    value = dump[a-dumpStart];
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string tablePath;
+    std::string dumpPath;
+    uint32_t dumpStart = 0;
+    uint32_t top = 5;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    if (commands.size() <= 1)
+    {
+        printHelp();
+        return -1;
+    }
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--table")
+            {
+                tablePath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--dump")
+            {
+                dumpPath = splitedCommand[1];
+                continue;
+            }
+
+            uint32_t value = 0;
+            if ( codeg::GetIntegerFromString(splitedCommand[1], value) == 0 )
+            {
+                std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                return -1;
+            }
+
+            if ( splitedCommand[0] == "--dump-start")
+            {
+                dumpStart = value;
+                continue;
+            }
+            if ( splitedCommand[0] == "--top")
+            {
+                top = value;
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( tablePath.empty() || dumpPath.empty() )
+    {
+        std::cout << "No instrumentation table or RAM dump (--table=<path> --dump=<path>) !" << std::endl;
+        return -1;
+    }
+
+    codeg::JsonValue table;
+    try
+    {
+        if ( !codeg::JsonValue::parseFile(tablePath, table) )
+        {
+            std::cout << "Can't read the instrumentation table \""<< tablePath <<"\"" << std::endl;
+            return -1;
+        }
+    }
+    catch (const codeg::SyntaxError& e)
+    {
+        std::cout << "Bad instrumentation table : " << e.what() << std::endl;
+        return -1;
+    }
+
+    std::ifstream fileDump(dumpPath, std::ios::binary);
+    if ( !fileDump )
+    {
+        std::cout << "Can't read the RAM dump \""<< dumpPath <<"\"" << std::endl;
+        return -1;
+    }
+    std::vector<uint8_t> dump( (std::istreambuf_iterator<char>(fileDump)), std::istreambuf_iterator<char>() );
+
+    unsigned int counterSize = static_cast<unsigned int>(table["counterSize"].getNumber());
+    bool saturating = table["saturating"].getBool();
+    uint32_t maxCount = (counterSize == 2) ? 0xFFFF : 0xFF;
+
+    ///Reading the counters
+    std::vector<ProfileCounter> counters;
+    const codeg::JsonValue& tableCounters = table["counters"];
+    counters.reserve(tableCounters.size());
+    for (std::size_t i=0; i<tableCounters.size(); ++i)
+    {
+        const codeg::JsonValue& vCounter = tableCounters[i];
+
+        uint8_t low = 0;
+        uint8_t high = 0;
+        if ( !ReadCounter(dump, dumpStart, vCounter["address"], low) ||
+             ((counterSize == 2) && !ReadCounter(dump, dumpStart, vCounter["addressHigh"], high)) )
+        {
+            std::cout << "The counter "<< i <<" is not in the RAM dump !" << std::endl;
+            return -1;
+        }
+
+        ProfileCounter counter;
+        counter._kind = vCounter["kind"].getString();
+        counter._name = vCounter["name"].getString();
+        counter._function = vCounter["function"].getString();
+        counter._file = vCounter["file"].getString();
+        counter._line = static_cast<unsigned int>(vCounter["line"].getNumber());
+        counter._count = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high)<<8);
+        counter._saturated = saturating && (counter._count == maxCount);
+        counters.push_back(std::move(counter));
+    }
+
+    ///By function
+    std::map<std::string, ProfileFunction> functions;
+    uint64_t totalHits = 0;
+    uint32_t saturatedCount = 0;
+    for (auto&& vCounter : counters)
+    {
+        ProfileFunction& function = functions[vCounter._function];
+        function._name = vCounter._function;
+        if ( (vCounter._kind == "function") && (vCounter._name == vCounter._function) )
+        {
+            function._entries += vCounter._count;
+        }
+        function._hits += vCounter._count;
+        function._counters.push_back(&vCounter);
+
+        totalHits += vCounter._count;
+        saturatedCount += vCounter._saturated ? 1 : 0;
+    }
+
+    std::vector<ProfileFunction*> sortedFunctions;
+    for (auto&& vFunction : functions)
+    {
+        sortedFunctions.push_back(&vFunction.second);
+        std::stable_sort(vFunction.second._counters.begin(), vFunction.second._counters.end(), [](const ProfileCounter* a, const ProfileCounter* b)
+        {
+            return a->_count > b->_count;
+        });
+    }
+    std::stable_sort(sortedFunctions.begin(), sortedFunctions.end(), [](const ProfileFunction* a, const ProfileFunction* b)
+    {
+        return a->_hits > b->_hits;
+    });
+
+    ///Report
+    std::cout << "Instrumentation : "<< table["mode"].getString() <<", "<< counters.size() <<" counters of "<< counterSize*8
+              <<" bits ("<< (saturating ? "saturating" : "wrapping") <<")" << std::endl;
+    std::cout << "Counted executions : "<< totalHits << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(24) << "function" << std::right << std::setw(12) << "entries" << std::setw(12) << "hits"
+              << std::setw(9) << "share" << std::endl;
+    for (auto&& vFunction : sortedFunctions)
+    {
+        double share = (totalHits > 0) ? (100.0 * static_cast<double>(vFunction->_hits) / static_cast<double>(totalHits)) : 0.0;
+        std::cout << std::left << std::setw(24) << (vFunction->_name.empty() ? "(main)" : vFunction->_name) << std::right
+                  << std::setw(12) << vFunction->_entries << std::setw(12) << vFunction->_hits
+                  << std::setw(8) << std::fixed << std::setprecision(2) << share << "%" << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Hot spots :" << std::endl;
+    for (auto&& vFunction : sortedFunctions)
+    {
+        if (vFunction->_hits == 0)
+        {
+            continue;
+        }
+        std::cout << "\t" << (vFunction->_name.empty() ? "(main)" : vFunction->_name) << " :" << std::endl;
+        for (std::size_t i=0; (i<vFunction->_counters.size()) && (i<top); ++i)
+        {
+            const ProfileCounter* counter = vFunction->_counters[i];
+            if (counter->_count == 0)
+            {
+                break;
+            }
+            std::cout << "\t\t" << std::setw(8) << counter->_count << (counter->_saturated ? "+" : " ") << " " << counter->_kind
+                      << " \"" << counter->_name << "\" (" << counter->_file << " line " << counter->_line << ")" << std::endl;
+        }
+    }
+
+    if (saturatedCount > 0)
+    {
+        codeg::ConsoleWarningWrite(std::to_string(saturatedCount)+" counters are saturated (+), the real count is bigger");
+    }
+    else if ( !saturating )
+    {
+        codeg::ConsoleInfoWrite("the counters are wrapping, a count is modulo "+std::to_string(maxCount+1));
+    }
+
+    if (totalHits == 0)
+    {
+        codeg::ConsoleErrorWrite("no counter was incremented (bad RAM dump or table ?)");
+        return -1;
+    }
+    return 0;
+}
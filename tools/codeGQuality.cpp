@@ -0,0 +1,481 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdlib>
+
+#include "C_sizeReport.hpp"
+#include "C_simulator.hpp"
+#include "C_programGenerator.hpp"
+#include "C_json.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+
+#include "CMakeConfig.hpp"
+
+struct QualityProgram
+{
+    std::string _name;
+    std::string _source; //Path or "generated:<scale>:<seed>"
+    uint32_t _maxInstructions;
+    std::vector<std::string> _arguments; //Compiler arguments
+};
+
+struct QualityMetrics
+{
+    uint32_t _size = 0;
+    uint32_t _classes[codeg::SizeClasses::SIZE_CLASS_COUNT] = {0};
+    uint64_t _cycles = 0;
+    uint64_t _instructions = 0;
+    std::string _stop;
+};
+
+void printHelp()
+{
+    std::cout << "codeGQuality usage :" << std::endl << std::endl;
+
+    std::cout << "Set the compiler that build the programs of the corpus (needed)" << std::endl;
+    std::cout << "\tcodeGQuality --compiler=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the corpus file (default is example/quality_corpus), every line is a program :" << std::endl;
+    std::cout << "<name> <source> <max instructions> <compiler arguments ...>, the source is relative to the corpus file" << std::endl;
+    std::cout << "or \"generated:<scale>:<seed>\" for a program of codeGGen" << std::endl;
+    std::cout << "\tcodeGQuality --corpus=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the baselines file (default is example/quality_baselines.json)" << std::endl;
+    std::cout << "\tcodeGQuality --baselines=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the maximum growth of the size and of the cycles in percent (default is 1)" << std::endl;
+    std::cout << "\tcodeGQuality --threshold=<percent>" << std::endl << std::endl;
+
+    std::cout << "Write the measures in the baselines file instead of checking them (accept an intentional change)" << std::endl;
+    std::cout << "\tcodeGQuality --update" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGQuality --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGQuality --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGQuality created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+bool LoadCorpus(const std::string& path, std::vector<QualityProgram>& programs)
+{
+    std::ifstream file(path);
+    if ( !file )
+    {
+        return false;
+    }
+
+    std::string directory;
+    std::size_t separator = path.find_last_of("/\\");
+    if (separator != std::string::npos)
+    {
+        directory = path.substr(0, separator+1);
+    }
+
+    std::string line;
+    unsigned int lineCount = 0;
+    while ( std::getline(file, line) )
+    {
+        ++lineCount;
+        if ( !line.empty() && (line.back() == '\r') )
+        {
+            line.pop_back();
+        }
+
+        std::istringstream lineStream(line);
+        QualityProgram program;
+        std::string maxInstructions;
+        if ( !(lineStream >> program._name) || (program._name[0] == '#') )
+        {//Empty line or comment
+            continue;
+        }
+        if ( !(lineStream >> program._source >> maxInstructions) )
+        {
+            throw codeg::SyntaxError("corpus : bad line "+std::to_string(lineCount)+" (wanted <name> <source> <max instructions> ...)");
+        }
+        if ( codeg::GetIntegerFromString(maxInstructions, program._maxInstructions) == 0 )
+        {
+            throw codeg::SyntaxError("corpus : bad maximum of instructions at line "+std::to_string(lineCount));
+        }
+        if (program._source.compare(0, 10, "generated:") != 0)
+        {
+            program._source = directory + program._source;
+        }
+
+        std::string argument;
+        while (lineStream >> argument)
+        {
+            program._arguments.push_back(argument);
+        }
+        programs.push_back(std::move(program));
+    }
+    return true;
+}
+
+bool MeasureProgram(const std::string& compilerPath, const QualityProgram& program, QualityMetrics& metrics)
+{
+    std::string sourcePath = program._source;
+
+    if (sourcePath.compare(0, 10, "generated:") == 0)
+    {//Synthetic workload
+        std::vector<std::string> values;
+        codeg::Split(sourcePath, values, ':');
+
+        codeg::ProgramGeneratorSettings settings;
+        if ( (values.size() != 3) || (codeg::GetIntegerFromString(values[1], settings._scale) == 0) ||
+             (codeg::GetIntegerFromString(values[2], settings._seed) == 0) )
+        {
+            std::cout << "Bad generated source : \""<< sourcePath <<"\"" << std::endl;
+            return false;
+        }
+
+        codeg::ProgramGenerator generator;
+        generator.setSettings(settings);
+        sourcePath = "quality_"+program._name;
+        if ( !generator.generate(sourcePath) )
+        {
+            std::cout << "Can't write the program \""<< sourcePath <<"\"" << std::endl;
+            return false;
+        }
+    }
+
+    ///Compiling
+    std::string outPath = "quality_"+program._name+".cg";
+    std::string aluRevision = "GP8B_V1";
+    std::string command = "\""+compilerPath+"\" --in=\""+sourcePath+"\" --out=\""+outPath+"\"";
+    for (auto&& vArgument : program._arguments)
+    {
+        command += " "+vArgument;
+        if (vArgument.compare(0, 6, "--alu=") == 0)
+        {
+            aluRevision = vArgument.substr(6);
+        }
+    }
+    command += " --size-report=json > \""+outPath+".log\" 2>&1";
+
+    if ( std::system(command.c_str()) != 0 )
+    {
+        std::cout << "The compilation of \""<< program._name <<"\" failed (see \""<< outPath <<".log\")" << std::endl;
+        return false;
+    }
+
+    codeg::SizeReport report;
+    if ( !report.loadJson(outPath+".size.json") )
+    {
+        std::cout << "Can't read the size report of \""<< program._name <<"\"" << std::endl;
+        return false;
+    }
+    metrics._size = report.getTotal();
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        metrics._classes[i] = report.getClasses()._classes[i];
+    }
+
+    ///Simulating
+    codeg::Alu alu;
+    if ( !alu.setRevision(aluRevision) )
+    {
+        std::cout << "Unknown ALU revision : \""<< aluRevision <<"\" !" << std::endl;
+        return false;
+    }
+
+    codeg::Simulator simulator;
+    simulator.setAlu(alu);
+    if ( !simulator.loadFromFile(outPath) )
+    {
+        std::cout << "Can't simulate \""<< outPath <<"\"" << std::endl;
+        return false;
+    }
+
+    codeg::SimulatorStops stop = simulator.run(program._maxInstructions);
+    metrics._cycles = simulator.getCounters()._cycles;
+    metrics._instructions = simulator.getCounters()._instructions;
+    metrics._stop = codeg::ReadableStringSimulatorStops[stop];
+
+    if ( (stop == codeg::SimulatorStops::SIMULATOR_STOP_BAD_JUMP) || (stop == codeg::SimulatorStops::SIMULATOR_STOP_UNKNOWN_OPCODE) )
+    {
+        std::cout << "The execution of \""<< program._name <<"\" stopped on a "<< metrics._stop << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ReadMetrics(const codeg::JsonValue& value, QualityMetrics& metrics)
+{
+    metrics._size = static_cast<uint32_t>(value["size"].getNumber());
+    for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+    {
+        metrics._classes[i] = static_cast<uint32_t>(value["classes"][codeg::ReadableStringSizeClasses[i]].getNumber());
+    }
+    metrics._cycles = static_cast<uint64_t>(value["cycles"].getNumber());
+    metrics._instructions = static_cast<uint64_t>(value["instructions"].getNumber());
+    metrics._stop = value["stop"].getString();
+}
+
+void WriteBaselines(std::ostream& stream, const std::map<std::string, QualityMetrics>& measures)
+{
+    stream << "{" << std::endl;
+    stream << "  \"version\": \"" << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << "\"," << std::endl;
+    stream << "  \"programs\": {";
+    bool first = true;
+    for (auto&& vMeasure : measures)
+    {
+        const QualityMetrics& metrics = vMeasure.second;
+        stream << (first ? "" : ",") << std::endl << "    \"" << codeg::JsonEscape(vMeasure.first) << "\": {\"size\": " << metrics._size
+               << ", \"classes\": {";
+        for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+        {
+            stream << (i ? ", " : "") << "\"" << codeg::ReadableStringSizeClasses[i] << "\": " << metrics._classes[i];
+        }
+        stream << "}, \"cycles\": " << metrics._cycles << ", \"instructions\": " << metrics._instructions
+               << ", \"stop\": \"" << codeg::JsonEscape(metrics._stop) << "\"}";
+        first = false;
+    }
+    stream << std::endl << "  }" << std::endl;
+    stream << "}" << std::endl;
+}
+
+double GetGrowth(uint64_t baseline, uint64_t value)
+{
+    if (baseline == 0)
+    {
+        return (value == 0) ? 0.0 : 100.0;
+    }
+    return 100.0 * (static_cast<double>(value) - static_cast<double>(baseline)) / static_cast<double>(baseline);
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string compilerPath;
+    std::string corpusPath = "example/quality_corpus";
+    std::string baselinesPath = "example/quality_baselines.json";
+    uint32_t threshold = 1;
+    bool update = false;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    if (commands.size() <= 1)
+    {
+        printHelp();
+        return -1;
+    }
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+        if ( commands[i] == "--update")
+        {
+            update = true;
+            continue;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--compiler")
+            {
+                compilerPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--corpus")
+            {
+                corpusPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--baselines")
+            {
+                baselinesPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--threshold")
+            {
+                try
+                {
+                    if ( codeg::GetIntegerFromString(splitedCommand[1], threshold) == 0 )
+                    {
+                        throw codeg::SyntaxError("not a value");
+                    }
+                }
+                catch (const codeg::SyntaxError&)
+                {
+                    std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( compilerPath.empty() )
+    {
+        std::cout << "No compiler !" << std::endl;
+        return -1;
+    }
+
+    std::vector<QualityProgram> programs;
+    std::map<std::string, QualityMetrics> measures;
+    std::map<std::string, QualityMetrics> baselines;
+
+    try
+    {
+        if ( !LoadCorpus(corpusPath, programs) )
+        {
+            std::cout << "Can't read the corpus \""<< corpusPath <<"\"" << std::endl;
+            return -1;
+        }
+
+        if ( !update )
+        {
+            codeg::JsonValue document;
+            if ( !codeg::JsonValue::parseFile(baselinesPath, document) )
+            {
+                std::cout << "Can't read the baselines \""<< baselinesPath <<"\" (write them with --update)" << std::endl;
+                return -1;
+            }
+            for (auto&& vProgram : document["programs"].getMembers())
+            {
+                ReadMetrics(vProgram.second, baselines[vProgram.first]);
+            }
+        }
+
+        for (auto&& vProgram : programs)
+        {
+            if ( !MeasureProgram(compilerPath, vProgram, measures[vProgram._name]) )
+            {
+                return -1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+
+    if ( update )
+    {
+        std::ofstream fileBaselines(baselinesPath, std::ios::trunc);
+        if ( !fileBaselines )
+        {
+            std::cout << "Can't write the file \""<< baselinesPath <<"\"" << std::endl;
+            return -1;
+        }
+        WriteBaselines(fileBaselines, measures);
+        std::cout << measures.size() << " baselines written in \""<< baselinesPath <<"\"" << std::endl;
+        std::cout << "OK !" << std::endl;
+        return 0;
+    }
+
+    ///Checking
+    bool regression = false;
+    bool changed = false;
+    for (auto&& vProgram : programs)
+    {
+        const QualityMetrics& metrics = measures[vProgram._name];
+
+        std::cout << std::left << std::setw(20) << vProgram._name << std::right;
+
+        std::map<std::string, QualityMetrics>::const_iterator itBaseline = baselines.find(vProgram._name);
+        if (itBaseline == baselines.end())
+        {
+            std::cout << " no baseline (write it with --update)" << std::endl;
+            regression = true;
+            continue;
+        }
+        const QualityMetrics& baseline = itBaseline->second;
+
+        double sizeGrowth = GetGrowth(baseline._size, metrics._size);
+        double cycleGrowth = GetGrowth(baseline._cycles, metrics._cycles);
+
+        std::cout << std::setw(6) << metrics._size << " bytes (" << std::showpos << std::fixed << std::setprecision(2)
+                  << sizeGrowth << "%), " << std::noshowpos << std::setw(10) << metrics._cycles << " cycles (" << std::showpos
+                  << cycleGrowth << "%)" << std::noshowpos;
+
+        bool failed = false;
+        if ( (sizeGrowth > threshold) || (cycleGrowth > threshold) )
+        {
+            std::cout << " REGRESSION";
+            failed = true;
+        }
+        if (metrics._stop != baseline._stop)
+        {
+            std::cout << " stopped on \"" << metrics._stop << "\" (baseline \"" << baseline._stop << "\")";
+            failed = true;
+        }
+        std::cout << std::endl;
+
+        if ( (metrics._size != baseline._size) || (metrics._cycles != baseline._cycles) )
+        {
+            for (uint8_t i=0; i<codeg::SizeClasses::SIZE_CLASS_COUNT; ++i)
+            {
+                if (metrics._classes[i] != baseline._classes[i])
+                {
+                    std::cout << "\t" << codeg::ReadableStringSizeClasses[i] << " : " << baseline._classes[i]
+                              << " -> " << metrics._classes[i] << " bytes" << std::endl;
+                }
+            }
+            changed = changed || !failed;
+        }
+        regression = regression || failed;
+    }
+
+    if ( regression )
+    {
+        std::cout << "The output quality regressed (more than " << threshold << "%), accept an intentional change with --update" << std::endl;
+        return -1;
+    }
+    if ( changed )
+    {
+        std::cout << "Some programs changed, the baselines can be updated with --update" << std::endl;
+    }
+    std::cout << "OK !" << std::endl;
+    return 0;
+}
@@ -0,0 +1,289 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#include "C_simulator.hpp"
+#include "C_alu.hpp"
+#include "C_readableBus.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_console.hpp"
+
+#include "CMakeConfig.hpp"
+
+void printHelp()
+{
+    std::cout << "codeGSim usage :" << std::endl << std::endl;
+
+    std::cout << "Set the codeG binary to be executed" << std::endl;
+    std::cout << "\tcodeGSim --in=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the maximum number of executed instructions (default is 100000000)" << std::endl;
+    std::cout << "\tcodeGSim --max=<count>" << std::endl << std::endl;
+
+    std::cout << "Set the ALU revision (GP8B_V1, GP8B_V4, default is GP8B_V1)" << std::endl;
+    std::cout << "\tcodeGSim --alu=<revision>" << std::endl << std::endl;
+
+    std::cout << "Every instruction have an argument byte (the binary is written with dummy bytes)" << std::endl;
+    std::cout << "\tcodeGSim --dummy" << std::endl << std::endl;
+
+    std::cout << "Set the constant value read on an external bus" << std::endl;
+    std::cout << "\tcodeGSim --bread1=<value> --bread2=<value> --spi=<value> --ext1=<value> --ext2=<value>" << std::endl << std::endl;
+
+    std::cout << "Execute the binary multiple times and print the simulated instructions per second" << std::endl;
+    std::cout << "\tcodeGSim --benchmark[=<runs>]" << std::endl << std::endl;
+
+    std::cout << "Fail when the benchmark is slower than a number of millions of instructions per second" << std::endl;
+    std::cout << "\tcodeGSim --min-rate=<count>" << std::endl << std::endl;
+
+    std::cout << "Write the 64KB of RAM at the end of the execution (read the instrumentation counters with codeGProfile)" << std::endl;
+    std::cout << "\tcodeGSim --ram-dump=<path>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGSim --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGSim --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGSim created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string fileInPath;
+    std::string aluRevision = "GP8B_V1";
+    std::string ramDumpPath;
+    uint64_t maxInstructions = 100000000;
+    bool writeDummy = false;
+    uint32_t benchmarkRuns = 0;
+    uint32_t minRate = 0;
+
+    codeg::Simulator simulator;
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    if (commands.size() <= 1)
+    {
+        printHelp();
+        return -1;
+    }
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+        if ( commands[i] == "--dummy")
+        {
+            writeDummy = true;
+            continue;
+        }
+        if ( commands[i] == "--benchmark")
+        {
+            benchmarkRuns = 5;
+            continue;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--in")
+            {
+                fileInPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--alu")
+            {
+                aluRevision = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--ram-dump")
+            {
+                ramDumpPath = splitedCommand[1];
+                continue;
+            }
+
+            uint32_t value = 0;
+            if ( codeg::GetIntegerFromString(splitedCommand[1], value) == 0 )
+            {
+                std::cout << "Bad value : \""<< commands[i] <<"\" !" << std::endl;
+                return -1;
+            }
+
+            if ( splitedCommand[0] == "--max")
+            {
+                maxInstructions = (value > 0) ? value : 1;
+                continue;
+            }
+            if ( splitedCommand[0] == "--benchmark")
+            {
+                benchmarkRuns = (value > 0) ? value : 1;
+                continue;
+            }
+            if ( splitedCommand[0] == "--min-rate")
+            {
+                minRate = value;
+                continue;
+            }
+
+            const std::pair<const char*, codeg::ReadableBusses> inputs[]=
+            {
+                {"--bread1", codeg::ReadableBusses::READABLE_BREAD1},
+                {"--bread2", codeg::ReadableBusses::READABLE_BREAD2},
+                {"--spi", codeg::ReadableBusses::READABLE_SPI},
+                {"--ext1", codeg::ReadableBusses::READABLE_EXT1},
+                {"--ext2", codeg::ReadableBusses::READABLE_EXT2}
+            };
+            auto it = std::find_if(std::begin(inputs), std::end(inputs), [&](const std::pair<const char*, codeg::ReadableBusses>& input)
+            {
+                return splitedCommand[0] == input.first;
+            });
+            if ( it != std::end(inputs) )
+            {
+                simulator.setInput(it->second, static_cast<uint8_t>(value));
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( fileInPath.empty() )
+    {
+        std::cout << "No input file !" << std::endl;
+        return -1;
+    }
+
+    codeg::Alu alu;
+    if ( !alu.setRevision(aluRevision) )
+    {
+        std::cout << "Unknown ALU revision : \""<< aluRevision <<"\" !" << std::endl;
+        return -1;
+    }
+    simulator.setAlu(alu);
+
+    if ( !simulator.loadFromFile(fileInPath, writeDummy) )
+    {
+        std::cout << "Can't read the file \""<< fileInPath <<"\" (or the last instruction is truncated)" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Input file : \""<< fileInPath <<"\"" << std::endl;
+    std::cout << "Instructions : "<< simulator.getInstructionCount() << std::endl;
+
+    ///Executing
+    uint32_t runs = (benchmarkRuns > 0) ? benchmarkRuns : 1;
+    std::vector<double> rates;
+    codeg::SimulatorStops stop = codeg::SimulatorStops::SIMULATOR_STOP_END;
+
+    for (uint32_t r=0; r<runs; ++r)
+    {
+        simulator.reset();
+
+        auto start = std::chrono::steady_clock::now();
+        stop = simulator.run(maxInstructions);
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        if (duration.count() > 0.0)
+        {
+            rates.push_back(static_cast<double>(simulator.getCounters()._instructions) / duration.count() / 1000000.0);
+        }
+    }
+
+    const codeg::SimulatorCounters& counters = simulator.getCounters();
+    const codeg::SimulatorRegisters& registers = simulator.getRegisters();
+
+    std::cout << "Stopped : "<< codeg::ReadableStringSimulatorStops[stop] <<" (at address "<< registers._address <<")" << std::endl;
+    std::cout << "Executed instructions : "<< counters._instructions <<", skipped : "<< counters._skipped << std::endl;
+    std::cout << "Cycles : "<< counters._cycles <<", jumps : "<< counters._jumps << std::endl;
+    std::cout << "Bus writes : "<< counters._writes1 <<" (BWRITE1, last "<< static_cast<unsigned int>(registers._bus1) <<"), "
+                                  << counters._writes2 <<" (BWRITE2, last "<< static_cast<unsigned int>(registers._bus2) <<")" << std::endl;
+    std::cout << "RAM writes : "<< counters._ramWrites << std::endl;
+    std::cout << "Clocks : "<< counters._peripheralClocks <<" (peripheral), "<< counters._spiClocks <<" (SPI)" << std::endl;
+    std::cout << "Ticks : "<< counters._ticks <<" (simple), "<< counters._longTicks <<" (long)" << std::endl;
+
+    if ( !ramDumpPath.empty() )
+    {
+        std::ofstream fileRamDump(ramDumpPath, std::ios::binary | std::ios::trunc);
+        if ( !fileRamDump )
+        {
+            std::cout << "Can't write the file \""<< ramDumpPath <<"\"" << std::endl;
+            return -1;
+        }
+        for (uint32_t a=0; a<65536; ++a)
+        {
+            fileRamDump.put( static_cast<char>(simulator.getRam(static_cast<uint16_t>(a))) );
+        }
+        std::cout << "RAM dump : \""<< ramDumpPath <<"\"" << std::endl;
+    }
+
+    if ( (stop == codeg::SimulatorStops::SIMULATOR_STOP_BAD_JUMP) || (stop == codeg::SimulatorStops::SIMULATOR_STOP_UNKNOWN_OPCODE) )
+    {
+        codeg::ConsoleErrorWrite(std::string("the execution stopped on a ")+codeg::ReadableStringSimulatorStops[stop]);
+        return -1;
+    }
+
+    if (benchmarkRuns > 0)
+    {
+        if ( rates.empty() )
+        {
+            std::cout << "The execution is too short to be measured" << std::endl;
+            return 0;
+        }
+        std::sort(rates.begin(), rates.end());
+        double best = rates.back();
+        double median = rates[rates.size()/2];
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Benchmark : "<< rates.size() <<" runs, best "<< best <<" M instructions/s, median "<< median <<" M instructions/s" << std::endl;
+
+        if (median < minRate)
+        {
+            codeg::ConsoleErrorWrite("the simulator is slower than "+std::to_string(minRate)+" M instructions/s");
+            return -1;
+        }
+    }
+
+    std::cout << "OK !" << std::endl;
+    return 0;
+}
@@ -0,0 +1,242 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright 2021 Guillaume Guillet                                            //
+//                                                                             //
+// Licensed under the Apache License, Version 2.0 (the "License");             //
+// you may not use this file except in compliance with the License.            //
+// You may obtain a copy of the License at                                     //
+//                                                                             //
+//     http://www.apache.org/licenses/LICENSE-2.0                              //
+//                                                                             //
+// Unless required by applicable law or agreed to in writing, software         //
+// distributed under the License is distributed on an "AS IS" BASIS,           //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    //
+// See the License for the specific language governing permissions and         //
+// limitations under the License.                                              //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <filesystem>
+
+#include "C_superoptimizer.hpp"
+#include "C_peephole.hpp"
+#include "C_instruction.hpp"
+#include "C_string.hpp"
+#include "C_value.hpp"
+#include "C_console.hpp"
+#include "C_error.hpp"
+
+#include "CMakeConfig.hpp"
+
+void printHelp()
+{
+    std::cout << "codeGSuperopt usage :" << std::endl << std::endl;
+
+    std::cout << "Set the output file of the peephole rules (default is \"superopt_rules\")" << std::endl;
+    std::cout << "\tcodeGSuperopt --out=<path>" << std::endl << std::endl;
+
+    std::cout << "Set the maximum length of the searched sequences (default is 3)" << std::endl;
+    std::cout << "\tcodeGSuperopt --length=<count>" << std::endl << std::endl;
+
+    std::cout << "Set the opcodes of the searched sequences (default is every supported opcode)" << std::endl;
+    std::cout << "\tcodeGSuperopt --opcodes=<opcode>,<opcode>,..." << std::endl << std::endl;
+
+    std::cout << "Set the number of threads (default is the number of cores)" << std::endl;
+    std::cout << "\tcodeGSuperopt --threads=<count>" << std::endl << std::endl;
+
+    std::cout << "Set the cache directory (default is \"superopt_cache\", an empty path disable the cache)" << std::endl;
+    std::cout << "\tcodeGSuperopt --cache=<path>" << std::endl << std::endl;
+
+    std::cout << "Print the version (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGSuperopt --version" << std::endl << std::endl;
+
+    std::cout << "Print the help page (and do nothing else)" << std::endl;
+    std::cout << "\tcodeGSuperopt --help" << std::endl << std::endl;
+}
+void printVersion()
+{
+    std::cout << "codeGSuperopt created by Guillaume Guillet, version " << CGG_VERSION_MAJOR << "." << CGG_VERSION_MINOR << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if ( int err = codeg::ConsoleInit() )
+    {
+        std::cout << "Warning, bad console init, the console can be ugly now ! (error: "<<err<<")" << std::endl;
+    }
+
+    std::string fileOutPath = "superopt_rules";
+    std::string cachePath = "superopt_cache";
+    uint32_t length = 3;
+    uint32_t threadCount = std::thread::hardware_concurrency();
+    std::vector<uint8_t> opcodes = codeg::Superoptimizer::getDefaultOpcodes();
+
+    std::vector<std::string> commands(argv, argv + argc);
+
+    for (unsigned int i=1; i<commands.size(); ++i)
+    {
+        //Commands
+        if ( commands[i] == "--help")
+        {
+            printHelp();
+            return 0;
+        }
+        if ( commands[i] == "--version")
+        {
+            printVersion();
+            return 0;
+        }
+
+        //Commands with an argument
+        std::vector<std::string> splitedCommand;
+        codeg::Split(commands[i], splitedCommand, '=');
+
+        if (splitedCommand.size() == 2)
+        {
+            if ( splitedCommand[0] == "--out")
+            {
+                fileOutPath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--cache")
+            {
+                cachePath = splitedCommand[1];
+                continue;
+            }
+            if ( splitedCommand[0] == "--length")
+            {
+                if ( codeg::GetIntegerFromString(splitedCommand[1], length) == 0 )
+                {
+                    std::cout << "Bad length : \""<< splitedCommand[1] <<"\" !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--threads")
+            {
+                if ( codeg::GetIntegerFromString(splitedCommand[1], threadCount) == 0 )
+                {
+                    std::cout << "Bad number of threads : \""<< splitedCommand[1] <<"\" !" << std::endl;
+                    return -1;
+                }
+                continue;
+            }
+            if ( splitedCommand[0] == "--opcodes")
+            {
+                std::vector<std::string> names;
+                codeg::Split(splitedCommand[1], names, ',');
+
+                opcodes.clear();
+                for (const std::string& name : names)
+                {
+                    uint8_t opcode = 0;
+                    while ( (opcode <= codeg::OPCODE_LTICK) && (name != codeg::ReadableStringBinaryOpcodes[opcode]) )
+                    {
+                        ++opcode;
+                    }
+                    if ( (opcode > codeg::OPCODE_LTICK) || !codeg::Superoptimizer::isSupportedOpcode(opcode) )
+                    {
+                        std::cout << "Unsupported opcode : \""<< name <<"\" !" << std::endl;
+                        return -1;
+                    }
+                    opcodes.push_back(opcode);
+                }
+                continue;
+            }
+        }
+
+        //Unknown command
+        std::cout << "Unknown command : \""<< commands[i] <<"\" !" << std::endl;
+        return -1;
+    }
+
+    if ( (length == 0) || (length > CODEG_SUPEROPTIMIZER_MAX_LENGTH) )
+    {
+        std::cout << "The length must be between 1 and "<< CODEG_SUPEROPTIMIZER_MAX_LENGTH <<" !" << std::endl;
+        return -1;
+    }
+    if ( opcodes.empty() )
+    {
+        std::cout << "No opcodes !" << std::endl;
+        return -1;
+    }
+
+    std::ofstream fileOut( fileOutPath, std::ios::trunc );
+    if ( !fileOut )
+    {
+        std::cout << "Can't write the file \""<< fileOutPath <<"\"" << std::endl;
+        return -1;
+    }
+    if ( !cachePath.empty() )
+    {
+        std::error_code err;
+        std::filesystem::create_directories(cachePath, err);
+        if (err)
+        {
+            codeg::ConsoleWarningWrite("can't create the cache directory \""+cachePath+"\", the cache is disabled");
+            cachePath.clear();
+        }
+    }
+
+    std::cout << "Output file : \""<< fileOutPath <<"\"" << std::endl;
+    std::cout << "Threads : "<< threadCount << std::endl;
+
+    ///Searching
+    codeg::Superoptimizer superoptimizer;
+    superoptimizer.setThreadCount(threadCount);
+    superoptimizer.setCachePath(cachePath);
+
+    try
+    {
+        superoptimizer.setOpcodes(opcodes);
+
+        for (uint32_t l=1; l<=length; ++l)
+        {
+            std::size_t rewriteCount = superoptimizer.getRewrites().size();
+            superoptimizer.search(l);
+
+            codeg::ConsoleInfoWrite("length "+std::to_string(l)+" : "+
+                                    std::to_string(superoptimizer.getSequenceCount(l))+" sequences can't be reduced, "+
+                                    std::to_string(superoptimizer.getRewrites().size()-rewriteCount)+" rewrites found"+
+                                    (superoptimizer.isCached(l) ? " (cached)" : ""));
+        }
+    }
+    catch (const codeg::FatalError& e)
+    {
+        codeg::ConsoleFatalWrite(e.what());
+        return -1;
+    }
+
+    ///Writing the rules (the same syntax as --peephole of the compiler)
+    codeg::Peephole peephole;
+
+    fileOut << "#Peephole rules found by codeGSuperopt (sequences up to " << length << " instructions)" << std::endl;
+    fileOut << "#Opcodes :";
+    for (uint8_t opcode : opcodes)
+    {
+        fileOut << " " << ToReadableOpcode(opcode);
+    }
+    fileOut << std::endl;
+
+    for (std::size_t i=0; i<superoptimizer.getRewrites().size(); ++i)
+    {
+        std::string rule = superoptimizer.getRule(i);
+        try
+        {
+            peephole.addRule(rule);
+        }
+        catch (const codeg::SyntaxError& e)
+        {
+            codeg::ConsoleFatalWrite(std::string("bad generated rule : ")+e.what());
+            return -1;
+        }
+        fileOut << rule << std::endl;
+    }
+
+    std::cout << superoptimizer.getRewrites().size() << " rules written" << std::endl;
+    std::cout << "OK !" << std::endl;
+    return 0;
+}